@@ -0,0 +1,115 @@
+//Compares std::map, btree_map and fixed_btree_map holding N random keys: finding keys, replacing a key by
+//erasing it and inserting another, and scanning ranges of 64 elements from a lower_bound.
+//
+//  make bench
+//  ./bench/bin/btree_map_bench
+
+#include <flex/fixed_btree_map.h>
+
+#include <map>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  uint32_t next(uint32_t& seed)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+
+  struct timings
+  {
+    double mFind;
+    double mChurn;
+    double mScan;
+    uint64_t mCheck;
+  };
+
+  template<class Map>
+  timings run_map(Map& map, uint32_t* keys, size_t n)
+  {
+    const size_t steps = 1 << 20;
+    timings t;
+    t.mCheck = 0;
+    uint32_t seed = 2463534242u;
+    map.clear();
+    for (size_t i = 0; i < n; ++i)
+    {
+      keys[i] = next(seed);
+      map[keys[i]] = i;
+    }
+
+    double start = now();
+    for (size_t i = 0; i < steps; ++i)
+    {
+      t.mCheck += map.find(keys[next(seed) % n])->second;
+    }
+    t.mFind = (now() - start) * 1e9 / steps;
+
+    start = now();
+    for (size_t i = 0; i < steps; ++i)
+    {
+      uint32_t& key = keys[next(seed) % n];
+      map.erase(key);
+      key = next(seed);
+      map[key] = i;
+    }
+    t.mChurn = (now() - start) * 1e9 / steps;
+
+    const size_t scans = steps / 64;
+    start = now();
+    for (size_t i = 0; i < scans; ++i)
+    {
+      typename Map::iterator it = map.lower_bound(next(seed));
+      for (int j = 0; (j < 64) && (it != map.end()); ++j, ++it)
+      {
+        t.mCheck += it->second;
+      }
+    }
+    t.mScan = (now() - start) * 1e9 / (scans * 64);
+    return t;
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static uint32_t keys[N];
+    static std::map<uint32_t, uint32_t> map;
+    static flex::btree_map<uint32_t, uint32_t> btree;
+    static flex::fixed_btree_map<uint32_t, uint32_t, N> fixed_btree;
+
+    const timings a = run_map(map, keys, N);
+    const timings b = run_map(btree, keys, N);
+    const timings c = run_map(fixed_btree, keys, N);
+    if ((a.mCheck != b.mCheck) || (a.mCheck != c.mCheck))
+    {
+      printf("std::map and btree_map disagree at %lu keys\n", (unsigned long) N);
+    }
+    printf("%10lu %-16s %10.2f %10.2f %10.2f\n", (unsigned long) N, "std::map", a.mFind, a.mChurn, a.mScan);
+    printf("%10lu %-16s %10.2f %10.2f %10.2f\n", (unsigned long) N, "btree_map", b.mFind, b.mChurn, b.mScan);
+    printf("%10lu %-16s %10.2f %10.2f %10.2f\n", (unsigned long) N, "fixed_btree_map", c.mFind, c.mChurn, c.mScan);
+  }
+
+}
+
+int main()
+{
+  printf("%10s %-16s %10s %10s %10s\n", "keys", "container", "find ns", "churn ns", "scan ns");
+  run<1 << 10>();
+  run<1 << 14>();
+  run<1 << 18>();
+  run<1 << 20>();
+  return 0;
+}
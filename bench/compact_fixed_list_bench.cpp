@@ -0,0 +1,91 @@
+//Compares traversal of fixed_list and compact_fixed_list holding uint32_t, with the nodes linked in a
+//shuffled order so that each step is a dependent load from an unpredictable address.
+//
+//  make bench
+//  ./bench/bin/compact_fixed_list_bench
+//
+//The compact list wins while its nodes fit in a cache level that the pointer-linked nodes overflow.  When both
+//fit, or neither does, the extra index arithmetic on each step can make it slightly slower.
+
+#include <flex/compact_fixed_list.h>
+#include <flex/fixed_list.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  //Orders values by a multiplicative hash, which shuffles the links without moving the nodes.
+  struct hash_less
+  {
+    bool operator()(uint32_t a, uint32_t b) const
+    {
+      return (a * 2654435761u) < (b * 2654435761u);
+    }
+  };
+
+  template<class List>
+  double traverse_ns(List& list, size_t n, uint64_t& check)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      list.push_back(static_cast<uint32_t>(i));
+    }
+    list.sort(hash_less());
+
+    const size_t passes = (1 << 25) / n;
+    const double start = now();
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+      for (typename List::const_iterator it = list.begin(); it != list.end(); ++it)
+      {
+        check += *it;
+      }
+    }
+    return (now() - start) * 1e9 / (passes * n);
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static flex::fixed_list<uint32_t, N> pointer_list;
+    static flex::compact_fixed_list<uint32_t, N> compact_list;
+
+    uint64_t check_pointer = 0;
+    uint64_t check_compact = 0;
+    const double pointer_ns = traverse_ns(pointer_list, N, check_pointer);
+    const double compact_ns = traverse_ns(compact_list, N, check_compact);
+    if (check_pointer != check_compact)
+    {
+      printf("fixed_list and compact_fixed_list disagree at %lu elements\n", (unsigned long) N);
+    }
+    printf("%10lu %8lu %8lu %14.2f %15.2f %9.2fx\n", (unsigned long) N,
+        (unsigned long) sizeof(typename flex::fixed_list<uint32_t, N>::node_type),
+        (unsigned long) sizeof(typename flex::compact_fixed_list<uint32_t, N>::node_type), pointer_ns, compact_ns,
+        pointer_ns / compact_ns);
+  }
+
+}
+
+int main()
+{
+  printf("%10s %8s %8s %14s %15s %10s\n", "elements", "node", "compact", "list ns/step", "compact ns/step",
+      "speedup");
+  run<1 << 10>();
+  run<1 << 12>();
+  run<1 << 14>();
+  run<1 << 16>();
+  run<1 << 17>();
+  run<1 << 18>();
+  run<1 << 20>();
+  return 0;
+}
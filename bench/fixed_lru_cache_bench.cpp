@@ -0,0 +1,115 @@
+//Compares fixed_lru_cache with the usual hand-rolled LRU built from a fixed_list of entries and a fixed_hash_map
+//from key to list iterator.  Keys are drawn from a range twice the capacity, so about half of the lookups miss
+//and each miss is followed by a put that evicts.
+//
+//  make bench
+//  ./bench/bin/fixed_lru_cache_bench
+
+#include <flex/fixed_hash_map.h>
+#include <flex/fixed_list.h>
+#include <flex/fixed_lru_cache.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  template<size_t N>
+  class hand_rolled_cache
+  {
+  public:
+    typedef flex::fixed_list<std::pair<uint32_t, uint32_t>, N> list_type;
+    typedef flex::fixed_hash_map<uint32_t, typename list_type::iterator, N> map_type;
+
+    uint32_t* get(uint32_t key)
+    {
+      typename map_type::iterator it = mMap.find(key);
+      if (it == mMap.end())
+      {
+        return NULL;
+      }
+      //A fixed_list splices by copying, so refresh the entry by hand and repoint the map at it.
+      const std::pair<uint32_t, uint32_t> entry = *it->second;
+      mList.erase(it->second);
+      mList.push_front(entry);
+      it->second = mList.begin();
+      return &it->second->second;
+    }
+
+    void put(uint32_t key, uint32_t val)
+    {
+      if (mList.size() == N)
+      {
+        mMap.erase(mList.back().first);
+        mList.pop_back();
+      }
+      mList.push_front(std::make_pair(key, val));
+      mMap[key] = mList.begin();
+    }
+
+  protected:
+    list_type mList;
+    map_type mMap;
+  };
+
+  template<class Cache>
+  double run_ns(Cache& cache, size_t range, size_t steps, uint64_t& check)
+  {
+    uint32_t seed = 1;
+    const double start = now();
+    for (size_t i = 0; i < steps; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      const uint32_t key = (seed >> 8) % range;
+      uint32_t* val = cache.get(key);
+      if (val)
+      {
+        check += *val;
+      }
+      else
+      {
+        cache.put(key, key);
+      }
+    }
+    return (now() - start) * 1e9 / steps;
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static hand_rolled_cache<N> hand_rolled;
+    static flex::fixed_lru_cache<uint32_t, uint32_t, N> cache;
+
+    const size_t steps = 1 << 22;
+    uint64_t check_hand_rolled = 0;
+    uint64_t check_cache = 0;
+    const double hand_rolled_ns = run_ns(hand_rolled, 2 * N, steps, check_hand_rolled);
+    const double cache_ns = run_ns(cache, 2 * N, steps, check_cache);
+    if (check_hand_rolled != check_cache)
+    {
+      printf("caches disagree at %lu entries\n", (unsigned long) N);
+    }
+    printf("%10lu %16.2f %14.2f %9.2fx %9.1f%%\n", (unsigned long) N, hand_rolled_ns, cache_ns,
+        hand_rolled_ns / cache_ns, 100.0 * cache.hits() / (cache.hits() + cache.misses()));
+  }
+
+}
+
+int main()
+{
+  printf("%10s %16s %14s %10s %10s\n", "entries", "list+map ns/op", "lru ns/op", "speedup", "hit rate");
+  run<1 << 8>();
+  run<1 << 12>();
+  run<1 << 16>();
+  run<1 << 18>();
+  return 0;
+}
@@ -0,0 +1,163 @@
+//Compares std::for_each with flex::for_each_prefetched over a fixed_list whose nodes are linked in shuffled
+//buffer order, and over a hash_map whose nodes were recycled in random order.  Each element is a 32 byte
+//record that the function sums, either directly or after some mixing work per element.
+//
+//  make bench
+//  ./bench/bin/for_each_prefetched_bench
+
+#include <flex/algorithm.h>
+#include <flex/fixed_list.h>
+#include <flex/hash_map.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  const size_t ELEMENTS = 1 << 20;
+
+  struct record
+  {
+    uint64_t mField[4];
+  };
+
+  //Sums the records after Rounds of mixing each.  With enough rounds the next node's load no longer fits in
+  //the out-of-order window behind the work, which is where prefetching pays off.
+  template<int Rounds>
+  struct sum_record
+  {
+    uint64_t mTotal;
+
+    sum_record() :
+        mTotal(0)
+    {
+    }
+
+    void operator()(const record& r)
+    {
+      uint64_t h = r.mField[0] ^ (r.mField[1] + r.mField[2]) ^ r.mField[3];
+      for (int i = 0; i < Rounds; ++i)
+      {
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ULL;
+      }
+      mTotal += h;
+    }
+
+    void operator()(const std::pair<const uint32_t, record>& p)
+    {
+      (*this)(p.second);
+    }
+  };
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  uint32_t next(uint32_t& seed)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+
+  record make_record(uint32_t i)
+  {
+    record r;
+    for (int j = 0; j < 4; ++j)
+    {
+      r.mField[j] = i * 4 + j;
+    }
+    return r;
+  }
+
+  template<int Rounds, class Container>
+  void run(const char* name, const Container& c)
+  {
+    const int passes = 8;
+    sum_record<Rounds> expected;
+    double start = now();
+    for (int pass = 0; pass < passes; ++pass)
+    {
+      expected = std::for_each(c.begin(), c.end(), sum_record<Rounds>());
+    }
+    const double plain_ns = (now() - start) * 1e9 / (passes * c.size());
+    printf("%-12s %8d %10s %10.2f\n", name, Rounds, "for_each", plain_ns);
+
+    const size_t distances[] = { 1, 2, 4, 8, 16 };
+    for (size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); ++d)
+    {
+      sum_record<Rounds> s;
+      start = now();
+      for (int pass = 0; pass < passes; ++pass)
+      {
+        s = flex::for_each_prefetched(c, sum_record<Rounds>(), distances[d]);
+      }
+      const double ns = (now() - start) * 1e9 / (passes * c.size());
+      if (s.mTotal != expected.mTotal)
+      {
+        printf("%s: for_each_prefetched disagrees with std::for_each\n", name);
+      }
+      printf("%-12s %8d %10lu %10.2f\n", name, Rounds, (unsigned long) distances[d], ns);
+    }
+  }
+
+}
+
+int main()
+{
+  uint32_t seed = 2463534242u;
+
+  //Fill the list, then erase it in random order so the node pool hands the buffer back shuffled.
+  static flex::fixed_list<record, ELEMENTS> list;
+  {
+    static flex::fixed_list<record, ELEMENTS>::iterator nodes[ELEMENTS];
+    for (uint32_t i = 0; i < ELEMENTS; ++i)
+    {
+      list.push_back(make_record(i));
+      nodes[i] = --list.end();
+    }
+    for (size_t i = ELEMENTS - 1; i > 0; --i)
+    {
+      std::swap(nodes[i], nodes[next(seed) % (i + 1)]);
+    }
+    for (size_t i = 0; i < ELEMENTS; ++i)
+    {
+      list.erase(nodes[i]);
+    }
+    for (uint32_t i = 0; i < ELEMENTS; ++i)
+    {
+      list.push_back(make_record(i));
+    }
+  }
+
+  //Churn the map so recycled nodes are scattered through the heap relative to bucket order.
+  static uint32_t keys[ELEMENTS];
+  flex::hash_map<uint32_t, record> map;
+  for (uint32_t i = 0; i < ELEMENTS; ++i)
+  {
+    keys[i] = next(seed);
+    map[keys[i]] = make_record(i);
+  }
+  for (uint32_t i = 0; i < 4 * ELEMENTS; ++i)
+  {
+    uint32_t& key = keys[next(seed) % ELEMENTS];
+    map.erase(key);
+    key = next(seed);
+    map[key] = make_record(i);
+  }
+
+  printf("%-12s %8s %10s %10s\n", "container", "rounds", "distance", "ns/elem");
+  run<0>("fixed_list", list);
+  run<48>("fixed_list", list);
+  run<0>("hash_map", map);
+  run<48>("hash_map", map);
+  return 0;
+}
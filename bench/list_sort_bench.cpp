@@ -0,0 +1,101 @@
+//Times list::sort() and list::radix_sort() on a fixed_list of pseudo-random uint32_t keys, with the nodes linked
+//in an order unrelated to where they sit in the buffer, as after a long run of inserts and erases.
+//
+//  make bench
+//  ./bench/bin/list_sort_bench
+
+#include <flex/fixed_list.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  struct identity_key
+  {
+    uint32_t operator()(uint32_t x) const
+    {
+      return x;
+    }
+  };
+
+  //Orders values by a multiplicative hash, which shuffles the links without moving the nodes.
+  struct hash_less
+  {
+    bool operator()(uint32_t a, uint32_t b) const
+    {
+      return (a * 2654435761u) < (b * 2654435761u);
+    }
+  };
+
+  template<class List>
+  void fill(List& list, size_t n)
+  {
+    list.clear();
+    uint32_t seed = 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      list.push_back(seed);
+    }
+    list.sort(hash_less());
+  }
+
+  template<class List>
+  bool is_sorted(const List& list)
+  {
+    typename List::const_iterator prev = list.begin();
+    for (typename List::const_iterator it = prev; it != list.end(); prev = it++)
+    {
+      if (*it < *prev)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static flex::fixed_list<uint32_t, N> list;
+
+    fill(list, N);
+    double start = now();
+    list.sort();
+    const double sort_ms = (now() - start) * 1e3;
+    const bool sort_ok = is_sorted(list);
+
+    fill(list, N);
+    start = now();
+    list.radix_sort(identity_key());
+    const double radix_ms = (now() - start) * 1e3;
+    const bool radix_ok = is_sorted(list);
+
+    if (!sort_ok || !radix_ok)
+    {
+      printf("unsorted result at %lu elements\n", (unsigned long) N);
+    }
+    printf("%10lu %10.2f %12.2f\n", (unsigned long) N, sort_ms, radix_ms);
+  }
+
+}
+
+int main()
+{
+  printf("%10s %10s %12s\n", "elements", "sort ms", "radix ms");
+  run<1 << 10>();
+  run<1 << 14>();
+  run<1 << 17>();
+  run<1 << 20>();
+  return 0;
+}
@@ -0,0 +1,106 @@
+//Compares std::map, skip_map and fixed_skip_map as one side of a price-level order book.  Each step updates
+//the quantity at a price near the best level, adding the level if it is missing and removing it when the
+//quantity runs out, then reads the best level.
+//
+//  make bench
+//  ./bench/bin/skip_map_bench
+
+#include <flex/fixed_skip_map.h>
+
+#include <map>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  uint32_t next(uint32_t& seed)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+
+  template<class Book>
+  double book_ns(Book& book, size_t levels, uint64_t& check)
+  {
+    const size_t steps = 1 << 22;
+    uint32_t seed = 12345;
+    book.clear();
+    for (size_t i = 0; i < levels; ++i)
+    {
+      book[static_cast<uint32_t>(i)] = 100;
+    }
+
+    const double start = now();
+    for (size_t i = 0; i < steps; ++i)
+    {
+      //Most updates land within a few levels of the best price.
+      const uint32_t r = next(seed);
+      const uint32_t best = book.empty() ? 0 : book.begin()->first;
+      const uint32_t price = best + ((r & 7) ? (r >> 8) % 8 : (r >> 8) % (2 * levels));
+      typename Book::iterator it = book.find(price);
+      if (it == book.end())
+      {
+        if (book.size() < levels)
+        {
+          book[price] = 1 + (r & 63);
+        }
+      }
+      else if (it->second <= (r & 15))
+      {
+        book.erase(it);
+      }
+      else
+      {
+        it->second -= (r & 15);
+      }
+      if (!book.empty())
+      {
+        check += book.begin()->first + book.begin()->second;
+      }
+    }
+    return (now() - start) * 1e9 / steps;
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static std::map<uint32_t, uint32_t> map;
+    static flex::skip_map<uint32_t, uint32_t> skip;
+    static flex::fixed_skip_map<uint32_t, uint32_t, N> fixed_skip;
+
+    uint64_t check_map = 0;
+    uint64_t check_skip = 0;
+    uint64_t check_fixed = 0;
+    const double map_ns = book_ns(map, N, check_map);
+    const double skip_ns = book_ns(skip, N, check_skip);
+    const double fixed_ns = book_ns(fixed_skip, N, check_fixed);
+    if ((check_map != check_skip) || (check_map != check_fixed))
+    {
+      printf("std::map and skip_map disagree at %lu levels\n", (unsigned long) N);
+    }
+    printf("%10lu %14.2f %14.2f %14.2f %14lu\n", (unsigned long) N, map_ns, skip_ns, fixed_ns,
+        (unsigned long) sizeof(flex::fixed_skip_map<uint32_t, uint32_t, N>));
+  }
+
+}
+
+int main()
+{
+  printf("%10s %14s %14s %14s %14s\n", "levels", "std::map ns", "skip_map ns", "fixed ns", "fixed bytes");
+  run<1 << 4>();
+  run<1 << 8>();
+  run<1 << 12>();
+  run<1 << 16>();
+  return 0;
+}
@@ -0,0 +1,99 @@
+//Compares fixed_list and fixed_slist holding uint32_t, used as a queue (push_back/pop_front) and as a stack
+//(push_front/pop_front).
+//
+//  make bench
+//  ./bench/bin/slist_bench
+
+#include <flex/fixed_list.h>
+#include <flex/fixed_slist.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  template<class List>
+  double queue_ns(List& list, size_t depth, uint64_t& check)
+  {
+    //Keeps depth elements queued while cycling values through.
+    const size_t steps = 1 << 24;
+    list.clear();
+    for (size_t i = 0; i < depth; ++i)
+    {
+      list.push_back(static_cast<uint32_t>(i));
+    }
+    const double start = now();
+    for (size_t i = 0; i < steps; ++i)
+    {
+      check += list.front();
+      list.pop_front();
+      list.push_back(static_cast<uint32_t>(i));
+    }
+    return (now() - start) * 1e9 / steps;
+  }
+
+  template<class List>
+  double stack_ns(List& list, size_t depth, uint64_t& check)
+  {
+    //Fills to depth and drains again, repeatedly.
+    const size_t passes = (1 << 24) / depth;
+    list.clear();
+    const double start = now();
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+      for (size_t i = 0; i < depth; ++i)
+      {
+        list.push_front(static_cast<uint32_t>(i));
+      }
+      for (size_t i = 0; i < depth; ++i)
+      {
+        check += list.front();
+        list.pop_front();
+      }
+    }
+    return (now() - start) * 1e9 / (passes * depth);
+  }
+
+  template<size_t N>
+  void run()
+  {
+    static flex::fixed_list<uint32_t, N> list;
+    static flex::fixed_slist<uint32_t, N> slist;
+
+    uint64_t check_list = 0;
+    uint64_t check_slist = 0;
+    const double list_queue = queue_ns(list, N, check_list);
+    const double slist_queue = queue_ns(slist, N, check_slist);
+    const double list_stack = stack_ns(list, N, check_list);
+    const double slist_stack = stack_ns(slist, N, check_slist);
+    if (check_list != check_slist)
+    {
+      printf("fixed_list and fixed_slist disagree at %lu elements\n", (unsigned long) N);
+    }
+    printf("%10lu %10lu %11lu %14.2f %15.2f %14.2f %15.2f\n", (unsigned long) N,
+        (unsigned long) sizeof(typename flex::fixed_list<uint32_t, N>::node_type),
+        (unsigned long) sizeof(typename flex::fixed_slist<uint32_t, N>::node_type), list_queue, slist_queue,
+        list_stack, slist_stack);
+  }
+
+}
+
+int main()
+{
+  printf("%10s %10s %11s %14s %15s %14s %15s\n", "elements", "list node", "slist node", "list queue ns",
+      "slist queue ns", "list stack ns", "slist stack ns");
+  run<1 << 6>();
+  run<1 << 12>();
+  run<1 << 16>();
+  run<1 << 20>();
+  return 0;
+}
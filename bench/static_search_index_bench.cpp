@@ -0,0 +1,79 @@
+//Compares static_search_index::lower_bound with std::lower_bound over sorted tables of 1K to 100M ints.
+//
+//  make bench
+//  ./bench/bin/static_search_index_bench [max keys]
+//
+//The 100M key table and its index take about 1GB of memory; pass a smaller maximum to stop earlier.
+
+#include <flex/static_search_index.h>
+#include <flex/vector.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  unsigned int next_random(unsigned int& state)
+  {
+    state = state * 1664525u + 1013904223u;
+    return state;
+  }
+
+}
+
+int main(int argc, char** argv)
+{
+  const size_t max_keys = (argc > 1) ? strtoul(argv[1], NULL, 10) : 100000000;
+  const size_t queries = 10000000;
+
+  printf("%12s %14s %14s %10s\n", "keys", "std ns/query", "index ns/query", "speedup");
+  for (size_t n = 1000; n <= max_keys; n *= 10)
+  {
+    flex::vector<int> table(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      table[i] = static_cast<int>(2 * i);
+    }
+    flex::static_search_index<int> index(table.begin(), table.end());
+
+    flex::vector<int> keys(queries);
+    unsigned int state = 12345;
+    for (size_t i = 0; i < queries; ++i)
+    {
+      keys[i] = static_cast<int>(next_random(state) % (2 * n));
+    }
+
+    size_t check = 0;
+    double start = now();
+    for (size_t i = 0; i < queries; ++i)
+    {
+      check += std::lower_bound(table.begin(), table.end(), keys[i]) - table.begin();
+    }
+    const double std_ns = (now() - start) * 1e9 / queries;
+
+    start = now();
+    for (size_t i = 0; i < queries; ++i)
+    {
+      check -= index.lower_bound(keys[i]);
+    }
+    const double index_ns = (now() - start) * 1e9 / queries;
+
+    if (check != 0)
+    {
+      printf("static_search_index and std::lower_bound disagree at %lu keys\n", (unsigned long) n);
+      return 1;
+    }
+    printf("%12lu %14.1f %14.1f %9.2fx\n", (unsigned long) n, std_ns, index_ns, std_ns / index_ns);
+  }
+  return 0;
+}
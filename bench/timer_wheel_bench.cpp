@@ -0,0 +1,135 @@
+//Compares a std::multimap keyed by expiry tick with timer_wheel as the timeout list of an order book.  Each
+//of 2^20 orders holds one timeout.  Each step cancels an order's timeout and schedules a new one up to
+//2^16 ticks out, and every fourth step the clock ticks, which expires whatever is due.
+//
+//  make bench
+//  ./bench/bin/timer_wheel_bench
+
+#include <flex/timer_wheel.h>
+
+#include <map>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  const size_t ORDERS = 1 << 20;
+  const size_t STEPS = 1 << 24;
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  uint32_t next(uint32_t& seed)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+
+  //Clears the handle of an order whose timeout fired.
+  struct expire_order
+  {
+    expire_order() :
+        handles(NULL), expired(0)
+    {
+    }
+
+    void operator()(uint32_t& order)
+    {
+      handles[order] = flex::timer_wheel_handle();
+      ++expired;
+    }
+
+    flex::timer_wheel_handle* handles;
+    uint64_t expired;
+  };
+
+  typedef flex::timer_wheel<uint32_t, ORDERS, expire_order> wheel_type;
+  typedef std::multimap<uint64_t, uint32_t> multimap_type;
+
+  double run_multimap(uint64_t& expired)
+  {
+    static multimap_type timeouts;
+    static multimap_type::iterator handles[ORDERS];
+    uint32_t seed = 2463534242u;
+    uint64_t clock = 0;
+    for (uint32_t i = 0; i < ORDERS; ++i)
+    {
+      handles[i] = timeouts.insert(std::make_pair(clock + 1 + next(seed) % 65536, i));
+    }
+
+    const double start = now();
+    for (size_t i = 0; i < STEPS; ++i)
+    {
+      const uint32_t order = next(seed) % ORDERS;
+      if (handles[order] != timeouts.end())
+      {
+        timeouts.erase(handles[order]);
+      }
+      handles[order] = timeouts.insert(std::make_pair(clock + 1 + next(seed) % 65536, order));
+      if ((i & 3) == 0)
+      {
+        ++clock;
+        while (!timeouts.empty() && (timeouts.begin()->first <= clock))
+        {
+          handles[timeouts.begin()->second] = timeouts.end();
+          timeouts.erase(timeouts.begin());
+          ++expired;
+        }
+      }
+    }
+    return (now() - start) * 1e9 / STEPS;
+  }
+
+  double run_wheel(uint64_t& expired)
+  {
+    static wheel_type timeouts;
+    static flex::timer_wheel_handle handles[ORDERS];
+    timeouts.get_expiry_handler().handles = handles;
+    uint32_t seed = 2463534242u;
+    for (uint32_t i = 0; i < ORDERS; ++i)
+    {
+      handles[i] = timeouts.schedule(1 + next(seed) % 65536, i);
+    }
+
+    const double start = now();
+    for (size_t i = 0; i < STEPS; ++i)
+    {
+      const uint32_t order = next(seed) % ORDERS;
+      timeouts.cancel(handles[order]);
+      handles[order] = timeouts.schedule(1 + next(seed) % 65536, order);
+      if ((i & 3) == 0)
+      {
+        timeouts.tick();
+      }
+    }
+    expired = timeouts.get_expiry_handler().expired;
+    return (now() - start) * 1e9 / STEPS;
+  }
+
+}
+
+int main()
+{
+  uint64_t multimap_expired = 0;
+  uint64_t wheel_expired = 0;
+  const double multimap_ns = run_multimap(multimap_expired);
+  const double wheel_ns = run_wheel(wheel_expired);
+  if (multimap_expired != wheel_expired)
+  {
+    printf("std::multimap expired %lu timers and timer_wheel %lu\n", (unsigned long) multimap_expired,
+        (unsigned long) wheel_expired);
+  }
+  printf("%-16s %14s %14s\n", "container", "ns/step", "expired");
+  printf("%-16s %14.2f %14lu\n", "std::multimap", multimap_ns, (unsigned long) multimap_expired);
+  printf("%-16s %14.2f %14lu\n", "timer_wheel", wheel_ns, (unsigned long) wheel_expired);
+  printf("%-16s %14lu\n", "wheel bytes", (unsigned long) sizeof(wheel_type));
+  return 0;
+}
@@ -0,0 +1,89 @@
+//Compares list and unrolled_list holding uint32_t.  Both are built by inserting at pseudo-random positions,
+//so the list nodes are linked in an order unrelated to where they were allocated.
+//
+//  make bench
+//  ./bench/bin/unrolled_list_bench
+//
+//Traversal is the gain: the unrolled list takes one dependent load per chunk instead of one per element.
+//Building includes walking to the insertion point, which dominates for both containers at these sizes.
+
+#include <flex/list.h>
+#include <flex/unrolled_list.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace
+{
+
+  double now()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  template<class List>
+  double build_ns(List& list, size_t n)
+  {
+    //Insert each element a pseudo-random distance from the front of the list.
+    const double start = now();
+    uint32_t seed = 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      typename List::iterator it = list.begin();
+      std::advance(it, (seed >> 8) % (list.size() + 1));
+      list.insert(it, static_cast<uint32_t>(i));
+    }
+    return (now() - start) * 1e9 / n;
+  }
+
+  template<class List>
+  double traverse_ns(const List& list, uint64_t& check)
+  {
+    const size_t passes = (1 << 26) / list.size();
+    const double start = now();
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+      for (typename List::const_iterator it = list.begin(); it != list.end(); ++it)
+      {
+        check += *it;
+      }
+    }
+    return (now() - start) * 1e9 / (passes * list.size());
+  }
+
+  void run(size_t n)
+  {
+    flex::list<uint32_t> list;
+    flex::unrolled_list<uint32_t> unrolled;
+
+    const double list_build = build_ns(list, n);
+    const double unrolled_build = build_ns(unrolled, n);
+
+    uint64_t check_list = 0;
+    uint64_t check_unrolled = 0;
+    const double list_ns = traverse_ns(list, check_list);
+    const double unrolled_ns = traverse_ns(unrolled, check_unrolled);
+    if ((check_list != check_unrolled) || !std::equal(list.begin(), list.end(), unrolled.begin()))
+    {
+      printf("list and unrolled_list disagree at %lu elements\n", (unsigned long) n);
+    }
+    printf("%10lu %14.2f %18.2f %9.2fx %14.2f %18.2f\n", (unsigned long) n, list_ns, unrolled_ns,
+        list_ns / unrolled_ns, list_build, unrolled_build);
+  }
+
+}
+
+int main()
+{
+  printf("%10s %14s %18s %10s %14s %18s\n", "elements", "list ns/step", "unrolled ns/step", "speedup",
+      "list ns/insert", "unrolled ns/insert");
+  run(1 << 10);
+  run(1 << 12);
+  run(1 << 14);
+  run(1 << 16);
+  return 0;
+}
@@ -0,0 +1,317 @@
+#ifndef FLEX_ALGORITHM_H
+#define FLEX_ALGORITHM_H
+
+#include <flex/list.h>
+#include <flex/ring.h>
+#include <flex/vector.h>
+#include <flex/internal/hashtable.h>
+#include <flex/internal/simd.h>
+
+namespace flex
+{
+
+  //Container algorithms for vector and ring, which also cover fixed_vector, small_vector and fixed_ring.
+  //Containers of int, long, long long, float and double are searched with SSE2 or AVX2 kernels chosen at
+  //runtime; any other element type uses the std algorithm.  A ring is processed as the two contiguous spans
+  //on either side of its wrap-around point, so it is vectorized as well.  See internal/simd.h.
+  //
+  //Node-based containers can't be vectorized, but their traversals stall on each node's link.
+  //for_each_prefetched() walks a list or hash table while prefetching the nodes ahead of the one being
+  //processed.
+
+  /// ring_spans
+  ///
+  /// The elements of a ring as at most two contiguous spans.  The second span is empty when the elements
+  /// do not wrap around the end of the buffer.
+  ///
+  template<class T> struct ring_spans
+  {
+    const T* mFirst[2];
+    const T* mLast[2];
+
+    template<class Iterator>
+    ring_spans(Iterator first, Iterator last)
+    {
+      mFirst[0] = first.mPtr;
+      if (first.mPtr <= last.mPtr)
+      {
+        mLast[0] = last.mPtr;
+        mFirst[1] = mLast[1] = last.mPtr;
+      }
+      else
+      {
+        mLast[0] = first.mRightBound + 1;
+        mFirst[1] = first.mLeftBound;
+        mLast[1] = last.mPtr;
+      }
+    }
+
+    //Distance from the first element to p, which points into the given span.
+    size_t index(const T* p, int span) const
+    {
+      return (span == 0) ? (p - mFirst[0]) : ((mLast[0] - mFirst[0]) + (p - mFirst[1]));
+    }
+
+    size_t find(const T& value) const
+    {
+      const T* p = simd::find(mFirst[0], mLast[0], value);
+      if (p != mLast[0])
+      {
+        return index(p, 0);
+      }
+      return index(simd::find(mFirst[1], mLast[1], value), 1);
+    }
+
+    template<bool Min>
+    size_t extreme_element() const
+    {
+      const T* a = Min ? simd::min_element(mFirst[0], mLast[0]) : simd::max_element(mFirst[0], mLast[0]);
+      const T* b = Min ? simd::min_element(mFirst[1], mLast[1]) : simd::max_element(mFirst[1], mLast[1]);
+      if ((a == mLast[0]) || ((b != mLast[1]) && (Min ? (*b < *a) : (*a < *b))))
+      {
+        return index(b, 1);
+      }
+      return index(a, 0);
+    }
+  };
+
+  /// accumulate
+  ///
+  /// Equivalent to std::accumulate(c.begin(), c.end(), init).  A floating point sum is added lane by lane
+  /// and may differ from std::accumulate in its last bits.
+  ///
+  template<class T, class Alloc, class Growth, class U>
+  inline U accumulate(const vector<T, Alloc, Growth>& c, U init)
+  {
+    return simd::accumulate(c.begin(), c.end(), init);
+  }
+
+  template<class T, class Alloc, class Growth, class U>
+  inline U accumulate(const ring<T, Alloc, Growth>& c, U init)
+  {
+    ring_spans<T> s(c.begin(), c.end());
+    return simd::accumulate(s.mFirst[1], s.mLast[1], simd::accumulate(s.mFirst[0], s.mLast[0], init));
+  }
+
+  /// contains
+  ///
+  /// Returns true if an element of c equals value.
+  ///
+  template<class T, class Alloc, class Growth>
+  inline bool contains(const vector<T, Alloc, Growth>& c, const typename vector<T, Alloc, Growth>::value_type& value)
+  {
+    return (simd::find(c.begin(), c.end(), value) != c.end());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline bool contains(const ring<T, Alloc, Growth>& c, const typename ring<T, Alloc, Growth>::value_type& value)
+  {
+    return (ring_spans<T>(c.begin(), c.end()).find(value) != c.size());
+  }
+
+  /// count
+  ///
+  /// Equivalent to std::count(c.begin(), c.end(), value).
+  ///
+  template<class T, class Alloc, class Growth>
+  inline size_t count(const vector<T, Alloc, Growth>& c, const typename vector<T, Alloc, Growth>::value_type& value)
+  {
+    return simd::count(c.begin(), c.end(), value);
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline size_t count(const ring<T, Alloc, Growth>& c, const typename ring<T, Alloc, Growth>::value_type& value)
+  {
+    ring_spans<T> s(c.begin(), c.end());
+    return simd::count(s.mFirst[0], s.mLast[0], value) + simd::count(s.mFirst[1], s.mLast[1], value);
+  }
+
+  /// find
+  ///
+  /// Equivalent to std::find(c.begin(), c.end(), value).
+  ///
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator find(vector<T, Alloc, Growth>& c,
+      const typename vector<T, Alloc, Growth>::value_type& value)
+  {
+    return c.begin() + (simd::find(c.begin(), c.end(), value) - c.begin());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator find(const vector<T, Alloc, Growth>& c,
+      const typename vector<T, Alloc, Growth>::value_type& value)
+  {
+    return simd::find(c.begin(), c.end(), value);
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator find(ring<T, Alloc, Growth>& c,
+      const typename ring<T, Alloc, Growth>::value_type& value)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).find(value);
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator find(const ring<T, Alloc, Growth>& c,
+      const typename ring<T, Alloc, Growth>::value_type& value)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).find(value);
+  }
+
+  /// for_each_prefetched
+  ///
+  /// Equivalent to std::for_each(first, last, f) over a range of a list or fixed_list, but prefetches the
+  /// node distance links ahead.  The lead node still has to be reached one link at a time, but those loads
+  /// overlap with f running on the nodes behind it instead of following each call.  This pays off when f does
+  /// enough work per element to fill the out-of-order window; a trivial f is bound by the links either way.
+  ///
+  template<class T, class Pointer, class Reference, class Function>
+  inline Function for_each_prefetched(list_iterator<T, Pointer, Reference> first,
+      list_iterator<T, Pointer, Reference> last, Function f, size_t distance = 4)
+  {
+    list_iterator<T, Pointer, Reference> lead = first;
+    for (size_t i = 0; (i < distance) && (lead != last); ++i)
+    {
+      ++lead;
+      FLEX_PREFETCH(lead.mNode);
+    }
+    for (; first != last; ++first)
+    {
+      if (lead != last)
+      {
+        ++lead;
+        FLEX_PREFETCH(lead.mNode);
+      }
+      f(*first);
+    }
+    return f;
+  }
+
+  template<class T, class Alloc, class Function>
+  inline Function for_each_prefetched(list<T, Alloc>& c, Function f, size_t distance = 4)
+  {
+    return for_each_prefetched(c.begin(), c.end(), f, distance);
+  }
+
+  template<class T, class Alloc, class Function>
+  inline Function for_each_prefetched(const list<T, Alloc>& c, Function f, size_t distance = 4)
+  {
+    return for_each_prefetched(c.begin(), c.end(), f, distance);
+  }
+
+  /// for_each_prefetched
+  ///
+  /// Equivalent to std::for_each(c.begin(), c.end(), f) over a hash_map, hash_set or their fixed variants.
+  /// The bucket array is read in order, so the chain head distance buckets ahead is prefetched from it; unlike
+  /// a list, those loads are independent and are all in flight at once.  Within a chain, the next node is
+  /// prefetched before f is called on the current one.
+  ///
+  template<typename Key, typename Value, typename Allocator, typename ExtractKey, typename Equal, typename H1,
+      typename H2, typename H, typename RehashPolicy, bool bCacheHashCode, bool bMutableIterators, bool bUniqueKeys,
+      class Function>
+  inline Function for_each_prefetched(
+      hashtable<Key, Value, Allocator, ExtractKey, Equal, H1, H2, H, RehashPolicy, bCacheHashCode, bMutableIterators,
+          bUniqueKeys>& c, Function f, size_t distance = 4)
+  {
+    typedef typename hashtable<Key, Value, Allocator, ExtractKey, Equal, H1, H2, H, RehashPolicy, bCacheHashCode,
+        bMutableIterators, bUniqueKeys>::local_iterator local_iterator;
+    const size_t n = c.bucket_count();
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (i + distance < n)
+      {
+        FLEX_PREFETCH(c.begin(i + distance).mpNode);
+      }
+      for (local_iterator it = c.begin(i); it != c.end(i); ++it)
+      {
+        FLEX_PREFETCH(it.mpNode->mpNext);
+        f(*it);
+      }
+    }
+    return f;
+  }
+
+  template<typename Key, typename Value, typename Allocator, typename ExtractKey, typename Equal, typename H1,
+      typename H2, typename H, typename RehashPolicy, bool bCacheHashCode, bool bMutableIterators, bool bUniqueKeys,
+      class Function>
+  inline Function for_each_prefetched(
+      const hashtable<Key, Value, Allocator, ExtractKey, Equal, H1, H2, H, RehashPolicy, bCacheHashCode,
+          bMutableIterators, bUniqueKeys>& c, Function f, size_t distance = 4)
+  {
+    typedef typename hashtable<Key, Value, Allocator, ExtractKey, Equal, H1, H2, H, RehashPolicy, bCacheHashCode,
+        bMutableIterators, bUniqueKeys>::const_local_iterator const_local_iterator;
+    const size_t n = c.bucket_count();
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (i + distance < n)
+      {
+        FLEX_PREFETCH(c.begin(i + distance).mpNode);
+      }
+      for (const_local_iterator it = c.begin(i); it != c.end(i); ++it)
+      {
+        FLEX_PREFETCH(it.mpNode->mpNext);
+        f(*it);
+      }
+    }
+    return f;
+  }
+
+  /// max_element
+  ///
+  /// Equivalent to std::max_element(c.begin(), c.end()).
+  ///
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator max_element(vector<T, Alloc, Growth>& c)
+  {
+    return c.begin() + (simd::max_element(c.begin(), c.end()) - c.begin());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator max_element(const vector<T, Alloc, Growth>& c)
+  {
+    return simd::max_element(c.begin(), c.end());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator max_element(ring<T, Alloc, Growth>& c)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).template extreme_element<false>();
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator max_element(const ring<T, Alloc, Growth>& c)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).template extreme_element<false>();
+  }
+
+  /// min_element
+  ///
+  /// Equivalent to std::min_element(c.begin(), c.end()).
+  ///
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator min_element(vector<T, Alloc, Growth>& c)
+  {
+    return c.begin() + (simd::min_element(c.begin(), c.end()) - c.begin());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator min_element(const vector<T, Alloc, Growth>& c)
+  {
+    return simd::min_element(c.begin(), c.end());
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator min_element(ring<T, Alloc, Growth>& c)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).template extreme_element<true>();
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator min_element(const ring<T, Alloc, Growth>& c)
+  {
+    return c.begin() + ring_spans<T>(c.begin(), c.end()).template extreme_element<true>();
+  }
+
+} //namespace flex
+
+#endif /* FLEX_ALGORITHM_H */
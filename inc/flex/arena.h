@@ -0,0 +1,441 @@
+#ifndef FLEX_ARENA_H
+#define FLEX_ARENA_H
+
+#include <limits>//For std::numeric_limits used in max_size()
+#include <memory>//For std::allocator<void> used in allocate()
+
+#include <flex/allocation_guard.h>
+
+//Every arena allocation is aligned to this boundary.  It must be a power of two and at least the alignment
+//of the types that are placed in the arena.  Byte allocators (such as the one used by hash_map) rely on
+//it being large enough to hold any node type.
+#ifndef FLEX_ARENA_ALIGNMENT
+#define FLEX_ARENA_ALIGNMENT 16
+#endif
+
+//The default size of a heap block that is chained to the arena once its current block has been used up.
+#ifndef FLEX_ARENA_BLOCK_SIZE
+#define FLEX_ARENA_BLOCK_SIZE 4096
+#endif
+
+namespace flex
+{
+
+  //An arena is a monotonic (bump-pointer) allocator.  Memory is handed out by advancing a pointer through
+  //the current block, and individual deallocations are ignored.  Everything is released at once with
+  //reset(), which makes the arena a good fit for per-message or per-request scratch memory.  Heap blocks
+  //are chained once the current block is exhausted.  These blocks are retained by reset(), so an arena
+  //that is reused for every request stops touching the heap once it has warmed up.  The arena_block
+  //struct is the header that is stored at the front of each chained block.
+  struct arena_block
+  {
+    arena_block* mNext;
+    size_t mSize;
+  };
+
+  class arena: public guarded_object
+  {
+  public:
+    typedef size_t size_type;
+
+    arena();
+    explicit arena(size_type block_size);
+    ~arena();
+
+    void* allocate(size_type n, size_type alignment = FLEX_ARENA_ALIGNMENT);
+    size_type block_size() const;
+    size_type capacity() const;
+    bool fixed() const;
+    void reset();
+    void shrink_to_fit();
+    size_type size() const;
+
+    static arena* current();
+
+  protected:
+    arena_block* mHead;
+    arena_block* mCurrent;
+    char* mPtr;
+    char* mEnd;
+    char* mFixedBegin;
+    char* mFixedEnd;
+    size_type mBlockSize;
+    size_type mSize;
+    bool mFixed;
+    bool mOverflow;
+
+    arena(char* first, char* last);
+
+    void* AllocateSlow(size_type n, size_type alignment);
+    static char* GetBlockData(arena_block* block);
+    static arena*& GetCurrent();
+
+    friend class arena_scope;
+
+  private:
+    arena(const arena&);
+    arena& operator=(const arena&);
+  };
+
+  inline arena::arena() :
+      mHead(NULL), mCurrent(NULL), mPtr(NULL), mEnd(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mBlockSize(
+          FLEX_ARENA_BLOCK_SIZE), mSize(0), mFixed(false), mOverflow(false)
+  {
+  }
+
+  inline arena::arena(size_type block_size) :
+      mHead(NULL), mCurrent(NULL), mPtr(NULL), mEnd(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mBlockSize(block_size), mSize(
+          0), mFixed(false), mOverflow(false)
+  {
+  }
+
+  inline arena::~arena()
+  {
+    while (mHead)
+    {
+      arena_block* next = mHead->mNext;
+      ::operator delete((void*) mHead);
+      mHead = next;
+    }
+
+    //Do not leave a dangling pointer behind if the arena is destroyed while still in scope.
+    if (GetCurrent() == this)
+    {
+      GetCurrent() = NULL;
+    }
+  }
+
+  inline void* arena::allocate(size_type n, size_type alignment)
+  {
+    //Round the bump pointer up to the requested alignment.  The common case is a single add and mask.
+    char* ptr = (char*) (((size_t) mPtr + (alignment - 1)) & ~(alignment - 1));
+    if (FLEX_LIKELY((ptr <= mEnd) && ((size_type )(mEnd - ptr) >= n)))
+    {
+      mSize += (ptr + n) - mPtr;
+      mPtr = ptr + n;
+      return ptr;
+    }
+    else
+    {
+      return AllocateSlow(n, alignment);
+    }
+  }
+
+  inline arena::size_type arena::block_size() const
+  {
+    return mBlockSize;
+  }
+
+  inline arena::size_type arena::capacity() const
+  {
+    size_type n = mFixedEnd - mFixedBegin;
+    for (arena_block* it = mHead; it; it = it->mNext)
+    {
+      n += it->mSize;
+    }
+    return n;
+  }
+
+  inline bool arena::fixed() const
+  {
+    return mFixed;
+  }
+
+  inline void arena::reset()
+  {
+    //Rewind to the front of the arena.  The fixed buffer is always used first, followed by each
+    //chained block in the order they were allocated.
+    if (mFixedBegin)
+    {
+      mCurrent = NULL;
+      mPtr = mFixedBegin;
+      mEnd = mFixedEnd;
+      mFixed = true;
+    }
+    else if (mHead)
+    {
+      mCurrent = mHead;
+      mPtr = GetBlockData(mHead);
+      mEnd = mPtr + mHead->mSize;
+    }
+    else
+    {
+      mCurrent = NULL;
+      mPtr = NULL;
+      mEnd = NULL;
+    }
+    mSize = 0;
+  }
+
+  inline void arena::shrink_to_fit()
+  {
+    //Release every chained block that sits past the block currently in use.  Calling this directly after
+    //reset() returns a fixed_arena to its fixed buffer and leaves an arena with a single block.
+    arena_block** link = mCurrent ? &mCurrent->mNext : &mHead;
+    while (*link)
+    {
+      arena_block* next = (*link)->mNext;
+      ::operator delete((void*) *link);
+      *link = next;
+    }
+  }
+
+  inline arena::size_type arena::size() const
+  {
+    return mSize;
+  }
+
+  inline arena* arena::current()
+  {
+    return GetCurrent();
+  }
+
+  inline arena::arena(char* first, char* last) :
+      mHead(NULL), mCurrent(NULL), mPtr(first), mEnd(last), mFixedBegin(first), mFixedEnd(last), mBlockSize(
+          FLEX_ARENA_BLOCK_SIZE), mSize(0), mFixed(true), mOverflow(false)
+  {
+  }
+
+  inline void* arena::AllocateSlow(size_type n, size_type alignment)
+  {
+    //The current block cannot satisfy the request.  Move on to the next retained block if it is large
+    //enough, otherwise chain a new block in front of it so the retained block is not lost.
+    arena_block* next = mCurrent ? mCurrent->mNext : mHead;
+
+    size_type required = n + alignment;
+    if ((next == NULL) || (next->mSize < required))
+    {
+#ifndef FLEX_RELEASE
+      if (FLEX_UNLIKELY(mFixed))
+      {
+        if (!mOverflow)
+        {
+          mOverflow = true;
+          flex::error_msg("flex::fixed_arena - exceeded capacity");
+        }
+      }
+#endif
+      FLEX_ERROR_MSG_IF(sAllocationGuardEnabled, "flex::arena: allocated new block when guard was enabled");
+
+      size_type block_size = (required > mBlockSize) ? required : mBlockSize;
+      arena_block* block = (arena_block*) ::operator new(sizeof(arena_block) + block_size);
+      block->mSize = block_size;
+      block->mNext = next;
+      if (mCurrent)
+      {
+        mCurrent->mNext = block;
+      }
+      else
+      {
+        mHead = block;
+      }
+      next = block;
+    }
+
+    mFixed = false;
+    mSize += mEnd - mPtr;
+    mCurrent = next;
+    mPtr = GetBlockData(next);
+    mEnd = mPtr + next->mSize;
+    return allocate(n, alignment);
+  }
+
+  inline char* arena::GetBlockData(arena_block* block)
+  {
+    return ((char*) block) + sizeof(arena_block);
+  }
+
+  inline arena*& arena::GetCurrent()
+  {
+    //A function-local static is used so the header can be included in multiple translation units.  Each
+    //thread has its own, so scopes opened on different threads do not see or restore each other's arenas.
+    static FLEX_THREAD_LOCAL arena* sCurrent = NULL;
+    return sCurrent;
+  }
+
+  template<size_t N> class fixed_arena: public arena
+  {
+  public:
+    typedef arena base_type;
+    typedef base_type::size_type size_type;
+
+    fixed_arena();
+
+  private:
+    union
+    {
+      char mBuffer[N];
+      long double dummy;
+    };
+  };
+
+  template<size_t N>
+  inline fixed_arena<N>::fixed_arena() :
+      arena(mBuffer, mBuffer + N)
+  {
+  }
+
+  //Containers always default construct their allocator, so an arena_allocator needs to find its arena
+  //without being passed one.  An arena_scope makes an arena the current arena of the calling thread for its
+  //lifetime.  Any arena_allocator that is default constructed on that thread while the scope is active
+  //(including the allocators of containers created inside the scope) will allocate from that arena.  Scopes
+  //may be nested, and each thread has its own.
+  class arena_scope
+  {
+  public:
+    explicit arena_scope(arena& a);
+    ~arena_scope();
+
+  private:
+    arena* mPrevious;
+
+    arena_scope(const arena_scope&);
+    arena_scope& operator=(const arena_scope&);
+  };
+
+  inline arena_scope::arena_scope(arena& a) :
+      mPrevious(arena::GetCurrent())
+  {
+    arena::GetCurrent() = &a;
+  }
+
+  inline arena_scope::~arena_scope()
+  {
+    arena::GetCurrent() = mPrevious;
+  }
+
+  //An allocator that hands out memory from an arena.  deallocate() is a no-op, as the memory is reclaimed
+  //when the arena is reset.  An arena_allocator that is constructed with no current arena falls back to the
+  //heap and behaves like flex::allocator.
+  template<class T> class arena_allocator: public guarded_object
+  {
+  public:
+    // type definitions
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // rebind allocator to type U
+    template<class U>
+    struct rebind
+    {
+      typedef arena_allocator<U> other;
+    };
+
+    // return address of values
+    pointer address(reference value) const
+    {
+      return &value;
+    }
+    const_pointer address(const_reference value) const
+    {
+      return &value;
+    }
+
+    inline arena_allocator() :
+        mArena(arena::current())
+    {
+    }
+
+    inline explicit arena_allocator(arena& a) :
+        mArena(&a)
+    {
+    }
+
+    inline arena_allocator(const arena_allocator& obj) :
+        mArena(obj.get_arena())
+    {
+    }
+
+    template<class U>
+    inline arena_allocator(const arena_allocator<U>& obj) :
+        mArena(obj.get_arena())
+    {
+    }
+
+    inline ~arena_allocator()
+    {
+    }
+
+    // return the arena this allocator draws from, or NULL when it uses the heap
+    inline arena* get_arena() const
+    {
+      return mArena;
+    }
+
+    // return maximum number of elements that can be allocated
+    inline size_type max_size() const
+    {
+      return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    // allocate but don't initialize num elements of type T
+    inline pointer allocate(size_type num, typename std::allocator<void>::const_pointer = 0)
+    {
+      if (mArena)
+      {
+        return reinterpret_cast<pointer>(mArena->allocate(num * sizeof(T)));
+      }
+      else
+      {
+        FLEX_ERROR_MSG_IF(sAllocationGuardEnabled, "flex::arena_allocator: performed allocation when guard was enabled");
+        return reinterpret_cast<pointer>(::operator new(num * sizeof(T)));
+      }
+    }
+
+#ifdef FLEX_HAS_CXX11
+    template<class...Args>
+    inline void construct(pointer p, Args&&... args)
+    {
+      // initialize memory with placement new
+      new ((void*) p) T(std::forward<Args>(args)...);
+    }
+#else
+    // initialize elements of allocated storage p with value value
+    inline void construct(pointer p, const T& value)
+    {
+      // initialize memory with placement new
+      new ((void*) p) T(value);
+    }
+#endif
+
+    // destroy elements of initialized storage p
+    inline void destroy(pointer p)
+    {
+      // destroy objects by calling their destructor
+      p->~T();
+    }
+
+    // memory owned by an arena is reclaimed by arena::reset()
+    inline void deallocate(pointer p, size_type /*num*/)
+    {
+      if (!mArena)
+      {
+        ::operator delete((void*) p);
+      }
+    }
+
+  private:
+    arena* mArena;
+  };
+
+  // allocators are interchangeable when they draw from the same arena
+  template<class T1, class T2>
+  bool operator==(const arena_allocator<T1>& lhs, const arena_allocator<T2>& rhs)
+  {
+    return lhs.get_arena() == rhs.get_arena();
+  }
+
+  template<class T1, class T2>
+  bool operator!=(const arena_allocator<T1>& lhs, const arena_allocator<T2>& rhs)
+  {
+    return lhs.get_arena() != rhs.get_arena();
+  }
+
+} //namespace flex
+
+#endif /* FLEX_ARENA_H */
@@ -0,0 +1,1244 @@
+#ifndef FLEX_BTREE_MAP_H
+#define FLEX_BTREE_MAP_H
+
+#include <flex/pool.h>
+#include <flex/initializer_list.h>
+#include <flex/internal/algorithm.h>
+#include <flex/internal/btree_map_iterator.h>
+#include <flex/internal/relocate.h>
+#include <flex/internal/simd.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+/*
+ * FLEX_BTREE_NODE_SIZE
+ *
+ * The number of bytes a btree_map fits each node's keys and values into.  The node counts follow from it.
+ */
+#ifndef FLEX_BTREE_NODE_SIZE
+#define FLEX_BTREE_NODE_SIZE (4 * FLEX_CACHE_LINE_SIZE)
+#endif
+
+namespace flex
+{
+
+  //The storage a btree_map pool hands out for one node, rounded up to a whole number of cache lines.
+  template<class Node> struct btree_block
+  {
+    char mData[(sizeof(Node) + FLEX_CACHE_LINE_SIZE - 1) / FLEX_CACHE_LINE_SIZE * FLEX_CACHE_LINE_SIZE];
+  };
+
+  //A pool of btree_map nodes of one kind.  Like skip_map_pool, it may be built over a buffer, after which it
+  //is fixed and only reaches the allocator on overflow.
+  template<class Block, class Alloc>
+  struct btree_pool: public pool<Block, typename Alloc::template rebind<typename pool<Block>::node_type>::other>
+  {
+    typedef pool<Block, typename Alloc::template rebind<typename pool<Block>::node_type>::other> base_type;
+    typedef typename base_type::node_type node_type;
+
+    btree_pool();
+    btree_pool(node_type* first, node_type* last);
+
+    bool fixed() const;
+    void ReleaseOverflow(const void* first, const void* last);
+  };
+
+  template<class Block, class Alloc>
+  inline btree_pool<Block, Alloc>::btree_pool() :
+      base_type()
+  {
+  }
+
+  template<class Block, class Alloc>
+  inline btree_pool<Block, Alloc>::btree_pool(node_type* first, node_type* last) :
+      base_type(first, last)
+  {
+  }
+
+  template<class Block, class Alloc>
+  inline bool btree_pool<Block, Alloc>::fixed() const
+  {
+    return this->mFixed;
+  }
+
+  template<class Block, class Alloc>
+  inline void btree_pool<Block, Alloc>::ReleaseOverflow(const void* first, const void* last)
+  {
+    //Matches ~fixed_pool().  Nodes outside [first, last) were allocated after the buffer ran out.
+#ifndef FLEX_RELEASE
+    if (FLEX_UNLIKELY(this->mOverflow))
+    {
+      while (this->mHead)
+      {
+        node_type* ptr = (node_type*) this->allocate();
+        if (((const char*) ptr < (const char*) first) || ((const char*) ptr >= (const char*) last))
+        {
+          this->mAllocator.deallocate(ptr, 1);
+        }
+      }
+    }
+#endif
+  }
+
+  //Finds the first of n sorted keys that is not less than key.
+  template<class Key, class Compare> struct btree_search
+  {
+    static size_t lower_bound(const Key* keys, size_t n, const Key& key, const Compare& comp)
+    {
+      return branchless_lower_bound(keys, keys + n, key, comp) - keys;
+    }
+  };
+
+  //With the default comparator, keys that have a SIMD lane type are compared a register at a time.
+  template<class Key> struct btree_search<Key, std::less<Key> >
+  {
+    static size_t lower_bound(const Key* keys, size_t n, const Key& key, const std::less<Key>& comp)
+    {
+      if (simd::lane_of<Key>::value != simd::lane_none)
+      {
+        return simd::lower_bound(keys, keys + n, key) - keys;
+      }
+      return branchless_lower_bound(keys, keys + n, key, comp) - keys;
+    }
+  };
+
+  //A btree_map is an ordered map kept as a B+tree.  Each node is sized to FLEX_BTREE_NODE_SIZE bytes, so a
+  //lookup touches a few cache lines per level over a tree that is only a few levels deep, instead of one cache
+  //line per level of a binary tree.  Elements live only in the leaves, which keep their keys and their mapped
+  //values in separate arrays and are linked in key order, so a range scan walks contiguous arrays.  Within a
+  //node, int, long, long long, float and double keys are searched with SIMD compares when the comparator is
+  //std::less; other keys use branchless_lower_bound.
+  //
+  //Nodes come from two pools, one for leaves and one for internal nodes, so elements are never allocated one
+  //at a time.  Every node but the root is kept at least half full, which bounds the nodes needed for n
+  //elements; fixed_btree_map relies on this to size its buffer.
+  //
+  //As with flat_map, the iterator dereferences to a pair of references, and iterators and references are
+  //invalidated by every insertion and erasure.
+  template<class Key, class T, class Compare = std::less<Key>, class Alloc = allocator<char> >
+  class btree_map: public guarded_object
+  {
+  public:
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    //The elements a leaf holds and the keys an internal node holds, at least four of each.
+    static const size_type LEAF_CAPACITY =
+        ((FLEX_BTREE_NODE_SIZE - sizeof(btree_node_base) - 2 * sizeof(void*)) / (sizeof(Key) + sizeof(T)) < 4) ?
+            4 : (FLEX_BTREE_NODE_SIZE - sizeof(btree_node_base) - 2 * sizeof(void*)) / (sizeof(Key) + sizeof(T));
+    static const size_type INTERNAL_CAPACITY =
+        ((FLEX_BTREE_NODE_SIZE - sizeof(btree_node_base) - sizeof(void*)) / (sizeof(Key) + sizeof(void*)) < 4) ?
+            4 : (FLEX_BTREE_NODE_SIZE - sizeof(btree_node_base) - sizeof(void*)) / (sizeof(Key) + sizeof(void*));
+
+    //Every leaf but the root holds at least LEAF_MIN elements, and every internal node but the root at least
+    //INTERNAL_MIN keys.
+    static const size_type LEAF_MIN = LEAF_CAPACITY / 2;
+    static const size_type INTERNAL_MIN = INTERNAL_CAPACITY / 2;
+
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef btree_leaf<Key, T, LEAF_CAPACITY> leaf_type;
+    typedef btree_internal<Key, INTERNAL_CAPACITY> internal_type;
+    typedef btree_map_iterator<Key, T, LEAF_CAPACITY> iterator;
+    typedef btree_map_iterator<Key, T, LEAF_CAPACITY, const T*, const T&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+
+    //Orders value_type objects by their keys.
+    struct value_compare
+    {
+      Compare mCompare;
+
+      value_compare(const Compare& comp) :
+          mCompare(comp)
+      {
+      }
+
+      bool operator()(const value_type& a, const value_type& b) const
+      {
+        return mCompare(a.first, b.first);
+      }
+    };
+
+    btree_map();
+    explicit btree_map(const Compare& comp);
+    template<typename InputIterator> btree_map(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    btree_map(const btree_map<Key, T, Compare, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    btree_map(btree_map<Key, T, Compare, Alloc>&& obj);
+#endif
+    btree_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+    ~btree_map();
+
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    void clear();
+    size_type count(const Key& key) const;
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    std::pair<iterator, iterator> equal_range(const Key& key);
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const Key& key);
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    bool fixed() const;
+    std::pair<iterator, bool> insert(const value_type& val);
+    template<typename InputIterator> void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> il);
+    key_compare key_comp() const;
+    iterator lower_bound(const Key& key);
+    const_iterator lower_bound(const Key& key) const;
+    size_type max_size() const;
+    btree_map<Key, T, Compare, Alloc>& operator=(const btree_map<Key, T, Compare, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    btree_map<Key, T, Compare, Alloc>& operator=(btree_map<Key, T, Compare, Alloc>&& obj);
+#endif
+    btree_map<Key, T, Compare, Alloc>& operator=(std::initializer_list<value_type> il);
+    T& operator[](const Key& key);
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    size_type size() const;
+    void swap(btree_map<Key, T, Compare, Alloc>& obj);
+    iterator upper_bound(const Key& key);
+    const_iterator upper_bound(const Key& key) const;
+    value_compare value_comp() const;
+
+  protected:
+    typedef btree_pool<btree_block<leaf_type>, Alloc> leaf_pool_type;
+    typedef btree_pool<btree_block<internal_type>, Alloc> internal_pool_type;
+
+    btree_map(typename leaf_pool_type::node_type* leaf_first, typename leaf_pool_type::node_type* leaf_last,
+        typename internal_pool_type::node_type* internal_first, typename internal_pool_type::node_type* internal_last,
+        const Compare& comp);
+
+    template<class U> static void EraseAt(U* array, size_type n, size_type position);
+    template<class U> static void InsertAt(U* array, size_type n, size_type position, const U& val);
+    static void LinkChild(internal_type* node, size_type position, btree_node_base* child);
+    static const Key& MaxKey(const btree_node_base* node);
+
+    void DestroySubtree(btree_node_base* node);
+    void EraseAt(leaf_type* leaf, size_type position);
+    leaf_type* FindLeaf(const Key& key) const;
+    void FreeInternal(internal_type* node);
+    void FreeLeaf(leaf_type* leaf);
+    void InsertInParent(btree_node_base* left, const Key& key, btree_node_base* right);
+    iterator InsertUnique(const Key& key, const T& value, bool& inserted);
+    const_iterator LowerBound(const Key& key) const;
+    iterator MakeIterator(const leaf_type* leaf, size_type position) const;
+    internal_type* NewInternal();
+    leaf_type* NewLeaf();
+    void RebalanceInternal(internal_type* node);
+    void RebalanceLeaf(leaf_type* leaf);
+    void RebuildSeparators(btree_node_base* node);
+    void RemoveChild(internal_type* parent, size_type position);
+    size_type Search(const Key* keys, size_type n, const Key& key) const;
+
+    btree_node_base* mRoot;
+    leaf_type* mFirst;
+    leaf_type* mLast;
+    size_type mSize;
+    Compare mCompare;
+    leaf_pool_type mLeafPool;
+    internal_pool_type mInternalPool;
+  };
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::LEAF_CAPACITY;
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::INTERNAL_CAPACITY;
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::LEAF_MIN;
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::INTERNAL_MIN;
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map() :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare()
+  {
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(const Compare& comp) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(comp)
+  {
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(InputIterator first, InputIterator last, const Compare& comp) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(comp)
+  {
+    insert(first, last);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(const btree_map<Key, T, Compare, Alloc>& obj) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(obj.mCompare)
+  {
+    insert(obj.begin(), obj.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(btree_map<Key, T, Compare, Alloc>&& obj) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(obj.mCompare)
+  {
+    if (obj.fixed())
+    {
+      insert(obj.begin(), obj.end());
+      obj.clear();
+    }
+    else
+    {
+      swap(obj);
+    }
+  }
+#endif
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(std::initializer_list<value_type> il, const Compare& comp) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(comp)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::~btree_map()
+  {
+    clear();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline T& btree_map<Key, T, Compare, Alloc>::at(const Key& key)
+  {
+    const_iterator it = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((it == end()) || mCompare(key, it->first), "flex::btree_map.at() - key not found");
+    return it.mLeaf->mValues.data()[it.mIndex];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline const T& btree_map<Key, T, Compare, Alloc>::at(const Key& key) const
+  {
+    const_iterator it = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((it == end()) || mCompare(key, it->first), "flex::btree_map.at() - key not found");
+    return it.mLeaf->mValues.data()[it.mIndex];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::begin()
+  {
+    return iterator(mFirst, 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::begin() const
+  {
+    return const_iterator(mFirst, 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::cbegin() const
+  {
+    return const_iterator(mFirst, 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::cend() const
+  {
+    return end();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_reverse_iterator btree_map<Key, T, Compare, Alloc>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_reverse_iterator btree_map<Key, T, Compare, Alloc>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::clear()
+  {
+    if (mRoot)
+    {
+      DestroySubtree(mRoot);
+    }
+    mRoot = NULL;
+    mFirst = mLast = NULL;
+    mSize = 0;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::count(
+      const Key& key) const
+  {
+    return (find(key) != end()) ? 1 : 0;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool btree_map<Key, T, Compare, Alloc>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::end()
+  {
+    return iterator(mLast, mLast ? mLast->mCount : 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::end() const
+  {
+    return const_iterator(mLast, mLast ? mLast->mCount : 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename btree_map<Key, T, Compare, Alloc>::iterator,
+      typename btree_map<Key, T, Compare, Alloc>::iterator> btree_map<Key, T, Compare, Alloc>::equal_range(
+      const Key& key)
+  {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename btree_map<Key, T, Compare, Alloc>::const_iterator,
+      typename btree_map<Key, T, Compare, Alloc>::const_iterator> btree_map<Key, T, Compare, Alloc>::equal_range(
+      const Key& key) const
+  {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::erase(
+      const_iterator position)
+  {
+    leaf_type* const leaf = position.mLeaf;
+    const size_type i = position.mIndex;
+    if ((leaf == mRoot) || (leaf->mCount > LEAF_MIN))
+    {
+      //The leaf doesn't underflow, so nothing moves but the elements after position.  A root leaf is freed
+      //once its last element is erased.
+      EraseAt(leaf, i);
+      return mRoot ? MakeIterator(leaf, i) : end();
+    }
+
+    //Rebalancing may move the next element to another leaf, so it is found again by its key.
+    const_iterator next = position;
+    ++next;
+    if (next == end())
+    {
+      EraseAt(leaf, i);
+      return end();
+    }
+    const Key key(next->first);
+    EraseAt(leaf, i);
+    return lower_bound(key);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::erase(
+      const_iterator first, const_iterator last)
+  {
+    //Each erase may rebalance leaves and invalidate last, so the range is erased by count.
+    iterator it(first.mLeaf, first.mIndex);
+    for (size_type n = std::distance(first, last); n > 0; --n)
+    {
+      it = erase(it);
+    }
+    return it;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::erase(
+      const Key& key)
+  {
+    const_iterator it = find(key);
+    if (it == end())
+    {
+      return 0;
+    }
+    EraseAt(it.mLeaf, it.mIndex);
+    return 1;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::find(const Key& key)
+  {
+    const_iterator it = LowerBound(key);
+    return ((it == end()) || mCompare(key, it->first)) ? end() : iterator(it.mLeaf, it.mIndex);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::find(
+      const Key& key) const
+  {
+    const_iterator it = LowerBound(key);
+    return ((it == end()) || mCompare(key, it->first)) ? end() : it;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool btree_map<Key, T, Compare, Alloc>::fixed() const
+  {
+    return mLeafPool.fixed();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename btree_map<Key, T, Compare, Alloc>::iterator, bool> btree_map<Key, T, Compare, Alloc>::insert(
+      const value_type& val)
+  {
+    bool inserted;
+    iterator it = InsertUnique(val.first, val.second, inserted);
+    return std::make_pair(it, inserted);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline void btree_map<Key, T, Compare, Alloc>::insert(InputIterator first, InputIterator last)
+  {
+    bool inserted;
+    for (; first != last; ++first)
+    {
+      InsertUnique((*first).first, (*first).second, inserted);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::key_compare btree_map<Key, T, Compare, Alloc>::key_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::lower_bound(
+      const Key& key)
+  {
+    const_iterator it = LowerBound(key);
+    return iterator(it.mLeaf, it.mIndex);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::lower_bound(
+      const Key& key) const
+  {
+    return LowerBound(key);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::max_size() const
+  {
+    return size_type(-1) / sizeof(value_type);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>& btree_map<Key, T, Compare, Alloc>::operator=(
+      const btree_map<Key, T, Compare, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      mCompare = obj.mCompare;
+      insert(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>& btree_map<Key, T, Compare, Alloc>::operator=(
+      btree_map<Key, T, Compare, Alloc>&& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      swap(obj);
+    }
+    return *this;
+  }
+#endif
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>& btree_map<Key, T, Compare, Alloc>::operator=(
+      std::initializer_list<value_type> il)
+  {
+    clear();
+    insert(il.begin(), il.end());
+    return *this;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline T& btree_map<Key, T, Compare, Alloc>::operator[](const Key& key)
+  {
+    bool inserted;
+    iterator it = InsertUnique(key, T(), inserted);
+    return it.mLeaf->mValues.data()[it.mIndex];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::reverse_iterator btree_map<Key, T, Compare, Alloc>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_reverse_iterator btree_map<Key, T, Compare, Alloc>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::reverse_iterator btree_map<Key, T, Compare, Alloc>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_reverse_iterator btree_map<Key, T, Compare, Alloc>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::swap(btree_map<Key, T, Compare, Alloc>& obj)
+  {
+    if (this == &obj)
+    {
+      return;
+    }
+
+    if (!fixed() && !obj.fixed())
+    {
+      std::swap(mRoot, obj.mRoot);
+      std::swap(mFirst, obj.mFirst);
+      std::swap(mLast, obj.mLast);
+      std::swap(mSize, obj.mSize);
+      std::swap(mCompare, obj.mCompare);
+      return;
+    }
+
+    //Nodes can't leave a fixed buffer.  Instead the elements are exchanged in order, which leaves each tree's
+    //leaves sorted but its separators stale, so they are rebuilt.  The longer map then hands its remaining
+    //elements over one at a time.
+    iterator lhs = begin();
+    iterator rhs = obj.begin();
+    for (; (lhs != end()) && (rhs != obj.end()); ++lhs, ++rhs)
+    {
+      std::swap(lhs.mLeaf->mKeys.data()[lhs.mIndex], rhs.mLeaf->mKeys.data()[rhs.mIndex]);
+      std::swap(lhs.mLeaf->mValues.data()[lhs.mIndex], rhs.mLeaf->mValues.data()[rhs.mIndex]);
+    }
+    if (mRoot)
+    {
+      RebuildSeparators(mRoot);
+    }
+    if (obj.mRoot)
+    {
+      obj.RebuildSeparators(obj.mRoot);
+    }
+
+    btree_map& longer = (mSize > obj.mSize) ? *this : obj;
+    btree_map& shorter = (mSize > obj.mSize) ? obj : *this;
+    for (size_type n = longer.mSize - shorter.mSize; n > 0; --n)
+    {
+      iterator last = longer.end();
+      --last;
+      bool inserted;
+      shorter.InsertUnique(last.mLeaf->mKeys.data()[last.mIndex], last.mLeaf->mValues.data()[last.mIndex], inserted);
+      longer.EraseAt(last.mLeaf, last.mIndex);
+    }
+    std::swap(mCompare, obj.mCompare);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::upper_bound(
+      const Key& key)
+  {
+    const_iterator it = static_cast<const btree_map*>(this)->upper_bound(key);
+    return iterator(it.mLeaf, it.mIndex);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::upper_bound(
+      const Key& key) const
+  {
+    const_iterator it = LowerBound(key);
+    if ((it != end()) && !mCompare(key, it->first))
+    {
+      ++it;
+    }
+    return it;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::value_compare btree_map<Key, T, Compare, Alloc>::value_comp() const
+  {
+    return value_compare(mCompare);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline btree_map<Key, T, Compare, Alloc>::btree_map(typename leaf_pool_type::node_type* leaf_first,
+      typename leaf_pool_type::node_type* leaf_last, typename internal_pool_type::node_type* internal_first,
+      typename internal_pool_type::node_type* internal_last, const Compare& comp) :
+      mRoot(NULL), mFirst(NULL), mLast(NULL), mSize(0), mCompare(comp), mLeafPool(leaf_first, leaf_last),
+      mInternalPool(internal_first, internal_last)
+  {
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<class U>
+  inline void btree_map<Key, T, Compare, Alloc>::EraseAt(U* array, size_type n, size_type position)
+  {
+    //Closes the gap at position in an array of n constructed objects.
+    for (size_type i = position + 1; i < n; ++i)
+    {
+      array[i - 1] = FLEX_MOVE(array[i]);
+    }
+    array[n - 1].~U();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<class U>
+  inline void btree_map<Key, T, Compare, Alloc>::InsertAt(U* array, size_type n, size_type position, const U& val)
+  {
+    //Inserts val at position in an array of n constructed objects, which has room for one more.
+    if (position == n)
+    {
+      new ((void*) (array + n)) U(val);
+      return;
+    }
+    new ((void*) (array + n)) U(FLEX_MOVE(array[n - 1]));
+    for (size_type i = n - 1; i > position; --i)
+    {
+      array[i] = FLEX_MOVE(array[i - 1]);
+    }
+    array[position] = val;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::LinkChild(internal_type* node, size_type position,
+      btree_node_base* child)
+  {
+    node->mChildren[position] = child;
+    child->mParent = node;
+    child->mPosition = (unsigned short) position;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline const Key& btree_map<Key, T, Compare, Alloc>::MaxKey(const btree_node_base* node)
+  {
+    while (!node->mLeaf)
+    {
+      node = ((const internal_type*) node)->mChildren[node->mCount];
+    }
+    return ((const leaf_type*) node)->mKeys.data()[node->mCount - 1];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::DestroySubtree(btree_node_base* node)
+  {
+    if (node->mLeaf)
+    {
+      leaf_type* const leaf = (leaf_type*) node;
+      flex::destruct_range(leaf->mKeys.data(), leaf->mKeys.data() + leaf->mCount);
+      flex::destruct_range(leaf->mValues.data(), leaf->mValues.data() + leaf->mCount);
+      leaf->mCount = 0;
+      FreeLeaf(leaf);
+    }
+    else
+    {
+      internal_type* const internal = (internal_type*) node;
+      for (size_type i = 0; i <= internal->mCount; ++i)
+      {
+        DestroySubtree(internal->mChildren[i]);
+      }
+      flex::destruct_range(internal->mKeys.data(), internal->mKeys.data() + internal->mCount);
+      FreeInternal(internal);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::EraseAt(leaf_type* leaf, size_type position)
+  {
+    EraseAt(leaf->mKeys.data(), leaf->mCount, position);
+    EraseAt(leaf->mValues.data(), leaf->mCount, position);
+    --leaf->mCount;
+    --mSize;
+
+    if (leaf == mRoot)
+    {
+      if (leaf->mCount == 0)
+      {
+        FreeLeaf(leaf);
+        mRoot = NULL;
+        mFirst = mLast = NULL;
+      }
+    }
+    else if (leaf->mCount < LEAF_MIN)
+    {
+      RebalanceLeaf(leaf);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::leaf_type* btree_map<Key, T, Compare, Alloc>::FindLeaf(
+      const Key& key) const
+  {
+    btree_node_base* node = mRoot;
+    while (!node->mLeaf)
+    {
+      const internal_type* const internal = (const internal_type*) node;
+      node = internal->mChildren[Search(internal->mKeys.data(), internal->mCount, key)];
+      FLEX_PREFETCH(node);
+    }
+    return (leaf_type*) node;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::FreeInternal(internal_type* node)
+  {
+    mInternalPool.deallocate(node);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::FreeLeaf(leaf_type* leaf)
+  {
+    mLeafPool.deallocate(leaf);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::InsertInParent(btree_node_base* left, const Key& key,
+      btree_node_base* right)
+  {
+    //Adds right after left in their parent, separated by key, splitting the parent if it is full.
+    internal_type* node = (internal_type*) left->mParent;
+    if (!node)
+    {
+      node = NewInternal();
+      new ((void*) node->mKeys.data()) Key(key);
+      node->mCount = 1;
+      LinkChild(node, 0, left);
+      LinkChild(node, 1, right);
+      mRoot = node;
+      return;
+    }
+
+    const size_type position = left->mPosition;
+    Key* const keys = node->mKeys.data();
+    if (node->mCount == INTERNAL_CAPACITY)
+    {
+      //Of the INTERNAL_CAPACITY + 1 keys, counting the new one, the one at index h moves up and the rest are
+      //split evenly.  Which one that is depends on where the new key falls.
+      const size_type h = (INTERNAL_CAPACITY + 1) / 2;
+      internal_type* const sibling = NewInternal();
+      Key* const sibling_keys = sibling->mKeys.data();
+      if (position < h)
+      {
+        const Key up(keys[h - 1]);
+        uninitialized_relocate(keys + h, keys + INTERNAL_CAPACITY, sibling_keys);
+        for (size_type i = h; i <= INTERNAL_CAPACITY; ++i)
+        {
+          LinkChild(sibling, i - h, node->mChildren[i]);
+        }
+        sibling->mCount = (unsigned short) (INTERNAL_CAPACITY - h);
+        keys[h - 1].~Key();
+        node->mCount = (unsigned short) (h - 1);
+        InsertAt(keys, node->mCount, position, key);
+        for (size_type i = node->mCount + 1; i > position + 1; --i)
+        {
+          LinkChild(node, i, node->mChildren[i - 1]);
+        }
+        LinkChild(node, position + 1, right);
+        ++node->mCount;
+        InsertInParent(node, up, sibling);
+      }
+      else if (position == h)
+      {
+        uninitialized_relocate(keys + h, keys + INTERNAL_CAPACITY, sibling_keys);
+        LinkChild(sibling, 0, right);
+        for (size_type i = h + 1; i <= INTERNAL_CAPACITY; ++i)
+        {
+          LinkChild(sibling, i - h, node->mChildren[i]);
+        }
+        sibling->mCount = (unsigned short) (INTERNAL_CAPACITY - h);
+        node->mCount = (unsigned short) h;
+        InsertInParent(node, key, sibling);
+      }
+      else
+      {
+        const Key up(keys[h]);
+        uninitialized_relocate(keys + h + 1, keys + INTERNAL_CAPACITY, sibling_keys);
+        for (size_type i = h + 1; i <= INTERNAL_CAPACITY; ++i)
+        {
+          LinkChild(sibling, i - h - 1, node->mChildren[i]);
+        }
+        sibling->mCount = (unsigned short) (INTERNAL_CAPACITY - h - 1);
+        keys[h].~Key();
+        node->mCount = (unsigned short) h;
+        const size_type sibling_position = position - h - 1;
+        InsertAt(sibling_keys, sibling->mCount, sibling_position, key);
+        for (size_type i = sibling->mCount + 1; i > sibling_position + 1; --i)
+        {
+          LinkChild(sibling, i, sibling->mChildren[i - 1]);
+        }
+        LinkChild(sibling, sibling_position + 1, right);
+        ++sibling->mCount;
+        InsertInParent(node, up, sibling);
+      }
+      return;
+    }
+
+    InsertAt(keys, node->mCount, position, key);
+    for (size_type i = node->mCount + 1; i > position + 1; --i)
+    {
+      LinkChild(node, i, node->mChildren[i - 1]);
+    }
+    LinkChild(node, position + 1, right);
+    ++node->mCount;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::InsertUnique(
+      const Key& key, const T& value, bool& inserted)
+  {
+    if (!mRoot)
+    {
+      mRoot = mFirst = mLast = NewLeaf();
+    }
+
+    leaf_type* leaf = FindLeaf(key);
+    size_type i = Search(leaf->mKeys.data(), leaf->mCount, key);
+    if ((i < leaf->mCount) && !mCompare(key, leaf->mKeys.data()[i]))
+    {
+      inserted = false;
+      return iterator(leaf, i);
+    }
+
+    if (leaf->mCount == LEAF_CAPACITY)
+    {
+      //Split the full leaf, keeping the larger half on the left.  The last key on the left separates them, so
+      //a key that falls after it goes to the right.
+      const size_type keep = LEAF_CAPACITY - LEAF_CAPACITY / 2;
+      leaf_type* const right = NewLeaf();
+      uninitialized_relocate(leaf->mKeys.data() + keep, leaf->mKeys.data() + LEAF_CAPACITY, right->mKeys.data());
+      uninitialized_relocate(leaf->mValues.data() + keep, leaf->mValues.data() + LEAF_CAPACITY,
+          right->mValues.data());
+      right->mCount = (unsigned short) (LEAF_CAPACITY - keep);
+      leaf->mCount = (unsigned short) keep;
+
+      right->mPrev = leaf;
+      right->mNext = leaf->mNext;
+      if (leaf->mNext)
+      {
+        leaf->mNext->mPrev = right;
+      }
+      else
+      {
+        mLast = right;
+      }
+      leaf->mNext = right;
+      InsertInParent(leaf, leaf->mKeys.data()[keep - 1], right);
+
+      if (i >= keep)
+      {
+        i -= keep;
+        leaf = right;
+      }
+    }
+
+    InsertAt(leaf->mKeys.data(), leaf->mCount, i, key);
+    InsertAt(leaf->mValues.data(), leaf->mCount, i, value);
+    ++leaf->mCount;
+    ++mSize;
+    inserted = true;
+    return iterator(leaf, i);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::const_iterator btree_map<Key, T, Compare, Alloc>::LowerBound(
+      const Key& key) const
+  {
+    if (!mRoot)
+    {
+      return end();
+    }
+    const leaf_type* const leaf = FindLeaf(key);
+    return MakeIterator(leaf, Search(leaf->mKeys.data(), leaf->mCount, key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::iterator btree_map<Key, T, Compare, Alloc>::MakeIterator(
+      const leaf_type* leaf, size_type position) const
+  {
+    //One past the last element of a leaf is the first element of the next, except for the last leaf, where it
+    //is end().
+    if ((position == leaf->mCount) && leaf->mNext)
+    {
+      return iterator(leaf->mNext, 0);
+    }
+    return iterator(leaf, position);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::internal_type* btree_map<Key, T, Compare, Alloc>::NewInternal()
+  {
+    internal_type* const node = (internal_type*) mInternalPool.allocate();
+    node->mParent = NULL;
+    node->mCount = 0;
+    node->mPosition = 0;
+    node->mLeaf = false;
+    return node;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::leaf_type* btree_map<Key, T, Compare, Alloc>::NewLeaf()
+  {
+    leaf_type* const leaf = (leaf_type*) mLeafPool.allocate();
+    leaf->mParent = NULL;
+    leaf->mCount = 0;
+    leaf->mPosition = 0;
+    leaf->mLeaf = true;
+    leaf->mPrev = NULL;
+    leaf->mNext = NULL;
+    return leaf;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::RebalanceInternal(internal_type* node)
+  {
+    //node has INTERNAL_MIN - 1 keys.  Rotate a child in from a sibling through the parent, or merge with one.
+    internal_type* const parent = (internal_type*) node->mParent;
+    const size_type position = node->mPosition;
+    Key* const keys = node->mKeys.data();
+    Key* const parent_keys = parent->mKeys.data();
+
+    if (position > 0)
+    {
+      internal_type* const left = (internal_type*) parent->mChildren[position - 1];
+      if (left->mCount > INTERNAL_MIN)
+      {
+        InsertAt(keys, node->mCount, 0, parent_keys[position - 1]);
+        for (size_type i = node->mCount + 1; i > 0; --i)
+        {
+          LinkChild(node, i, node->mChildren[i - 1]);
+        }
+        LinkChild(node, 0, left->mChildren[left->mCount]);
+        ++node->mCount;
+        parent_keys[position - 1] = FLEX_MOVE(left->mKeys.data()[left->mCount - 1]);
+        left->mKeys.data()[left->mCount - 1].~Key();
+        --left->mCount;
+        return;
+      }
+    }
+    if (position < parent->mCount)
+    {
+      internal_type* const right = (internal_type*) parent->mChildren[position + 1];
+      if (right->mCount > INTERNAL_MIN)
+      {
+        new ((void*) (keys + node->mCount)) Key(parent_keys[position]);
+        LinkChild(node, node->mCount + 1, right->mChildren[0]);
+        ++node->mCount;
+        parent_keys[position] = right->mKeys.data()[0];
+        EraseAt(right->mKeys.data(), right->mCount, 0);
+        for (size_type i = 0; i < right->mCount; ++i)
+        {
+          LinkChild(right, i, right->mChildren[i + 1]);
+        }
+        --right->mCount;
+        return;
+      }
+    }
+
+    //Both siblings are at the minimum, so node merges with one of them and the key between them comes down.
+    internal_type* const left = (position > 0) ? (internal_type*) parent->mChildren[position - 1] : node;
+    internal_type* const right = (position > 0) ? node : (internal_type*) parent->mChildren[position + 1];
+    const size_type separator = left->mPosition;
+    Key* const left_keys = left->mKeys.data();
+    new ((void*) (left_keys + left->mCount)) Key(parent_keys[separator]);
+    uninitialized_relocate(right->mKeys.data(), right->mKeys.data() + right->mCount, left_keys + left->mCount + 1);
+    for (size_type i = 0; i <= right->mCount; ++i)
+    {
+      LinkChild(left, left->mCount + 1 + i, right->mChildren[i]);
+    }
+    left->mCount = (unsigned short) (left->mCount + 1 + right->mCount);
+    FreeInternal(right);
+    RemoveChild(parent, separator);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::RebalanceLeaf(leaf_type* leaf)
+  {
+    //leaf has LEAF_MIN - 1 elements.  Borrow one from a sibling, or merge with one.
+    internal_type* const parent = (internal_type*) leaf->mParent;
+    const size_type position = leaf->mPosition;
+    Key* const parent_keys = parent->mKeys.data();
+
+    if (position > 0)
+    {
+      leaf_type* const left = (leaf_type*) parent->mChildren[position - 1];
+      if (left->mCount > LEAF_MIN)
+      {
+        const size_type last = left->mCount - 1;
+        InsertAt(leaf->mKeys.data(), leaf->mCount, 0, left->mKeys.data()[last]);
+        InsertAt(leaf->mValues.data(), leaf->mCount, 0, left->mValues.data()[last]);
+        ++leaf->mCount;
+        left->mKeys.data()[last].~Key();
+        left->mValues.data()[last].~T();
+        --left->mCount;
+        parent_keys[position - 1] = left->mKeys.data()[last - 1];
+        return;
+      }
+    }
+    if (position < parent->mCount)
+    {
+      leaf_type* const right = (leaf_type*) parent->mChildren[position + 1];
+      if (right->mCount > LEAF_MIN)
+      {
+        new ((void*) (leaf->mKeys.data() + leaf->mCount)) Key(right->mKeys.data()[0]);
+        new ((void*) (leaf->mValues.data() + leaf->mCount)) T(right->mValues.data()[0]);
+        ++leaf->mCount;
+        EraseAt(right->mKeys.data(), right->mCount, 0);
+        EraseAt(right->mValues.data(), right->mCount, 0);
+        --right->mCount;
+        parent_keys[position] = leaf->mKeys.data()[leaf->mCount - 1];
+        return;
+      }
+    }
+
+    //Both siblings are at the minimum, so the right leaf of the pair is merged into the left.
+    leaf_type* const left = (position > 0) ? (leaf_type*) parent->mChildren[position - 1] : leaf;
+    leaf_type* const right = (position > 0) ? leaf : (leaf_type*) parent->mChildren[position + 1];
+    uninitialized_relocate(right->mKeys.data(), right->mKeys.data() + right->mCount,
+        left->mKeys.data() + left->mCount);
+    uninitialized_relocate(right->mValues.data(), right->mValues.data() + right->mCount,
+        left->mValues.data() + left->mCount);
+    left->mCount = (unsigned short) (left->mCount + right->mCount);
+
+    left->mNext = right->mNext;
+    if (right->mNext)
+    {
+      right->mNext->mPrev = left;
+    }
+    else
+    {
+      mLast = left;
+    }
+    const size_type separator = left->mPosition;
+    FreeLeaf(right);
+    RemoveChild(parent, separator);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::RebuildSeparators(btree_node_base* node)
+  {
+    //Sets every separator below node to the largest key in the child on its left.
+    if (!node->mLeaf)
+    {
+      internal_type* const internal = (internal_type*) node;
+      for (size_type i = 0; i <= internal->mCount; ++i)
+      {
+        RebuildSeparators(internal->mChildren[i]);
+        if (i < internal->mCount)
+        {
+          internal->mKeys.data()[i] = MaxKey(internal->mChildren[i]);
+        }
+      }
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void btree_map<Key, T, Compare, Alloc>::RemoveChild(internal_type* parent, size_type position)
+  {
+    //Removes the key at position and the child after it, which has already been merged away.
+    EraseAt(parent->mKeys.data(), parent->mCount, position);
+    for (size_type i = position + 1; i < parent->mCount; ++i)
+    {
+      LinkChild(parent, i, parent->mChildren[i + 1]);
+    }
+    --parent->mCount;
+
+    if (parent == mRoot)
+    {
+      if (parent->mCount == 0)
+      {
+        mRoot = parent->mChildren[0];
+        mRoot->mParent = NULL;
+        mRoot->mPosition = 0;
+        FreeInternal(parent);
+      }
+    }
+    else if (parent->mCount < INTERNAL_MIN)
+    {
+      RebalanceInternal(parent);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename btree_map<Key, T, Compare, Alloc>::size_type btree_map<Key, T, Compare, Alloc>::Search(
+      const Key* keys, size_type n, const Key& key) const
+  {
+    return btree_search<Key, Compare>::lower_bound(keys, n, key, mCompare);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool operator==(const btree_map<Key, T, Compare, Alloc>& lhs, const btree_map<Key, T, Compare, Alloc>& rhs)
+  {
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+    typename btree_map<Key, T, Compare, Alloc>::const_iterator b = rhs.begin();
+    for (typename btree_map<Key, T, Compare, Alloc>::const_iterator a = lhs.begin(); a != lhs.end(); ++a, ++b)
+    {
+      if (!(a->first == b->first) || !(a->second == b->second))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool operator!=(const btree_map<Key, T, Compare, Alloc>& lhs, const btree_map<Key, T, Compare, Alloc>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_BTREE_MAP_H */
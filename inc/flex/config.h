@@ -17,6 +17,13 @@
 #define FLEX_HAS_CXX11 true
 #endif
 
+/*
+ * FLEX_HAS_CXX17
+ */
+#if (__cplusplus >= 201703L)
+#define FLEX_HAS_CXX17 true
+#endif
+
 /*
  * FLEX_NOEXCEPT
  */
@@ -27,6 +34,15 @@
 #define FLEX_NOEXCEPT
 #endif
 
+/*
+ * FLEX_THREAD_LOCAL
+ */
+#ifdef FLEX_HAS_CXX11
+#define FLEX_THREAD_LOCAL thread_local
+#else
+#define FLEX_THREAD_LOCAL __thread
+#endif
+
 /*
  * FLEX_LIKELY
  */
@@ -41,6 +57,25 @@
 
 #endif//FLEX_LIKELY
 
+/*
+ * FLEX_PREFETCH
+ */
+#ifndef FLEX_PREFETCH
+#if defined(__GNUC__) && (__GNUC__ >= 3)
+#define FLEX_PREFETCH(addr) __builtin_prefetch((addr))
+#else
+#define FLEX_PREFETCH(addr)
+#endif
+
+#endif//FLEX_PREFETCH
+
+/*
+ * FLEX_CACHE_LINE_SIZE
+ */
+#ifndef FLEX_CACHE_LINE_SIZE
+#define FLEX_CACHE_LINE_SIZE 64
+#endif
+
 /*
  * flex::destruct_range
  */
@@ -0,0 +1,293 @@
+#ifndef FLEX_FIXED_BITMAP_POOL_H
+#define FLEX_FIXED_BITMAP_POOL_H
+
+#include <flex/allocator.h>
+
+#include <stdint.h>
+
+namespace flex
+{
+
+  //A fixed_bitmap_pool is a fixed_pool that tracks which objects are in use with a bitmap stored next to
+  //the buffer, rather than with a linked list stored over-top of the free objects.  Allocation scans the
+  //bitmap for the first clear bit, which is a handful of word compares and a single count-trailing-zeros
+  //instruction.  More importantly, the bitmap allows every live object to be visited in address order with
+  //for_each_live(), so a periodic sweep over the pool is a sequential walk of the buffer.
+  //
+  //Like fixed_pool, objects that are allocated after the buffer is exhausted come from the heap.  These
+  //overflow objects are not tracked by the bitmap and therefore are not visited by for_each_live().
+  template<class T, size_t N, class Alloc = flex::allocator<T> > class fixed_bitmap_pool: guarded_object
+  {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef uint64_t word_type;
+
+    fixed_bitmap_pool();
+    ~fixed_bitmap_pool();
+
+    void* allocate();
+    size_type capacity() const;
+#ifdef FLEX_HAS_CXX11
+    template<class...Args> pointer construct(Args&&... val);
+#else
+    pointer construct();
+    pointer construct(const value_type& val);
+#endif
+    void deallocate(void* ptr);
+    void destruct(pointer ptr);
+    bool empty() const;
+    template<class Function> void for_each_live(Function f);
+    template<class Function> void for_each_live(Function f) const;
+    bool is_live(const_pointer ptr) const;
+    fixed_bitmap_pool<T, N, Alloc>& operator=(const fixed_bitmap_pool<T, N, Alloc>& obj);
+    size_type size() const;
+
+  protected:
+    static const size_type kWordBits = 64;
+    static const size_type kWordCount = (N + kWordBits - 1) / kWordBits;
+
+    word_type mBitmap[kWordCount];
+    size_type mHint;
+    size_type mLiveCount;
+    Alloc mAllocator;
+    bool mOverflow;
+
+    void* AllocateNewObject();
+    bool IsInBuffer(const void* ptr) const;
+    static size_type CountTrailingZeros(word_type word);
+
+  private:
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(T)];
+      long double dummy;
+    };
+#endif
+  };
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_bitmap_pool<T, N, Alloc>::fixed_bitmap_pool() :
+      mHint(0), mLiveCount(0), mOverflow(false)
+  {
+    for (size_type i = 0; i < kWordCount; ++i)
+    {
+      mBitmap[i] = 0;
+    }
+
+    //Mark the bits past the end of the buffer as used, so the scan in allocate() never returns them.
+    if (N % kWordBits)
+    {
+      mBitmap[kWordCount - 1] = ~((((word_type) 1) << (N % kWordBits)) - 1);
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_bitmap_pool<T, N, Alloc>::~fixed_bitmap_pool()
+  {
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void* fixed_bitmap_pool<T, N, Alloc>::allocate()
+  {
+    //Every word before mHint is known to be full.
+    for (size_type i = mHint; i < kWordCount; ++i)
+    {
+      word_type free_bits = ~mBitmap[i];
+      if (free_bits)
+      {
+        size_type bit = CountTrailingZeros(free_bits);
+        mBitmap[i] |= ((word_type) 1) << bit;
+        mHint = i;
+        ++mLiveCount;
+        return ((pointer) mBuffer) + (i * kWordBits + bit);
+      }
+    }
+
+    mHint = kWordCount;
+    return AllocateNewObject();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::size_type fixed_bitmap_pool<T, N, Alloc>::capacity() const
+  {
+    return N;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  template<class... Args>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::pointer fixed_bitmap_pool<T, N, Alloc>::construct(Args&&... args)
+  {
+    void* ptr = allocate();
+    new (ptr) value_type(std::forward<Args>(args)...);
+    return (pointer) ptr;
+  }
+#else
+  template<class T, size_t N, class Alloc>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::pointer fixed_bitmap_pool<T, N, Alloc>::construct()
+  {
+    void* ptr = allocate();
+    new (ptr) value_type();
+    return (pointer) ptr;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::pointer fixed_bitmap_pool<T, N, Alloc>::construct(const value_type& val)
+  {
+    void* ptr = allocate();
+    new (ptr) value_type(val);
+    return (pointer) ptr;
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline void fixed_bitmap_pool<T, N, Alloc>::deallocate(void* ptr)
+  {
+    if (FLEX_LIKELY(IsInBuffer(ptr)))
+    {
+      size_type index = ((pointer) ptr) - ((pointer) mBuffer);
+      size_type word = index / kWordBits;
+      mBitmap[word] &= ~(((word_type) 1) << (index % kWordBits));
+      if (word < mHint)
+      {
+        mHint = word;
+      }
+      --mLiveCount;
+    }
+    else
+    {
+      mAllocator.deallocate((pointer) ptr, 1);
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void fixed_bitmap_pool<T, N, Alloc>::destruct(pointer ptr)
+  {
+    ptr->~value_type();
+    deallocate(ptr);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline bool fixed_bitmap_pool<T, N, Alloc>::empty() const
+  {
+    return (mLiveCount == N);
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<class Function>
+  inline void fixed_bitmap_pool<T, N, Alloc>::for_each_live(Function f)
+  {
+    //Each word is copied before it is walked, so the function may safely destruct the object it is given.
+    for (size_type i = 0; i < kWordCount; ++i)
+    {
+      word_type bits = mBitmap[i];
+      if (i == kWordCount - 1 && (N % kWordBits))
+      {
+        bits &= (((word_type) 1) << (N % kWordBits)) - 1;
+      }
+
+      pointer base = ((pointer) mBuffer) + i * kWordBits;
+      while (bits)
+      {
+        f(base[CountTrailingZeros(bits)]);
+        bits &= bits - 1;
+      }
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<class Function>
+  inline void fixed_bitmap_pool<T, N, Alloc>::for_each_live(Function f) const
+  {
+    for (size_type i = 0; i < kWordCount; ++i)
+    {
+      word_type bits = mBitmap[i];
+      if (i == kWordCount - 1 && (N % kWordBits))
+      {
+        bits &= (((word_type) 1) << (N % kWordBits)) - 1;
+      }
+
+      const_pointer base = ((const_pointer) mBuffer) + i * kWordBits;
+      while (bits)
+      {
+        f(base[CountTrailingZeros(bits)]);
+        bits &= bits - 1;
+      }
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline bool fixed_bitmap_pool<T, N, Alloc>::is_live(const_pointer ptr) const
+  {
+    if (IsInBuffer(ptr))
+    {
+      size_type index = ptr - ((const_pointer) mBuffer);
+      return (mBitmap[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_bitmap_pool<T, N, Alloc>& fixed_bitmap_pool<T, N, Alloc>::operator=(const fixed_bitmap_pool<T, N, Alloc>&)
+  {
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::size_type fixed_bitmap_pool<T, N, Alloc>::size() const
+  {
+    //Matches pool::size(), which is the number of objects that are available to be retrieved.
+    return N - mLiveCount;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void* fixed_bitmap_pool<T, N, Alloc>::AllocateNewObject()
+  {
+#ifndef FLEX_RELEASE
+    if (!mOverflow)
+    {
+      mOverflow = true;
+      flex::error_msg("fixed_bitmap_pool: exceeded capacity");
+    }
+#endif
+
+    return mAllocator.allocate(1);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline bool fixed_bitmap_pool<T, N, Alloc>::IsInBuffer(const void* ptr) const
+  {
+    return (ptr >= (const void*) mBuffer) && (ptr < (const void*) (((const_pointer) mBuffer) + N));
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename fixed_bitmap_pool<T, N, Alloc>::size_type fixed_bitmap_pool<T, N, Alloc>::CountTrailingZeros(
+      word_type word)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    size_type n = 0;
+    while (!(word & 1))
+    {
+      word >>= 1;
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_BITMAP_POOL_H */
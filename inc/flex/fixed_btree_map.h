@@ -0,0 +1,166 @@
+#ifndef FLEX_FIXED_BTREE_MAP_H
+#define FLEX_FIXED_BTREE_MAP_H
+
+#include <flex/btree_map.h>
+
+namespace flex
+{
+
+  //A btree_map whose nodes all come from internal buffers sized for N elements, so it never allocates once
+  //constructed, whatever the order of inserts and erases.  Since every leaf but the root is at least half
+  //full, N elements never need more than LEAF_COUNT leaves, and those leaves never need more than
+  //INTERNAL_COUNT internal nodes.  Going past N elements reports an error and falls back to Alloc.
+  template<class Key, class T, size_t N, class Compare = std::less<Key>, class Alloc = allocator<char> >
+  class fixed_btree_map: public btree_map<Key, T, Compare, Alloc>
+  {
+  public:
+    typedef btree_map<Key, T, Compare, Alloc> base_type;
+
+    typedef typename base_type::key_type key_type;
+    typedef typename base_type::mapped_type mapped_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::key_compare key_compare;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    using base_type::clear;
+    using base_type::insert;
+
+    static const size_t LEAF_COUNT = N / base_type::LEAF_MIN + 1;
+    static const size_t INTERNAL_COUNT = LEAF_COUNT / base_type::INTERNAL_MIN + 1;
+
+    fixed_btree_map();
+    explicit fixed_btree_map(const Compare& comp);
+    template<typename InputIterator> fixed_btree_map(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    fixed_btree_map(const fixed_btree_map<Key, T, N, Compare, Alloc>& obj);
+    fixed_btree_map(const btree_map<Key, T, Compare, Alloc>& obj);
+    fixed_btree_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+    ~fixed_btree_map();
+
+    fixed_btree_map<Key, T, N, Compare, Alloc>& operator=(const fixed_btree_map<Key, T, N, Compare, Alloc>& obj);
+    fixed_btree_map<Key, T, N, Compare, Alloc>& operator=(const btree_map<Key, T, Compare, Alloc>& obj);
+    fixed_btree_map<Key, T, N, Compare, Alloc>& operator=(std::initializer_list<value_type> il);
+
+  private:
+    typedef typename base_type::leaf_pool_type::node_type leaf_node_type;
+    typedef typename base_type::internal_pool_type::node_type internal_node_type;
+
+    //Blocks are a whole number of cache lines, so aligning the buffers to a cache line aligns every node.
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(leaf_node_type), FLEX_CACHE_LINE_SIZE>::type mLeafBuffer[LEAF_COUNT];
+    typename std::aligned_storage<sizeof(internal_node_type), FLEX_CACHE_LINE_SIZE>::type mInternalBuffer[INTERNAL_COUNT];
+#else
+    union
+    {
+      char mLeafBuffer[LEAF_COUNT * sizeof(leaf_node_type)];
+      long double dummy;
+    };
+    union
+    {
+      char mInternalBuffer[INTERNAL_COUNT * sizeof(internal_node_type)];
+      long double dummy2;
+    };
+#endif
+  };
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  const size_t fixed_btree_map<Key, T, N, Compare, Alloc>::LEAF_COUNT;
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  const size_t fixed_btree_map<Key, T, N, Compare, Alloc>::INTERNAL_COUNT;
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map() :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT, Compare())
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map(const Compare& comp) :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT, comp)
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map(InputIterator first, InputIterator last,
+      const Compare& comp) :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT, comp)
+  {
+    insert(first, last);
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map(
+      const fixed_btree_map<Key, T, N, Compare, Alloc>& obj) :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT,
+          obj.key_comp())
+  {
+    insert(obj.begin(), obj.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map(const btree_map<Key, T, Compare, Alloc>& obj) :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT,
+          obj.key_comp())
+  {
+    insert(obj.begin(), obj.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::fixed_btree_map(std::initializer_list<value_type> il,
+      const Compare& comp) :
+      btree_map<Key, T, Compare, Alloc>((leaf_node_type*) mLeafBuffer, ((leaf_node_type*) mLeafBuffer) + LEAF_COUNT,
+          (internal_node_type*) mInternalBuffer, ((internal_node_type*) mInternalBuffer) + INTERNAL_COUNT, comp)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>::~fixed_btree_map()
+  {
+    //Return every node to its pool, then free the ones that were allocated after a buffer overflowed.
+    clear();
+    this->mLeafPool.ReleaseOverflow((const void*) mLeafBuffer,
+        (const void*) (((const char*) mLeafBuffer) + LEAF_COUNT * sizeof(leaf_node_type)));
+    this->mInternalPool.ReleaseOverflow((const void*) mInternalBuffer,
+        (const void*) (((const char*) mInternalBuffer) + INTERNAL_COUNT * sizeof(internal_node_type)));
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>& fixed_btree_map<Key, T, N, Compare, Alloc>::operator=(
+      const fixed_btree_map<Key, T, N, Compare, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>& fixed_btree_map<Key, T, N, Compare, Alloc>::operator=(
+      const btree_map<Key, T, Compare, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_btree_map<Key, T, N, Compare, Alloc>& fixed_btree_map<Key, T, N, Compare, Alloc>::operator=(
+      std::initializer_list<value_type> il)
+  {
+    base_type::operator=(il);
+    return *this;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_BTREE_MAP_H */
@@ -0,0 +1,56 @@
+#ifndef FLEX_FIXED_FLAT_MAP_H
+#define FLEX_FIXED_FLAT_MAP_H
+
+#include <flex/fixed_vector.h>
+#include <flex/flat_map.h>
+
+namespace flex
+{
+
+  //A flat_map whose keys and values are held in fixed_vectors of capacity N.  Inserting past N is reported
+  //as a fixed_vector overflow.
+  template<class Key, class T, size_t N, class Compare = std::less<Key> > class fixed_flat_map: public flat_map<Key,
+      T, Compare, fixed_vector<Key, N>, fixed_vector<T, N> >
+  {
+  public:
+    typedef flat_map<Key, T, Compare, fixed_vector<Key, N>, fixed_vector<T, N> > base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::size_type size_type;
+
+    fixed_flat_map();
+    explicit fixed_flat_map(const Compare& comp);
+    template<typename InputIterator> fixed_flat_map(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    fixed_flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+  };
+
+  template<class Key, class T, size_t N, class Compare>
+  inline fixed_flat_map<Key, T, N, Compare>::fixed_flat_map() :
+      base_type()
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare>
+  inline fixed_flat_map<Key, T, N, Compare>::fixed_flat_map(const Compare& comp) :
+      base_type(comp)
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare>
+  template<typename InputIterator>
+  inline fixed_flat_map<Key, T, N, Compare>::fixed_flat_map(InputIterator first, InputIterator last,
+      const Compare& comp) :
+      base_type(first, last, comp)
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare>
+  inline fixed_flat_map<Key, T, N, Compare>::fixed_flat_map(std::initializer_list<value_type> il, const Compare& comp) :
+      base_type(il, comp)
+  {
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_FLAT_MAP_H */
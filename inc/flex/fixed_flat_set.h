@@ -0,0 +1,55 @@
+#ifndef FLEX_FIXED_FLAT_SET_H
+#define FLEX_FIXED_FLAT_SET_H
+
+#include <flex/fixed_vector.h>
+#include <flex/flat_set.h>
+
+namespace flex
+{
+
+  //A flat_set whose keys are held in a fixed_vector of capacity N.  Inserting past N is reported as a
+  //fixed_vector overflow.
+  template<class Key, size_t N, class Compare = std::less<Key> > class fixed_flat_set: public flat_set<Key, Compare,
+      fixed_vector<Key, N> >
+  {
+  public:
+    typedef flat_set<Key, Compare, fixed_vector<Key, N> > base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::size_type size_type;
+
+    fixed_flat_set();
+    explicit fixed_flat_set(const Compare& comp);
+    template<typename InputIterator> fixed_flat_set(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    fixed_flat_set(std::initializer_list<value_type> il, const Compare& comp = Compare());
+  };
+
+  template<class Key, size_t N, class Compare>
+  inline fixed_flat_set<Key, N, Compare>::fixed_flat_set() :
+      base_type()
+  {
+  }
+
+  template<class Key, size_t N, class Compare>
+  inline fixed_flat_set<Key, N, Compare>::fixed_flat_set(const Compare& comp) :
+      base_type(comp)
+  {
+  }
+
+  template<class Key, size_t N, class Compare>
+  template<typename InputIterator>
+  inline fixed_flat_set<Key, N, Compare>::fixed_flat_set(InputIterator first, InputIterator last, const Compare& comp) :
+      base_type(first, last, comp)
+  {
+  }
+
+  template<class Key, size_t N, class Compare>
+  inline fixed_flat_set<Key, N, Compare>::fixed_flat_set(std::initializer_list<value_type> il, const Compare& comp) :
+      base_type(il, comp)
+  {
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_FLAT_SET_H */
@@ -26,9 +26,8 @@ namespace flex
     typedef typename base_type::difference_type difference_type;
 
     using base_type::mAnchor;
-    using base_type::mNodePool;
-    using base_type::mAllocator;
     using base_type::mOverflow;
+    using base_type::PurgeOverflowNodes;
     using base_type::assign;
     using base_type::begin;
     using base_type::clear;
@@ -143,18 +142,7 @@ namespace flex
     {
       //If the fixed list overflowed, we want to clean out the nodes that were allocated.
       clear(); //Perform a clear which moves everything to the node pool
-      while (mNodePool != NULL)
-      {
-        node_type* next = static_cast<node_type*>(mNodePool->mNext);
-        //A node was allocated if it is outside the range of buffer.  Remember mBuffer + N
-        //denotes the end() iterator.  Therefore it is possible that an allocated node could be
-        //equal to it.
-        if ((mNodePool < (node_type*) mBuffer) || (mNodePool >= ((node_type*) mBuffer) + N))
-        {
-          mAllocator.deallocate(mNodePool, 1);
-        }
-        mNodePool = next;
-      }
+      PurgeOverflowNodes((node_type*) mBuffer, ((node_type*) mBuffer) + N);
     }
 #endif
   }
@@ -0,0 +1,546 @@
+#ifndef FLEX_FIXED_LRU_CACHE_H
+#define FLEX_FIXED_LRU_CACHE_H
+
+#include <flex/allocation_guard.h>
+#include <flex/internal/functional.h>
+#include <flex/internal/list_iterator.h>
+
+#include <stdint.h>
+#include <utility>
+
+namespace flex
+{
+
+  //A node of a fixed_lru_cache.  The list links order the entries by recency, and mHashNext chains the entries
+  //that share a bucket.  Unused nodes are chained through mHashNext as well.
+  template<class T>
+  struct lru_cache_node: public list_node<T>
+  {
+    lru_cache_node* mHashNext;
+  };
+
+  //The number of buckets in a fixed_lru_cache of N entries: the smallest power of two that is at least N, so the
+  //load factor never exceeds one.
+  template<size_t N, size_t Buckets = 2, size_t Bits = 1, bool Done = (Buckets >= N)>
+  struct lru_cache_buckets
+  {
+    static const size_t value = lru_cache_buckets<N, Buckets * 2, Bits + 1>::value;
+    static const size_t bits = lru_cache_buckets<N, Buckets * 2, Bits + 1>::bits;
+  };
+
+  template<size_t N, size_t Buckets, size_t Bits>
+  struct lru_cache_buckets<N, Buckets, Bits, true>
+  {
+    static const size_t value = Buckets;
+    static const size_t bits = Bits;
+  };
+
+  //The default eviction handler of a fixed_lru_cache, which ignores evictions.
+  struct lru_cache_no_eviction
+  {
+    template<class Key, class T>
+    void operator()(const Key&, T&) const
+    {
+    }
+  };
+
+  //A cache of up to N key/value pairs that evicts the least recently used entry when full.  Each entry is a
+  //single node holding both its hash chain link and its recency links, so a lookup is one hash probe and a
+  //hit relinks the node to the front without touching the table.  All nodes and buckets are held in the cache
+  //itself and nothing is allocated after construction.
+  //
+  //get() counts a hit or a miss and refreshes the entry; peek() and contains() do neither.  put() inserts or
+  //replaces a value and makes it the most recent.  Before an entry is evicted to make room, EvictionHandler is
+  //called with its key and value.  Entries removed by erase() or clear() are not reported as evictions.
+  //reset_stats() zeroes the hit, miss and eviction counters together.
+  //
+  //Iteration runs from the most to the least recently used entry.
+  template<class Key, class T, size_t N, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>,
+      class EvictionHandler = lru_cache_no_eviction>
+  class fixed_lru_cache: public guarded_object
+  {
+  public:
+    typedef fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler> this_type;
+
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef lru_cache_node<value_type> node_type;
+    typedef list_iterator<value_type, value_type*, value_type&> iterator;
+    typedef list_iterator<value_type, const value_type*, const value_type&> const_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef Predicate key_equal;
+    typedef EvictionHandler eviction_handler_type;
+
+    static const size_t BUCKET_COUNT = lru_cache_buckets<N>::value;
+
+    explicit fixed_lru_cache(const EvictionHandler& on_evict = EvictionHandler(), const Hash& hash = Hash(),
+        const Predicate& pred = Predicate());
+    fixed_lru_cache(const this_type& obj);
+    ~fixed_lru_cache();
+
+    iterator begin();
+    const_iterator begin() const;
+    size_type capacity() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    void clear();
+    bool contains(const key_type& key) const;
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    bool erase(const key_type& key);
+    size_type evictions() const;
+    bool full() const;
+    mapped_type* get(const key_type& key);
+    eviction_handler_type& get_eviction_handler();
+    size_type hits() const;
+    size_type max_size() const;
+    size_type misses() const;
+    this_type& operator=(const this_type& obj);
+    mapped_type* peek(const key_type& key);
+    const mapped_type* peek(const key_type& key) const;
+    mapped_type& put(const key_type& key, const mapped_type& val);
+#ifdef FLEX_HAS_CXX11
+    mapped_type& put(const key_type& key, mapped_type&& val);
+#endif
+    void reset_stats();
+    size_type size() const;
+    bool touch(const key_type& key);
+
+  protected:
+    node_type* Acquire();
+    size_t Bucket(const key_type& key) const;
+    node_type* Find(const key_type& key, size_t bucket) const;
+    void Link(node_type* node, size_t bucket);
+    void MoveToFront(node_type* node);
+    void Release(node_type* node);
+
+    list_node_base mAnchor;
+    node_type* mBuckets[BUCKET_COUNT];
+    node_type* mFree;
+    size_type mSize;
+    size_type mHits;
+    size_type mMisses;
+    size_type mEvictions;
+    Hash mHash;
+    Predicate mPredicate;
+    EvictionHandler mOnEvict;
+
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(node_type), alignof(node_type)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(node_type)];
+      long double dummy;
+    };
+#endif
+  };
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  const size_t fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::BUCKET_COUNT;
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::fixed_lru_cache(
+      const EvictionHandler& on_evict, const Hash& hash, const Predicate& pred) :
+      mFree(NULL), mSize(0), mHits(0), mMisses(0), mEvictions(0), mHash(hash), mPredicate(pred), mOnEvict(on_evict)
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+      mBuckets[i] = NULL;
+    }
+
+    //Chain the unused nodes in buffer order, so the first entries are packed at the front.
+    node_type* const nodes = (node_type*) mBuffer;
+    for (size_t i = N; i > 0; --i)
+    {
+      nodes[i - 1].mHashNext = mFree;
+      mFree = nodes + i - 1;
+    }
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::fixed_lru_cache(const this_type& obj) :
+      guarded_object(), mFree(NULL), mSize(0), mHits(0), mMisses(0), mEvictions(0), mHash(obj.mHash),
+      mPredicate(obj.mPredicate), mOnEvict(obj.mOnEvict)
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+      mBuckets[i] = NULL;
+    }
+
+    node_type* const nodes = (node_type*) mBuffer;
+    for (size_t i = N; i > 0; --i)
+    {
+      nodes[i - 1].mHashNext = mFree;
+      mFree = nodes + i - 1;
+    }
+    *this = obj;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::~fixed_lru_cache()
+  {
+    clear();
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::iterator fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::begin()
+  {
+    return iterator(mAnchor.mNext);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::const_iterator fixed_lru_cache<Key, T,
+      N, Hash, Predicate, EvictionHandler>::begin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::capacity() const
+  {
+    return N;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::const_iterator fixed_lru_cache<Key, T,
+      N, Hash, Predicate, EvictionHandler>::cbegin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::const_iterator fixed_lru_cache<Key, T,
+      N, Hash, Predicate, EvictionHandler>::cend() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline void fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::clear()
+  {
+    list_node_base* node = mAnchor.mNext;
+    while (node != &mAnchor)
+    {
+      node_type* const entry = static_cast<node_type*>(node);
+      node = node->mNext;
+      entry->mValue.~value_type();
+      entry->mHashNext = mFree;
+      mFree = entry;
+    }
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+      mBuckets[i] = NULL;
+    }
+    mSize = 0;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline bool fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::contains(const key_type& key) const
+  {
+    return (Find(key, Bucket(key)) != NULL);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline bool fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::iterator fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::end()
+  {
+    return iterator(&mAnchor);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::const_iterator fixed_lru_cache<Key, T,
+      N, Hash, Predicate, EvictionHandler>::end() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline bool fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::erase(const key_type& key)
+  {
+    node_type* const node = Find(key, Bucket(key));
+    if (node)
+    {
+      Release(node);
+      return true;
+    }
+    return false;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::evictions() const
+  {
+    return mEvictions;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline bool fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::full() const
+  {
+    return (mSize == N);
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::mapped_type* fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::get(const key_type& key)
+  {
+    node_type* const node = Find(key, Bucket(key));
+    if (node)
+    {
+      ++mHits;
+      MoveToFront(node);
+      return &node->mValue.second;
+    }
+    ++mMisses;
+    return NULL;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::eviction_handler_type&
+  fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::get_eviction_handler()
+  {
+    return mOnEvict;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::hits() const
+  {
+    return mHits;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::max_size() const
+  {
+    return N;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::misses() const
+  {
+    return mMisses;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::this_type& fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::operator=(const this_type& obj)
+  {
+    if (this != &obj)
+    {
+      //Inserting from the least to the most recent entry reproduces the recency order.
+      clear();
+      for (const list_node_base* node = obj.mAnchor.mPrev; node != &obj.mAnchor; node = node->mPrev)
+      {
+        const value_type& val = static_cast<const node_type*>(node)->mValue;
+        put(val.first, val.second);
+      }
+      mHits = obj.mHits;
+      mMisses = obj.mMisses;
+      mEvictions = obj.mEvictions;
+    }
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::mapped_type* fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::peek(const key_type& key)
+  {
+    node_type* const node = Find(key, Bucket(key));
+    return node ? &node->mValue.second : NULL;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline const typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::mapped_type* fixed_lru_cache<Key,
+      T, N, Hash, Predicate, EvictionHandler>::peek(const key_type& key) const
+  {
+    const node_type* const node = Find(key, Bucket(key));
+    return node ? &node->mValue.second : NULL;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::mapped_type& fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::put(const key_type& key, const mapped_type& val)
+  {
+    const size_t bucket = Bucket(key);
+    node_type* node = Find(key, bucket);
+    if (node)
+    {
+      node->mValue.second = val;
+      MoveToFront(node);
+    }
+    else if (mFree)
+    {
+      node = Acquire();
+      new ((void*) &node->mValue) value_type(key, val);
+      Link(node, bucket);
+    }
+    else
+    {
+      //Evicting destroys the least recently used entry, which key or val may refer to, so they are copied out
+      //before the node is released.
+      value_type tmp(key, val);
+      node = Acquire();
+      new ((void*) &node->mValue) value_type(FLEX_MOVE(tmp));
+      Link(node, bucket);
+    }
+    return node->mValue.second;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::mapped_type& fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::put(const key_type& key, mapped_type&& val)
+  {
+    const size_t bucket = Bucket(key);
+    node_type* node = Find(key, bucket);
+    if (node)
+    {
+      node->mValue.second = std::move(val);
+      MoveToFront(node);
+    }
+    else if (mFree)
+    {
+      node = Acquire();
+      new ((void*) &node->mValue) value_type(key, std::move(val));
+      Link(node, bucket);
+    }
+    else
+    {
+      //Evicting destroys the least recently used entry, which key or val may refer to, so they are copied out
+      //before the node is released.
+      value_type tmp(key, std::move(val));
+      node = Acquire();
+      new ((void*) &node->mValue) value_type(std::move(tmp));
+      Link(node, bucket);
+    }
+    return node->mValue.second;
+  }
+#endif
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline void fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::reset_stats()
+  {
+    mHits = mMisses = mEvictions = 0;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::size_type fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::size() const
+  {
+    return mSize;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline bool fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::touch(const key_type& key)
+  {
+    node_type* const node = Find(key, Bucket(key));
+    if (node)
+    {
+      MoveToFront(node);
+      return true;
+    }
+    return false;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::node_type* fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::Acquire()
+  {
+    //Returns an unlinked node with no value, evicting the least recently used entry if the cache is full.
+    if (mFree)
+    {
+      node_type* const node = mFree;
+      mFree = node->mHashNext;
+      return node;
+    }
+
+    node_type* const node = static_cast<node_type*>(mAnchor.mPrev);
+    mOnEvict(node->mValue.first, node->mValue.second);
+    ++mEvictions;
+    Release(node);
+    mFree = node->mHashNext;
+    return node;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline size_t fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::Bucket(const key_type& key) const
+  {
+    //Fibonacci hashing takes the high bits of the product, so hashes that differ only in their high bits, or
+    //that share a stride, still spread across the buckets.
+    const uint64_t h = (uint64_t) mHash(key) * 0x9E3779B97F4A7C15ull;
+    return (size_t) (h >> (64 - lru_cache_buckets<N>::bits));
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline typename fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::node_type* fixed_lru_cache<Key, T, N,
+      Hash, Predicate, EvictionHandler>::Find(const key_type& key, size_t bucket) const
+  {
+    node_type* node = mBuckets[bucket];
+    while (node && !mPredicate(node->mValue.first, key))
+    {
+      node = node->mHashNext;
+    }
+    return node;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline void fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::Link(node_type* node, size_t bucket)
+  {
+    node->mHashNext = mBuckets[bucket];
+    mBuckets[bucket] = node;
+    node->insert(mAnchor.mNext);
+    ++mSize;
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline void fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::MoveToFront(node_type* node)
+  {
+    if (mAnchor.mNext != node)
+    {
+      node->remove();
+      node->insert(mAnchor.mNext);
+    }
+  }
+
+  template<class Key, class T, size_t N, class Hash, class Predicate, class EvictionHandler>
+  inline void fixed_lru_cache<Key, T, N, Hash, Predicate, EvictionHandler>::Release(node_type* node)
+  {
+    //Unlinks the entry from its bucket and the recency list, destroys its value and returns it to the free chain.
+    node_type** link = &mBuckets[Bucket(node->mValue.first)];
+    while (*link != node)
+    {
+      link = &(*link)->mHashNext;
+    }
+    *link = node->mHashNext;
+
+    node->remove();
+    node->mValue.~value_type();
+    node->mHashNext = mFree;
+    mFree = node;
+    --mSize;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_LRU_CACHE_H */
@@ -6,10 +6,10 @@
 namespace flex
 {
 
-  template<class T, size_t N, class Alloc = allocator<T> > class fixed_ring: public ring<T, Alloc>
+  template<class T, size_t N, class Alloc = allocator<T>, class Growth = double_growth> class fixed_ring: public ring<T, Alloc, Growth>
   {
   public:
-    typedef ring<T, Alloc> base_type;
+    typedef ring<T, Alloc, Growth> base_type;
 
     typedef typename base_type::value_type value_type;
     typedef typename base_type::pointer pointer;
@@ -31,20 +31,20 @@ namespace flex
     explicit fixed_ring(size_type size, const value_type& val = value_type());
     fixed_ring(int size, const value_type& val);
     template<typename InputIterator> fixed_ring(InputIterator first, InputIterator last);
-    fixed_ring(const fixed_ring<T, N, Alloc> & obj);
-    fixed_ring(const ring<T, Alloc> & obj);
+    fixed_ring(const fixed_ring<T, N, Alloc, Growth> & obj);
+    fixed_ring(const ring<T, Alloc, Growth> & obj);
     fixed_ring(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    fixed_ring(fixed_ring<T, N, Alloc> && obj);
-    fixed_ring(ring<T, Alloc> && obj);
+    fixed_ring(fixed_ring<T, N, Alloc, Growth> && obj);
+    fixed_ring(ring<T, Alloc, Growth> && obj);
 #endif
 
-    fixed_ring<T, N, Alloc>& operator=(const fixed_ring<T, N, Alloc>& obj);
-    fixed_ring<T, N, Alloc>& operator=(const ring<T, Alloc>& obj);
-    fixed_ring<T, N, Alloc>& operator=(std::initializer_list<value_type> il);
+    fixed_ring<T, N, Alloc, Growth>& operator=(const fixed_ring<T, N, Alloc, Growth>& obj);
+    fixed_ring<T, N, Alloc, Growth>& operator=(const ring<T, Alloc, Growth>& obj);
+    fixed_ring<T, N, Alloc, Growth>& operator=(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    fixed_ring<T, N, Alloc>& operator=(fixed_ring<T, N, Alloc>&& obj);
-    fixed_ring<T, N, Alloc>& operator=(ring<T, Alloc>&& obj);
+    fixed_ring<T, N, Alloc, Growth>& operator=(fixed_ring<T, N, Alloc, Growth>&& obj);
+    fixed_ring<T, N, Alloc, Growth>& operator=(ring<T, Alloc, Growth>&& obj);
 #endif
 
   private:
@@ -61,105 +61,105 @@ namespace flex
 #endif
   };
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring() :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer, (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring() :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, (pointer) mBuffer + N)
   {
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(size_type size, const value_type& val) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + size, (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(size_type size, const value_type& val) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + size, (pointer) mBuffer + N)
   {
     std::uninitialized_fill(mBegin.mPtr, mEnd.mPtr, val);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(int size, const value_type& val) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + size, (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(int size, const value_type& val) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + size, (pointer) mBuffer + N)
   {
     std::uninitialized_fill(mBegin.mPtr, mEnd.mPtr, val);
   }
 
-  template<class T, size_t N, class Alloc>
+  template<class T, size_t N, class Alloc, class Growth>
   template<typename InputIterator>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(InputIterator first, InputIterator last) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(first, last), (pointer) mBuffer + N)
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(InputIterator first, InputIterator last) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(first, last), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(first, last, mBegin.mPtr);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(const fixed_ring<T, N, Alloc> & obj) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(const fixed_ring<T, N, Alloc, Growth> & obj) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(obj.mBegin, obj.mEnd, mBegin.mPtr);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(const ring<T, Alloc> & obj) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(const ring<T, Alloc, Growth> & obj) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(obj.begin(), obj.end(), mBegin.mPtr);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(std::initializer_list<value_type> il) :
-      ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + il.size(), (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(std::initializer_list<value_type> il) :
+      ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + il.size(), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(il.begin(), il.end(), mBegin);
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(fixed_ring<T, N, Alloc> && obj) :
-  ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(fixed_ring<T, N, Alloc, Growth> && obj) :
+  ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(std::make_move_iterator(obj.mBegin), std::make_move_iterator(obj.mEnd), mBegin);
     obj.clear();
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>::fixed_ring(ring<T, Alloc> && obj) :
-  ring<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>::fixed_ring(ring<T, Alloc, Growth> && obj) :
+  ring<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), (pointer) mBuffer + N)
   {
     std::uninitialized_copy(std::make_move_iterator(obj.begin()),std::make_move_iterator(obj.end()), mBegin);
     obj.clear();
   }
 #endif
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>& fixed_ring<T, N, Alloc>::operator=(const fixed_ring<T, N, Alloc>& obj)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>& fixed_ring<T, N, Alloc, Growth>::operator=(const fixed_ring<T, N, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>& fixed_ring<T, N, Alloc>::operator=(const ring<T, Alloc>& obj)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>& fixed_ring<T, N, Alloc, Growth>::operator=(const ring<T, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_ring<T, N, Alloc>& fixed_ring<T, N, Alloc>::operator=(std::initializer_list<value_type> il)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_ring<T, N, Alloc, Growth>& fixed_ring<T, N, Alloc, Growth>::operator=(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
     return *this;
   }
 
 #ifdef FLEX_HAS_CXX11
-template<class T, size_t N, class Alloc>
-inline fixed_ring<T, N, Alloc>& fixed_ring<T, N, Alloc>::operator=(fixed_ring<T, N, Alloc>&& obj)
+template<class T, size_t N, class Alloc, class Growth>
+inline fixed_ring<T, N, Alloc, Growth>& fixed_ring<T, N, Alloc, Growth>::operator=(fixed_ring<T, N, Alloc, Growth>&& obj)
 {
   assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
   obj.clear();
   return *this;
 }
 
-template<class T, size_t N, class Alloc>
-inline fixed_ring<T, N, Alloc>& fixed_ring<T, N, Alloc>::operator=(ring<T, Alloc>&& obj)
+template<class T, size_t N, class Alloc, class Growth>
+inline fixed_ring<T, N, Alloc, Growth>& fixed_ring<T, N, Alloc, Growth>::operator=(ring<T, Alloc, Growth>&& obj)
 {
   assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
   obj.clear();
@@ -0,0 +1,149 @@
+#ifndef FLEX_FIXED_SKIP_MAP_H
+#define FLEX_FIXED_SKIP_MAP_H
+
+#include <flex/skip_map.h>
+
+namespace flex
+{
+
+  //A skip_map whose towers all come from an internal buffer sized for N elements, so its memory is fixed at
+  //sizeof(fixed_skip_map) no matter the order of inserts and erases.  The buffer holds a single-link tower for
+  //every element, and taller towers in the counts of skip_map::TowerCount().  If a taller class runs out, new
+  //nodes are simply made shorter; only going past N elements reports an error and falls back to Alloc.
+  template<class Key, class T, size_t N, class Compare = std::less<Key>, class Alloc = allocator<char> >
+  class fixed_skip_map: public skip_map<Key, T, Compare, Alloc>
+  {
+  public:
+    typedef skip_map<Key, T, Compare, Alloc> base_type;
+
+    typedef typename base_type::key_type key_type;
+    typedef typename base_type::mapped_type mapped_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::key_compare key_compare;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::node_type node_type;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    using base_type::clear;
+    using base_type::insert;
+
+    //The bytes of tower storage, matching skip_map::TowerCount() for each class.
+    static const size_t BUFFER_SIZE = N * sizeof(skip_map_tower<value_type, 1>)
+        + ((N >> 1) + 1) * sizeof(skip_map_tower<value_type, 2>)
+        + ((N >> 3) + 1) * sizeof(skip_map_tower<value_type, 4>)
+        + ((N >> 7) + 1) * sizeof(skip_map_tower<value_type, 8>)
+        + ((N >> 15) + 1) * sizeof(skip_map_tower<value_type, 16>);
+
+    fixed_skip_map();
+    explicit fixed_skip_map(const Compare& comp);
+    template<typename InputIterator> fixed_skip_map(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    fixed_skip_map(const fixed_skip_map<Key, T, N, Compare, Alloc>& obj);
+    fixed_skip_map(const skip_map<Key, T, Compare, Alloc>& obj);
+    fixed_skip_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+    ~fixed_skip_map();
+
+    fixed_skip_map<Key, T, N, Compare, Alloc>& operator=(const fixed_skip_map<Key, T, N, Compare, Alloc>& obj);
+    fixed_skip_map<Key, T, N, Compare, Alloc>& operator=(const skip_map<Key, T, Compare, Alloc>& obj);
+    fixed_skip_map<Key, T, N, Compare, Alloc>& operator=(std::initializer_list<value_type> il);
+
+  private:
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(node_type), alignof(node_type)>::type mBuffer[(BUFFER_SIZE
+        + sizeof(node_type) - 1) / sizeof(node_type)];
+#else
+    union
+    {
+      char mBuffer[BUFFER_SIZE];
+      long double dummy;
+    };
+#endif
+  };
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  const size_t fixed_skip_map<Key, T, N, Compare, Alloc>::BUFFER_SIZE;
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map() :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, Compare())
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map(const Compare& comp) :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, comp)
+  {
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map(InputIterator first, InputIterator last,
+      const Compare& comp) :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, comp)
+  {
+    insert(first, last);
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map(const fixed_skip_map<Key, T, N, Compare, Alloc>& obj) :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, obj.key_comp())
+  {
+    this->Append(obj.begin(), obj.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map(const skip_map<Key, T, Compare, Alloc>& obj) :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, obj.key_comp())
+  {
+    this->Append(obj.begin(), obj.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::fixed_skip_map(std::initializer_list<value_type> il,
+      const Compare& comp) :
+      skip_map<Key, T, Compare, Alloc>((void*) mBuffer, N, comp)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>::~fixed_skip_map()
+  {
+    //Return every tower to its pool, then free the ones that were allocated after the buffer overflowed.
+    clear();
+    this->ReleaseOverflow((const void*) mBuffer, (const void*) (((const char*) mBuffer) + BUFFER_SIZE));
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>& fixed_skip_map<Key, T, N, Compare, Alloc>::operator=(
+      const fixed_skip_map<Key, T, N, Compare, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>& fixed_skip_map<Key, T, N, Compare, Alloc>::operator=(
+      const skip_map<Key, T, Compare, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class Compare, class Alloc>
+  inline fixed_skip_map<Key, T, N, Compare, Alloc>& fixed_skip_map<Key, T, N, Compare, Alloc>::operator=(
+      std::initializer_list<value_type> il)
+  {
+    base_type::operator=(il);
+    return *this;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_SKIP_MAP_H */
@@ -0,0 +1,192 @@
+#ifndef FLEX_FIXED_SLIST_H
+#define FLEX_FIXED_SLIST_H
+
+#include <flex/slist.h>
+
+namespace flex
+{
+
+  //An slist that takes its nodes from an internal buffer of N nodes.  Like fixed_list, exceeding the buffer
+  //reports an error and falls back to Alloc.
+  template<class T, size_t N, class Alloc = allocator<slist_node<T> > > class fixed_slist: public slist<T, Alloc>
+  {
+  public:
+    typedef slist<T, Alloc> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::node_type node_type;
+    typedef typename base_type::base_node_type base_node_type;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    using base_type::mAnchor;
+    using base_type::mOverflow;
+    using base_type::PurgeOverflowNodes;
+    using base_type::assign;
+    using base_type::begin;
+    using base_type::clear;
+    using base_type::end;
+    using base_type::before_begin;
+    using base_type::insert_after;
+
+    fixed_slist();
+    explicit fixed_slist(size_type size, const value_type& val = value_type());
+    fixed_slist(int size, const value_type& val);
+    template<typename InputIterator> fixed_slist(InputIterator first, InputIterator last);
+    fixed_slist(const fixed_slist<T, N, Alloc> & obj);
+    fixed_slist(const slist<T, Alloc> & obj);
+    fixed_slist(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    fixed_slist(fixed_slist<T, N, Alloc> && obj);
+    fixed_slist(slist<T, Alloc> && obj);
+#endif
+    ~fixed_slist();
+
+    fixed_slist<T, N, Alloc>& operator=(const fixed_slist<T, N, Alloc>& obj);
+    fixed_slist<T, N, Alloc>& operator=(const slist<T, Alloc>& obj);
+    fixed_slist<T, N, Alloc>& operator=(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    fixed_slist<T, N, Alloc>& operator=(fixed_slist<T, N, Alloc>&& obj);
+    fixed_slist<T, N, Alloc>& operator=(slist<T, Alloc>&& obj);
+#endif
+
+  private:
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(node_type), alignof(node_type)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(node_type)];
+      long double dummy;
+    };
+#endif
+  };
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist() :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(size_type size, const value_type& val) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), size, val);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(int size, const value_type& val) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), (size_type) size, val);
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<typename InputIterator>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(InputIterator first, InputIterator last) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), first, last);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(const fixed_slist<T, N, Alloc> & obj) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), obj.cbegin(), obj.cend());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(const slist<T, Alloc> & obj) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), obj.cbegin(), obj.cend());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(std::initializer_list<value_type> il) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), il.begin(), il.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(fixed_slist<T, N, Alloc> && obj) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::fixed_slist(slist<T, Alloc> && obj) :
+      slist<T, Alloc>((node_type*) mBuffer, ((node_type*) mBuffer) + N)
+  {
+    insert_after(before_begin(), std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>::~fixed_slist()
+  {
+#ifndef FLEX_RELEASE
+    if (FLEX_UNLIKELY(mOverflow))
+    {
+      //If the fixed slist overflowed, we want to clean out the nodes that were allocated.
+      clear(); //Perform a clear which moves everything to the node pool
+      PurgeOverflowNodes((node_type*) mBuffer, ((node_type*) mBuffer) + N);
+    }
+#endif
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>& fixed_slist<T, N, Alloc>::operator=(const fixed_slist<T, N, Alloc>& obj)
+  {
+    assign(obj.begin(), obj.end());
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>& fixed_slist<T, N, Alloc>::operator=(const slist<T, Alloc>& obj)
+  {
+    assign(obj.begin(), obj.end());
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>& fixed_slist<T, N, Alloc>::operator=(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>& fixed_slist<T, N, Alloc>::operator=(fixed_slist<T, N, Alloc>&& obj)
+  {
+    assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slist<T, N, Alloc>& fixed_slist<T, N, Alloc>::operator=(slist<T, Alloc>&& obj)
+  {
+    assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+    return *this;
+  }
+#endif
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_SLIST_H */
@@ -0,0 +1,85 @@
+#ifndef FLEX_FIXED_SLOT_MAP_H
+#define FLEX_FIXED_SLOT_MAP_H
+
+#include <flex/slot_map.h>
+
+namespace flex
+{
+
+  template<class T, size_t N, class Alloc = allocator<T> > class fixed_slot_map: public slot_map<T, Alloc>
+  {
+  public:
+    typedef slot_map<T, Alloc> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+    typedef typename base_type::handle_type handle_type;
+    typedef typename base_type::slot_type slot_type;
+
+    fixed_slot_map();
+    fixed_slot_map(const fixed_slot_map<T, N, Alloc>& obj);
+    fixed_slot_map(const slot_map<T, Alloc>& obj);
+
+    fixed_slot_map<T, N, Alloc>& operator=(const fixed_slot_map<T, N, Alloc>& obj);
+    fixed_slot_map<T, N, Alloc>& operator=(const slot_map<T, Alloc>& obj);
+
+  private:
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(T)];
+      long double dummy;
+    };
+#endif
+    slot_type mSlotBuffer[N];
+    uint32_t mEraseBuffer[N];
+  };
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slot_map<T, N, Alloc>::fixed_slot_map() :
+      slot_map<T, Alloc>((pointer) mBuffer, mSlotBuffer, mEraseBuffer, N)
+  {
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slot_map<T, N, Alloc>::fixed_slot_map(const fixed_slot_map<T, N, Alloc>& obj) :
+      slot_map<T, Alloc>((pointer) mBuffer, mSlotBuffer, mEraseBuffer, N)
+  {
+    base_type::operator=(obj);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slot_map<T, N, Alloc>::fixed_slot_map(const slot_map<T, Alloc>& obj) :
+      slot_map<T, Alloc>((pointer) mBuffer, mSlotBuffer, mEraseBuffer, N)
+  {
+    base_type::operator=(obj);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slot_map<T, N, Alloc>& fixed_slot_map<T, N, Alloc>::operator=(const fixed_slot_map<T, N, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline fixed_slot_map<T, N, Alloc>& fixed_slot_map<T, N, Alloc>::operator=(const slot_map<T, Alloc>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_SLOT_MAP_H */
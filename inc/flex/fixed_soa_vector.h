@@ -0,0 +1,125 @@
+#ifndef FLEX_FIXED_SOA_VECTOR_H
+#define FLEX_FIXED_SOA_VECTOR_H
+
+#include <flex/soa_vector.h>
+
+#ifdef FLEX_HAS_CXX11
+
+namespace flex
+{
+
+  //A soa_vector whose columns are laid out in an inline buffer of N rows.  Like a fixed_vector, growing past
+  //N is reported as an error and the container then continues on the heap.
+  template<size_t N, class... Fields> class fixed_soa_vector: public soa_vector<Fields...>
+  {
+  public:
+    typedef soa_vector<Fields...> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    using base_type::resize;
+
+    fixed_soa_vector();
+    explicit fixed_soa_vector(size_type size);
+    fixed_soa_vector(size_type size, const value_type& val);
+    fixed_soa_vector(const fixed_soa_vector<N, Fields...>& obj);
+    fixed_soa_vector(const soa_vector<Fields...>& obj);
+    fixed_soa_vector(fixed_soa_vector<N, Fields...>&& obj);
+    fixed_soa_vector(soa_vector<Fields...>&& obj);
+
+    fixed_soa_vector<N, Fields...>& operator=(const fixed_soa_vector<N, Fields...>& obj);
+    fixed_soa_vector<N, Fields...>& operator=(const soa_vector<Fields...>& obj);
+    fixed_soa_vector<N, Fields...>& operator=(fixed_soa_vector<N, Fields...>&& obj);
+    fixed_soa_vector<N, Fields...>& operator=(soa_vector<Fields...>&& obj);
+
+  private:
+    typename std::aligned_storage<soa_layout<Fields...>::bytes(N), alignof(std::max_align_t)>::type mBuffer;
+  };
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector() :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(size_type size) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    resize(size);
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(size_type size, const value_type& val) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    resize(size, val);
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(const fixed_soa_vector<N, Fields...>& obj) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    base_type::operator=(obj);
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(const soa_vector<Fields...>& obj) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    base_type::operator=(obj);
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(fixed_soa_vector<N, Fields...>&& obj) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    base_type::operator=(std::move(obj));
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>::fixed_soa_vector(soa_vector<Fields...>&& obj) :
+      soa_vector<Fields...>((char*) &mBuffer, N)
+  {
+    base_type::operator=(std::move(obj));
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>& fixed_soa_vector<N, Fields...>::operator=(
+      const fixed_soa_vector<N, Fields...>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>& fixed_soa_vector<N, Fields...>::operator=(const soa_vector<Fields...>& obj)
+  {
+    base_type::operator=(obj);
+    return *this;
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>& fixed_soa_vector<N, Fields...>::operator=(
+      fixed_soa_vector<N, Fields...>&& obj)
+  {
+    base_type::operator=(std::move(obj));
+    return *this;
+  }
+
+  template<size_t N, class... Fields>
+  inline fixed_soa_vector<N, Fields...>& fixed_soa_vector<N, Fields...>::operator=(soa_vector<Fields...>&& obj)
+  {
+    base_type::operator=(std::move(obj));
+    return *this;
+  }
+
+} //namespace flex
+
+#endif //FLEX_HAS_CXX11
+
+#endif /* FLEX_FIXED_SOA_VECTOR_H */
@@ -0,0 +1,219 @@
+#ifndef FLEX_FIXED_UNROLLED_LIST_H
+#define FLEX_FIXED_UNROLLED_LIST_H
+
+#include <flex/unrolled_list.h>
+
+namespace flex
+{
+
+  //An unrolled_list that takes its chunks from an internal buffer.  N is the number of elements.  Every chunk
+  //but the first and last is kept at least half full, so the buffer holds enough chunks for N elements at half
+  //fill plus those two.  Like fixed_list, exceeding the buffer reports an error and falls back to Alloc.
+  template<class T, size_t N, size_t K = unrolled_list_default_size<T>::value,
+      class Alloc = allocator<typename pool<unrolled_list_chunk<T, K> >::node_type> >
+  class fixed_unrolled_list: public unrolled_list<T, K, Alloc>
+  {
+  public:
+    typedef unrolled_list<T, K, Alloc> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::chunk_type chunk_type;
+    typedef typename base_type::node_type node_type;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    //The number of chunks in the buffer.
+    static const size_t CHUNKS = N / (K / 2) + 2;
+
+    using base_type::assign;
+    using base_type::begin;
+    using base_type::clear;
+    using base_type::end;
+    using base_type::insert;
+
+    fixed_unrolled_list();
+    explicit fixed_unrolled_list(size_type size, const value_type& val = value_type());
+    fixed_unrolled_list(int size, const value_type& val);
+    template<typename InputIterator> fixed_unrolled_list(InputIterator first, InputIterator last);
+    fixed_unrolled_list(const fixed_unrolled_list<T, N, K, Alloc>& obj);
+    fixed_unrolled_list(const base_type& obj);
+    fixed_unrolled_list(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    fixed_unrolled_list(fixed_unrolled_list<T, N, K, Alloc>&& obj);
+    fixed_unrolled_list(base_type&& obj);
+#endif
+    ~fixed_unrolled_list();
+
+    size_type capacity() const;
+
+    fixed_unrolled_list<T, N, K, Alloc>& operator=(const fixed_unrolled_list<T, N, K, Alloc>& obj);
+    fixed_unrolled_list<T, N, K, Alloc>& operator=(const base_type& obj);
+    fixed_unrolled_list<T, N, K, Alloc>& operator=(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    fixed_unrolled_list<T, N, K, Alloc>& operator=(fixed_unrolled_list<T, N, K, Alloc>&& obj);
+    fixed_unrolled_list<T, N, K, Alloc>& operator=(base_type&& obj);
+#endif
+
+  private:
+    using base_type::mPool;
+
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(node_type), alignof(node_type)>::type mBuffer[CHUNKS];
+#else
+    union
+    {
+      char mBuffer[CHUNKS * sizeof(node_type)];
+      long double dummy;
+    };
+#endif
+  };
+
+  template<class T, size_t N, size_t K, class Alloc>
+  const size_t fixed_unrolled_list<T, N, K, Alloc>::CHUNKS;
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list() :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(size_type size, const value_type& val) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), size, val);
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(int size, const value_type& val) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), (size_type) size, val);
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  template<typename InputIterator>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(InputIterator first, InputIterator last) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), first, last);
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(const fixed_unrolled_list<T, N, K, Alloc>& obj) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), obj.begin(), obj.end());
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(const base_type& obj) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), obj.begin(), obj.end());
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(std::initializer_list<value_type> il) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), il.begin(), il.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(fixed_unrolled_list<T, N, K, Alloc>&& obj) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::fixed_unrolled_list(base_type&& obj) :
+      base_type((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS)
+  {
+    insert(end(), std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+    obj.clear();
+  }
+#endif
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>::~fixed_unrolled_list()
+  {
+    //Return every chunk to the pool so the overflowed ones can be told apart from the buffer and freed.
+    clear();
+    mPool.ReleaseOverflow((node_type*) mBuffer, ((node_type*) mBuffer) + CHUNKS);
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline typename fixed_unrolled_list<T, N, K, Alloc>::size_type fixed_unrolled_list<T, N, K, Alloc>::capacity() const
+  {
+    return N;
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>& fixed_unrolled_list<T, N, K, Alloc>::operator=(
+      const fixed_unrolled_list<T, N, K, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      assign(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>& fixed_unrolled_list<T, N, K, Alloc>::operator=(const base_type& obj)
+  {
+    if (this != &obj)
+    {
+      assign(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>& fixed_unrolled_list<T, N, K, Alloc>::operator=(
+      std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>& fixed_unrolled_list<T, N, K, Alloc>::operator=(
+      fixed_unrolled_list<T, N, K, Alloc>&& obj)
+  {
+    if (this != &obj)
+    {
+      assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+      obj.clear();
+    }
+    return *this;
+  }
+
+  template<class T, size_t N, size_t K, class Alloc>
+  inline fixed_unrolled_list<T, N, K, Alloc>& fixed_unrolled_list<T, N, K, Alloc>::operator=(base_type&& obj)
+  {
+    if (this != &obj)
+    {
+      assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+      obj.clear();
+    }
+    return *this;
+  }
+#endif
+
+} //namespace flex
+
+#endif /* FLEX_FIXED_UNROLLED_LIST_H */
@@ -6,10 +6,10 @@
 namespace flex
 {
 
-  template<class T, size_t N, class Alloc = allocator<T> > class fixed_vector: public vector<T, Alloc>
+  template<class T, size_t N, class Alloc = allocator<T>, class Growth = double_growth> class fixed_vector: public vector<T, Alloc, Growth>
   {
   public:
-    typedef vector<T, Alloc> base_type;
+    typedef vector<T, Alloc, Growth> base_type;
 
     typedef typename base_type::value_type value_type;
     typedef typename base_type::pointer pointer;
@@ -32,20 +32,20 @@ namespace flex
     explicit fixed_vector(size_type size, const value_type& val = value_type());
     fixed_vector(int size, const value_type& val);
     template<typename InputIterator> fixed_vector(InputIterator first, InputIterator last);
-    fixed_vector(const fixed_vector<T, N, Alloc> & obj);
-    fixed_vector(const vector<T, Alloc> & obj);
+    fixed_vector(const fixed_vector<T, N, Alloc, Growth> & obj);
+    fixed_vector(const vector<T, Alloc, Growth> & obj);
     fixed_vector(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    fixed_vector(fixed_vector<T, N, Alloc> && obj);
-    fixed_vector(vector<T, Alloc> && obj);
+    fixed_vector(fixed_vector<T, N, Alloc, Growth> && obj);
+    fixed_vector(vector<T, Alloc, Growth> && obj);
 #endif
 
-    fixed_vector<T, N, Alloc>& operator=(const fixed_vector<T, N, Alloc>& obj);
-    fixed_vector<T, N, Alloc>& operator=(const vector<T, Alloc>& obj);
-    fixed_vector<T, N, Alloc>& operator=(std::initializer_list<value_type> il);
+    fixed_vector<T, N, Alloc, Growth>& operator=(const fixed_vector<T, N, Alloc, Growth>& obj);
+    fixed_vector<T, N, Alloc, Growth>& operator=(const vector<T, Alloc, Growth>& obj);
+    fixed_vector<T, N, Alloc, Growth>& operator=(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    fixed_vector<T, N, Alloc>& operator=(fixed_vector<T, N, Alloc>&& obj);
-    fixed_vector<T, N, Alloc>& operator=(vector<T, Alloc>&& obj);
+    fixed_vector<T, N, Alloc, Growth>& operator=(fixed_vector<T, N, Alloc, Growth>&& obj);
+    fixed_vector<T, N, Alloc, Growth>& operator=(vector<T, Alloc, Growth>&& obj);
 #endif
 
   private:
@@ -60,105 +60,105 @@ namespace flex
 #endif
   };
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector() :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer, N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector() :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
   {
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(size_type size, const value_type& val) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + size, N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(size_type size, const value_type& val) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + size, N)
   {
     std::uninitialized_fill(mBegin, mEnd, val);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(int size, const value_type& val) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + size, N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(int size, const value_type& val) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + size, N)
   {
     std::uninitialized_fill(mBegin, mEnd, val);
   }
 
-  template<class T, size_t N, class Alloc>
+  template<class T, size_t N, class Alloc, class Growth>
   template<typename InputIterator>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(InputIterator first, InputIterator last) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(first, last), N)
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(InputIterator first, InputIterator last) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(first, last), N)
   {
     std::uninitialized_copy(first, last, mBegin);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(const fixed_vector<T, N, Alloc> & obj) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(const fixed_vector<T, N, Alloc, Growth> & obj) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
   {
     std::uninitialized_copy(obj.mBegin, obj.mEnd, mBegin);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(const vector<T, Alloc> & obj) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(const vector<T, Alloc, Growth> & obj) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
   {
     std::uninitialized_copy(obj.begin(), obj.end(), mBegin);
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(std::initializer_list<value_type> il) :
-      vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + il.size(), N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(std::initializer_list<value_type> il) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + il.size(), N)
   {
     std::uninitialized_copy(il.begin(), il.end(), mBegin);
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(fixed_vector<T, N, Alloc> && obj) :
-  vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(fixed_vector<T, N, Alloc, Growth> && obj) :
+  vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
   {
     std::uninitialized_copy(std::make_move_iterator(obj.mBegin), std::make_move_iterator(obj.mEnd), mBegin);
     obj.clear();
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>::fixed_vector(vector<T, Alloc> && obj) :
-  vector<T, Alloc>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>::fixed_vector(vector<T, Alloc, Growth> && obj) :
+  vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer + std::distance(obj.mBegin, obj.mEnd), N)
   {
     std::uninitialized_copy(std::make_move_iterator(obj.begin()),std::make_move_iterator(obj.end()), mBegin);
     obj.clear();
   }
 #endif
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>& fixed_vector<T, N, Alloc>::operator=(const fixed_vector<T, N, Alloc>& obj)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>& fixed_vector<T, N, Alloc, Growth>::operator=(const fixed_vector<T, N, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>& fixed_vector<T, N, Alloc>::operator=(const vector<T, Alloc>& obj)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>& fixed_vector<T, N, Alloc, Growth>::operator=(const vector<T, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
-  template<class T, size_t N, class Alloc>
-  inline fixed_vector<T, N, Alloc>& fixed_vector<T, N, Alloc>::operator=(std::initializer_list<value_type> il)
+  template<class T, size_t N, class Alloc, class Growth>
+  inline fixed_vector<T, N, Alloc, Growth>& fixed_vector<T, N, Alloc, Growth>::operator=(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
     return *this;
   }
 
 #ifdef FLEX_HAS_CXX11
-template<class T, size_t N, class Alloc>
-inline fixed_vector<T, N, Alloc>& fixed_vector<T, N, Alloc>::operator=(fixed_vector<T, N, Alloc>&& obj)
+template<class T, size_t N, class Alloc, class Growth>
+inline fixed_vector<T, N, Alloc, Growth>& fixed_vector<T, N, Alloc, Growth>::operator=(fixed_vector<T, N, Alloc, Growth>&& obj)
 {
   assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
   obj.clear();
   return *this;
 }
 
-template<class T, size_t N, class Alloc>
-inline fixed_vector<T, N, Alloc>& fixed_vector<T, N, Alloc>::operator=(vector<T, Alloc>&& obj)
+template<class T, size_t N, class Alloc, class Growth>
+inline fixed_vector<T, N, Alloc, Growth>& fixed_vector<T, N, Alloc, Growth>::operator=(vector<T, Alloc, Growth>&& obj)
 {
   assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
   obj.clear();
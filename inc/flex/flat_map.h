@@ -0,0 +1,607 @@
+#ifndef FLEX_FLAT_MAP_H
+#define FLEX_FLAT_MAP_H
+
+#include <flex/vector.h>
+#include <flex/internal/algorithm.h>
+#include <flex/internal/flat_map_iterator.h>
+#include <flex/internal/flat_merge.h>
+
+#include <utility>
+
+namespace flex
+{
+
+  //A flat_map is an ordered map stored as two parallel sorted arrays, one of keys and one of values.  Lookups
+  //binary search the key array alone, which packs more keys per cache line than a node-based tree or an
+  //array of pairs, and use branchless_lower_bound so their cost does not depend on branch prediction.
+  //Iteration walks both arrays linearly.  Inserting or erasing a single element shifts the elements after it,
+  //so building a map should be done with the range insert(), which sorts the new elements and merges them in
+  //one pass.
+  //
+  //The containers must store their elements contiguously with pointer iterators, such as vector, fixed_vector
+  //or small_vector.  Iterators and references are invalidated by every insertion and erasure.
+  template<class Key, class T, class Compare = std::less<Key>, class KeyContainer = vector<Key>,
+      class MappedContainer = vector<T> > class flat_map: public guarded_object
+  {
+  public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef KeyContainer key_container_type;
+    typedef MappedContainer mapped_container_type;
+    typedef flat_map_iterator<Key, T> iterator;
+    typedef flat_map_iterator<Key, T, const T*, const T&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    //Orders value_type objects by their keys.
+    struct value_compare
+    {
+      Compare mCompare;
+
+      value_compare(const Compare& comp) :
+          mCompare(comp)
+      {
+      }
+
+      bool operator()(const value_type& a, const value_type& b) const
+      {
+        return mCompare(a.first, b.first);
+      }
+    };
+
+    flat_map();
+    explicit flat_map(const Compare& comp);
+    template<typename InputIterator> flat_map(InputIterator first, InputIterator last, const Compare& comp = Compare());
+    flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    void clear();
+    size_type count(const Key& key) const;
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    std::pair<iterator, iterator> equal_range(const Key& key);
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const Key& key);
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    std::pair<iterator, bool> insert(const value_type& val);
+    template<typename InputIterator> void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> il);
+    key_compare key_comp() const;
+    const key_container_type& keys() const;
+    iterator lower_bound(const Key& key);
+    const_iterator lower_bound(const Key& key) const;
+    size_type max_size() const;
+    T& operator[](const Key& key);
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    void reserve(size_type n);
+    void shrink_to_fit();
+    size_type size() const;
+    void swap(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& obj);
+    iterator upper_bound(const Key& key);
+    const_iterator upper_bound(const Key& key) const;
+    value_compare value_comp() const;
+    mapped_container_type& values();
+    const mapped_container_type& values() const;
+
+  protected:
+    KeyContainer mKeys;
+    MappedContainer mValues;
+    Compare mCompare;
+
+    size_type LowerBound(const Key& key) const;
+    size_type UpperBound(const Key& key) const;
+    //Sorts the elements from n on and drops those whose key repeats.
+    void CompactTail(size_type n);
+    iterator MakeIterator(size_type n);
+    const_iterator MakeIterator(size_type n) const;
+
+    //Trims both containers back to mSize when destroyed, unless mMap has been cleared.
+    struct InsertRollback
+    {
+      flat_map* mMap;
+      size_type mSize;
+
+      InsertRollback(flat_map* map, size_type n) :
+          mMap(map), mSize(n)
+      {
+      }
+
+      ~InsertRollback()
+      {
+        if (mMap)
+        {
+          mMap->mKeys.erase(mMap->mKeys.begin() + mSize, mMap->mKeys.end());
+          mMap->mValues.erase(mMap->mValues.begin() + mSize, mMap->mValues.end());
+        }
+      }
+    };
+  };
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map() :
+      mKeys(), mValues(), mCompare()
+  {
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(const Compare& comp) :
+      mKeys(), mValues(), mCompare(comp)
+  {
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  template<typename InputIterator>
+  inline flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(InputIterator first, InputIterator last,
+      const Compare& comp) :
+      mKeys(), mValues(), mCompare(comp)
+  {
+    insert(first, last);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(std::initializer_list<value_type> il,
+      const Compare& comp) :
+      mKeys(), mValues(), mCompare(comp)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(const Key& key)
+  {
+    const size_type n = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((n == size()) || mCompare(key, mKeys[n]), "flex::flat_map.at() - key not found");
+    return mValues[n];
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline const T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(const Key& key) const
+  {
+    const size_type n = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((n == size()) || mCompare(key, mKeys[n]), "flex::flat_map.at() - key not found");
+    return mValues[n];
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::begin()
+  {
+    return MakeIterator(0);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::begin() const
+  {
+    return MakeIterator(0);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::cbegin() const
+  {
+    return MakeIterator(0);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::cend() const
+  {
+    return MakeIterator(size());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_reverse_iterator flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_reverse_iterator flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::clear()
+  {
+    mKeys.clear();
+    mValues.clear();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::count(const Key& key) const
+  {
+    const size_type n = LowerBound(key);
+    return ((n != size()) && !mCompare(key, mKeys[n])) ? 1 : 0;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline bool flat_map<Key, T, Compare, KeyContainer, MappedContainer>::empty() const
+  {
+    return mKeys.empty();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::end()
+  {
+    return MakeIterator(size());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::end() const
+  {
+    return MakeIterator(size());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator,
+      typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator> flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::equal_range(const Key& key)
+  {
+    const size_type n = LowerBound(key);
+    const size_type m = ((n != size()) && !mCompare(key, mKeys[n])) ? n + 1 : n;
+    return std::pair<iterator, iterator>(MakeIterator(n), MakeIterator(m));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator,
+      typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator> flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::equal_range(const Key& key) const
+  {
+    const size_type n = LowerBound(key);
+    const size_type m = ((n != size()) && !mCompare(key, mKeys[n])) ? n + 1 : n;
+    return std::pair<const_iterator, const_iterator>(MakeIterator(n), MakeIterator(m));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::erase(const_iterator position)
+  {
+    const size_type n = position.mKey - mKeys.begin();
+    mKeys.erase(mKeys.begin() + n);
+    mValues.erase(mValues.begin() + n);
+    return MakeIterator(n);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::erase(const_iterator first, const_iterator last)
+  {
+    const size_type n = first.mKey - mKeys.begin();
+    const size_type m = last.mKey - mKeys.begin();
+    mKeys.erase(mKeys.begin() + n, mKeys.begin() + m);
+    mValues.erase(mValues.begin() + n, mValues.begin() + m);
+    return MakeIterator(n);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::erase(const Key& key)
+  {
+    const size_type n = LowerBound(key);
+    if ((n != size()) && !mCompare(key, mKeys[n]))
+    {
+      mKeys.erase(mKeys.begin() + n);
+      mValues.erase(mValues.begin() + n);
+      return 1;
+    }
+    return 0;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::find(const Key& key)
+  {
+    const size_type n = LowerBound(key);
+    return ((n != size()) && !mCompare(key, mKeys[n])) ? MakeIterator(n) : end();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::find(const Key& key) const
+  {
+    const size_type n = LowerBound(key);
+    return ((n != size()) && !mCompare(key, mKeys[n])) ? MakeIterator(n) : end();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool> flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::insert(const value_type& val)
+  {
+    const size_type n = LowerBound(val.first);
+    if ((n != size()) && !mCompare(val.first, mKeys[n]))
+    {
+      return std::pair<iterator, bool>(MakeIterator(n), false);
+    }
+    mKeys.insert(mKeys.begin() + n, val.first);
+    mValues.insert(mValues.begin() + n, val.second);
+    return std::pair<iterator, bool>(MakeIterator(n), true);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  template<typename InputIterator>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert(InputIterator first, InputIterator last)
+  {
+    //Elements whose key is already in the map are skipped.  The rest are appended to the map's own containers,
+    //stably sorted there, stripped of repeated keys (the first occurrence wins, as with repeated single
+    //inserts), and then merged into place, so nothing is allocated beyond the containers' own growth.  The
+    //appended elements are also compacted whenever the keys fill their capacity, and later elements are checked
+    //against the compacted ones, so a fixed_flat_map only overflows if the distinct new keys don't fit.
+    const size_type n = size();
+    {
+      //If copying an element in throws, the appended elements are removed again, so the keys and values stay
+      //in step and the map is left as it was.
+      InsertRollback rollback(this, n);
+      size_type sorted = n;
+      for (; first != last; ++first)
+      {
+        if ((size() == mKeys.capacity()) && (size() != sorted))
+        {
+          CompactTail(n);
+          sorted = size();
+        }
+        if (std::binary_search(mKeys.begin(), mKeys.begin() + n, (*first).first, mCompare)
+            || std::binary_search(mKeys.begin() + n, mKeys.begin() + sorted, (*first).first, mCompare))
+        {
+          continue;
+        }
+        mKeys.push_back((*first).first);
+        mValues.push_back((*first).second);
+      }
+      CompactTail(n);
+      rollback.mMap = NULL;
+    }
+    if (size() != n)
+    {
+      flat_pairs<Key, T> pairs(&mKeys[0], &mValues[0]);
+      flat_merge(pairs, 0, n, size(), mCompare);
+    }
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::key_compare flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::key_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline const typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::key_container_type& flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::keys() const
+  {
+    return mKeys;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::lower_bound(const Key& key)
+  {
+    return MakeIterator(LowerBound(key));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::lower_bound(const Key& key) const
+  {
+    return MakeIterator(LowerBound(key));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::max_size() const
+  {
+    return mKeys.max_size();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::operator[](const Key& key)
+  {
+    const size_type n = LowerBound(key);
+    if ((n == size()) || mCompare(key, mKeys[n]))
+    {
+      mKeys.insert(mKeys.begin() + n, key);
+      mValues.insert(mValues.begin() + n, T());
+    }
+    return mValues[n];
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::reverse_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_reverse_iterator flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::reverse_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_reverse_iterator flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::reserve(size_type n)
+  {
+    mKeys.reserve(n);
+    mValues.reserve(n);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::shrink_to_fit()
+  {
+    mKeys.shrink_to_fit();
+    mValues.shrink_to_fit();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::size() const
+  {
+    return mKeys.size();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::swap(
+      flat_map<Key, T, Compare, KeyContainer, MappedContainer>& obj)
+  {
+    mKeys.swap(obj.mKeys);
+    mValues.swap(obj.mValues);
+    std::swap(mCompare, obj.mCompare);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::upper_bound(const Key& key)
+  {
+    return MakeIterator(UpperBound(key));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::upper_bound(const Key& key) const
+  {
+    return MakeIterator(UpperBound(key));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::value_compare flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::value_comp() const
+  {
+    return value_compare(mCompare);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::mapped_container_type& flat_map<Key, T,
+      Compare, KeyContainer, MappedContainer>::values()
+  {
+    return mValues;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline const typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::mapped_container_type& flat_map<Key,
+      T, Compare, KeyContainer, MappedContainer>::values() const
+  {
+    return mValues;
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::LowerBound(const Key& key) const
+  {
+    return flex::branchless_lower_bound(mKeys.begin(), mKeys.end(), key, mCompare) - mKeys.begin();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::UpperBound(const Key& key) const
+  {
+    return flex::branchless_upper_bound(mKeys.begin(), mKeys.end(), key, mCompare) - mKeys.begin();
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::CompactTail(size_type n)
+  {
+    if (size() == n)
+    {
+      return;
+    }
+
+    flat_pairs<Key, T> pairs(&mKeys[0], &mValues[0]);
+    flat_stable_sort(pairs, n, size(), mCompare);
+
+    size_type m = n;
+    for (size_type i = n; i < size(); ++i)
+    {
+      const Key& key = pairs.key(i);
+      if ((m != n) && !mCompare(pairs.key(m - 1), key))
+      {
+        continue;
+      }
+      if (m != i)
+      {
+        pairs.move(m, i);
+      }
+      ++m;
+    }
+    mKeys.erase(mKeys.begin() + m, mKeys.end());
+    mValues.erase(mValues.begin() + m, mValues.end());
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::MakeIterator(size_type n)
+  {
+    return iterator(mKeys.begin() + n, mValues.begin() + n);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare,
+      KeyContainer, MappedContainer>::MakeIterator(size_type n) const
+  {
+    return const_iterator(mKeys.begin() + n, mValues.begin() + n);
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline bool operator==(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+      const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs)
+  {
+    return ((lhs.size() == rhs.size()) && std::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin())
+        && std::equal(lhs.values().begin(), lhs.values().end(), rhs.values().begin()));
+  }
+
+  template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+  inline bool operator!=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+      const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FLAT_MAP_H */
@@ -0,0 +1,396 @@
+#ifndef FLEX_FLAT_SET_H
+#define FLEX_FLAT_SET_H
+
+#include <flex/vector.h>
+#include <flex/internal/algorithm.h>
+#include <flex/internal/flat_merge.h>
+
+#include <utility>
+
+namespace flex
+{
+
+  //A flat_set is an ordered set stored as a sorted array.  See flat_map for the trade-offs.  The container must
+  //store its elements contiguously with pointer iterators, such as vector, fixed_vector or small_vector.
+  template<class Key, class Compare = std::less<Key>, class Container = vector<Key> > class flat_set: public guarded_object
+  {
+  public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef Container container_type;
+    typedef const Key* iterator;
+    typedef const Key* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const Key& reference;
+    typedef const Key& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    flat_set();
+    explicit flat_set(const Compare& comp);
+    template<typename InputIterator> flat_set(InputIterator first, InputIterator last, const Compare& comp = Compare());
+    flat_set(std::initializer_list<value_type> il, const Compare& comp = Compare());
+
+    iterator begin() const;
+    iterator cbegin() const;
+    iterator cend() const;
+    reverse_iterator crbegin() const;
+    reverse_iterator crend() const;
+    void clear();
+    size_type count(const Key& key) const;
+    bool empty() const;
+    iterator end() const;
+    std::pair<iterator, iterator> equal_range(const Key& key) const;
+    iterator erase(iterator position);
+    iterator erase(iterator first, iterator last);
+    size_type erase(const Key& key);
+    iterator find(const Key& key) const;
+    std::pair<iterator, bool> insert(const value_type& val);
+    template<typename InputIterator> void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> il);
+    const container_type& keys() const;
+    key_compare key_comp() const;
+    iterator lower_bound(const Key& key) const;
+    size_type max_size() const;
+    reverse_iterator rbegin() const;
+    reverse_iterator rend() const;
+    void reserve(size_type n);
+    void shrink_to_fit();
+    size_type size() const;
+    void swap(flat_set<Key, Compare, Container>& obj);
+    iterator upper_bound(const Key& key) const;
+    value_compare value_comp() const;
+
+  protected:
+    Container mKeys;
+    Compare mCompare;
+
+    //Sorts the elements from n on and drops those whose key repeats.
+    void CompactTail(size_type n);
+
+    //Trims the container back to mSize when destroyed, unless mSet has been cleared.
+    struct InsertRollback
+    {
+      flat_set* mSet;
+      size_type mSize;
+
+      InsertRollback(flat_set* set, size_type n) :
+          mSet(set), mSize(n)
+      {
+      }
+
+      ~InsertRollback()
+      {
+        if (mSet)
+        {
+          mSet->mKeys.erase(mSet->mKeys.begin() + mSize, mSet->mKeys.end());
+        }
+      }
+    };
+  };
+
+  template<class Key, class Compare, class Container>
+  inline flat_set<Key, Compare, Container>::flat_set() :
+      mKeys(), mCompare()
+  {
+  }
+
+  template<class Key, class Compare, class Container>
+  inline flat_set<Key, Compare, Container>::flat_set(const Compare& comp) :
+      mKeys(), mCompare(comp)
+  {
+  }
+
+  template<class Key, class Compare, class Container>
+  template<typename InputIterator>
+  inline flat_set<Key, Compare, Container>::flat_set(InputIterator first, InputIterator last, const Compare& comp) :
+      mKeys(), mCompare(comp)
+  {
+    insert(first, last);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline flat_set<Key, Compare, Container>::flat_set(std::initializer_list<value_type> il, const Compare& comp) :
+      mKeys(), mCompare(comp)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::begin() const
+  {
+    return mKeys.begin();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::cbegin() const
+  {
+    return mKeys.begin();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::cend() const
+  {
+    return mKeys.end();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::reverse_iterator flat_set<Key, Compare, Container>::crbegin() const
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::reverse_iterator flat_set<Key, Compare, Container>::crend() const
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::clear()
+  {
+    mKeys.clear();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::size_type flat_set<Key, Compare, Container>::count(
+      const Key& key) const
+  {
+    iterator it = lower_bound(key);
+    return ((it != end()) && !mCompare(key, *it)) ? 1 : 0;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline bool flat_set<Key, Compare, Container>::empty() const
+  {
+    return mKeys.empty();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::end() const
+  {
+    return mKeys.end();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline std::pair<typename flat_set<Key, Compare, Container>::iterator,
+      typename flat_set<Key, Compare, Container>::iterator> flat_set<Key, Compare, Container>::equal_range(
+      const Key& key) const
+  {
+    iterator it = lower_bound(key);
+    iterator last = ((it != end()) && !mCompare(key, *it)) ? it + 1 : it;
+    return std::pair<iterator, iterator>(it, last);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::erase(
+      iterator position)
+  {
+    const size_type n = position - mKeys.begin();
+    mKeys.erase(mKeys.begin() + n);
+    return mKeys.begin() + n;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::erase(iterator first,
+      iterator last)
+  {
+    const size_type n = first - mKeys.begin();
+    mKeys.erase(mKeys.begin() + n, mKeys.begin() + (last - mKeys.begin()));
+    return mKeys.begin() + n;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::size_type flat_set<Key, Compare, Container>::erase(const Key& key)
+  {
+    iterator it = lower_bound(key);
+    if ((it != end()) && !mCompare(key, *it))
+    {
+      erase(it);
+      return 1;
+    }
+    return 0;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::find(
+      const Key& key) const
+  {
+    iterator it = lower_bound(key);
+    return ((it != end()) && !mCompare(key, *it)) ? it : end();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline std::pair<typename flat_set<Key, Compare, Container>::iterator, bool> flat_set<Key, Compare, Container>::insert(
+      const value_type& val)
+  {
+    const size_type n = lower_bound(val) - mKeys.begin();
+    if ((n != size()) && !mCompare(val, mKeys[n]))
+    {
+      return std::pair<iterator, bool>(mKeys.begin() + n, false);
+    }
+    mKeys.insert(mKeys.begin() + n, val);
+    return std::pair<iterator, bool>(mKeys.begin() + n, true);
+  }
+
+  template<class Key, class Compare, class Container>
+  template<typename InputIterator>
+  inline void flat_set<Key, Compare, Container>::insert(InputIterator first, InputIterator last)
+  {
+    //Keys already in the set are skipped.  The rest are appended to the set's own container, sorted there,
+    //stripped of repeats, and merged into place.  See flat_map::insert().
+    const size_type n = size();
+    {
+      InsertRollback rollback(this, n);
+      size_type sorted = n;
+      for (; first != last; ++first)
+      {
+        if ((size() == mKeys.capacity()) && (size() != sorted))
+        {
+          CompactTail(n);
+          sorted = size();
+        }
+        if (std::binary_search(mKeys.begin(), mKeys.begin() + n, *first, mCompare)
+            || std::binary_search(mKeys.begin() + n, mKeys.begin() + sorted, *first, mCompare))
+        {
+          continue;
+        }
+        mKeys.push_back(*first);
+      }
+      CompactTail(n);
+      rollback.mSet = NULL;
+    }
+    if (size() != n)
+    {
+      flat_keys<Key> keys(&mKeys[0]);
+      flat_merge(keys, 0, n, size(), mCompare);
+    }
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline const typename flat_set<Key, Compare, Container>::container_type& flat_set<Key, Compare, Container>::keys() const
+  {
+    return mKeys;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::key_compare flat_set<Key, Compare, Container>::key_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::lower_bound(
+      const Key& key) const
+  {
+    return flex::branchless_lower_bound(mKeys.begin(), mKeys.end(), key, mCompare);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::size_type flat_set<Key, Compare, Container>::max_size() const
+  {
+    return mKeys.max_size();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::reverse_iterator flat_set<Key, Compare, Container>::rbegin() const
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::reverse_iterator flat_set<Key, Compare, Container>::rend() const
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::reserve(size_type n)
+  {
+    mKeys.reserve(n);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::shrink_to_fit()
+  {
+    mKeys.shrink_to_fit();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::size_type flat_set<Key, Compare, Container>::size() const
+  {
+    return mKeys.size();
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::swap(flat_set<Key, Compare, Container>& obj)
+  {
+    mKeys.swap(obj.mKeys);
+    std::swap(mCompare, obj.mCompare);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::iterator flat_set<Key, Compare, Container>::upper_bound(
+      const Key& key) const
+  {
+    return flex::branchless_upper_bound(mKeys.begin(), mKeys.end(), key, mCompare);
+  }
+
+  template<class Key, class Compare, class Container>
+  inline typename flat_set<Key, Compare, Container>::value_compare flat_set<Key, Compare, Container>::value_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class Key, class Compare, class Container>
+  inline void flat_set<Key, Compare, Container>::CompactTail(size_type n)
+  {
+    if (size() == n)
+    {
+      return;
+    }
+
+    flat_keys<Key> keys(&mKeys[0]);
+    flat_stable_sort(keys, n, size(), mCompare);
+
+    size_type m = n;
+    for (size_type i = n; i < size(); ++i)
+    {
+      const Key& key = keys.key(i);
+      if ((m != n) && !mCompare(keys.key(m - 1), key))
+      {
+        continue;
+      }
+      if (m != i)
+      {
+        keys.move(m, i);
+      }
+      ++m;
+    }
+    mKeys.erase(mKeys.begin() + m, mKeys.end());
+  }
+
+  template<class Key, class Compare, class Container>
+  inline bool operator==(const flat_set<Key, Compare, Container>& lhs, const flat_set<Key, Compare, Container>& rhs)
+  {
+    return ((lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+
+  template<class Key, class Compare, class Container>
+  inline bool operator!=(const flat_set<Key, Compare, Container>& lhs, const flat_set<Key, Compare, Container>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_FLAT_SET_H */
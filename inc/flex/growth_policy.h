@@ -0,0 +1,135 @@
+#ifndef FLEX_GROWTH_POLICY_H
+#define FLEX_GROWTH_POLICY_H
+
+#include <flex/config.h>
+
+#include <stddef.h>
+
+#ifdef FLEX_USE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+//The page size used by page_growth when none is given.
+#ifndef FLEX_PAGE_SIZE
+#define FLEX_PAGE_SIZE 4096
+#endif
+
+//The page size used by hugepage_growth.  It matches the size used by hugepage_allocator.
+#ifndef FLEX_HUGEPAGE_SIZE
+#define FLEX_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+namespace flex
+{
+
+  //Returns the number of bytes the allocator will actually hand out for a request of n bytes.  Growth
+  //policies use it to size a container so that it fills its allocation, rather than leaving the slack of
+  //the allocator's size class unused.  When FLEX_USE_JEMALLOC is defined, jemalloc is asked directly through
+  //nallocx().  Otherwise the size is rounded to jemalloc's size classes (16 byte steps up to 128, then four
+  //classes per power of two), which is also a good fit for tcmalloc and similar allocators.
+  //Allocators with their own size classes may provide an overload taking the allocator type.
+  template<class Alloc>
+  inline size_t good_size(const Alloc&, size_t n)
+  {
+#ifdef FLEX_USE_JEMALLOC
+    return n ? nallocx(n, 0) : 0;
+#else
+    if (n <= 8)
+    {
+      return 8;
+    }
+    else if (n <= 128)
+    {
+      return (n + 15) & ~(size_t) 15;
+    }
+    else
+    {
+      size_t lg = 0;
+      for (size_t x = n - 1; x > 1; x >>= 1)
+      {
+        ++lg;
+      }
+      const size_t delta = (size_t) 1 << (lg - 2);
+      return (n + delta - 1) & ~(delta - 1);
+    }
+#endif
+  }
+
+  /*
+   * Growth policies decide the capacity of vector, ring and basic_string when they run out of room.  A policy
+   * is a type with a single static function:
+   *
+   *    template<class Alloc>
+   *    static size_t new_capacity(size_t capacity, size_t min_size, size_t elem_size, size_t overhead, const Alloc& alloc);
+   *
+   * It returns the new capacity, which must be at least min_size.  capacity is the current capacity and
+   * elem_size the size of an element.  overhead is the number of elements the container allocates past its
+   * capacity (one for the unused slot of a ring and the trailing 0 of a string), so a policy that rounds the
+   * allocation can account for it.
+   */
+
+  //Grows the capacity by the factor Num/Den, and by at least one element.
+  template<size_t Num, size_t Den>
+  struct factor_growth
+  {
+    template<class Alloc>
+    static size_t new_capacity(size_t capacity, size_t min_size, size_t, size_t, const Alloc&)
+    {
+      size_t new_capacity = (capacity > 0) ? (capacity * Num / Den) : 1;
+      if (new_capacity <= capacity)
+      {
+        new_capacity = capacity + 1;
+      }
+      return (new_capacity < min_size) ? min_size : new_capacity;
+    }
+  };
+
+  //The default policy.  Doubling keeps the amortized cost of growth low, at the price of up to half of a
+  //large allocation being unused.
+  typedef factor_growth<2, 1> double_growth;
+
+  //Grows by 1.5x.  This wastes less memory on large containers and lets a sequence of reallocations reuse
+  //previously freed blocks, at the cost of reallocating more often.
+  typedef factor_growth<3, 2> one_and_half_growth;
+
+  //Applies the Base policy, then rounds allocations of at least a page up to a multiple of PageSize.  Memory
+  //that would be wasted in the last page is handed to the container as extra capacity instead.
+  template<class Base = double_growth, size_t PageSize = FLEX_PAGE_SIZE>
+  struct page_growth
+  {
+    template<class Alloc>
+    static size_t new_capacity(size_t capacity, size_t min_size, size_t elem_size, size_t overhead, const Alloc& alloc)
+    {
+      size_t new_capacity = Base::new_capacity(capacity, min_size, elem_size, overhead, alloc);
+      size_t bytes = (new_capacity + overhead) * elem_size;
+      if (bytes >= PageSize)
+      {
+        bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+        new_capacity = (bytes / elem_size) - overhead;
+      }
+      return new_capacity;
+    }
+  };
+
+  //Page rounding for containers backed by huge pages, such as those using hugepage_allocator.
+  template<class Base = double_growth>
+  struct hugepage_growth: page_growth<Base, FLEX_HUGEPAGE_SIZE>
+  {
+  };
+
+  //Applies the Base policy, then grows the capacity to fill the allocator's size class (see good_size).
+  template<class Base = double_growth>
+  struct size_class_growth
+  {
+    template<class Alloc>
+    static size_t new_capacity(size_t capacity, size_t min_size, size_t elem_size, size_t overhead, const Alloc& alloc)
+    {
+      size_t new_capacity = Base::new_capacity(capacity, min_size, elem_size, overhead, alloc);
+      size_t bytes = good_size(alloc, (new_capacity + overhead) * elem_size);
+      return (bytes / elem_size) - overhead;
+    }
+  };
+
+} //namespace flex
+
+#endif /* FLEX_GROWTH_POLICY_H */
@@ -0,0 +1,312 @@
+#ifndef FLEX_HUGEPAGE_ALLOCATOR_H
+#define FLEX_HUGEPAGE_ALLOCATOR_H
+
+#include <cerrno>//For errno saved around the huge page attempts in allocate()
+#include <limits>//For std::numeric_limits used in max_size()
+#include <memory>//For std::allocator<void> used in allocate()
+
+#include <flex/allocation_guard.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//Allocations are rounded up to a multiple of the huge page size, which is also the granularity used by the
+//transparent huge page fallback.
+#ifndef FLEX_HUGEPAGE_SIZE
+#define FLEX_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+namespace flex
+{
+
+  //Options for hugepage_allocator.  They are template arguments rather than constructor arguments because
+  //containers always default construct their allocator.
+  enum hugepage_flags
+  {
+    hugepage_default = 0,
+    //Pre-fault every page when the memory is mapped, so first touch never page faults.  Reserved huge pages
+    //are mapped with MAP_POPULATE and transparent huge pages are touched once the mapping is advised.
+    hugepage_populate = 1,
+    //Lock the pages into memory with mlock(), so they are never swapped out.
+    hugepage_lock = 2
+  };
+
+  //Touch every page in the range so the kernel faults it in now rather than on first use.  This is useful
+  //for warming up large fixed containers that live in static storage, where no allocator is involved.
+  inline void touch_pages(void* ptr, size_t n)
+  {
+    volatile char* first = (volatile char*) ptr;
+    volatile char* last = first + n;
+    size_t page_size = 4096;
+#if defined(__linux__)
+    page_size = sysconf(_SC_PAGESIZE);
+#endif
+    for (volatile char* it = first; it < last; it += page_size)
+    {
+      //Write the byte back so anonymous memory is backed by a real page rather than the shared zero page.
+      *it = *it;
+    }
+    if (n)
+    {
+      *(last - 1) = *(last - 1);
+    }
+  }
+
+  //Lock the pages of the range into memory.  Returns false (and reports the error) if the lock failed,
+  //typically because it exceeds RLIMIT_MEMLOCK.
+  inline bool lock_pages(void* ptr, size_t n)
+  {
+#if defined(__linux__)
+    if (mlock(ptr, n) != 0)
+    {
+      flex::error_msg("flex::lock_pages: mlock failed");
+      return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  //An allocator that backs each allocation with its own huge page mapping.  The mapping is requested with
+  //MAP_HUGETLB first, which requires huge pages to be reserved by the system (vm.nr_hugepages).  If that
+  //fails, a regular mapping aligned to FLEX_HUGEPAGE_SIZE is made and the kernel is asked to back it with
+  //transparent huge pages through madvise(MADV_HUGEPAGE).  Since every allocation is rounded up to a huge
+  //page, this allocator is meant for containers that make a few large allocations, such as a vector or ring
+  //that is reserved up front, the bucket array of a hash_map, or the storage of a large fixed container
+  //itself (see hugepage_new).  On platforms other than Linux it falls back to operator new.
+  template<class T, int Flags = hugepage_default> class hugepage_allocator: public guarded_object
+  {
+  public:
+    // type definitions
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // rebind allocator to type U
+    template<class U>
+    struct rebind
+    {
+      typedef hugepage_allocator<U, Flags> other;
+    };
+
+    // return address of values
+    pointer address(reference value) const
+    {
+      return &value;
+    }
+    const_pointer address(const_reference value) const
+    {
+      return &value;
+    }
+
+    /* constructors and destructor
+     * - nothing to do because the allocator has no state
+     */
+    inline hugepage_allocator()
+    {
+    }
+
+    inline hugepage_allocator(const hugepage_allocator&)
+    {
+    }
+
+    template<class U>
+    inline hugepage_allocator(const hugepage_allocator<U, Flags>&)
+    {
+    }
+
+    inline ~hugepage_allocator()
+    {
+    }
+
+    // return maximum number of elements that can be allocated
+    inline size_type max_size() const
+    {
+      return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    // allocate but don't initialize num elements of type T
+    inline pointer allocate(size_type num, typename std::allocator<void>::const_pointer = 0)
+    {
+      FLEX_ERROR_MSG_IF(sAllocationGuardEnabled, "flex::hugepage_allocator: performed allocation when guard was enabled");
+#if defined(__linux__)
+      size_type n = GetMappingSize(num);
+      if (n == 0)
+      {
+        return NULL;
+      }
+
+      //The huge page attempts are allowed to fail, so do not let them leak into errno.
+      int saved_errno = errno;
+      void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_POPULATE
+      if (Flags & hugepage_populate)
+      {
+        flags |= MAP_POPULATE;
+      }
+#endif
+      ptr = mmap(NULL, n, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+      if (ptr == MAP_FAILED)
+      {
+        //No huge pages are reserved.  Fall back to transparent huge pages.
+        ptr = MapTransparent(n);
+      }
+      errno = saved_errno;
+
+      if (Flags & hugepage_lock)
+      {
+        lock_pages(ptr, n);
+      }
+      return reinterpret_cast<pointer>(ptr);
+#else
+      return reinterpret_cast<pointer>(::operator new(num * sizeof(T)));
+#endif
+    }
+
+#ifdef FLEX_HAS_CXX11
+    template<class...Args>
+    inline void construct(pointer p, Args&&... args)
+    {
+      // initialize memory with placement new
+      new ((void*) p) T(std::forward<Args>(args)...);
+    }
+#else
+    // initialize elements of allocated storage p with value value
+    inline void construct(pointer p, const T& value)
+    {
+      // initialize memory with placement new
+      new ((void*) p) T(value);
+    }
+#endif
+
+    // destroy elements of initialized storage p
+    inline void destroy(pointer p)
+    {
+      // destroy objects by calling their destructor
+      p->~T();
+    }
+
+    // deallocate storage p of deleted elements
+    inline void deallocate(pointer p, size_type num)
+    {
+#if defined(__linux__)
+      //Unmapping the memory also releases any lock that was placed on it.
+      if (p)
+      {
+        munmap((void*) p, GetMappingSize(num));
+      }
+#else
+      ::operator delete((void*) p);
+#endif
+    }
+
+  private:
+    static size_type GetMappingSize(size_type num)
+    {
+      size_type n = num * sizeof(T);
+      return (n + FLEX_HUGEPAGE_SIZE - 1) & ~((size_type) FLEX_HUGEPAGE_SIZE - 1);
+    }
+
+#if defined(__linux__)
+    static void* MapTransparent(size_type n)
+    {
+      //The kernel only backs whole, aligned huge pages with transparent huge pages, so map an extra huge page
+      //and trim the mapping down to n bytes starting on a huge page boundary.
+      char* first = (char*) mmap(NULL, n + FLEX_HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+          -1, 0);
+      if (first == MAP_FAILED)
+      {
+        flex::throw_bad_alloc();
+      }
+      char* last = first + n + FLEX_HUGEPAGE_SIZE;
+      char* ptr = (char*) (((size_t) first + FLEX_HUGEPAGE_SIZE - 1) & ~((size_t) FLEX_HUGEPAGE_SIZE - 1));
+      if (ptr != first)
+      {
+        munmap(first, ptr - first);
+      }
+      if (ptr + n != last)
+      {
+        munmap(ptr + n, last - (ptr + n));
+      }
+#ifdef MADV_HUGEPAGE
+      madvise(ptr, n, MADV_HUGEPAGE);
+#endif
+      //MAP_POPULATE would fault the pages in as regular pages before the madvise() above takes effect, so the
+      //pages are touched afterwards instead.
+      if (Flags & hugepage_populate)
+      {
+        touch_pages(ptr, n);
+      }
+      return ptr;
+    }
+#endif
+  };
+
+  // return that all specializations of this allocator are interchangeable
+  template<class T1, int F1, class T2, int F2>
+  bool operator==(const hugepage_allocator<T1, F1>&, const hugepage_allocator<T2, F2>&)
+  {
+    return true;
+  }
+
+  template<class T1, int F1, class T2, int F2>
+  bool operator!=(const hugepage_allocator<T1, F1>&, const hugepage_allocator<T2, F2>&)
+  {
+    return false;
+  }
+
+  //Construct an object (typically a large fixed container) in huge page backed memory.  The container's
+  //own buffer is part of the object, so it ends up on huge pages as well.  Release it with hugepage_delete.
+#ifdef FLEX_HAS_CXX11
+  template<class T, int Flags = hugepage_default, class...Args>
+  inline T* hugepage_new(Args&&... args)
+  {
+    hugepage_allocator<T, Flags> alloc;
+    T* ptr = alloc.allocate(1);
+    ::new ((void*) ptr) T(std::forward<Args>(args)...);
+    return ptr;
+  }
+#else
+  template<class T>
+  inline T* hugepage_new()
+  {
+    hugepage_allocator<T> alloc;
+    T* ptr = alloc.allocate(1);
+    ::new ((void*) ptr) T();
+    return ptr;
+  }
+
+  template<class T, int Flags>
+  inline T* hugepage_new()
+  {
+    hugepage_allocator<T, Flags> alloc;
+    T* ptr = alloc.allocate(1);
+    ::new ((void*) ptr) T();
+    return ptr;
+  }
+#endif
+
+  template<class T>
+  inline void hugepage_delete(T* ptr)
+  {
+    if (ptr)
+    {
+      hugepage_allocator<T> alloc;
+      ptr->~T();
+      alloc.deallocate(ptr, 1);
+    }
+  }
+
+} //namespace flex
+
+#endif /* FLEX_HUGEPAGE_ALLOCATOR_H */
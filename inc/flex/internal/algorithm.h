@@ -2,6 +2,7 @@
 #define FLEX_INTERNAL_ALGORITHM_H
 
 #include <algorithm>
+#include <functional>
 
 #ifndef FLEX_HAS_CXX11
 namespace std
@@ -46,4 +47,69 @@ namespace std
 
 #endif //FLEX_HAS_CXX11
 
+namespace flex
+{
+
+  /// branchless_lower_bound
+  ///
+  /// Equivalent to std::lower_bound over a random access range.  The search halves the range a fixed number
+  /// of times and selects the next half with a conditional move rather than a branch, so it does not suffer
+  /// the branch mispredictions of std::lower_bound on unpredictable keys.
+  ///
+  template<typename RandomAccessIterator, typename T, typename Compare>
+  inline RandomAccessIterator branchless_lower_bound(RandomAccessIterator first, RandomAccessIterator last,
+      const T& value, Compare comp)
+  {
+    size_t n = last - first;
+    if (n == 0)
+    {
+      return first;
+    }
+    while (n > 1)
+    {
+      const size_t half = n / 2;
+      first = comp(first[half], value) ? first + half : first;
+      n -= half;
+    }
+    return first + (comp(*first, value) ? 1 : 0);
+  }
+
+  template<typename RandomAccessIterator, typename T>
+  inline RandomAccessIterator branchless_lower_bound(RandomAccessIterator first, RandomAccessIterator last,
+      const T& value)
+  {
+    return branchless_lower_bound(first, last, value, std::less<T>());
+  }
+
+  /// branchless_upper_bound
+  ///
+  /// Equivalent to std::upper_bound.  See branchless_lower_bound.
+  ///
+  template<typename RandomAccessIterator, typename T, typename Compare>
+  inline RandomAccessIterator branchless_upper_bound(RandomAccessIterator first, RandomAccessIterator last,
+      const T& value, Compare comp)
+  {
+    size_t n = last - first;
+    if (n == 0)
+    {
+      return first;
+    }
+    while (n > 1)
+    {
+      const size_t half = n / 2;
+      first = comp(value, first[half]) ? first : first + half;
+      n -= half;
+    }
+    return first + (comp(value, *first) ? 0 : 1);
+  }
+
+  template<typename RandomAccessIterator, typename T>
+  inline RandomAccessIterator branchless_upper_bound(RandomAccessIterator first, RandomAccessIterator last,
+      const T& value)
+  {
+    return branchless_upper_bound(first, last, value, std::less<T>());
+  }
+
+}  //namespace flex
+
 #endif //FLEX_INTERNAL_ALGORITHM_H
@@ -0,0 +1,193 @@
+#ifndef FLEX_INTERNAL_BTREE_MAP_ITERATOR_H
+#define FLEX_INTERNAL_BTREE_MAP_ITERATOR_H
+
+#include <flex/config.h>
+#include <flex/internal/flat_map_iterator.h>
+
+#include <iterator>
+
+namespace flex
+{
+
+  //Uninitialized storage for N objects of type T.  A btree_map node constructs only the first mCount of them.
+  template<class T, size_t N> struct btree_array
+  {
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(T)];
+      long double dummy;
+    };
+#endif
+
+    T* data()
+    {
+      return (T*) mBuffer;
+    }
+
+    const T* data() const
+    {
+      return (const T*) mBuffer;
+    }
+  };
+
+  //The part of a btree_map node shared by leaves and internal nodes.
+  struct btree_node_base
+  {
+    btree_node_base* mParent;
+    unsigned short mCount; //Keys held by the node.
+    unsigned short mPosition; //Index of the node among its parent's children.
+    bool mLeaf;
+  };
+
+  //A leaf holds up to N elements, with the keys in one array so a search reads as few cache lines as
+  //possible, and the mapped values in another.  Leaves are linked in key order.
+  template<class Key, class T, size_t N> struct btree_leaf: public btree_node_base
+  {
+    btree_leaf* mPrev;
+    btree_leaf* mNext;
+    btree_array<Key, N> mKeys;
+    btree_array<T, N> mValues;
+  };
+
+  //An internal node holds up to N separating keys and one more child than keys.  Every key in mChildren[i]
+  //is less than or equal to mKeys[i], and every key in mChildren[i + 1] is greater.
+  template<class Key, size_t N> struct btree_internal: public btree_node_base
+  {
+    btree_array<Key, N> mKeys;
+    btree_node_base* mChildren[N + 1];
+  };
+
+  //Iterator over a btree_map.  It holds a leaf and an index into it, and steps to the neighbouring leaf at
+  //either end.  end() is one past the last element of the last leaf.  Like flat_map_iterator, dereferencing
+  //yields a pair of references to the key and the value.
+  template<class Key, class T, size_t N, class ValuePointer = T*, class ValueReference = T&>
+  struct btree_map_iterator
+  {
+    typedef btree_map_iterator<Key, T, N, ValuePointer, ValueReference> this_type;
+    typedef btree_map_iterator<Key, T, N, T*, T&> iterator;
+    typedef btree_leaf<Key, T, N> leaf_type;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef std::pair<Key, T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef flat_map_reference<Key, ValueReference> reference;
+    typedef typename flat_map_iterator<Key, T, ValuePointer, ValueReference>::pointer pointer;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    leaf_type* mLeaf;
+    size_t mIndex;
+
+    btree_map_iterator();
+    btree_map_iterator(const leaf_type* leaf, size_t index);
+    btree_map_iterator(const iterator& x);
+
+    this_type& operator++();
+    this_type operator++(int);
+    this_type& operator--();
+    this_type operator--(int);
+
+    reference operator*() const;
+    pointer operator->() const;
+  };
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference>::btree_map_iterator() :
+      mLeaf(NULL), mIndex(0)
+  {
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference>::btree_map_iterator(const leaf_type* leaf,
+      size_t index) :
+      mLeaf(const_cast<leaf_type*>(leaf)), mIndex(index)
+  {
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference>::btree_map_iterator(const iterator& x) :
+      mLeaf(x.mLeaf), mIndex(x.mIndex)
+  {
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference>& btree_map_iterator<Key, T, N, ValuePointer,
+      ValueReference>::operator++()
+  {
+    if ((++mIndex == mLeaf->mCount) && mLeaf->mNext)
+    {
+      mLeaf = mLeaf->mNext;
+      mIndex = 0;
+    }
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference> btree_map_iterator<Key, T, N, ValuePointer,
+      ValueReference>::operator++(int)
+  {
+    this_type tmp(*this);
+    operator++();
+    return tmp;
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference>& btree_map_iterator<Key, T, N, ValuePointer,
+      ValueReference>::operator--()
+  {
+    if (mIndex == 0)
+    {
+      mLeaf = mLeaf->mPrev;
+      mIndex = mLeaf->mCount;
+    }
+    --mIndex;
+    return *this;
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline btree_map_iterator<Key, T, N, ValuePointer, ValueReference> btree_map_iterator<Key, T, N, ValuePointer,
+      ValueReference>::operator--(int)
+  {
+    this_type tmp(*this);
+    operator--();
+    return tmp;
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline typename btree_map_iterator<Key, T, N, ValuePointer, ValueReference>::reference btree_map_iterator<Key, T, N,
+      ValuePointer, ValueReference>::operator*() const
+  {
+    return reference(mLeaf->mKeys.data()[mIndex], mLeaf->mValues.data()[mIndex]);
+  }
+
+  template<class Key, class T, size_t N, class ValuePointer, class ValueReference>
+  inline typename btree_map_iterator<Key, T, N, ValuePointer, ValueReference>::pointer btree_map_iterator<Key, T, N,
+      ValuePointer, ValueReference>::operator->() const
+  {
+    return pointer(operator*());
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+  template<typename Key, typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB,
+      typename ReferenceB>
+  inline bool operator==(const btree_map_iterator<Key, T, N, PointerA, ReferenceA>& a,
+      const btree_map_iterator<Key, T, N, PointerB, ReferenceB>& b)
+  {
+    return (a.mLeaf == b.mLeaf) && (a.mIndex == b.mIndex);
+  }
+
+  template<typename Key, typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB,
+      typename ReferenceB>
+  inline bool operator!=(const btree_map_iterator<Key, T, N, PointerA, ReferenceA>& a,
+      const btree_map_iterator<Key, T, N, PointerB, ReferenceB>& b)
+  {
+    return (a.mLeaf != b.mLeaf) || (a.mIndex != b.mIndex);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_BTREE_MAP_ITERATOR_H */
@@ -0,0 +1,153 @@
+#ifndef FLEX_INTERNAL_COMPACT_LIST_ITERATOR_H
+#define FLEX_INTERNAL_COMPACT_LIST_ITERATOR_H
+
+#include <flex/config.h>
+
+#include <iterator>
+#include <stdint.h>
+
+namespace flex
+{
+
+  //Selects the narrowest index type able to address N nodes plus the anchor, which is stored at index N.
+  template<size_t N, bool Small = (N < 0xFFFF)> struct compact_list_index
+  {
+    typedef uint16_t type;
+  };
+
+  template<size_t N> struct compact_list_index<N, false>
+  {
+    typedef uint32_t type;
+  };
+
+  //A node of a compact_fixed_list.  The links are indices into the list's node buffer rather than pointers, so a
+  //node of a small T is a fraction of the size of a list_node<T>.
+  template<typename T, typename Index>
+  struct compact_list_node
+  {
+    Index mPrev;
+    Index mNext;
+    T mValue;
+  };
+
+  template<typename T, typename Index, typename Pointer = T*, typename Reference = T&>
+  struct compact_list_iterator
+  {
+    typedef compact_list_iterator<T, Index, Pointer, Reference> this_type;
+    typedef compact_list_iterator<T, Index, T*, T&> iterator;
+    typedef compact_list_node<T, Index> node_type;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+  public:
+    node_type* mNodes;
+    Index mIndex;
+
+  public:
+    compact_list_iterator();
+    compact_list_iterator(const node_type* nodes, Index index);
+    compact_list_iterator(const iterator& x);
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    this_type& operator++();
+    this_type operator++(int);
+
+    this_type& operator--();
+    this_type operator--(int);
+  };
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline compact_list_iterator<T, Index, Pointer, Reference>::compact_list_iterator() :
+      mNodes(), mIndex()
+  {
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline compact_list_iterator<T, Index, Pointer, Reference>::compact_list_iterator(const node_type* nodes,
+      Index index) :
+      mNodes(const_cast<node_type*>(nodes)), mIndex(index)
+  {
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline compact_list_iterator<T, Index, Pointer, Reference>::compact_list_iterator(const iterator& x) :
+      mNodes(x.mNodes), mIndex(x.mIndex)
+  {
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::reference compact_list_iterator<T, Index,
+      Pointer, Reference>::operator*() const
+  {
+    return mNodes[mIndex].mValue;
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::pointer compact_list_iterator<T, Index,
+      Pointer, Reference>::operator->() const
+  {
+    return &mNodes[mIndex].mValue;
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::this_type&
+  compact_list_iterator<T, Index, Pointer, Reference>::operator++()
+  {
+    mIndex = mNodes[mIndex].mNext;
+    return *this;
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::this_type compact_list_iterator<T, Index,
+      Pointer, Reference>::operator++(int)
+  {
+    this_type temp(*this);
+    mIndex = mNodes[mIndex].mNext;
+    return temp;
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::this_type&
+  compact_list_iterator<T, Index, Pointer, Reference>::operator--()
+  {
+    mIndex = mNodes[mIndex].mPrev;
+    return *this;
+  }
+
+  template<typename T, typename Index, typename Pointer, typename Reference>
+  inline typename compact_list_iterator<T, Index, Pointer, Reference>::this_type compact_list_iterator<T, Index,
+      Pointer, Reference>::operator--(int)
+  {
+    this_type temp(*this);
+    mIndex = mNodes[mIndex].mPrev;
+    return temp;
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+
+  template<typename T, typename Index, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const compact_list_iterator<T, Index, PointerA, ReferenceA>& a,
+      const compact_list_iterator<T, Index, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex == b.mIndex;
+  }
+
+  template<typename T, typename Index, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const compact_list_iterator<T, Index, PointerA, ReferenceA>& a,
+      const compact_list_iterator<T, Index, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex != b.mIndex;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_COMPACT_LIST_ITERATOR_H */
@@ -0,0 +1,221 @@
+#ifndef FLEX_INTERNAL_FLAT_MAP_ITERATOR_H
+#define FLEX_INTERNAL_FLAT_MAP_ITERATOR_H
+
+#include <iterator>
+#include <utility>
+
+namespace flex
+{
+
+  //The element of a flat_map as seen through its iterator: a pair of references to the key and the value,
+  //which live in separate arrays.  It converts to the map's value_type.
+  template<class Key, class ValueReference> struct flat_map_reference
+  {
+    const Key& first;
+    ValueReference second;
+
+    flat_map_reference(const Key& key, ValueReference value) :
+        first(key), second(value)
+    {
+    }
+
+    template<class T>
+    operator std::pair<Key, T>() const
+    {
+      return std::pair<Key, T>(first, second);
+    }
+  };
+
+  //Iterator over a flat_map.  The keys and values are held in separate arrays, so the iterator keeps a
+  //pointer into each.  Dereferencing yields a flat_map_reference by value.  operator-> returns a small proxy
+  //holding that reference so it->first and it->second work.
+  template<class Key, class T, class ValuePointer = T*, class ValueReference = T&> struct flat_map_iterator
+  {
+    typedef flat_map_iterator<Key, T, ValuePointer, ValueReference> this_type;
+    typedef flat_map_iterator<Key, T, T*, T&> iterator;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef std::pair<Key, T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef flat_map_reference<Key, ValueReference> reference;
+    typedef std::random_access_iterator_tag iterator_category; //Dereferencing returns a proxy, so this is only
+                                                               //a random access iterator for read-only algorithms.
+    typedef size_t size_type;
+
+    struct pointer
+    {
+      reference mRef;
+
+      pointer(const reference& ref) :
+          mRef(ref)
+      {
+      }
+
+      const reference* operator->() const
+      {
+        return &mRef;
+      }
+    };
+
+    const Key* mKey;
+    ValuePointer mValue;
+
+    flat_map_iterator();
+    flat_map_iterator(const Key* key, ValuePointer value);
+    flat_map_iterator(const iterator& x);
+
+    this_type& operator++();
+    this_type operator++(int);
+    this_type& operator--();
+    this_type operator--(int);
+    this_type operator+(difference_type n) const;
+    this_type operator-(difference_type n) const;
+    difference_type operator-(const this_type& x) const;
+    this_type& operator+=(difference_type n);
+    this_type& operator-=(difference_type n);
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[](difference_type n) const;
+  };
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>::flat_map_iterator() :
+      mKey(NULL), mValue(NULL)
+  {
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>::flat_map_iterator(const Key* key, ValuePointer value) :
+      mKey(key), mValue(value)
+  {
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>::flat_map_iterator(const iterator& x) :
+      mKey(x.mKey), mValue(x.mValue)
+  {
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>& flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator++()
+  {
+    ++mKey;
+    ++mValue;
+    return *this;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference> flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator++(int)
+  {
+    this_type tmp(mKey, mValue);
+    operator++();
+    return tmp;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>& flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator--()
+  {
+    --mKey;
+    --mValue;
+    return *this;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference> flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator--(int)
+  {
+    this_type tmp(mKey, mValue);
+    operator--();
+    return tmp;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference> flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator+(difference_type n) const
+  {
+    return this_type(mKey + n, mValue + n);
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference> flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator-(difference_type n) const
+  {
+    return this_type(mKey - n, mValue - n);
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline typename flat_map_iterator<Key, T, ValuePointer, ValueReference>::difference_type flat_map_iterator<Key, T,
+      ValuePointer, ValueReference>::operator-(const this_type& x) const
+  {
+    return mKey - x.mKey;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>& flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator+=(difference_type n)
+  {
+    mKey += n;
+    mValue += n;
+    return *this;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline flat_map_iterator<Key, T, ValuePointer, ValueReference>& flat_map_iterator<Key, T, ValuePointer,
+      ValueReference>::operator-=(difference_type n)
+  {
+    mKey -= n;
+    mValue -= n;
+    return *this;
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline typename flat_map_iterator<Key, T, ValuePointer, ValueReference>::reference flat_map_iterator<Key, T,
+      ValuePointer, ValueReference>::operator*() const
+  {
+    return reference(*mKey, *mValue);
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline typename flat_map_iterator<Key, T, ValuePointer, ValueReference>::pointer flat_map_iterator<Key, T,
+      ValuePointer, ValueReference>::operator->() const
+  {
+    return pointer(reference(*mKey, *mValue));
+  }
+
+  template<class Key, class T, class ValuePointer, class ValueReference>
+  inline typename flat_map_iterator<Key, T, ValuePointer, ValueReference>::reference flat_map_iterator<Key, T,
+      ValuePointer, ValueReference>::operator[](difference_type n) const
+  {
+    return reference(mKey[n], mValue[n]);
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+  template<typename Key, typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const flat_map_iterator<Key, T, PointerA, ReferenceA>& a,
+      const flat_map_iterator<Key, T, PointerB, ReferenceB>& b)
+  {
+    return a.mKey == b.mKey;
+  }
+
+  template<typename Key, typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const flat_map_iterator<Key, T, PointerA, ReferenceA>& a,
+      const flat_map_iterator<Key, T, PointerB, ReferenceB>& b)
+  {
+    return a.mKey != b.mKey;
+  }
+
+  template<typename Key, typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator<(const flat_map_iterator<Key, T, PointerA, ReferenceA>& a,
+      const flat_map_iterator<Key, T, PointerB, ReferenceB>& b)
+  {
+    return a.mKey < b.mKey;
+  }
+}    //namespace flex
+
+#endif /* FLEX_INTERNAL_FLAT_MAP_ITERATOR_H */
@@ -0,0 +1,181 @@
+#ifndef FLEX_INTERNAL_FLAT_MERGE_H
+#define FLEX_INTERNAL_FLAT_MERGE_H
+
+#include <flex/config.h>
+
+#include <algorithm>
+
+namespace flex
+{
+
+  //The sorted arrays behind a flat_set, seen by the in-place algorithms below.
+  template<class Key> struct flat_keys
+  {
+    Key* mKeys;
+
+    explicit flat_keys(Key* keys) :
+        mKeys(keys)
+    {
+    }
+
+    const Key& key(size_t i) const
+    {
+      return mKeys[i];
+    }
+
+    void move(size_t dest, size_t src)
+    {
+      mKeys[dest] = FLEX_MOVE(mKeys[src]);
+    }
+
+    void swap(size_t a, size_t b)
+    {
+      std::swap(mKeys[a], mKeys[b]);
+    }
+  };
+
+  //The parallel key and value arrays behind a flat_map.  Every move and swap is applied to both, so the arrays
+  //stay in step.
+  template<class Key, class T> struct flat_pairs
+  {
+    Key* mKeys;
+    T* mValues;
+
+    flat_pairs(Key* keys, T* values) :
+        mKeys(keys), mValues(values)
+    {
+    }
+
+    const Key& key(size_t i) const
+    {
+      return mKeys[i];
+    }
+
+    void move(size_t dest, size_t src)
+    {
+      mKeys[dest] = FLEX_MOVE(mKeys[src]);
+      mValues[dest] = FLEX_MOVE(mValues[src]);
+    }
+
+    void swap(size_t a, size_t b)
+    {
+      std::swap(mKeys[a], mKeys[b]);
+      std::swap(mValues[a], mValues[b]);
+    }
+  };
+
+  //The algorithms below sort and merge flat_keys and flat_pairs in place by swapping elements, so a range
+  //insert into a flat container needs no storage beyond the container's own.
+
+  //Reverses [first, last).
+  template<class Array>
+  inline void flat_reverse(Array& a, size_t first, size_t last)
+  {
+    while ((first != last) && (first != --last))
+    {
+      a.swap(first++, last);
+    }
+  }
+
+  //Swaps the blocks [first, middle) and [middle, last).
+  template<class Array>
+  inline void flat_rotate(Array& a, size_t first, size_t middle, size_t last)
+  {
+    flat_reverse(a, first, middle);
+    flat_reverse(a, middle, last);
+    flat_reverse(a, first, last);
+  }
+
+  //Stably merges the sorted runs [first, middle) and [middle, last) by rotating blocks into place.
+  template<class Array, class Compare>
+  inline void flat_merge(Array& a, size_t first, size_t middle, size_t last, const Compare& comp)
+  {
+    if ((first == middle) || (middle == last))
+    {
+      return;
+    }
+    if (last - first == 2)
+    {
+      if (comp(a.key(middle), a.key(first)))
+      {
+        a.swap(first, middle);
+      }
+      return;
+    }
+
+    //Split the longer run in half and find where its middle element falls in the other run.
+    size_t cut1;
+    size_t cut2;
+    if (middle - first > last - middle)
+    {
+      cut1 = first + (middle - first) / 2;
+      size_t lo = middle;
+      size_t hi = last;
+      while (lo < hi)
+      {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (comp(a.key(mid), a.key(cut1)))
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      cut2 = lo;
+    }
+    else
+    {
+      cut2 = middle + (last - middle) / 2;
+      size_t lo = first;
+      size_t hi = middle;
+      while (lo < hi)
+      {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (comp(a.key(cut2), a.key(mid)))
+        {
+          hi = mid;
+        }
+        else
+        {
+          lo = mid + 1;
+        }
+      }
+      cut1 = lo;
+    }
+
+    flat_rotate(a, cut1, middle, cut2);
+    const size_t new_middle = cut1 + (cut2 - middle);
+    flat_merge(a, first, cut1, new_middle, comp);
+    flat_merge(a, new_middle, cut2, last, comp);
+  }
+
+  //Stably sorts [first, last): insertion sort over short runs, then merges of doubling width.
+  template<class Array, class Compare>
+  inline void flat_stable_sort(Array& a, size_t first, size_t last, const Compare& comp)
+  {
+    const size_t RUN = 16;
+    for (size_t run = first; run < last; run += RUN)
+    {
+      const size_t end = std::min(run + RUN, last);
+      for (size_t i = run + 1; i < end; ++i)
+      {
+        for (size_t j = i; (j > run) && comp(a.key(j), a.key(j - 1)); --j)
+        {
+          a.swap(j, j - 1);
+        }
+      }
+    }
+    for (size_t width = RUN; width < last - first; width *= 2)
+    {
+      for (size_t lo = first; lo + width < last; lo += 2 * width)
+      {
+        flat_merge(a, lo, lo + width, std::min(lo + 2 * width, last), comp);
+      }
+    }
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_FLAT_MERGE_H */
@@ -34,6 +34,7 @@
 #include <flex/initializer_list.h>
 
 #include <iterator>
+#include <math.h> // ceilf
 #include <string.h>
 
 #ifdef _MSC_VER
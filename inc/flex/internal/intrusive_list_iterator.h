@@ -0,0 +1,128 @@
+#ifndef FLEX_INTERNAL_INTRUSIVE_LIST_ITERATOR_H
+#define FLEX_INTERNAL_INTRUSIVE_LIST_ITERATOR_H
+
+#include <flex/internal/list_iterator.h>
+
+namespace flex
+{
+
+  //Iterator over an intrusive_list.  It walks the list_node_base links and converts each node back to the T
+  //that contains it, through the Hook base class that T derives from.
+  template<typename T, typename Hook, typename Pointer = T*, typename Reference = T&>
+  struct intrusive_list_iterator
+  {
+    typedef intrusive_list_iterator<T, Hook, Pointer, Reference> this_type;
+    typedef intrusive_list_iterator<T, Hook, T*, T&> iterator;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+  public:
+    list_node_base* mNode;
+
+  public:
+    intrusive_list_iterator();
+    intrusive_list_iterator(const list_node_base* pNode);
+    intrusive_list_iterator(const iterator& x);
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    this_type& operator++();
+    this_type operator++(int);
+
+    this_type& operator--();
+    this_type operator--(int);
+  };
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline intrusive_list_iterator<T, Hook, Pointer, Reference>::intrusive_list_iterator() :
+      mNode()
+  {
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline intrusive_list_iterator<T, Hook, Pointer, Reference>::intrusive_list_iterator(const list_node_base* pNode) :
+      mNode(const_cast<list_node_base*>(pNode))
+  {
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline intrusive_list_iterator<T, Hook, Pointer, Reference>::intrusive_list_iterator(const iterator& x) :
+      mNode(x.mNode)
+  {
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::reference intrusive_list_iterator<T, Hook,
+      Pointer, Reference>::operator*() const
+  {
+    return static_cast<T&>(static_cast<Hook&>(*mNode));
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::pointer intrusive_list_iterator<T, Hook,
+      Pointer, Reference>::operator->() const
+  {
+    return &static_cast<T&>(static_cast<Hook&>(*mNode));
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::this_type&
+  intrusive_list_iterator<T, Hook, Pointer, Reference>::operator++()
+  {
+    mNode = mNode->mNext;
+    return *this;
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::this_type intrusive_list_iterator<T, Hook,
+      Pointer, Reference>::operator++(int)
+  {
+    this_type temp(*this);
+    mNode = mNode->mNext;
+    return temp;
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::this_type&
+  intrusive_list_iterator<T, Hook, Pointer, Reference>::operator--()
+  {
+    mNode = mNode->mPrev;
+    return *this;
+  }
+
+  template<typename T, typename Hook, typename Pointer, typename Reference>
+  inline typename intrusive_list_iterator<T, Hook, Pointer, Reference>::this_type intrusive_list_iterator<T, Hook,
+      Pointer, Reference>::operator--(int)
+  {
+    this_type temp(*this);
+    mNode = mNode->mPrev;
+    return temp;
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+
+  template<typename T, typename Hook, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const intrusive_list_iterator<T, Hook, PointerA, ReferenceA>& a,
+      const intrusive_list_iterator<T, Hook, PointerB, ReferenceB>& b)
+  {
+    return a.mNode == b.mNode;
+  }
+
+  template<typename T, typename Hook, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const intrusive_list_iterator<T, Hook, PointerA, ReferenceA>& a,
+      const intrusive_list_iterator<T, Hook, PointerB, ReferenceB>& b)
+  {
+    return a.mNode != b.mNode;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_INTRUSIVE_LIST_ITERATOR_H */
@@ -0,0 +1,200 @@
+#ifndef FLEX_INTERNAL_LIST_NODE_POOL_H
+#define FLEX_INTERNAL_LIST_NODE_POOL_H
+
+#include <flex/allocator.h>
+
+namespace flex
+{
+
+  /*
+   * The node storage shared by list and slist.  A node is taken from the node pool if one is available, then
+   * from the range [mFixedBegin, mFixedEnd) that a fixed container hands in at construction, and only then from
+   * mAllocator.  Erased nodes are pushed back onto the pool, which is chained through each node's mNext, so a
+   * list that has reached its size never allocates again.  Once a fixed container runs out of buffer it reports
+   * the overflow a single time and falls back to mAllocator.
+   */
+  template<class T, class Node, class Alloc> class list_node_pool: public guarded_object
+  {
+  protected:
+    typedef T value_type;
+    typedef Node node_type;
+    typedef size_t size_type;
+
+    list_node_pool();
+    list_node_pool(node_type* first, node_type* last);
+
+    node_type* AllocateNode();
+    node_type* RetrieveNode(const value_type& val);
+#ifdef FLEX_HAS_CXX11
+    node_type* RetrieveNode(value_type&& val);
+    template<class...Args> node_type* RetrieveNode(Args&&... args);
+#endif
+
+    size_type GetNodePoolSize();
+    void FillNodePool(size_type n);
+    void PushToNodePool(node_type* ptr);
+    void PurgeNodePool();
+    void PurgeOverflowNodes(node_type* first, node_type* last);
+
+    node_type* mNodePool;
+    node_type* mFixedBegin;
+    node_type* mFixedEnd;
+    Alloc mAllocator;
+    bool mFixed;
+    bool mOverflow;
+  };
+
+  template<class T, class Node, class Alloc>
+  inline list_node_pool<T, Node, Alloc>::list_node_pool() :
+      mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+  {
+  }
+
+  template<class T, class Node, class Alloc>
+  inline list_node_pool<T, Node, Alloc>::list_node_pool(node_type* first, node_type* last) :
+      mNodePool(NULL), mFixedBegin(first), mFixedEnd(last), mFixed(true), mOverflow(false)
+  {
+  }
+
+  template<class T, class Node, class Alloc>
+  inline typename list_node_pool<T, Node, Alloc>::node_type* list_node_pool<T, Node, Alloc>::AllocateNode()
+  {
+    if (mFixedBegin != mFixedEnd)
+    {
+      return mFixedBegin++;
+    }
+    else
+    {
+#ifndef FLEX_RELEASE
+      if (FLEX_UNLIKELY(mFixed))
+      {
+        if (!mOverflow)
+        {
+          mOverflow = true;
+          flex::error_msg("flex::fixed_list/fixed_slist - exceeded capacity");
+        }
+      }
+#endif
+      return mAllocator.allocate(1);
+    }
+  }
+
+  template<class T, class Node, class Alloc>
+  inline typename list_node_pool<T, Node, Alloc>::node_type* list_node_pool<T, Node, Alloc>::RetrieveNode(
+      const value_type& val)
+  {
+    node_type* ptr;
+    if (NULL == mNodePool)
+    {
+      ptr = AllocateNode();
+    }
+    else
+    {
+      ptr = mNodePool;
+      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+    }
+    new ((void*) &ptr->mValue) value_type(val);
+    return ptr;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Node, class Alloc>
+  inline typename list_node_pool<T, Node, Alloc>::node_type* list_node_pool<T, Node, Alloc>::RetrieveNode(
+      value_type&& val)
+  {
+    node_type* ptr;
+    if (NULL == mNodePool)
+    {
+      ptr = AllocateNode();
+    }
+    else
+    {
+      ptr = mNodePool;
+      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+    }
+    new ((void*) &ptr->mValue) value_type(std::move(val));
+    return ptr;
+  }
+
+  template<class T, class Node, class Alloc>
+  template<class...Args>
+  inline typename list_node_pool<T, Node, Alloc>::node_type* list_node_pool<T, Node, Alloc>::RetrieveNode(
+      Args&&... args)
+  {
+    node_type* ptr;
+    if (NULL == mNodePool)
+    {
+      ptr = AllocateNode();
+    }
+    else
+    {
+      ptr = mNodePool;
+      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+    }
+    new ((void*) &ptr->mValue) value_type(std::forward<Args>(args)...);
+    return ptr;
+  }
+#endif
+
+  template<class T, class Node, class Alloc>
+  inline typename list_node_pool<T, Node, Alloc>::size_type list_node_pool<T, Node, Alloc>::GetNodePoolSize()
+  {
+    size_type n = 0;
+    node_type* node_ptr = mNodePool;
+    while (node_ptr != NULL)
+    {
+      node_ptr = static_cast<node_type*>(node_ptr->mNext);
+      ++n;
+    }
+    return n;
+  }
+
+  template<class T, class Node, class Alloc>
+  inline void list_node_pool<T, Node, Alloc>::FillNodePool(size_type n)
+  {
+    for (; n; --n)
+    {
+      node_type* node_ptr = AllocateNode();
+      node_ptr->mNext = mNodePool;
+      mNodePool = node_ptr;
+    }
+  }
+
+  template<class T, class Node, class Alloc>
+  inline void list_node_pool<T, Node, Alloc>::PushToNodePool(node_type* ptr)
+  {
+    ptr->mValue.~value_type();
+    ptr->mNext = mNodePool;
+    mNodePool = ptr;
+  }
+
+  template<class T, class Node, class Alloc>
+  inline void list_node_pool<T, Node, Alloc>::PurgeNodePool()
+  {
+    while (mNodePool != NULL)
+    {
+      node_type* next = static_cast<node_type*>(mNodePool->mNext);
+      mAllocator.deallocate(mNodePool, 1);
+      mNodePool = next;
+    }
+  }
+
+  template<class T, class Node, class Alloc>
+  inline void list_node_pool<T, Node, Alloc>::PurgeOverflowNodes(node_type* first, node_type* last)
+  {
+    //Used by a fixed container that overflowed.  Empties the node pool, returning the nodes that lie outside its
+    //buffer [first, last) to the allocator.
+    while (mNodePool != NULL)
+    {
+      node_type* next = static_cast<node_type*>(mNodePool->mNext);
+      if ((mNodePool < first) || (mNodePool >= last))
+      {
+        mAllocator.deallocate(mNodePool, 1);
+      }
+      mNodePool = next;
+    }
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_LIST_NODE_POOL_H */
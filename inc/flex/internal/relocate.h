@@ -0,0 +1,77 @@
+#ifndef FLEX_INTERNAL_RELOCATE_H
+#define FLEX_INTERNAL_RELOCATE_H
+
+#include <flex/config.h>
+#include <flex/internal/type_traits.h>
+
+#include <string.h> //memcpy
+#include <memory>
+
+namespace flex
+{
+
+  ///////////////////////////////////////////////////////////////////////
+  // is_trivially_relocatable
+  //
+  // A type is trivially relocatable if moving an object to a new address and destroying the original is
+  // equivalent to copying its bytes.  Containers use this to grow with a single memcpy instead of a move
+  // construct and destroy per element.  Trivially copyable types qualify by default.  Many other types,
+  // such as those that hold a heap pointer but never point into themselves, qualify as well and may be
+  // declared so by specializing this trait:
+  //
+  //    namespace flex
+  //    {
+  //      template<> struct is_trivially_relocatable<my_type> : std::true_type {};
+  //    }
+  //
+  // A type that stores a pointer to itself or to one of its members must never be declared relocatable.
+  //
+#ifdef FLEX_HAS_CXX11
+  template<class T>
+  struct is_trivially_relocatable: std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+  {
+  };
+#elif defined(__GNUC__)
+  template<class T>
+  struct is_trivially_relocatable: std::integral_constant<bool, __has_trivial_copy(T) && __has_trivial_destructor(T)>
+  {
+  };
+#else
+  template<class T>
+  struct is_trivially_relocatable: std::integral_constant<bool, false>
+  {
+  };
+#endif
+
+  template<class T>
+  inline T* uninitialized_relocate_impl(T* first, T* last, T* dest, std::true_type)
+  {
+    const size_t n = last - first;
+    if (n)
+    {
+      memcpy((void*) dest, (const void*) first, n * sizeof(T));
+    }
+    return dest + n;
+  }
+
+  template<class T>
+  inline T* uninitialized_relocate_impl(T* first, T* last, T* dest, std::false_type)
+  {
+    T* dest_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(first), FLEX_MOVE_ITERATOR(last), dest);
+    flex::destruct_range(first, last);
+    return dest_end;
+  }
+
+  //Moves the objects in [first, last) into the uninitialized memory at dest and ends their lifetime at the
+  //source, as if each was move constructed and then destroyed.  The destination must not overlap the source.
+  //Returns the end of the destination range.
+  template<class T>
+  inline T* uninitialized_relocate(T* first, T* last, T* dest)
+  {
+    return uninitialized_relocate_impl(first, last, dest,
+        std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_RELOCATE_H */
@@ -27,7 +27,7 @@ namespace flex
     pointer mRightBound;
 
     ring_iterator();
-    ring_iterator(T* ptr, T* left_bound, T* right_bound);
+    ring_iterator(pointer ptr, pointer left_bound, pointer right_bound);
     ring_iterator(T* ptr, size_type n);
     ring_iterator(const iterator& x);
 
@@ -53,7 +53,7 @@ namespace flex
   }
 
   template<class T, class Pointer, class Reference>
-  inline ring_iterator<T, Pointer, Reference>::ring_iterator(T* ptr, T* left_bound, T* right_bound) :
+  inline ring_iterator<T, Pointer, Reference>::ring_iterator(pointer ptr, pointer left_bound, pointer right_bound) :
       mPtr(ptr), mLeftBound(left_bound), mRightBound(right_bound)
   {
   }
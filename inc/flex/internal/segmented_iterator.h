@@ -0,0 +1,206 @@
+#ifndef FLEX_INTERNAL_SEGMENTED_ITERATOR_H
+#define FLEX_INTERNAL_SEGMENTED_ITERATOR_H
+
+#include <iterator>
+
+namespace flex
+{
+
+  //Iterator over a segmented_vector.  It holds a pointer to the segment directory and the element index, so
+  //any operation that reallocates the directory (push_back, reserve, shrink_to_fit) invalidates iterators.
+  //References and pointers to the elements themselves are never invalidated by growth.
+  template<class T, size_t N, class Pointer = T*, class Reference = T&> struct segmented_iterator
+  {
+    typedef segmented_iterator<T, N, Pointer, Reference> this_type;
+    typedef segmented_iterator<T, N, T*, T&> iterator;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef size_t size_type;
+
+    T* const * mSegments;
+    size_type mIndex;
+
+    segmented_iterator();
+    segmented_iterator(T* const * segments, size_type index);
+    segmented_iterator(const iterator& x);
+
+    this_type& operator++();
+    this_type operator++(int);
+    this_type& operator--();
+    this_type operator--(int);
+    this_type operator+(difference_type n) const;
+    this_type operator-(difference_type n) const;
+    difference_type operator-(const this_type& x) const;
+    this_type& operator+=(difference_type n);
+    this_type& operator-=(difference_type n);
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[](difference_type n) const;
+  };
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>::segmented_iterator() :
+      mSegments(NULL), mIndex(0)
+  {
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>::segmented_iterator(T* const * segments, size_type index) :
+      mSegments(segments), mIndex(index)
+  {
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>::segmented_iterator(const iterator& x) :
+      mSegments(x.mSegments), mIndex(x.mIndex)
+  {
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>& segmented_iterator<T, N, Pointer, Reference>::operator++()
+  {
+    ++mIndex;
+    return *this;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference> segmented_iterator<T, N, Pointer, Reference>::operator++(int)
+  {
+    this_type tmp(mSegments, mIndex);
+    ++mIndex;
+    return tmp;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>& segmented_iterator<T, N, Pointer, Reference>::operator--()
+  {
+    --mIndex;
+    return *this;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference> segmented_iterator<T, N, Pointer, Reference>::operator--(int)
+  {
+    this_type tmp(mSegments, mIndex);
+    --mIndex;
+    return tmp;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference> segmented_iterator<T, N, Pointer, Reference>::operator+(
+      difference_type n) const
+  {
+    return this_type(mSegments, mIndex + n);
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference> segmented_iterator<T, N, Pointer, Reference>::operator-(
+      difference_type n) const
+  {
+    return this_type(mSegments, mIndex - n);
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline typename segmented_iterator<T, N, Pointer, Reference>::difference_type segmented_iterator<T, N, Pointer,
+      Reference>::operator-(const this_type& x) const
+  {
+    return (difference_type) mIndex - (difference_type) x.mIndex;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>& segmented_iterator<T, N, Pointer, Reference>::operator+=(
+      difference_type n)
+  {
+    mIndex += n;
+    return *this;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline segmented_iterator<T, N, Pointer, Reference>& segmented_iterator<T, N, Pointer, Reference>::operator-=(
+      difference_type n)
+  {
+    mIndex -= n;
+    return *this;
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline typename segmented_iterator<T, N, Pointer, Reference>::reference segmented_iterator<T, N, Pointer, Reference>::operator*() const
+  {
+    //N is a compile time constant, so the division and modulo reduce to a shift and mask when it is a power of two.
+    return mSegments[mIndex / N][mIndex % N];
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline typename segmented_iterator<T, N, Pointer, Reference>::pointer segmented_iterator<T, N, Pointer, Reference>::operator->() const
+  {
+    return &mSegments[mIndex / N][mIndex % N];
+  }
+
+  template<class T, size_t N, class Pointer, class Reference>
+  inline typename segmented_iterator<T, N, Pointer, Reference>::reference segmented_iterator<T, N, Pointer, Reference>::operator[](
+      difference_type n) const
+  {
+    const size_type i = mIndex + n;
+    return mSegments[i / N][i % N];
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex == b.mIndex;
+  }
+
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex != b.mIndex;
+  }
+
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator<(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex < b.mIndex;
+  }
+
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator>(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex > b.mIndex;
+  }
+
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator<=(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex <= b.mIndex;
+  }
+
+  template<typename T, size_t N, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator>=(const segmented_iterator<T, N, PointerA, ReferenceA>& a,
+      const segmented_iterator<T, N, PointerB, ReferenceB>& b)
+  {
+    return a.mIndex >= b.mIndex;
+  }
+
+  template<typename T, size_t N, typename Pointer, typename Reference>
+  inline segmented_iterator<T, N, Pointer, Reference> operator+(std::ptrdiff_t n,
+      const segmented_iterator<T, N, Pointer, Reference>& x)
+  {
+    return x + n;
+  }
+}    //namespace flex
+
+#endif /* FLEX_INTERNAL_SEGMENTED_ITERATOR_H */
@@ -0,0 +1,634 @@
+#ifndef FLEX_INTERNAL_SIMD_H
+#define FLEX_INTERNAL_SIMD_H
+
+#include <flex/config.h>
+
+#include <algorithm>
+#include <numeric>
+
+/*
+ * FLEX_HAS_SSE2
+ *
+ * SSE2 is part of the x86-64 baseline, so its kernels need no dispatch.
+ */
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__)) && !defined(FLEX_NO_SIMD)
+#define FLEX_HAS_SSE2 true
+#include <emmintrin.h>
+#endif
+
+/*
+ * FLEX_HAS_AVX2
+ *
+ * The AVX2 kernels are compiled with "#pragma GCC target" and selected at runtime, unless the whole program
+ * is already built for AVX2.
+ */
+#if defined(FLEX_HAS_SSE2) && (defined(__AVX2__) || (!defined(__clang__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))))
+#define FLEX_HAS_AVX2 true
+#include <immintrin.h>
+#endif
+
+namespace flex
+{
+  namespace simd
+  {
+
+    //The lane layouts that have kernels.  Any other element type uses the std algorithms.
+    enum lane_type
+    {
+      lane_none, lane_i32, lane_i64, lane_f32, lane_f64
+    };
+
+    template<class T> struct lane_of
+    {
+      static const int value = lane_none;
+    };
+
+#ifdef FLEX_HAS_SSE2
+    template<int Size> struct integer_lane
+    {
+      static const int value = (Size == 4) ? lane_i32 : ((Size == 8) ? lane_i64 : lane_none);
+    };
+
+    template<> struct lane_of<int> : integer_lane<sizeof(int)>
+    {
+    };
+
+    template<> struct lane_of<long> : integer_lane<sizeof(long)>
+    {
+    };
+
+    template<> struct lane_of<long long> : integer_lane<sizeof(long long)>
+    {
+    };
+
+    template<> struct lane_of<float>
+    {
+      static const int value = lane_f32;
+    };
+
+    template<> struct lane_of<double>
+    {
+      static const int value = lane_f64;
+    };
+
+    template<int Lane> struct sse2_ops;
+
+    template<> struct sse2_ops<lane_i32>
+    {
+      typedef __m128i reg;
+      static const size_t lanes = 4;
+
+      static reg load(const void* p)
+      {
+        return _mm_loadu_si128(static_cast<const __m128i*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm_storeu_si128(static_cast<__m128i*>(p), a);
+      }
+      template<class T> static reg set1(T v)
+      {
+        return _mm_set1_epi32(static_cast<int>(v));
+      }
+      static reg zero()
+      {
+        return _mm_setzero_si128();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(a, b)));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm_add_epi32(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        const reg gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+      }
+      static reg max(reg a, reg b)
+      {
+        const reg gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+      }
+    };
+
+    template<> struct sse2_ops<lane_i64>
+    {
+      typedef __m128i reg;
+      static const size_t lanes = 2;
+
+      static reg load(const void* p)
+      {
+        return _mm_loadu_si128(static_cast<const __m128i*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm_storeu_si128(static_cast<__m128i*>(p), a);
+      }
+      template<class T> static reg set1(T v)
+      {
+        return _mm_set1_epi64x(static_cast<long long>(v));
+      }
+      static reg zero()
+      {
+        return _mm_setzero_si128();
+      }
+      static int eq(reg a, reg b)
+      {
+        //SSE2 only compares 32-bit lanes.  A 64-bit lane is equal when both of its halves are.
+        const reg half = _mm_cmpeq_epi32(a, b);
+        return _mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)))));
+      }
+      //SSE2 has no 64-bit compare, so lt(), min() and max() resolve the two lanes one at a time.
+      static int lt(reg a, reg b)
+      {
+        long long x[2], y[2];
+        store(x, a);
+        store(y, b);
+        return ((x[0] < y[0]) ? 1 : 0) | ((x[1] < y[1]) ? 2 : 0);
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm_add_epi64(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        long long x[2], y[2];
+        store(x, a);
+        store(y, b);
+        return _mm_set_epi64x((y[1] < x[1]) ? y[1] : x[1], (y[0] < x[0]) ? y[0] : x[0]);
+      }
+      static reg max(reg a, reg b)
+      {
+        long long x[2], y[2];
+        store(x, a);
+        store(y, b);
+        return _mm_set_epi64x((x[1] < y[1]) ? y[1] : x[1], (x[0] < y[0]) ? y[0] : x[0]);
+      }
+    };
+
+    template<> struct sse2_ops<lane_f32>
+    {
+      typedef __m128 reg;
+      static const size_t lanes = 4;
+
+      static reg load(const void* p)
+      {
+        return _mm_loadu_ps(static_cast<const float*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm_storeu_ps(static_cast<float*>(p), a);
+      }
+      static reg set1(float v)
+      {
+        return _mm_set1_ps(v);
+      }
+      static reg zero()
+      {
+        return _mm_setzero_ps();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm_add_ps(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm_min_ps(a, b);
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm_max_ps(a, b);
+      }
+    };
+
+    template<> struct sse2_ops<lane_f64>
+    {
+      typedef __m128d reg;
+      static const size_t lanes = 2;
+
+      static reg load(const void* p)
+      {
+        return _mm_loadu_pd(static_cast<const double*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm_storeu_pd(static_cast<double*>(p), a);
+      }
+      static reg set1(double v)
+      {
+        return _mm_set1_pd(v);
+      }
+      static reg zero()
+      {
+        return _mm_setzero_pd();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm_movemask_pd(_mm_cmplt_pd(a, b));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm_add_pd(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm_min_pd(a, b);
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm_max_pd(a, b);
+      }
+    };
+#endif //FLEX_HAS_SSE2
+
+  } //namespace simd
+} //namespace flex
+
+#ifdef FLEX_HAS_SSE2
+#define FLEX_SIMD_NAMESPACE sse2
+#include <flex/internal/simd_kernels.h>
+#undef FLEX_SIMD_NAMESPACE
+#endif
+
+#ifdef FLEX_HAS_AVX2
+#ifndef __AVX2__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace flex
+{
+  namespace simd
+  {
+
+    template<int Lane> struct avx2_ops;
+
+    template<> struct avx2_ops<lane_i32>
+    {
+      typedef __m256i reg;
+      static const size_t lanes = 8;
+
+      static reg load(const void* p)
+      {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm256_storeu_si256(static_cast<__m256i*>(p), a);
+      }
+      template<class T> static reg set1(T v)
+      {
+        return _mm256_set1_epi32(static_cast<int>(v));
+      }
+      static reg zero()
+      {
+        return _mm256_setzero_si256();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm256_add_epi32(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm256_min_epi32(a, b);
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm256_max_epi32(a, b);
+      }
+    };
+
+    template<> struct avx2_ops<lane_i64>
+    {
+      typedef __m256i reg;
+      static const size_t lanes = 4;
+
+      static reg load(const void* p)
+      {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm256_storeu_si256(static_cast<__m256i*>(p), a);
+      }
+      template<class T> static reg set1(T v)
+      {
+        return _mm256_set1_epi64x(static_cast<long long>(v));
+      }
+      static reg zero()
+      {
+        return _mm256_setzero_si256();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(b, a)));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm256_add_epi64(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+      }
+    };
+
+    template<> struct avx2_ops<lane_f32>
+    {
+      typedef __m256 reg;
+      static const size_t lanes = 8;
+
+      static reg load(const void* p)
+      {
+        return _mm256_loadu_ps(static_cast<const float*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm256_storeu_ps(static_cast<float*>(p), a);
+      }
+      static reg set1(float v)
+      {
+        return _mm256_set1_ps(v);
+      }
+      static reg zero()
+      {
+        return _mm256_setzero_ps();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm256_add_ps(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm256_min_ps(a, b);
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm256_max_ps(a, b);
+      }
+    };
+
+    template<> struct avx2_ops<lane_f64>
+    {
+      typedef __m256d reg;
+      static const size_t lanes = 4;
+
+      static reg load(const void* p)
+      {
+        return _mm256_loadu_pd(static_cast<const double*>(p));
+      }
+      static void store(void* p, reg a)
+      {
+        _mm256_storeu_pd(static_cast<double*>(p), a);
+      }
+      static reg set1(double v)
+      {
+        return _mm256_set1_pd(v);
+      }
+      static reg zero()
+      {
+        return _mm256_setzero_pd();
+      }
+      static int eq(reg a, reg b)
+      {
+        return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+      }
+      static int lt(reg a, reg b)
+      {
+        return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+      }
+      static reg add(reg a, reg b)
+      {
+        return _mm256_add_pd(a, b);
+      }
+      static reg min(reg a, reg b)
+      {
+        return _mm256_min_pd(a, b);
+      }
+      static reg max(reg a, reg b)
+      {
+        return _mm256_max_pd(a, b);
+      }
+    };
+
+  } //namespace simd
+} //namespace flex
+
+#define FLEX_SIMD_NAMESPACE avx2
+#include <flex/internal/simd_kernels.h>
+#undef FLEX_SIMD_NAMESPACE
+
+#ifndef __AVX2__
+#pragma GCC pop_options
+#endif
+#endif //FLEX_HAS_AVX2
+
+namespace flex
+{
+  namespace simd
+  {
+
+    inline bool has_avx2()
+    {
+#if defined(__AVX2__)
+      return true;
+#elif defined(FLEX_HAS_AVX2)
+      return __builtin_cpu_supports("avx2");
+#else
+      return false;
+#endif
+    }
+
+    //Routes each algorithm to the widest kernel the CPU supports for the lane type.
+    template<int Lane> struct dispatch
+    {
+#ifdef FLEX_HAS_SSE2
+      template<class T> static T accumulate(const T* first, const T* last, T init)
+      {
+#ifdef FLEX_HAS_AVX2
+        if (has_avx2())
+        {
+          return avx2::accumulate<avx2_ops<Lane> >(first, last, init);
+        }
+#endif
+        return sse2::accumulate<sse2_ops<Lane> >(first, last, init);
+      }
+
+      template<class T> static size_t count(const T* first, const T* last, T value)
+      {
+#ifdef FLEX_HAS_AVX2
+        if (has_avx2())
+        {
+          return avx2::count<avx2_ops<Lane> >(first, last, value);
+        }
+#endif
+        return sse2::count<sse2_ops<Lane> >(first, last, value);
+      }
+
+      template<class T> static size_t count_less(const T* first, const T* last, T value)
+      {
+#ifdef FLEX_HAS_AVX2
+        if (has_avx2())
+        {
+          return avx2::count_less<avx2_ops<Lane> >(first, last, value);
+        }
+#endif
+        return sse2::count_less<sse2_ops<Lane> >(first, last, value);
+      }
+
+      template<class T> static const T* find(const T* first, const T* last, T value)
+      {
+#ifdef FLEX_HAS_AVX2
+        if (has_avx2())
+        {
+          return avx2::find<avx2_ops<Lane> >(first, last, value);
+        }
+#endif
+        return sse2::find<sse2_ops<Lane> >(first, last, value);
+      }
+
+      template<bool Min, class T> static const T* extreme_element(const T* first, const T* last)
+      {
+#ifdef FLEX_HAS_AVX2
+        if (has_avx2())
+        {
+          return avx2::extreme_element<avx2_ops<Lane>, Min>(first, last);
+        }
+#endif
+        return sse2::extreme_element<sse2_ops<Lane>, Min>(first, last);
+      }
+#endif //FLEX_HAS_SSE2
+    };
+
+    template<> struct dispatch<lane_none>
+    {
+      template<class T> static T accumulate(const T* first, const T* last, T init)
+      {
+        return std::accumulate(first, last, init);
+      }
+
+      template<class T> static size_t count(const T* first, const T* last, const T& value)
+      {
+        return std::count(first, last, value);
+      }
+
+      template<class T> static size_t count_less(const T* first, const T* last, const T& value)
+      {
+        size_t n = 0;
+        for (; first != last; ++first)
+        {
+          n += (*first < value) ? 1 : 0;
+        }
+        return n;
+      }
+
+      template<class T> static const T* find(const T* first, const T* last, const T& value)
+      {
+        return std::find(first, last, value);
+      }
+
+      template<bool Min, class T> static const T* extreme_element(const T* first, const T* last)
+      {
+        return Min ? std::min_element(first, last) : std::max_element(first, last);
+      }
+    };
+
+    /// The entry points below take a contiguous range.  Ranges of int, long, long long, float and double use
+    /// SSE2 or AVX2 kernels; everything else is forwarded to the std algorithm of the same name.
+    ///
+    /// accumulate adds the lanes separately, so a floating point sum may differ from std::accumulate in its
+    /// last bits.  min_element and max_element return the first extreme element, as the std versions do.  If
+    /// the range holds NaNs they may return a different element than the std versions, which is the first
+    /// element equal to the extreme the lanes reduce to, or first when that extreme is a NaN.
+    /// lower_bound requires a sorted range and counts every element less than value rather than bisecting,
+    /// which is faster for ranges as short as a B-tree node.
+    ///
+    template<class T, class U>
+    inline U accumulate(const T* first, const T* last, U init)
+    {
+      return std::accumulate(first, last, init);
+    }
+
+    template<class T>
+    inline T accumulate(const T* first, const T* last, T init)
+    {
+      return dispatch<lane_of<T>::value>::accumulate(first, last, init);
+    }
+
+    template<class T>
+    inline size_t count(const T* first, const T* last, const T& value)
+    {
+      return dispatch<lane_of<T>::value>::count(first, last, value);
+    }
+
+    template<class T>
+    inline const T* find(const T* first, const T* last, const T& value)
+    {
+      return dispatch<lane_of<T>::value>::find(first, last, value);
+    }
+
+    template<class T>
+    inline const T* lower_bound(const T* first, const T* last, const T& value)
+    {
+      return first + dispatch<lane_of<T>::value>::count_less(first, last, value);
+    }
+
+    template<class T>
+    inline const T* max_element(const T* first, const T* last)
+    {
+      return dispatch<lane_of<T>::value>::template extreme_element<false>(first, last);
+    }
+
+    template<class T>
+    inline const T* min_element(const T* first, const T* last)
+    {
+      return dispatch<lane_of<T>::value>::template extreme_element<true>(first, last);
+    }
+
+  } //namespace simd
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_SIMD_H */
@@ -0,0 +1,114 @@
+//This file deliberately has no include guard.  internal/simd.h includes it once per instruction set, with
+//FLEX_SIMD_NAMESPACE naming the namespace that receives the kernels, so that each copy is compiled for the
+//target selected around the #include.  The kernels are written against an Ops class which supplies the
+//register type, the number of lanes and the handful of operations needed.
+
+namespace flex
+{
+  namespace simd
+  {
+    namespace FLEX_SIMD_NAMESPACE
+    {
+
+      template<class Ops, class T>
+      inline const T* find(const T* first, const T* last, T value)
+      {
+        const typename Ops::reg x = Ops::set1(value);
+        for (; (size_t) (last - first) >= Ops::lanes; first += Ops::lanes)
+        {
+          const int mask = Ops::eq(Ops::load(first), x);
+          if (mask)
+          {
+            return first + __builtin_ctz(mask);
+          }
+        }
+        return std::find(first, last, value);
+      }
+
+      template<class Ops, class T>
+      inline size_t count(const T* first, const T* last, T value)
+      {
+        const typename Ops::reg x = Ops::set1(value);
+        size_t n = 0;
+        for (; (size_t) (last - first) >= Ops::lanes; first += Ops::lanes)
+        {
+          n += __builtin_popcount(Ops::eq(Ops::load(first), x));
+        }
+        return n + std::count(first, last, value);
+      }
+
+      template<class Ops, class T>
+      inline size_t count_less(const T* first, const T* last, T value)
+      {
+        const typename Ops::reg x = Ops::set1(value);
+        size_t n = 0;
+        for (; (size_t) (last - first) >= Ops::lanes; first += Ops::lanes)
+        {
+          n += __builtin_popcount(Ops::lt(Ops::load(first), x));
+        }
+        for (; first != last; ++first)
+        {
+          n += (*first < value) ? 1 : 0;
+        }
+        return n;
+      }
+
+      template<class Ops, class T>
+      inline T accumulate(const T* first, const T* last, T init)
+      {
+        typename Ops::reg sum = Ops::zero();
+        for (; (size_t) (last - first) >= Ops::lanes; first += Ops::lanes)
+        {
+          sum = Ops::add(sum, Ops::load(first));
+        }
+
+        T buf[Ops::lanes];
+        Ops::store(buf, sum);
+        for (size_t i = 0; i < Ops::lanes; ++i)
+        {
+          init += buf[i];
+        }
+        return std::accumulate(first, last, init);
+      }
+
+      //The extreme value is found lane by lane, then a second pass finds its first occurrence.  The
+      //second pass stops early and usually touches only part of the range.
+      template<class Ops, bool Min, class T>
+      inline const T* extreme_element(const T* first, const T* last)
+      {
+        if ((size_t) (last - first) < Ops::lanes)
+        {
+          return Min ? std::min_element(first, last) : std::max_element(first, last);
+        }
+
+        const T* it = first + Ops::lanes;
+        typename Ops::reg best = Ops::load(first);
+        for (; (size_t) (last - it) >= Ops::lanes; it += Ops::lanes)
+        {
+          best = Min ? Ops::min(best, Ops::load(it)) : Ops::max(best, Ops::load(it));
+        }
+
+        T buf[Ops::lanes];
+        Ops::store(buf, best);
+        T value = buf[0];
+        for (size_t i = 1; i < Ops::lanes; ++i)
+        {
+          value = (Min ? (buf[i] < value) : (value < buf[i])) ? buf[i] : value;
+        }
+        for (; it != last; ++it)
+        {
+          value = (Min ? (*it < value) : (value < *it)) ? *it : value;
+        }
+
+        //With NaNs in the range the result can differ from std::min_element and std::max_element, whose result
+        //follows from comparing each element with the best so far in order.  A NaN compares false both ways, so
+        //the lanes and the reductions above drop or keep it at different points than that single scan does.
+        //The element returned is the first one equal to the value settled on here, or first when that value is
+        //itself a NaN, since a NaN compares equal to nothing.
+        it = find<Ops>(first, last, value);
+        return (it != last) ? it : first;
+      }
+
+    } //namespace FLEX_SIMD_NAMESPACE
+  } //namespace simd
+} //namespace flex
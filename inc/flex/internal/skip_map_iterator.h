@@ -0,0 +1,151 @@
+#ifndef FLEX_INTERNAL_SKIP_MAP_ITERATOR_H
+#define FLEX_INTERNAL_SKIP_MAP_ITERATOR_H
+
+#include <iterator>
+
+namespace flex
+{
+
+  //A skip_map node.  mNext holds mHeight links, one per level, and is declared with a single entry so that
+  //taller nodes can be laid out as a skip_map_tower with the remaining links following directly after it.
+  //Level 0 also has a back link, mPrev, so the map can be iterated in both directions.
+  template<class Value> struct skip_map_node
+  {
+    Value mValue;
+    skip_map_node* mPrev;
+    size_t mHeight;
+    skip_map_node* mNext[1];
+  };
+
+  //Storage for a node with L links.
+  template<class Value, size_t L> struct skip_map_tower: public skip_map_node<Value>
+  {
+    skip_map_node<Value>* mMore[L - 1];
+  };
+
+  template<class Value> struct skip_map_tower<Value, 1> : public skip_map_node<Value>
+  {
+  };
+
+  template<typename Value, typename Pointer = Value*, typename Reference = Value&>
+  struct skip_map_iterator
+  {
+    typedef skip_map_iterator<Value, Pointer, Reference> this_type;
+    typedef skip_map_iterator<Value, Value*, Value&> iterator;
+    typedef skip_map_node<Value> node_type;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+  public:
+    node_type* mNode;
+
+  public:
+    skip_map_iterator();
+    skip_map_iterator(const node_type * pNode);
+    skip_map_iterator(const iterator & x);
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    this_type& operator++();
+    this_type operator++(int);
+
+    this_type& operator--();
+    this_type operator--(int);
+  };
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline skip_map_iterator<Value, Pointer, Reference>::skip_map_iterator() :
+      mNode()
+  {
+
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline skip_map_iterator<Value, Pointer, Reference>::skip_map_iterator(const node_type* pNode) :
+      mNode(const_cast<node_type*>(pNode))
+  {
+
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline skip_map_iterator<Value, Pointer, Reference>::skip_map_iterator(const iterator& x) :
+      mNode(const_cast<node_type*>(x.mNode))
+  {
+
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::reference skip_map_iterator<Value, Pointer,
+      Reference>::operator*() const
+  {
+    return mNode->mValue;
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::pointer skip_map_iterator<Value, Pointer,
+      Reference>::operator->() const
+  {
+    return &mNode->mValue;
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::this_type&
+  skip_map_iterator<Value, Pointer, Reference>::operator++()
+  {
+    mNode = mNode->mNext[0];
+    return *this;
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::this_type skip_map_iterator<Value, Pointer,
+      Reference>::operator++(int)
+  {
+    this_type temp(*this);
+    mNode = mNode->mNext[0];
+    return temp;
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::this_type&
+  skip_map_iterator<Value, Pointer, Reference>::operator--()
+  {
+    mNode = mNode->mPrev;
+    return *this;
+  }
+
+  template<typename Value, typename Pointer, typename Reference>
+  inline typename skip_map_iterator<Value, Pointer, Reference>::this_type skip_map_iterator<Value, Pointer,
+      Reference>::operator--(int)
+  {
+    this_type temp(*this);
+    mNode = mNode->mPrev;
+    return temp;
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+
+  template<typename Value, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const skip_map_iterator<Value, PointerA, ReferenceA>& a,
+      const skip_map_iterator<Value, PointerB, ReferenceB>& b)
+  {
+    return a.mNode == b.mNode;
+  }
+
+  template<typename Value, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const skip_map_iterator<Value, PointerA, ReferenceA>& a,
+      const skip_map_iterator<Value, PointerB, ReferenceB>& b)
+  {
+    return a.mNode != b.mNode;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_SKIP_MAP_ITERATOR_H */
@@ -0,0 +1,117 @@
+#ifndef FLEX_INTERNAL_SLIST_ITERATOR_H
+#define FLEX_INTERNAL_SLIST_ITERATOR_H
+
+#include <iterator>
+
+namespace flex
+{
+
+  struct slist_node_base
+  {
+    slist_node_base* mNext;
+  };
+
+  template<class T> struct slist_node: public slist_node_base
+  {
+    T mValue;
+  };
+
+  template<typename T, typename Pointer = T*, typename Reference = T&>
+  struct slist_iterator
+  {
+    typedef slist_iterator<T, Pointer, Reference> this_type;
+    typedef slist_iterator<T, T*, T&> iterator;
+    typedef slist_node<T> node_type;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+  public:
+    node_type* mNode;
+
+  public:
+    slist_iterator();
+    slist_iterator(const slist_node_base * pNode);
+    slist_iterator(const iterator & x);
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    this_type& operator++();
+    this_type operator++(int);
+  };
+
+  template<typename T, typename Pointer, typename Reference>
+  inline slist_iterator<T, Pointer, Reference>::slist_iterator() :
+      mNode()
+  {
+
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline slist_iterator<T, Pointer, Reference>::slist_iterator(const slist_node_base* pNode) :
+      mNode(static_cast<node_type*>((slist_node<T>*) const_cast<slist_node_base*>(pNode)))
+  {
+
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline slist_iterator<T, Pointer, Reference>::slist_iterator(const iterator& x) :
+      mNode(const_cast<node_type*>(x.mNode))
+  {
+
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline typename slist_iterator<T, Pointer, Reference>::reference slist_iterator<T, Pointer, Reference>::operator*() const
+  {
+    return mNode->mValue;
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline typename slist_iterator<T, Pointer, Reference>::pointer slist_iterator<T, Pointer, Reference>::operator->() const
+  {
+    return &mNode->mValue;
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline typename slist_iterator<T, Pointer, Reference>::this_type&
+  slist_iterator<T, Pointer, Reference>::operator++()
+  {
+    mNode = static_cast<node_type*>(mNode->mNext);
+    return *this;
+  }
+
+  template<typename T, typename Pointer, typename Reference>
+  inline typename slist_iterator<T, Pointer, Reference>::this_type slist_iterator<T, Pointer, Reference>::operator++(int)
+  {
+    this_type temp(*this);
+    mNode = static_cast<node_type*>(mNode->mNext);
+    return temp;
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+
+  template<typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const slist_iterator<T, PointerA, ReferenceA>& a,
+      const slist_iterator<T, PointerB, ReferenceB>& b)
+  {
+    return a.mNode == b.mNode;
+  }
+
+  template<typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const slist_iterator<T, PointerA, ReferenceA>& a,
+      const slist_iterator<T, PointerB, ReferenceB>& b)
+  {
+    return a.mNode != b.mNode;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_SLIST_ITERATOR_H */
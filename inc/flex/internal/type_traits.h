@@ -1,6 +1,8 @@
 #ifndef FLEX_INTERNAL_TYPE_TRAITS_H
 #define FLEX_INTERNAL_TYPE_TRAITS_H
 
+#include <flex/config.h>
+
 #ifdef FLEX_HAS_CXX11
 
 #include <type_traits>
@@ -0,0 +1,165 @@
+#ifndef FLEX_INTERNAL_UNROLLED_LIST_ITERATOR_H
+#define FLEX_INTERNAL_UNROLLED_LIST_ITERATOR_H
+
+#include <flex/config.h>
+#include <flex/internal/list_iterator.h>
+
+namespace flex
+{
+
+  //The default number of elements per chunk fills about four cache lines, and never fewer than 8 elements.
+  template<class T> struct unrolled_list_default_size
+  {
+    static const size_t value =
+        (sizeof(T) * 8 < 4 * FLEX_CACHE_LINE_SIZE) ? (4 * FLEX_CACHE_LINE_SIZE / sizeof(T)) : 8;
+  };
+
+  //A chunk of an unrolled_list.  It is linked into the list like a list node, and holds up to K elements
+  //packed at the front of its buffer.  The elements are constructed in place by the container.
+  template<class T, size_t K>
+  struct unrolled_list_chunk: public list_node_base
+  {
+    size_t mCount;
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[K];
+#else
+    union
+    {
+      char mBuffer[K * sizeof(T)];
+      long double dummy;
+    };
+#endif
+  };
+
+  //Iterator over an unrolled_list.  It holds the chunk and the index of the element within it.  end() is the
+  //list's anchor node with index 0.
+  template<typename T, size_t K, typename Pointer = T*, typename Reference = T&>
+  struct unrolled_list_iterator
+  {
+    typedef unrolled_list_iterator<T, K, Pointer, Reference> this_type;
+    typedef unrolled_list_iterator<T, K, T*, T&> iterator;
+    typedef unrolled_list_chunk<T, K> chunk_type;
+
+    /*
+     * The 5 typedefs below are required by the std library to properly identify an iterator.
+     */
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+  public:
+    list_node_base* mNode;
+    size_t mIndex;
+
+  public:
+    unrolled_list_iterator();
+    unrolled_list_iterator(const list_node_base* pNode, size_t index);
+    unrolled_list_iterator(const iterator& x);
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    this_type& operator++();
+    this_type operator++(int);
+
+    this_type& operator--();
+    this_type operator--(int);
+  };
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline unrolled_list_iterator<T, K, Pointer, Reference>::unrolled_list_iterator() :
+      mNode(), mIndex()
+  {
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline unrolled_list_iterator<T, K, Pointer, Reference>::unrolled_list_iterator(const list_node_base* pNode,
+      size_t index) :
+      mNode(const_cast<list_node_base*>(pNode)), mIndex(index)
+  {
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline unrolled_list_iterator<T, K, Pointer, Reference>::unrolled_list_iterator(const iterator& x) :
+      mNode(x.mNode), mIndex(x.mIndex)
+  {
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::reference unrolled_list_iterator<T, K, Pointer,
+      Reference>::operator*() const
+  {
+    return ((T*) static_cast<chunk_type*>(mNode)->mBuffer)[mIndex];
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::pointer unrolled_list_iterator<T, K, Pointer,
+      Reference>::operator->() const
+  {
+    return ((T*) static_cast<chunk_type*>(mNode)->mBuffer) + mIndex;
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::this_type&
+  unrolled_list_iterator<T, K, Pointer, Reference>::operator++()
+  {
+    if (++mIndex == static_cast<chunk_type*>(mNode)->mCount)
+    {
+      mNode = mNode->mNext;
+      mIndex = 0;
+    }
+    return *this;
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::this_type unrolled_list_iterator<T, K, Pointer,
+      Reference>::operator++(int)
+  {
+    this_type temp(*this);
+    ++(*this);
+    return temp;
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::this_type&
+  unrolled_list_iterator<T, K, Pointer, Reference>::operator--()
+  {
+    if (mIndex == 0)
+    {
+      mNode = mNode->mPrev;
+      mIndex = static_cast<chunk_type*>(mNode)->mCount;
+    }
+    --mIndex;
+    return *this;
+  }
+
+  template<typename T, size_t K, typename Pointer, typename Reference>
+  inline typename unrolled_list_iterator<T, K, Pointer, Reference>::this_type unrolled_list_iterator<T, K, Pointer,
+      Reference>::operator--(int)
+  {
+    this_type temp(*this);
+    --(*this);
+    return temp;
+  }
+
+  // Extra template parameters were put in to support comparisons between const and non-const iterators.
+
+  template<typename T, size_t K, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator==(const unrolled_list_iterator<T, K, PointerA, ReferenceA>& a,
+      const unrolled_list_iterator<T, K, PointerB, ReferenceB>& b)
+  {
+    return (a.mNode == b.mNode) && (a.mIndex == b.mIndex);
+  }
+
+  template<typename T, size_t K, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+  inline bool operator!=(const unrolled_list_iterator<T, K, PointerA, ReferenceA>& a,
+      const unrolled_list_iterator<T, K, PointerB, ReferenceB>& b)
+  {
+    return (a.mNode != b.mNode) || (a.mIndex != b.mIndex);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTERNAL_UNROLLED_LIST_ITERATOR_H */
@@ -0,0 +1,471 @@
+#ifndef FLEX_INTRUSIVE_LIST_H
+#define FLEX_INTRUSIVE_LIST_H
+
+#include <flex/allocation_guard.h>
+#include <flex/internal/intrusive_list_iterator.h>
+
+namespace flex
+{
+
+  //The links an object needs to sit on an intrusive_list.  An object derives from one hook per list it may be
+  //on at the same time, each with its own Tag type to tell them apart.  An unlinked hook has null links, which
+  //is how is_linked() and the assertions below detect misuse.
+  //
+  //If AutoUnlink is set, destroying a linked object removes it from its list.  Otherwise destroying a linked
+  //object is reported as an error, since the list would be left pointing at it.
+  template<class Tag = void, bool AutoUnlink = false> class intrusive_list_hook: public list_node_base
+  {
+  public:
+    intrusive_list_hook();
+    intrusive_list_hook(const intrusive_list_hook& obj);
+    ~intrusive_list_hook();
+
+    bool is_linked() const;
+    intrusive_list_hook& operator=(const intrusive_list_hook& obj);
+    void unlink();
+  };
+
+  template<class Tag, bool AutoUnlink>
+  inline intrusive_list_hook<Tag, AutoUnlink>::intrusive_list_hook()
+  {
+    mPrev = mNext = NULL;
+  }
+
+  //Copying an object does not copy its membership in a list.
+  template<class Tag, bool AutoUnlink>
+  inline intrusive_list_hook<Tag, AutoUnlink>::intrusive_list_hook(const intrusive_list_hook& /*obj*/) :
+      list_node_base()
+  {
+    mPrev = mNext = NULL;
+  }
+
+  template<class Tag, bool AutoUnlink>
+  inline intrusive_list_hook<Tag, AutoUnlink>::~intrusive_list_hook()
+  {
+    if (AutoUnlink)
+    {
+      if (is_linked())
+      {
+        remove();
+      }
+    }
+    else
+    {
+      FLEX_ERROR_MSG_IF(is_linked(), "flex::intrusive_list_hook: destroyed an element that is still linked");
+    }
+  }
+
+  template<class Tag, bool AutoUnlink>
+  inline bool intrusive_list_hook<Tag, AutoUnlink>::is_linked() const
+  {
+    return (mNext != NULL);
+  }
+
+  template<class Tag, bool AutoUnlink>
+  inline intrusive_list_hook<Tag, AutoUnlink>& intrusive_list_hook<Tag, AutoUnlink>::operator=(
+      const intrusive_list_hook& /*obj*/)
+  {
+    return *this;
+  }
+
+  //Removes the object from whichever list it is on, without needing the list itself.  Does nothing if the
+  //object is not linked.
+  template<class Tag, bool AutoUnlink>
+  inline void intrusive_list_hook<Tag, AutoUnlink>::unlink()
+  {
+    if (is_linked())
+    {
+      remove();
+      mPrev = mNext = NULL;
+    }
+  }
+
+  //An intrusive_list links objects that are already owned elsewhere, such as in a fixed_pool or a
+  //fixed_vector, through a Hook base class of T.  Nothing is allocated, copied or destroyed by the list;
+  //insertion and removal only relink pointers.  The list does not own its elements, so clearing or destroying
+  //it just unlinks them.
+  //
+  //An element may be unlinked through its hook without reference to the list, so the list cannot keep a count
+  //of its elements.  size() walks the list; use empty() where possible.
+  template<class T, class Hook = intrusive_list_hook<> > class intrusive_list: public guarded_object
+  {
+  public:
+    typedef intrusive_list<T, Hook> this_type;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef Hook hook_type;
+    typedef intrusive_list_iterator<T, Hook, T*, T&> iterator;
+    typedef intrusive_list_iterator<T, Hook, const T*, const T&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    intrusive_list();
+#ifdef FLEX_HAS_CXX11
+    intrusive_list(intrusive_list<T, Hook>&& x);
+#endif
+    ~intrusive_list();
+
+    reference back();
+    const_reference back() const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    void clear();
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    iterator erase(iterator position);
+    iterator erase(iterator first, iterator last);
+    reference front();
+    const_reference front() const;
+    iterator insert(iterator position, reference val);
+    static iterator iterator_to(reference val);
+    static const_iterator iterator_to(const_reference val);
+#ifdef FLEX_HAS_CXX11
+    intrusive_list<T, Hook>& operator=(intrusive_list<T, Hook>&& x);
+#endif
+    void pop_back();
+    void pop_front();
+    void push_back(reference val);
+    void push_front(reference val);
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    template<typename Predicate> void remove_if(Predicate pred);
+    void reverse();
+    size_type size() const;
+    void splice(iterator position, this_type& x);
+    void splice(iterator position, this_type& x, iterator i);
+    void splice(iterator position, this_type& x, iterator first, iterator last);
+    void swap(intrusive_list<T, Hook>& x);
+    static void unlink(reference val);
+
+  protected:
+    static list_node_base* NodeOf(reference val);
+    static void Unlink(list_node_base* node);
+
+    //See list::mAnchor.
+    list_node_base mAnchor;
+
+  private:
+    //An element can only be on one list per hook, so a list cannot be copied.
+    intrusive_list(const intrusive_list<T, Hook>& obj);
+    intrusive_list<T, Hook>& operator=(const intrusive_list<T, Hook>& obj);
+  };
+
+  template<class T, class Hook>
+  inline intrusive_list<T, Hook>::intrusive_list()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Hook>
+  inline intrusive_list<T, Hook>::intrusive_list(intrusive_list<T, Hook>&& x)
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    swap(x);
+  }
+#endif
+
+  template<class T, class Hook>
+  inline intrusive_list<T, Hook>::~intrusive_list()
+  {
+    clear();
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::reference intrusive_list<T, Hook>::back()
+  {
+    return *iterator(mAnchor.mPrev);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reference intrusive_list<T, Hook>::back() const
+  {
+    return *const_iterator(mAnchor.mPrev);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::begin()
+  {
+    return iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_iterator intrusive_list<T, Hook>::begin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_iterator intrusive_list<T, Hook>::cbegin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_iterator intrusive_list<T, Hook>::cend() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reverse_iterator intrusive_list<T, Hook>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reverse_iterator intrusive_list<T, Hook>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::clear()
+  {
+    //Null the links of every element so their hooks report that they are no longer linked.
+    list_node_base* node = mAnchor.mNext;
+    while (node != &mAnchor)
+    {
+      list_node_base* const next = node->mNext;
+      node->mPrev = node->mNext = NULL;
+      node = next;
+    }
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+  }
+
+  template<class T, class Hook>
+  inline bool intrusive_list<T, Hook>::empty() const
+  {
+    return (mAnchor.mNext == &mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::end()
+  {
+    return iterator(&mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_iterator intrusive_list<T, Hook>::end() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(iterator position)
+  {
+    list_node_base* const next = position.mNode->mNext;
+    Unlink(position.mNode);
+    return iterator(next);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(iterator first, iterator last)
+  {
+    while (first != last)
+    {
+      first = erase(first);
+    }
+    return last;
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::reference intrusive_list<T, Hook>::front()
+  {
+    return *iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reference intrusive_list<T, Hook>::front() const
+  {
+    return *const_iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::insert(iterator position, reference val)
+  {
+    list_node_base* const node = NodeOf(val);
+    FLEX_ERROR_MSG_IF(node->mNext != NULL, "flex::intrusive_list: inserted an element that is already linked");
+    node->insert(position.mNode);
+    return iterator(node);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::iterator_to(reference val)
+  {
+    return iterator(NodeOf(val));
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_iterator intrusive_list<T, Hook>::iterator_to(const_reference val)
+  {
+    return const_iterator(static_cast<const Hook*>(&val));
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Hook>
+  inline intrusive_list<T, Hook>& intrusive_list<T, Hook>::operator=(intrusive_list<T, Hook>&& x)
+  {
+    clear();
+    swap(x);
+    return *this;
+  }
+#endif
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::pop_back()
+  {
+    Unlink(mAnchor.mPrev);
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::pop_front()
+  {
+    Unlink(mAnchor.mNext);
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::push_back(reference val)
+  {
+    insert(end(), val);
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::push_front(reference val)
+  {
+    insert(begin(), val);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::reverse_iterator intrusive_list<T, Hook>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reverse_iterator intrusive_list<T, Hook>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::reverse_iterator intrusive_list<T, Hook>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::const_reverse_iterator intrusive_list<T, Hook>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class T, class Hook>
+  template<typename Predicate>
+  inline void intrusive_list<T, Hook>::remove_if(Predicate pred)
+  {
+    iterator it = begin();
+    while (it != end())
+    {
+      if (pred(*it))
+      {
+        it = erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::reverse()
+  {
+    list_node_base* node_ptr = &mAnchor;
+    do
+    {
+      list_node_base* const tmp = node_ptr->mNext;
+      node_ptr->mNext = node_ptr->mPrev;
+      node_ptr->mPrev = tmp;
+      node_ptr = node_ptr->mPrev;
+    }
+    while (node_ptr != &mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline typename intrusive_list<T, Hook>::size_type intrusive_list<T, Hook>::size() const
+  {
+    return (size_type) std::distance(begin(), end());
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::splice(iterator position, this_type& x)
+  {
+    if (!x.empty())
+    {
+      position.mNode->splice(x.mAnchor.mNext, &x.mAnchor);
+    }
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::splice(iterator position, this_type& /*x*/, iterator i)
+  {
+    iterator last(i);
+    ++last;
+    if ((position != i) && (position != last))
+    {
+      position.mNode->splice(i.mNode, last.mNode);
+    }
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::splice(iterator position, this_type& /*x*/, iterator first, iterator last)
+  {
+    //The range is already in place when position is last.
+    if ((first != last) && (position != last))
+    {
+      position.mNode->splice(first.mNode, last.mNode);
+    }
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::swap(intrusive_list<T, Hook>& x)
+  {
+    list_node_base::swap(mAnchor, x.mAnchor);
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::unlink(reference val)
+  {
+    static_cast<Hook&>(val).unlink();
+  }
+
+  template<class T, class Hook>
+  inline list_node_base* intrusive_list<T, Hook>::NodeOf(reference val)
+  {
+    return static_cast<Hook*>(&val);
+  }
+
+  template<class T, class Hook>
+  inline void intrusive_list<T, Hook>::Unlink(list_node_base* node)
+  {
+    node->remove();
+    node->mPrev = node->mNext = NULL;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_INTRUSIVE_LIST_H */
@@ -2,16 +2,20 @@
 #define FLEX_LIST_H
 
 #include <flex/internal/list_iterator.h>
+#include <flex/internal/list_node_pool.h>
 #include <flex/allocator.h>
 #include <flex/initializer_list.h>
 
+#include <stdint.h>
+
 namespace flex
 {
 
-  template<class T, class Alloc = allocator<list_node<T> > > class list: public guarded_object
+  template<class T, class Alloc = allocator<list_node<T> > > class list: public list_node_pool<T, list_node<T>, Alloc>
   {
   public:
     typedef list<T, Alloc> this_type;
+    typedef list_node_pool<T, list_node<T>, Alloc> node_pool_type;
 
     typedef T value_type;
     typedef T* pointer;
@@ -91,6 +95,7 @@ namespace flex
     void push_back(value_type&& val);
     void push_front(value_type&& val);
 #endif
+    template<typename KeyFunction> void radix_sort(KeyFunction key_fn);
     reverse_iterator rbegin();
     const_reverse_iterator rbegin() const;
     reverse_iterator rend();
@@ -114,29 +119,36 @@ namespace flex
     void unique();
     template<typename BinaryPredicate> void unique(BinaryPredicate binary_pred);
   protected:
+    using node_pool_type::mNodePool;
+    using node_pool_type::mFixedBegin;
+    using node_pool_type::mFixedEnd;
+    using node_pool_type::mAllocator;
+    using node_pool_type::mFixed;
+    using node_pool_type::mOverflow;
+    using node_pool_type::AllocateNode;
+    using node_pool_type::RetrieveNode;
+    using node_pool_type::GetNodePoolSize;
+    using node_pool_type::FillNodePool;
+    using node_pool_type::PushToNodePool;
+    using node_pool_type::PurgeNodePool;
+    using node_pool_type::PurgeOverflowNodes;
 
     list(node_type* first, node_type* last);
 
     /*
-     * Internal methods used by the public sort() method.
+     * Internal methods used by the public sort() and radix_sort() methods.  They work on chains of nodes linked
+     * only by mNext and terminated by NULL.
      */
-    iterator merge(iterator lhs_first, iterator rhs_first, iterator rhs_last);
-    template<typename Compare> iterator merge(iterator lhs_first, iterator rhs_first, iterator rhs_last, Compare comp);
-    template<typename Compare> iterator sort(iterator first, iterator last, size_type n, Compare comp);
-    void splice(iterator position, iterator first, iterator last);
+    void LinkChain(list_node_base* head);
+    template<typename Compare> static list_node_base* MergeChains(list_node_base* a, list_node_base* b,
+        Compare comp);
+    template<typename KeyFunction> static void RadixDeal(list_node_base* head, KeyFunction& key_fn, uint64_t sign,
+        size_t shift, list_node_base** bucket_head, list_node_base*** bucket_tail);
+    template<typename KeyFunction> static list_node_base** RadixPasses(list_node_base*& head, list_node_base** tail,
+        KeyFunction& key_fn, uint64_t sign, uint64_t differ, size_t end);
+    template<typename KeyFunction, typename Key> void RadixSort(KeyFunction key_fn, Key);
 
-    node_type* AllocateNode();
-    node_type* RetrieveNode(const value_type& val);
-#ifdef FLEX_HAS_CXX11
-    node_type* RetrieveNode(value_type&& val);
-    template<class...Args> node_type* RetrieveNode(Args&&... args);
-#endif
-
-    size_type GetNodePoolSize();
-    void FillNodePool(size_type n);
-    void PushToNodePool(node_type* ptr);
     void PushRangeToNodePool(iterator first, iterator last);
-    void PurgeNodePool();
 
     /*
      * The anchor node contains the head and tail pointers for the list.  It is type base_node_type, and doesn't take up
@@ -146,12 +158,6 @@ namespace flex
      */
     base_node_type mAnchor;
     size_type mSize;
-    node_type* mNodePool;
-    node_type* mFixedBegin;
-    node_type* mFixedEnd;
-    Alloc mAllocator;
-    bool mFixed;
-    bool mOverflow;
 
   private:
 
@@ -159,14 +165,14 @@ namespace flex
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list() :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
   }
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list(size_type size, const T& val) :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     insert(begin(), size, val);
@@ -174,7 +180,7 @@ namespace flex
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list(int size, const T& val) :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     insert(begin(), (size_type) size, val);
@@ -183,7 +189,7 @@ namespace flex
   template<class T, class Alloc>
   template<typename InputIterator>
   inline list<T, Alloc>::list(InputIterator first, InputIterator last) :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     insert(begin(), first, last);
@@ -191,7 +197,7 @@ namespace flex
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list(const list<T, Alloc> & obj) :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     insert(begin(), obj.cbegin(), obj.cend());
@@ -200,7 +206,7 @@ namespace flex
 #ifdef FLEX_HAS_CXX11
   template<class T, class Alloc>
   inline list<T, Alloc>::list(list<T, Alloc> && obj):
-  mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+  mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     swap(std::move(obj));
@@ -209,7 +215,7 @@ namespace flex
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list(std::initializer_list<value_type> il) :
-      mSize(0), mNodePool(NULL), mFixedBegin(NULL), mFixedEnd(NULL), mFixed(false), mOverflow(false)
+      mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
     insert(begin(), il.begin(), il.end());
@@ -224,9 +230,9 @@ namespace flex
     {
       for (iterator it = begin(); it != end(); )
       {
-		iterator tmp = it;
-		++it;
-        mAllocator.deallocate(it.mNode, 1);
+        iterator tmp = it;
+        ++it;
+        mAllocator.deallocate(tmp.mNode, 1);
       }
 
       PurgeNodePool();
@@ -713,71 +719,6 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename list<T, Alloc>::iterator list<T, Alloc>::merge(iterator lhs_first, iterator rhs_first,
-      iterator rhs_last)
-  {
-    iterator front;
-    if (*rhs_first < *lhs_first)
-    {
-      front = rhs_first;
-    }
-    else
-    {
-      front = lhs_first;
-    }
-
-    while ((lhs_first != rhs_first) && (rhs_first != rhs_last))
-    {
-      if (*rhs_first < *lhs_first)
-      {
-        iterator splice_begin = rhs_first;
-        ++rhs_first;
-        while ((*rhs_first < *lhs_first) && (rhs_first != rhs_last))
-        {
-          ++rhs_first;
-        }
-        splice(lhs_first, splice_begin, rhs_first);
-      }
-      ++lhs_first;
-    }
-
-    return front;
-  }
-
-  template<class T, class Alloc>
-  template<typename Compare>
-  inline typename list<T, Alloc>::iterator list<T, Alloc>::merge(iterator lhs_first, iterator rhs_first,
-      iterator rhs_last, Compare comp)
-  {
-    iterator front;
-    if (*rhs_first < *lhs_first)
-    {
-      front = rhs_first;
-    }
-    else
-    {
-      front = lhs_first;
-    }
-
-    while ((lhs_first != rhs_first) && (rhs_first != rhs_last))
-    {
-      if (comp(*rhs_first, *lhs_first))
-      {
-        iterator splice_begin = rhs_first;
-        ++rhs_first;
-        while (comp(*rhs_first, *lhs_first) && (rhs_first != rhs_last))
-        {
-          ++rhs_first;
-        }
-        splice(lhs_first, splice_begin, rhs_first);
-      }
-      ++lhs_first;
-    }
-
-    return front;
-  }
-
   template<class T, class Alloc>
   inline list<T, Alloc>& list<T, Alloc>::operator=(const list<T, Alloc>& obj)
   {
@@ -875,6 +816,17 @@ namespace flex
   }
 #endif
 
+  template<class T, class Alloc>
+  template<typename KeyFunction>
+  inline void list<T, Alloc>::radix_sort(KeyFunction key_fn)
+  {
+    //The sample key lets RadixSort() deduce the key type without relying on C++11.
+    if (mSize > 1)
+    {
+      RadixSort(key_fn, key_fn(front()));
+    }
+  }
+
   template<class T, class Alloc>
   inline typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rbegin()
   {
@@ -998,93 +950,55 @@ namespace flex
   template<typename T, typename Alloc>
   inline void list<T, Alloc>::sort()
   {
-    std::less<value_type> comp;
-    sort(begin(), end(), size(), comp);
+    sort(std::less<value_type>());
   }
 
   template<typename T, typename Alloc>
   template<typename Compare>
   inline void list<T, Alloc>::sort(Compare comp)
   {
-    sort(begin(), end(), size(), comp);
-  }
-
-  template<typename T, typename Alloc>
-  template<typename Compare>
-  inline typename list<T, Alloc>::iterator list<T, Alloc>::sort(iterator first, iterator last, size_type n,
-      Compare comp)
-  {
-    switch (n)
+    if (mSize < 2)
     {
-    case 0:
-    case 1:
-      return first;
-    case 2: //Optimize when size is 2 (Not required)
-      if (comp(*--last, *first))
-      {
-        last.mNode->remove();
-        last.mNode->insert(first.mNode);
-        return last;
-      }
-      return first;
-    case 3: //Optimize when size is 3 (Not required)
+      return;
+    }
+
+    //Bottom-up merge sort over the next links alone.  bins[k] holds a sorted chain of 2^k nodes, so merging a
+    //new node in works like incrementing a binary counter, and no pass walks the list to find a midpoint.
+    //The prev links are rebuilt once at the end.
+    list_node_base* bins[sizeof(size_type) * 8 + 1];
+    size_t bin_count = 0;
+
+    mAnchor.mPrev->mNext = NULL;
+    list_node_base* node = mAnchor.mNext;
+    while (node)
     {
-      iterator mid = first;
-      ++mid;
-      --last;
-      //Unroll every combination of three elements.
-      if (comp(*mid, *first))
+      list_node_base* carry = node;
+      node = node->mNext;
+      carry->mNext = NULL;
+
+      size_t k = 0;
+      for (; (k < bin_count) && bins[k]; ++k)
       {
-        if (comp(*last, *mid))
-        {
-          //3 2 1
-          list_node_base::swap_not_empty(*first.mNode, *last.mNode);
-          return last;
-        }
-        else if (comp(*last, *first))
-        {
-          //3 1 2
-          first.mNode->remove();
-          first.mNode->insert(last.mNode->mNext);
-          return mid;
-        }
-        else
-        {
-          //2 1 3
-          mid.mNode->remove();
-          mid.mNode->insert(first.mNode);
-          return mid;
-        }
+        carry = MergeChains(bins[k], carry, comp);
+        bins[k] = NULL;
       }
-      else if (comp(*last, *first))
+      if (k == bin_count)
       {
-        //2 3 1
-        last.mNode->remove();
-        last.mNode->insert(first.mNode);
-        return last;
+        ++bin_count;
       }
-      else if (comp(*last, *mid))
+      bins[k] = carry;
+    }
+
+    //Lower bins hold the later elements, so each is merged in as the right hand side to keep the sort stable.
+    list_node_base* head = NULL;
+    for (size_t k = 0; k < bin_count; ++k)
+    {
+      if (bins[k])
       {
-        //1 3 2
-        last.mNode->remove();
-        last.mNode->insert(mid.mNode);
-        return first;
+        head = MergeChains(bins[k], head, comp);
       }
-      // 1 2 3
-      return first;
-    } //end of case 3
-    default: //merge sort for all larger sizes
-    {
-      size_type new_size = n / 2;
-      iterator mid(first);
-      std::advance(mid, new_size);
-
-      iterator lhs_front = sort(first, mid, new_size, comp);
-      iterator rhs_front = sort(mid, last, n - new_size, comp);
-
-      return merge(lhs_front, rhs_front, last, comp);
-    } //end of default
-    } //end of switch
+    }
+    LinkChain(head);
   }
 
   template<typename T, typename Alloc>
@@ -1152,15 +1066,6 @@ namespace flex
     }
   }
 
-  template<typename T, typename Alloc>
-  inline void list<T, Alloc>::splice(iterator position, iterator first, iterator last)
-  {
-    if (first != last)
-    {
-      ((base_node_type*) position.mNode)->splice((base_node_type*) first.mNode, (base_node_type*) last.mNode);
-    }
-  }
-
   template<class T, class Alloc>
   inline void list<T, Alloc>::swap(list<T, Alloc>& obj)
   {
@@ -1263,119 +1168,161 @@ namespace flex
 
   template<class T, class Alloc>
   inline list<T, Alloc>::list(node_type* first, node_type* last) :
-      mSize(0), mNodePool(NULL), mFixedBegin(first), mFixedEnd(last), mFixed(true), mOverflow(false)
+      node_pool_type(first, last), mSize(0)
   {
     mAnchor.mNext = mAnchor.mPrev = &mAnchor;
   }
 
   template<class T, class Alloc>
-  inline typename list<T, Alloc>::node_type* list<T, Alloc>::AllocateNode()
+  inline void list<T, Alloc>::LinkChain(list_node_base* head)
   {
-    if (mFixedBegin != mFixedEnd)
+    //Makes the chain starting at head the contents of the list, restoring the prev links.
+    list_node_base* prev = &mAnchor;
+    for (list_node_base* node = head; node; node = node->mNext)
     {
-      return mFixedBegin++;
+      node->mPrev = prev;
+      prev = node;
     }
-    else
+    mAnchor.mNext = head ? head : &mAnchor;
+    mAnchor.mPrev = prev;
+    prev->mNext = &mAnchor;
+  }
+
+  template<class T, class Alloc>
+  template<typename Compare>
+  inline list_node_base* list<T, Alloc>::MergeChains(list_node_base* a, list_node_base* b, Compare comp)
+  {
+    //Merges two sorted chains.  Ties are taken from a.
+    list_node_base* head;
+    list_node_base** tail = &head;
+    while (a && b)
     {
-#ifndef FLEX_RELEASE
-      if (FLEX_UNLIKELY(mFixed))
+      if (comp(static_cast<node_type*>(b)->mValue, static_cast<node_type*>(a)->mValue))
       {
-        if (!mOverflow)
-        {
-          mOverflow = true;
-          flex::error_msg("flex::fixed_list - exceeded capacity");
-        }
+        *tail = b;
+        tail = &b->mNext;
+        b = b->mNext;
+      }
+      else
+      {
+        *tail = a;
+        tail = &a->mNext;
+        a = a->mNext;
       }
-#endif
-      return mAllocator.allocate(1);
     }
+    *tail = a ? a : b;
+    return head;
   }
 
   template<class T, class Alloc>
-  inline list_node<T>* list<T, Alloc>::RetrieveNode(const value_type& val)
+  template<typename KeyFunction>
+  inline void list<T, Alloc>::RadixDeal(list_node_base* head, KeyFunction& key_fn, uint64_t sign, size_t shift,
+      list_node_base** bucket_head, list_node_base*** bucket_tail)
   {
-    node_type* ptr;
-    if (NULL == mNodePool)
+    //Appends each node of the chain to the bucket of its key's byte at shift.  Order within a bucket is kept.
+    //bucket_tail[b] is left pointing at the mNext of the last node in bucket b, or at bucket_head[b] if empty.
+    for (size_t b = 0; b < 256; ++b)
     {
-      ptr = AllocateNode();
+      bucket_tail[b] = &bucket_head[b];
     }
-    else
+    for (list_node_base* node = head; node; node = node->mNext)
     {
-      ptr = mNodePool;
-      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+      const uint64_t key = (uint64_t) key_fn(static_cast<node_type*>(node)->mValue) ^ sign;
+      const size_t b = (size_t) ((key >> shift) & 0xFF);
+      *bucket_tail[b] = node;
+      bucket_tail[b] = &node->mNext;
     }
-    new ((void*) &ptr->mValue) value_type(val);
-    return ptr;
   }
 
-#ifdef FLEX_HAS_CXX11
   template<class T, class Alloc>
-  inline list_node<T>* list<T, Alloc>::RetrieveNode(value_type&& val)
+  template<typename KeyFunction>
+  inline list_node_base** list<T, Alloc>::RadixPasses(list_node_base*& head, list_node_base** tail,
+      KeyFunction& key_fn, uint64_t sign, uint64_t differ, size_t end)
   {
-    node_type* ptr;
-    if (NULL == mNodePool)
+    //Sorts the chain least significant byte first, on each byte below end that differs between keys.  tail is
+    //the mNext of its last node.  Returns the mNext of the last node after sorting.
+    list_node_base* bucket_head[256];
+    list_node_base** bucket_tail[256];
+    for (size_t shift = 0; shift < end; shift += 8)
     {
-      ptr = AllocateNode();
-    }
-    else
-    {
-      ptr = mNodePool;
-      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+      if (((differ >> shift) & 0xFF) == 0)
+      {
+        continue;
+      }
+
+      RadixDeal(head, key_fn, sign, shift, bucket_head, bucket_tail);
+      tail = &head;
+      for (size_t b = 0; b < 256; ++b)
+      {
+        if (bucket_tail[b] != &bucket_head[b])
+        {
+          *tail = bucket_head[b];
+          tail = bucket_tail[b];
+        }
+      }
+      *tail = NULL;
     }
-    new ((void*) &ptr->mValue) value_type(std::move(val));
-    return ptr;
+    return tail;
   }
 
   template<class T, class Alloc>
-  template<class...Args>
-  inline list_node<T>* list<T, Alloc>::RetrieveNode(Args&&... args)
+  template<typename KeyFunction, typename Key>
+  inline void list<T, Alloc>::RadixSort(KeyFunction key_fn, Key)
   {
-    node_type* ptr;
-    if (NULL == mNodePool)
+#ifdef FLEX_HAS_CXX11
+    static_assert(std::is_integral<Key>::value, "flex::list.radix_sort() requires an integral key");
+#endif
+    //Keys are compared a byte at a time, with the sign bit flipped so signed keys order correctly.  A first
+    //pass finds the bytes on which every key agrees, and those are skipped.
+    const uint64_t sign = (Key(-1) < Key(0)) ? (uint64_t(1) << (sizeof(Key) * 8 - 1)) : 0;
+    list_node_base** const last = &mAnchor.mPrev->mNext;
+    list_node_base* head = mAnchor.mNext;
+
+    const uint64_t first_key = (uint64_t) key_fn(static_cast<node_type*>(head)->mValue);
+    uint64_t differ = 0;
+    size_t top = 0;
+    for (list_node_base* node = head->mNext; node != &mAnchor; node = node->mNext)
     {
-      ptr = AllocateNode();
+      differ |= first_key ^ (uint64_t) key_fn(static_cast<node_type*>(node)->mValue);
     }
-    else
+    for (size_t shift = 8; shift < sizeof(Key) * 8; shift += 8)
     {
-      ptr = mNodePool;
-      mNodePool = static_cast<node_type*>(mNodePool->mNext);
+      if ((differ >> shift) & 0xFF)
+      {
+        top = shift;
+      }
     }
-    new ((void*) &ptr->mValue) value_type(std::forward<Args>(args)...);
-    return ptr;
-  }
-#endif
+    *last = NULL;
 
-  template<class T, class Alloc>
-  inline typename list<T, Alloc>::size_type list<T, Alloc>::GetNodePoolSize()
-  {
-    size_type n = 0;
-    node_type* node_ptr = mNodePool;
-    while (node_ptr != NULL)
+    if ((top == 0) || (mSize < 256 * 256))
     {
-      node_ptr = static_cast<node_type*>(node_ptr->mNext);
-      ++n;
+      RadixPasses(head, last, key_fn, sign, differ, top + 8);
     }
-    return n;
-  }
-
-  template<class T, class Alloc>
-  inline void list<T, Alloc>::FillNodePool(size_type n)
-  {
-    for (; n; --n)
+    else
     {
-      node_type* node_ptr = AllocateNode();
-      node_ptr->mNext = mNodePool;
-      mNodePool = node_ptr;
+      //Walking a long list in link order misses the cache on nearly every node.  So the nodes are first dealt
+      //by the most significant differing byte, and each bucket is then sorted on the lower bytes by itself.
+      //Most of those passes stay within a working set that fits in cache.
+      list_node_base* msd_head[256];
+      list_node_base** msd_tail[256];
+      RadixDeal(head, key_fn, sign, top, msd_head, msd_tail);
+
+      list_node_base** tail = &head;
+      for (size_t b = 0; b < 256; ++b)
+      {
+        if (msd_tail[b] != &msd_head[b])
+        {
+          *msd_tail[b] = NULL;
+          *tail = msd_head[b];
+          tail = RadixPasses(*tail, msd_tail[b], key_fn, sign, differ, top);
+        }
+      }
     }
+    LinkChain(head);
   }
 
-  template<class T, class Alloc>
-  inline void list<T, Alloc>::PushToNodePool(list_node<T>* ptr)
-  {
-    ptr->mValue.~value_type();
-    ptr->mNext = mNodePool;
-    mNodePool = ptr;
-  }
+#ifdef FLEX_HAS_CXX11
+#endif
 
   template<class T, class Alloc>
   inline void list<T, Alloc>::PushRangeToNodePool(iterator first, iterator last)
@@ -1396,17 +1343,6 @@ namespace flex
     mNodePool = first.mNode;
   }
 
-  template<class T, class Alloc>
-  inline void list<T, Alloc>::PurgeNodePool(void)
-  {
-    while (mNodePool != NULL)
-    {
-      node_type* next = static_cast<node_type*>(mNodePool->mNext);
-      mAllocator.deallocate(mNodePool, 1);
-      mNodePool = next;
-    }
-  }
-
   template<class T, class Alloc>
   bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs)
   {
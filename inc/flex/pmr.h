@@ -0,0 +1,297 @@
+#ifndef FLEX_PMR_H
+#define FLEX_PMR_H
+
+#include <flex/config.h>
+
+#ifdef FLEX_HAS_CXX17
+
+#include <cstddef>//For std::max_align_t used in the byte alignment
+#include <limits>//For std::numeric_limits used in max_size()
+#include <memory_resource>
+
+#include <flex/allocation_guard.h>
+#include <flex/hash_map.h>
+#include <flex/list.h>
+#include <flex/pool.h>
+#include <flex/string.h>
+#include <flex/vector.h>
+
+namespace flex
+{
+
+  //An allocator that forwards to a std::pmr::memory_resource, allowing one resource (such as a
+  //monotonic_buffer_resource or an unsynchronized_pool_resource) to back both std and flex containers.
+  //Containers always default construct their allocator, so a default constructed pmr_allocator binds to
+  //std::pmr::get_default_resource().  Use flex::pmr::resource_scope to select the resource for a block of
+  //single-threaded code.
+  template<class T> class pmr_allocator: public guarded_object
+  {
+  public:
+    // type definitions
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // rebind allocator to type U
+    template<class U>
+    struct rebind
+    {
+      typedef pmr_allocator<U> other;
+    };
+
+    // return address of values
+    pointer address(reference value) const
+    {
+      return &value;
+    }
+    const_pointer address(const_reference value) const
+    {
+      return &value;
+    }
+
+    inline pmr_allocator() :
+        mResource(std::pmr::get_default_resource())
+    {
+    }
+
+    inline pmr_allocator(std::pmr::memory_resource* resource) :
+        mResource(resource)
+    {
+    }
+
+    inline pmr_allocator(const pmr_allocator& obj) :
+        mResource(obj.resource())
+    {
+    }
+
+    template<class U>
+    inline pmr_allocator(const pmr_allocator<U>& obj) :
+        mResource(obj.resource())
+    {
+    }
+
+    inline ~pmr_allocator()
+    {
+    }
+
+    // return the memory resource this allocator draws from
+    inline std::pmr::memory_resource* resource() const
+    {
+      return mResource;
+    }
+
+    // return maximum number of elements that can be allocated
+    inline size_type max_size() const
+    {
+      return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    // allocate but don't initialize num elements of type T
+    inline pointer allocate(size_type num, typename std::allocator<void>::const_pointer = 0)
+    {
+      //Only the global heap is reported to the guard.  Any other resource is assumed to be pre-sized.
+      FLEX_ERROR_MSG_IF(sAllocationGuardEnabled && (mResource == std::pmr::new_delete_resource()),
+          "flex::pmr_allocator: performed allocation when guard was enabled");
+      return reinterpret_cast<pointer>(mResource->allocate(num * sizeof(T), alignment));
+    }
+
+    template<class...Args>
+    inline void construct(pointer p, Args&&... args)
+    {
+      // initialize memory with placement new
+      new ((void*) p) T(std::forward<Args>(args)...);
+    }
+
+    // destroy elements of initialized storage p
+    inline void destroy(pointer p)
+    {
+      // destroy objects by calling their destructor
+      p->~T();
+    }
+
+    // deallocate storage p of deleted elements
+    inline void deallocate(pointer p, size_type num)
+    {
+      //Containers release their null storage unconditionally, and a resource need not accept it.
+      if (!p)
+      {
+        return;
+      }
+      mResource->deallocate((void*) p, num * sizeof(T), alignment);
+    }
+
+  private:
+    //Byte allocators (such as the one used by hash_map) carve nodes out of their allocations, so they
+    //are given the same alignment as operator new.
+    static const size_type alignment = (sizeof(T) == 1) ? alignof(std::max_align_t) : alignof(T);
+
+    std::pmr::memory_resource* mResource;
+  };
+
+  // allocators are interchangeable when their memory resources compare equal
+  template<class T1, class T2>
+  bool operator==(const pmr_allocator<T1>& lhs, const pmr_allocator<T2>& rhs)
+  {
+    return *lhs.resource() == *rhs.resource();
+  }
+
+  template<class T1, class T2>
+  bool operator!=(const pmr_allocator<T1>& lhs, const pmr_allocator<T2>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //Exposes a flex::pool or flex::fixed_pool as a std::pmr::memory_resource, so std containers can draw
+  //their nodes from it.  Requests that fit within a pool node are served by the pool, anything larger
+  //(such as the bucket array of a std::pmr::unordered_map) is forwarded to the upstream resource.
+  template<class Pool> class pool_resource: public std::pmr::memory_resource, public guarded_object
+  {
+  public:
+    typedef Pool pool_type;
+    typedef typename pool_type::value_type value_type;
+    typedef typename pool_type::node_type node_type;
+    typedef typename pool_type::size_type size_type;
+
+    pool_resource();
+    explicit pool_resource(std::pmr::memory_resource* upstream);
+
+    pool_type& get_pool();
+    const pool_type& get_pool() const;
+    std::pmr::memory_resource* upstream_resource() const;
+
+  protected:
+    pool_type mPool;
+    std::pmr::memory_resource* mUpstream;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment);
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment);
+    bool do_is_equal(const std::pmr::memory_resource& other) const FLEX_NOEXCEPT;
+
+    static bool IsPoolRequest(std::size_t bytes, std::size_t alignment);
+
+  private:
+    pool_resource(const pool_resource&);
+    pool_resource& operator=(const pool_resource&);
+  };
+
+  template<class Pool>
+  inline pool_resource<Pool>::pool_resource() :
+      mPool(), mUpstream(std::pmr::get_default_resource())
+  {
+  }
+
+  template<class Pool>
+  inline pool_resource<Pool>::pool_resource(std::pmr::memory_resource* upstream) :
+      mPool(), mUpstream(upstream)
+  {
+  }
+
+  template<class Pool>
+  inline typename pool_resource<Pool>::pool_type& pool_resource<Pool>::get_pool()
+  {
+    return mPool;
+  }
+
+  template<class Pool>
+  inline const typename pool_resource<Pool>::pool_type& pool_resource<Pool>::get_pool() const
+  {
+    return mPool;
+  }
+
+  template<class Pool>
+  inline std::pmr::memory_resource* pool_resource<Pool>::upstream_resource() const
+  {
+    return mUpstream;
+  }
+
+  template<class Pool>
+  inline void* pool_resource<Pool>::do_allocate(std::size_t bytes, std::size_t alignment)
+  {
+    if (IsPoolRequest(bytes, alignment))
+    {
+      return mPool.allocate();
+    }
+    else
+    {
+      return mUpstream->allocate(bytes, alignment);
+    }
+  }
+
+  template<class Pool>
+  inline void pool_resource<Pool>::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+  {
+    //The size and alignment passed to deallocate always match the original request, so the same test
+    //decides which resource the pointer came from.
+    if (IsPoolRequest(bytes, alignment))
+    {
+      mPool.deallocate(p);
+    }
+    else
+    {
+      mUpstream->deallocate(p, bytes, alignment);
+    }
+  }
+
+  template<class Pool>
+  inline bool pool_resource<Pool>::do_is_equal(const std::pmr::memory_resource& other) const FLEX_NOEXCEPT
+  {
+    return this == &other;
+  }
+
+  template<class Pool>
+  inline bool pool_resource<Pool>::IsPoolRequest(std::size_t bytes, std::size_t alignment)
+  {
+    return (bytes <= sizeof(node_type)) && (alignment <= alignof(value_type));
+  }
+
+  namespace pmr
+  {
+
+    //Installs a memory resource with std::pmr::set_default_resource() and restores the previous default when
+    //destroyed.  Until then every pmr_allocator (and therefore every flex::pmr container) that is default
+    //constructed picks it up.  The default resource is a single process-wide setting, so this affects every
+    //thread, and scopes opened on different threads restore each other's resources out of order.  Only use it
+    //while one thread is constructing containers; otherwise pass the resource to the allocator explicitly.
+    class resource_scope
+    {
+    public:
+      explicit resource_scope(std::pmr::memory_resource* resource) :
+          mPrevious(std::pmr::set_default_resource(resource))
+      {
+      }
+
+      ~resource_scope()
+      {
+        std::pmr::set_default_resource(mPrevious);
+      }
+
+    private:
+      std::pmr::memory_resource* mPrevious;
+
+      resource_scope(const resource_scope&);
+      resource_scope& operator=(const resource_scope&);
+    };
+
+    template<class T> using vector = flex::vector<T, pmr_allocator<T> >;
+
+    template<class T> using list = flex::list<T, pmr_allocator<list_node<T> > >;
+
+    template<class T> using basic_string = flex::basic_string<T, pmr_allocator<T> >;
+
+    typedef basic_string<char> string;
+    typedef basic_string<wchar_t> wstring;
+
+    template<class Key, class T, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>,
+        bool bCacheHashCode = false> using hash_map = flex::hash_map<Key, T, Hash, Predicate, pmr_allocator<char>, bCacheHashCode>;
+
+  } //namespace pmr
+
+} //namespace flex
+
+#endif /* FLEX_HAS_CXX17 */
+
+#endif /* FLEX_PMR_H */
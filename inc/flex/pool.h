@@ -3,6 +3,8 @@
 
 #include <flex/allocator.h>
 
+#include <algorithm>
+
 namespace flex
 {
 
@@ -58,7 +60,9 @@ namespace flex
     bool empty() const;
     pool& operator=(const pool&);
     void reserve(size_type n);
+    void shrink_to_fit();
     size_type size() const;
+    void swap(pool& obj);
 
   protected:
     pool_link* mHead;
@@ -87,18 +91,7 @@ namespace flex
   template<class T, class Alloc>
   inline pool<T, Alloc>::~pool()
   {
-    if (!mFixed)
-    {
-      //Only want to retrieve pointers when mHead is set (aka !empty()).
-      //Otherwise the pool will internally allocate new objects.
-      while (mHead)
-      {
-        //Do not confuse the mAllocator allocate/deallocate methods with the pool methods.  The pool's
-        //allocate() method is called to remove a pointer from the pool.  This is then deleted
-        //by mAllocator.  Think of the allocate() method as pool.pop_front().
-        mAllocator.deallocate((node_type*)allocate(), 1);
-      }
-    }
+    shrink_to_fit();
   }
 
   template<class T, class Alloc>
@@ -171,6 +164,25 @@ namespace flex
     return (mHead == NULL);
   }
 
+  template<class T, class Alloc>
+  inline void pool<T, Alloc>::shrink_to_fit()
+  {
+    //Releases every available object back to the allocator.  A fixed pool does not own its buffer, so
+    //there is nothing to release.
+    if (!mFixed)
+    {
+      //Only want to retrieve pointers when mHead is set (aka !empty()).
+      //Otherwise the pool will internally allocate new objects.
+      while (mHead)
+      {
+        //Do not confuse the mAllocator allocate/deallocate methods with the pool methods.  The pool's
+        //allocate() method is called to remove a pointer from the pool.  This is then deleted
+        //by mAllocator.  Think of the allocate() method as pool.pop_front().
+        mAllocator.deallocate((node_type*)allocate(), 1);
+      }
+    }
+  }
+
   template<class T, class Alloc>
   inline typename pool<T, Alloc>::size_type pool<T, Alloc>::size() const
   {
@@ -200,6 +212,20 @@ namespace flex
     }
   }
 
+  template<class T, class Alloc>
+  inline void pool<T, Alloc>::swap(pool& obj)
+  {
+    //Exchanges the available objects together with the allocators that own them.  A fixed pool's objects
+    //live in its own buffer, so they cannot change hands.
+    if (FLEX_UNLIKELY(mFixed || obj.mFixed))
+    {
+      flex::error_msg("flex::pool: cannot swap a fixed pool");
+      return;
+    }
+    std::swap(mHead, obj.mHead);
+    std::swap(mAllocator, obj.mAllocator);
+  }
+
   template<class T, class Alloc>
   inline pool<T, Alloc>::pool(node_type* first, node_type* last) :
       mHead(NULL), mFixed(true), mOverflow(false)
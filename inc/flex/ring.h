@@ -4,14 +4,16 @@
 #include <flex/internal/ring_iterator.h>
 
 #include <flex/allocator.h>
+#include <flex/growth_policy.h>
 #include <flex/initializer_list.h>
+#include <flex/internal/relocate.h>
 
 #include <algorithm>
 #include <memory>
 
 namespace flex
 {
-  template<class T, class Alloc = allocator<T> >
+  template<class T, class Alloc = allocator<T>, class Growth = double_growth>
   class ring_base: public guarded_object
   {
   public:
@@ -27,6 +29,7 @@ namespace flex
     typedef size_t size_type;
     typedef std::ptrdiff_t difference_type;
     typedef Alloc allocator_type;
+    typedef Growth growth_policy;
 
   protected:
 
@@ -44,13 +47,14 @@ namespace flex
     ~ring_base();
 
     pointer Allocate(size_type n);
+    void Deallocate();
     void DestroyAndDeallocate();
   };
 
-  template<class T, class Alloc = allocator<T> > class ring: public ring_base<T, Alloc>
+  template<class T, class Alloc = allocator<T>, class Growth = double_growth> class ring: public ring_base<T, Alloc, Growth>
   {
-    typedef ring_base<T, Alloc> base_type;
-    typedef ring<T, Alloc> this_type;
+    typedef ring_base<T, Alloc, Growth> base_type;
+    typedef ring<T, Alloc, Growth> this_type;
 
   public:
     typedef typename base_type::value_type value_type;
@@ -65,22 +69,24 @@ namespace flex
     typedef typename base_type::size_type size_type;
     typedef typename base_type::difference_type difference_type;
     typedef typename base_type::allocator_type allocator_type;
+    typedef typename base_type::growth_policy growth_policy;
 
     using base_type::mAllocator;
     using base_type::mBegin;
     using base_type::mEnd;
     using base_type::mFixed;
     using base_type::Allocate;
+    using base_type::Deallocate;
     using base_type::DestroyAndDeallocate;
 
     ring();
     explicit ring(size_type size, const value_type& val = value_type());
     ring(int size, const value_type& val);
     template<typename InputIterator> ring(InputIterator first, InputIterator last);
-    ring(const ring<T, Alloc> & obj);
+    ring(const ring<T, Alloc, Growth> & obj);
     ring(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    ring(ring<T, Alloc> && obj);
+    ring(ring<T, Alloc, Growth> && obj);
 #endif
     void assign(size_type size, const value_type& val);
     void assign(int size, const value_type& val);
@@ -107,6 +113,8 @@ namespace flex
     bool empty() const;
     iterator erase(iterator position);
     iterator erase(iterator first, iterator last);
+    template<class Predicate> size_type erase_if(Predicate pred);
+    iterator erase_unordered(iterator position);
     iterator end();
     const_iterator end() const;
     bool fixed() const;
@@ -122,10 +130,10 @@ namespace flex
     void insert(iterator position, int n, const value_type& val);
     template<typename InputIterator> void insert(iterator position, InputIterator first, InputIterator last);
     size_type max_size() const;
-    ring<T, Alloc>& operator=(const ring<T, Alloc>& obj);
-    ring<T, Alloc>& operator=(std::initializer_list<value_type> il);
+    ring<T, Alloc, Growth>& operator=(const ring<T, Alloc, Growth>& obj);
+    ring<T, Alloc, Growth>& operator=(std::initializer_list<value_type> il);
 #ifdef FLEX_HAS_CXX11
-    ring<T, Alloc>& operator=(ring<T, Alloc>&& obj);
+    ring<T, Alloc, Growth>& operator=(ring<T, Alloc, Growth>&& obj);
 #endif
     reference operator[](size_type n);
     const_reference operator[](size_type n) const;
@@ -145,9 +153,9 @@ namespace flex
     void resize(size_type n, const value_type& val = value_type());
     void shrink_to_fit();
     size_type size() const;
-    void swap(ring<T, Alloc>& obj);
+    void swap(ring<T, Alloc, Growth>& obj);
 #ifdef FLEX_HAS_CXX11
-    void swap(ring<T, Alloc>&& obj);
+    void swap(ring<T, Alloc, Growth>&& obj);
 #endif
 
   protected:
@@ -155,27 +163,28 @@ namespace flex
 
     size_type GetNewCapacity(size_type min);
     void DeallocateAndReassign(pointer new_begin, pointer new_end, size_type new_capacity);
+    pointer Relocate(iterator first, iterator last, pointer dest);
   };
 
   /*
    * ring_base
    */
-  template<class T, class Alloc>
-  inline ring_base<T, Alloc>::ring_base() :
+  template<class T, class Alloc, class Growth>
+  inline ring_base<T, Alloc, Growth>::ring_base() :
       mBegin(NULL, NULL, NULL), mEnd(NULL, NULL, NULL), mFixed(false)
 
   {
   }
 
-  template<class T, class Alloc>
-  inline ring_base<T, Alloc>::ring_base(size_type n) :
+  template<class T, class Alloc, class Growth>
+  inline ring_base<T, Alloc, Growth>::ring_base(size_type n) :
       mBegin(Allocate(n), n), mEnd(mBegin.mRightBound, mBegin.mPtr, mBegin.mRightBound), mFixed(false)
 
   {
   }
 
-  template<class T, class Alloc>
-  inline ring_base<T, Alloc>::ring_base(pointer new_begin, pointer new_end, pointer right_bound) :
+  template<class T, class Alloc, class Growth>
+  inline ring_base<T, Alloc, Growth>::ring_base(pointer new_begin, pointer new_end, pointer right_bound) :
       mBegin(new_begin, new_begin, right_bound), mEnd(new_end, new_begin, right_bound), mFixed(true)
 
   {
@@ -195,8 +204,8 @@ namespace flex
 #endif
   }
 
-  template<class T, class Alloc>
-  inline ring_base<T, Alloc>::~ring_base()
+  template<class T, class Alloc, class Growth>
+  inline ring_base<T, Alloc, Growth>::~ring_base()
   {
     flex::destruct_range(mBegin, mEnd);
     if (!mFixed)
@@ -206,19 +215,19 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename ring_base<T, Alloc>::pointer ring_base<T, Alloc>::Allocate(size_type capacity)
+  template<class T, class Alloc, class Growth>
+  inline typename ring_base<T, Alloc, Growth>::pointer ring_base<T, Alloc, Growth>::Allocate(size_type capacity)
   {
     //The size allocated is 1 more than the capacity.  This is due to the fact that we don't want begin() to equal end().
     //Therefore there will always be one allocated element that is unused.
     return mAllocator.allocate(capacity + 1);
   }
 
-  template<class T, class Alloc>
-  inline void ring_base<T, Alloc>::DestroyAndDeallocate()
+  template<class T, class Alloc, class Growth>
+  inline void ring_base<T, Alloc, Growth>::Deallocate()
   {
-    flex::destruct_range(mBegin, mEnd);
-
+    //Releases the buffer without destroying its elements.  This is used once the elements have been
+    //relocated to a new buffer.
 #ifndef FLEX_RELEASE
     if (FLEX_UNLIKELY(mFixed))
     {
@@ -232,50 +241,57 @@ namespace flex
     mAllocator.deallocate(mBegin.mLeftBound, (mBegin.mRightBound - mBegin.mLeftBound) + 1);
   }
 
+  template<class T, class Alloc, class Growth>
+  inline void ring_base<T, Alloc, Growth>::DestroyAndDeallocate()
+  {
+    flex::destruct_range(mBegin, mEnd);
+    Deallocate();
+  }
+
   /*
    * ring
    */
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring() :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring() :
       base_type()
   {
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(size_type capacity, const value_type& val) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(size_type capacity, const value_type& val) :
       base_type(capacity)
   {
     //Using mPtr is a bit more efficient, as we know the the newly allocated data doesn't wrap.
     std::uninitialized_fill(mBegin.mPtr, mEnd.mPtr, val);
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(int capacity, const value_type& val) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(int capacity, const value_type& val) :
       base_type(capacity)
   {
     //Using mPtr is a bit more efficient, as we know the the newly allocated data doesn't wrap.
     std::uninitialized_fill(mBegin.mPtr, mEnd.mPtr, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline ring<T, Alloc>::ring(InputIterator first, InputIterator last) :
+  inline ring<T, Alloc, Growth>::ring(InputIterator first, InputIterator last) :
       base_type(std::distance(first, last))
   {
     //Using the mBegin.mPtr is a bit more efficient, as we know the newly allocated data doesn't wrap.
     std::uninitialized_copy(first, last, mBegin.mPtr);
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(const ring<T, Alloc> & obj) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(const ring<T, Alloc, Growth> & obj) :
       base_type(obj.size())
   {
     //Using the mBegin.mPtr is a bit more efficient, as we know the newly allocated data doesn't wrap.
     std::uninitialized_copy(obj.begin(), obj.end(), mBegin.mPtr);
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(std::initializer_list<value_type> il) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(std::initializer_list<value_type> il) :
       base_type(il.size())
   {
     //Using the mBegin.mPtr is a bit more efficient, as we know the newly allocated data doesn't wrap.
@@ -283,16 +299,16 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(ring<T, Alloc> && obj) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(ring<T, Alloc, Growth> && obj) :
   base_type()
   {
     swap(std::move(obj));
   }
 #endif
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::assign(size_type n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::assign(size_type n, const value_type& val)
   {
     if (n > capacity())
     {
@@ -303,6 +319,7 @@ namespace flex
       //Copy all values.
       std::uninitialized_fill_n(new_begin, n, val);
 
+      flex::destruct_range(mBegin, mEnd);
       DeallocateAndReassign(new_begin, new_begin + n, new_capacity);
     }
     else
@@ -325,15 +342,15 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::assign(int new_size, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::assign(int new_size, const value_type& val)
   {
     assign((size_type) new_size, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline void ring<T, Alloc>::assign(InputIterator first, InputIterator last)
+  inline void ring<T, Alloc, Growth>::assign(InputIterator first, InputIterator last)
   {
     size_type n = std::distance(first, last);
     if (n > capacity())
@@ -345,6 +362,7 @@ namespace flex
       //Copy all values.
       pointer new_end = std::uninitialized_copy(first, last, new_begin);
 
+      flex::destruct_range(mBegin, mEnd);
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
     else
@@ -365,91 +383,91 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::assign(std::initializer_list<value_type> il)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::assign(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reference ring<T, Alloc>::at(size_type n)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reference ring<T, Alloc, Growth>::at(size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= size(), "flex::ring.at() - index out-of-bounds");
     return operator[](n);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reference ring<T, Alloc>::at(size_type n) const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reference ring<T, Alloc, Growth>::at(size_type n) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= size(), "flex::ring.at() - index out-of-bounds");
     return operator[](n);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reference ring<T, Alloc>::back()
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reference ring<T, Alloc, Growth>::back()
   {
     return *(mEnd - 1); //subtract 1 since mEnd points to one after the last element
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reference ring<T, Alloc>::back() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reference ring<T, Alloc, Growth>::back() const
   {
     return *(mEnd - 1); //subtract 1 since mEnd points to one after the last element
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::begin()
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::begin()
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_iterator ring<T, Alloc>::begin() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator ring<T, Alloc, Growth>::begin() const
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_iterator ring<T, Alloc>::cbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator ring<T, Alloc, Growth>::cbegin() const
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_iterator ring<T, Alloc>::cend() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator ring<T, Alloc, Growth>::cend() const
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reverse_iterator ring<T, Alloc>::crbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reverse_iterator ring<T, Alloc, Growth>::crbegin() const
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reverse_iterator ring<T, Alloc>::crend() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reverse_iterator ring<T, Alloc, Growth>::crend() const
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::size_type ring<T, Alloc>::capacity() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::size_type ring<T, Alloc, Growth>::capacity() const
   {
     return (mBegin.mRightBound - mBegin.mLeftBound);
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::clear()
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::clear()
   {
     flex::destruct_range(mBegin, mEnd);
     mEnd.mPtr = mBegin.mPtr;
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<class... Args>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::emplace(iterator position, Args&&... args)
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::emplace(iterator position, Args&&... args)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -467,15 +485,13 @@ namespace flex
       size_t new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Construct the inserted value first, as it may refer to an element of this container.
+      iterator new_position(new_begin + (position - mBegin), new_begin, new_begin + new_capacity);
+      new ((void*) new_position.mPtr) T(std::forward<Args>(args)...);
 
-      //Copy the inserted parameter val.
-      iterator new_position(new_end, new_begin, new_begin + new_capacity);
-      new ((void*) new_end) T(std::forward<Args>(args)...);
-
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
+      //Relocate all values to the left and to the right of position.
+      Relocate(mBegin, position, new_begin);
+      pointer new_end = Relocate(position, mEnd, new_position.mPtr + 1);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
       return new_position;
@@ -509,9 +525,9 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<class... Args>
-  inline void ring<T, Alloc>::emplace_back(Args&&... args)
+  inline void ring<T, Alloc, Growth>::emplace_back(Args&&... args)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -529,10 +545,11 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      pointer new_end = new_begin + size();
       new ((void*) new_end) T(std::forward<Args>(args)...);
       ++new_end;
+      Relocate(mBegin, mEnd, new_begin);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -542,9 +559,9 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<class... Args>
-  inline void ring<T, Alloc>::emplace_front(Args&&... args)
+  inline void ring<T, Alloc, Growth>::emplace_front(Args&&... args)
   {
     //Decrement is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be incremented if reallocation occurs.
@@ -561,9 +578,9 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
+      //Construct the new value first, as it may refer to an element of this container.
       new ((void*) new_begin) T(std::forward<Args>(args)...);
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), (new_begin + 1));
+      pointer new_end = Relocate(mBegin, mEnd, (new_begin + 1));
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -575,14 +592,14 @@ namespace flex
 
 #endif
 
-  template<class T, class Alloc>
-  inline bool ring<T, Alloc>::empty() const
+  template<class T, class Alloc, class Growth>
+  inline bool ring<T, Alloc, Growth>::empty() const
   {
     return (mBegin.mPtr == mEnd.mPtr);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::erase(iterator position)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::erase(iterator position)
   {
     //This copy will simply shift everything after position over to the left by one.
     //This will effectively overwrite position, erasing it from the container.
@@ -591,8 +608,8 @@ namespace flex
     return position;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::erase(iterator first, iterator last)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::erase(iterator first, iterator last)
   {
     if (first != last)
     {
@@ -607,50 +624,89 @@ namespace flex
     return first;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::end()
+  template<class T, class Alloc, class Growth>
+  template<class Predicate>
+  inline typename ring<T, Alloc, Growth>::size_type ring<T, Alloc, Growth>::erase_if(Predicate pred)
+  {
+    //Each survivor after the first erased element is moved once, directly to its final position.
+    iterator dest = std::find_if(mBegin, mEnd, pred);
+    if (dest == mEnd)
+    {
+      return 0;
+    }
+    for (iterator it = dest + 1; it != mEnd; ++it)
+    {
+      if (!pred(*it))
+      {
+        *dest = FLEX_MOVE(*it);
+        ++dest;
+      }
+    }
+    const size_type n = mEnd - dest;
+    flex::destruct_range(dest, mEnd);
+    mEnd.mPtr = dest.mPtr;
+    return n;
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::erase_unordered(iterator position)
+  {
+    //The last element is moved into the hole rather than shifting the tail, so the order is not kept.
+    iterator last = mEnd;
+    --last;
+    if (position != last)
+    {
+      *position = FLEX_MOVE(*last);
+    }
+    last->~T();
+    mEnd.mPtr = last.mPtr;
+    return position;
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::end()
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_iterator ring<T, Alloc>::end() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_iterator ring<T, Alloc, Growth>::end() const
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reference ring<T, Alloc>::front()
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reference ring<T, Alloc, Growth>::front()
   {
     return *mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reference ring<T, Alloc>::front() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reference ring<T, Alloc, Growth>::front() const
   {
     return *mBegin;
   }
 
-  template<class T, class Alloc>
-  inline bool ring<T, Alloc>::fixed() const
+  template<class T, class Alloc, class Growth>
+  inline bool ring<T, Alloc, Growth>::fixed() const
   {
     return mFixed;
   }
 
-  template<class T, class Alloc>
-  inline bool ring<T, Alloc>::full() const
+  template<class T, class Alloc, class Growth>
+  inline bool ring<T, Alloc, Growth>::full() const
   {
     return mBegin.mPtr == (mEnd + 1).mPtr;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::allocator_type ring<T, Alloc>::get_allocator() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::allocator_type ring<T, Alloc, Growth>::get_allocator() const
   {
     return mAllocator;
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::insert(iterator position, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::insert(iterator position, const value_type& val)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -668,15 +724,13 @@ namespace flex
       size_t new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Construct the inserted value first, as it may refer to an element of this container.
+      iterator new_position(new_begin + (position - mBegin), new_begin, new_begin + new_capacity);
+      new ((void*) new_position.mPtr) T(val);
 
-      //Copy the inserted parameter val.
-      iterator new_position(new_end, new_begin, new_begin + new_capacity);
-      new ((void*) new_end) T(val);
-
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
+      //Relocate all values to the left and to the right of position.
+      Relocate(mBegin, position, new_begin);
+      pointer new_end = Relocate(position, mEnd, new_position.mPtr + 1);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
       return new_position;
@@ -736,8 +790,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::iterator ring<T, Alloc>::insert(iterator position, value_type&& val)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::iterator ring<T, Alloc, Growth>::insert(iterator position, value_type&& val)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -755,15 +809,13 @@ namespace flex
       size_t new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
-
-      //Copy the inserted parameter val.
-      iterator new_position(new_end, new_begin, new_begin + new_capacity);
-      new ((void*) new_end) T(FLEX_MOVE(val));
+      //Construct the inserted value first, as it may refer to an element of this container.
+      iterator new_position(new_begin + (position - mBegin), new_begin, new_begin + new_capacity);
+      new ((void*) new_position.mPtr) T(FLEX_MOVE(val));
 
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
+      //Relocate all values to the left and to the right of position.
+      Relocate(mBegin, position, new_begin);
+      pointer new_end = Relocate(position, mEnd, new_position.mPtr + 1);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
       return new_position;
@@ -823,8 +875,8 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::insert(iterator position, size_type n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::insert(iterator position, size_type n, const value_type& val)
   {
     if ((size() + n) > capacity())
     {
@@ -833,14 +885,13 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Fill the parameter val first, as it may refer to an element of this container.
+      pointer new_position = new_begin + (position - mBegin);
+      std::uninitialized_fill_n(new_position, n, val);
 
-      //Fill the parameter val.
-      std::uninitialized_fill_n(new_end, n, val);
-
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), new_end + n);
+      //Relocate all values to the left and to the right of position.
+      Relocate(mBegin, position, new_begin);
+      pointer new_end = Relocate(position, mEnd, new_position + n);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -869,15 +920,15 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::insert(iterator position, int n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::insert(iterator position, int n, const value_type& val)
   {
     insert(position, (size_type) n, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline void ring<T, Alloc>::insert(iterator position, InputIterator first, InputIterator last)
+  inline void ring<T, Alloc, Growth>::insert(iterator position, InputIterator first, InputIterator last)
   {
     size_type n = std::distance(first, last);
     if ((size() + n) > capacity())
@@ -887,14 +938,13 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
-
-      //Copy the inserted range.
-      new_end = std::uninitialized_copy(first, last, new_end);
+      //Copy the inserted range first, as it may refer to elements of this container.
+      pointer new_position = new_begin + (position - mBegin);
+      std::uninitialized_copy(first, last, new_position);
 
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), new_end);
+      //Relocate all values to the left and to the right of position.
+      Relocate(mBegin, position, new_begin);
+      pointer new_end = Relocate(position, mEnd, new_position + n);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -921,8 +971,8 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::size_type ring<T, Alloc>::max_size() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::size_type ring<T, Alloc, Growth>::max_size() const
   {
     if (mFixed)
     {
@@ -934,56 +984,56 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>& ring<T, Alloc>::operator=(const ring<T, Alloc>& obj)
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>& ring<T, Alloc, Growth>::operator=(const ring<T, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>& ring<T, Alloc>::operator=(std::initializer_list<value_type> il)
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>& ring<T, Alloc, Growth>::operator=(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
     return *this;
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline ring<T, Alloc>& ring<T, Alloc>::operator=(ring<T, Alloc>&& obj)
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>& ring<T, Alloc, Growth>::operator=(ring<T, Alloc, Growth>&& obj)
   {
     swap(std::move(obj));
     return *this;
   }
 #endif
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reference ring<T, Alloc>::operator[](size_type n)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reference ring<T, Alloc, Growth>::operator[](size_type n)
   {
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reference ring<T, Alloc>::operator[](size_type n) const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reference ring<T, Alloc, Growth>::operator[](size_type n) const
   {
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::pop_back()
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::pop_back()
   {
     (--mEnd)->~T();
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::pop_front()
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::pop_front()
   {
     mBegin->~T();
     ++mBegin;
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::push_back(const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::push_back(const value_type& val)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -1001,10 +1051,11 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      pointer new_end = new_begin + size();
       new ((void*) new_end) T(val);
       ++new_end;
+      Relocate(mBegin, mEnd, new_begin);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -1014,8 +1065,8 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::push_front(const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::push_front(const value_type& val)
   {
     //Decrement is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be incremented if reallocation occurs.
@@ -1032,9 +1083,9 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
+      //Construct the new value first, as it may refer to an element of this container.
       new ((void*) new_begin) T(val);
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), (new_begin + 1));
+      pointer new_end = Relocate(mBegin, mEnd, (new_begin + 1));
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -1045,8 +1096,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::push_back(value_type&& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::push_back(value_type&& val)
   {
     //Increment is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be reverted if reallocation occurs.
@@ -1064,10 +1115,11 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      pointer new_end = new_begin + size();
       new ((void*) new_end) T(std::move(val));
       ++new_end;
+      Relocate(mBegin, mEnd, new_begin);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -1077,8 +1129,8 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::push_front(value_type&& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::push_front(value_type&& val)
   {
     //Decrement is performed first as it allows a much faster capacity check. The
     //drawback is that the iterator needs to be incremented if reallocation occurs.
@@ -1095,9 +1147,9 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all values.
+      //Construct the new value first, as it may refer to an element of this container.
       new ((void*) new_begin) T(std::move(val));
-      pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), (new_begin + 1));
+      pointer new_end = Relocate(mBegin, mEnd, (new_begin + 1));
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
@@ -1108,32 +1160,32 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reverse_iterator ring<T, Alloc>::rbegin()
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reverse_iterator ring<T, Alloc, Growth>::rbegin()
   {
     return reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reverse_iterator ring<T, Alloc>::rbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reverse_iterator ring<T, Alloc, Growth>::rbegin() const
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::reverse_iterator ring<T, Alloc>::rend()
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::reverse_iterator ring<T, Alloc, Growth>::rend()
   {
     return reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::const_reverse_iterator ring<T, Alloc>::rend() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::const_reverse_iterator ring<T, Alloc, Growth>::rend() const
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::reserve(size_type n)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::reserve(size_type n)
   {
     if (n > capacity())
     {
@@ -1141,15 +1193,15 @@ namespace flex
       size_type new_capacity = GetNewCapacity(n);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all current values.
-      pointer new_end = std::uninitialized_copy(mBegin, mEnd, new_begin);
+      //Relocate all current values.
+      pointer new_end = Relocate(mBegin, mEnd, new_begin);
 
       DeallocateAndReassign(new_begin, new_end, new_capacity);
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::resize(size_type n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::resize(size_type n, const value_type& val)
   {
     if (n < size())
     {
@@ -1163,8 +1215,8 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::shrink_to_fit()
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::shrink_to_fit()
   {
     if (!mFixed)
     {
@@ -1179,8 +1231,8 @@ namespace flex
           new_capacity = size();
           new_begin = Allocate(new_capacity);
 
-          //Copy all values.
-          new_end = std::uninitialized_copy(mBegin, mEnd, new_begin);
+          //Relocate all values.
+          new_end = Relocate(mBegin, mEnd, new_begin);
         }
         else
         {
@@ -1192,14 +1244,14 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::size_type ring<T, Alloc>::size() const
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::size_type ring<T, Alloc, Growth>::size() const
   {
     return (mEnd - mBegin);
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::swap(ring<T, Alloc>& obj)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::swap(ring<T, Alloc, Growth>& obj)
   {
     if ((!mFixed) && (!obj.fixed()))
     {
@@ -1224,8 +1276,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::swap(ring<T, Alloc>&& obj)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::swap(ring<T, Alloc, Growth>&& obj)
   {
     if ((!mFixed) && (!obj.fixed()))
     {
@@ -1240,27 +1292,26 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline ring<T, Alloc>::ring(pointer new_begin, pointer new_end, pointer right_bound) :
+  template<class T, class Alloc, class Growth>
+  inline ring<T, Alloc, Growth>::ring(pointer new_begin, pointer new_end, pointer right_bound) :
       base_type(new_begin, new_end, right_bound)
 
   {
   }
 
-  template<class T, class Alloc>
-  inline typename ring<T, Alloc>::size_type ring<T, Alloc>::GetNewCapacity(size_type min_size)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::size_type ring<T, Alloc, Growth>::GetNewCapacity(size_type min_size)
   {
-    // This needs to return a value of at least currentCapacity and at least 1.
-    size_type new_capacity = (capacity() > 0) ? (2 * capacity()) : 1;
-
-    // If we are still less than the min_size, just return the min_size.
-    return (new_capacity < min_size) ? min_size : new_capacity;
+    // The Growth policy returns a value of at least min_size.  One more element than the capacity is
+    // allocated, which is passed as the overhead.  See growth_policy.h.
+    return Growth::new_capacity(capacity(), min_size, sizeof(T), 1, mAllocator);
   }
 
-  template<class T, class Alloc>
-  inline void ring<T, Alloc>::DeallocateAndReassign(pointer new_begin, pointer new_end, size_type new_capacity)
+  template<class T, class Alloc, class Growth>
+  inline void ring<T, Alloc, Growth>::DeallocateAndReassign(pointer new_begin, pointer new_end, size_type new_capacity)
   {
-    DestroyAndDeallocate();
+    //The elements must already have been relocated or destroyed.
+    Deallocate();
 
     mBegin.mPtr = new_begin;
     mEnd.mPtr = new_end;
@@ -1269,8 +1320,24 @@ namespace flex
     mBegin.mRightBound = mEnd.mRightBound = new_begin + new_capacity;
   }
 
-  template<class T, class Alloc>
-  inline bool operator==(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline typename ring<T, Alloc, Growth>::pointer ring<T, Alloc, Growth>::Relocate(iterator first, iterator last, pointer dest)
+  {
+    //A range within the ring is made up of at most two contiguous spans, which are relocated separately.
+    //Note the right bound is inclusive, as the allocation is one larger than the capacity.
+    if (first.mPtr <= last.mPtr)
+    {
+      return flex::uninitialized_relocate(first.mPtr, last.mPtr, dest);
+    }
+    else
+    {
+      dest = flex::uninitialized_relocate(first.mPtr, first.mRightBound + 1, dest);
+      return flex::uninitialized_relocate(first.mLeftBound, last.mPtr, dest);
+    }
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline bool operator==(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     if (lhs.size() != rhs.size())
     {
@@ -1278,8 +1345,8 @@ namespace flex
     }
     else
     {
-      typename ring<T, Alloc>::const_iterator lit = lhs.begin();
-      typename ring<T, Alloc>::const_iterator rit = rhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator lit = lhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator rit = rhs.begin();
       while (lit != lhs.end())
       {
         if (*lit != *rit)
@@ -1293,13 +1360,13 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline bool operator<(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator<(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     if (lhs.size() < rhs.size())
     {
-      typename ring<T, Alloc>::const_iterator lit = lhs.begin();
-      typename ring<T, Alloc>::const_iterator rit = rhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator lit = lhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator rit = rhs.begin();
       while (lit != lhs.end())
       {
         if (*lit < *rit)
@@ -1317,8 +1384,8 @@ namespace flex
     }
     else
     {
-      typename ring<T, Alloc>::const_iterator lit = lhs.begin();
-      typename ring<T, Alloc>::const_iterator rit = rhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator lit = lhs.begin();
+      typename ring<T, Alloc, Growth>::const_iterator rit = rhs.begin();
       while (rit != rhs.end())
       {
         if (*lit < *rit)
@@ -1336,26 +1403,26 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline bool operator!=(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator!=(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     return !(lhs == rhs);
   }
 
-  template<class T, class Alloc>
-  inline bool operator>(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator>(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     return rhs < lhs;
   }
 
-  template<class T, class Alloc>
-  inline bool operator<=(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator<=(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     return !(rhs < lhs);
   }
 
-  template<class T, class Alloc>
-  inline bool operator>=(const ring<T, Alloc>& lhs, const ring<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator>=(const ring<T, Alloc, Growth>& lhs, const ring<T, Alloc, Growth>& rhs)
   {
     return !(lhs < rhs);
   }
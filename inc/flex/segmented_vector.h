@@ -0,0 +1,605 @@
+#ifndef FLEX_SEGMENTED_VECTOR_H
+#define FLEX_SEGMENTED_VECTOR_H
+
+#include <flex/pool.h>
+#include <flex/vector.h>
+#include <flex/internal/segmented_iterator.h>
+
+namespace flex
+{
+
+  //Storage for one segment of a segmented_vector.  The elements are constructed in place by the container.
+  template<class T, size_t N>
+  struct segmented_vector_segment
+  {
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(T)];
+      long double dummy;
+    };
+#endif
+  };
+
+  //A segmented_vector stores its elements in fixed-size segments of N elements that are taken from a pool,
+  //and keeps a directory of pointers to them.  Growth only allocates a new segment and appends its pointer
+  //to the directory, so elements are never copied or moved once constructed and references to them remain
+  //valid until the element is erased.  Random access is a directory lookup followed by an index into the
+  //segment.  Iterators hold the directory, so they are invalidated by growth like those of a vector.
+  //
+  //Each segment is contiguous.  Hot loops should use for_each_segment() or segment_data()/segment_size()
+  //to process a segment at a time, which keeps the inner loop over plain pointers and lets it vectorize.
+  //Choosing a power of two for N turns the index arithmetic into a shift and a mask.
+  //
+  //Alloc allocates the segments.  Like pool, it is an allocator of pool nodes (see node_type).
+  template<class T, size_t N = 64, class Alloc = allocator<typename pool<segmented_vector_segment<T, N> >::node_type> >
+  class segmented_vector: public guarded_object
+  {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef segmented_iterator<T, N> iterator;
+    typedef segmented_iterator<T, N, const T*, const T&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Alloc allocator_type;
+    typedef segmented_vector_segment<T, N> segment_type;
+    typedef pool<segment_type, Alloc> pool_type;
+    typedef typename pool_type::node_type node_type;
+
+    segmented_vector();
+    explicit segmented_vector(size_type size, const value_type& val = value_type());
+    segmented_vector(int size, const value_type& val);
+    template<typename InputIterator> segmented_vector(InputIterator first, InputIterator last);
+    segmented_vector(const segmented_vector<T, N, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    segmented_vector(segmented_vector<T, N, Alloc>&& obj);
+#endif
+    segmented_vector(std::initializer_list<value_type> il);
+    ~segmented_vector();
+
+    void assign(size_type size, const value_type& val);
+    void assign(int size, const value_type& val);
+    template<typename InputIterator>
+    void assign(InputIterator first, InputIterator last);
+    void assign(std::initializer_list<value_type> il);
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+    reference back();
+    const_reference back() const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    size_type capacity() const;
+    void clear();
+#ifdef FLEX_HAS_CXX11
+    template<class...Args> void emplace_back(Args&&... val);
+#endif
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    template<class Function> Function for_each_segment(Function f);
+    template<class Function> Function for_each_segment(Function f) const;
+    reference front();
+    const_reference front() const;
+    size_type max_size() const;
+    segmented_vector<T, N, Alloc>& operator=(const segmented_vector<T, N, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    segmented_vector<T, N, Alloc>& operator=(segmented_vector<T, N, Alloc>&& obj);
+#endif
+    segmented_vector<T, N, Alloc>& operator=(std::initializer_list<value_type> il);
+    reference operator[](size_type n);
+    const_reference operator[](size_type n) const;
+    void pop_back();
+    void push_back(const value_type& val);
+#ifdef FLEX_HAS_CXX11
+    void push_back(value_type&& val);
+#endif
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    void reserve(size_type n);
+    void resize(size_type n, const value_type& val = value_type());
+    size_type segment_count() const;
+    pointer segment_data(size_type i);
+    const_pointer segment_data(size_type i) const;
+    size_type segment_size(size_type i) const;
+    void shrink_to_fit();
+    size_type size() const;
+    void swap(segmented_vector<T, N, Alloc>& obj);
+
+  protected:
+    vector<pointer> mSegments;
+    pool_type mPool;
+    size_type mSize;
+
+    pointer AllocateSegment();
+    void Destroy(size_type first);
+    pointer GetNextSlot();
+  };
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector() :
+      mSegments(), mPool(), mSize(0)
+  {
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(size_type size, const value_type& val) :
+      mSegments(), mPool(), mSize(0)
+  {
+    assign(size, val);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(int size, const value_type& val) :
+      mSegments(), mPool(), mSize(0)
+  {
+    assign((size_type) size, val);
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<typename InputIterator>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(InputIterator first, InputIterator last) :
+      mSegments(), mPool(), mSize(0)
+  {
+    assign(first, last);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(const segmented_vector<T, N, Alloc>& obj) :
+      mSegments(), mPool(), mSize(0)
+  {
+    reserve(obj.size());
+    assign(obj.begin(), obj.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(segmented_vector<T, N, Alloc>&& obj) :
+      mSegments(), mPool(), mSize(0)
+  {
+    swap(obj);
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::segmented_vector(std::initializer_list<value_type> il) :
+      mSegments(), mPool(), mSize(0)
+  {
+    assign(il.begin(), il.end());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>::~segmented_vector()
+  {
+    Destroy(0);
+    for (size_type i = 0; i < mSegments.size(); ++i)
+    {
+      mPool.deallocate(mSegments[i]);
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::assign(size_type size, const value_type& val)
+  {
+    clear();
+    reserve(size);
+    for (; mSize < size; ++mSize)
+    {
+      ::new ((void*) GetNextSlot()) value_type(val);
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::assign(int size, const value_type& val)
+  {
+    assign((size_type) size, val);
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<typename InputIterator>
+  inline void segmented_vector<T, N, Alloc>::assign(InputIterator first, InputIterator last)
+  {
+    clear();
+    for (; first != last; ++first)
+    {
+      push_back(*first);
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::assign(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reference segmented_vector<T, N, Alloc>::at(size_type n)
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(n >= mSize, "flex::segmented_vector.at() - index out-of-bounds");
+    return operator[](n);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reference segmented_vector<T, N, Alloc>::at(size_type n) const
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(n >= mSize, "flex::segmented_vector.at() - index out-of-bounds");
+    return operator[](n);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reference segmented_vector<T, N, Alloc>::back()
+  {
+    return operator[](mSize - 1);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reference segmented_vector<T, N, Alloc>::back() const
+  {
+    return operator[](mSize - 1);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::iterator segmented_vector<T, N, Alloc>::begin()
+  {
+    return iterator(mSegments.begin(), 0);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_iterator segmented_vector<T, N, Alloc>::begin() const
+  {
+    return const_iterator(mSegments.begin(), 0);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_iterator segmented_vector<T, N, Alloc>::cbegin() const
+  {
+    return const_iterator(mSegments.begin(), 0);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_iterator segmented_vector<T, N, Alloc>::cend() const
+  {
+    return const_iterator(mSegments.begin(), mSize);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reverse_iterator segmented_vector<T, N, Alloc>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reverse_iterator segmented_vector<T, N, Alloc>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::size_type segmented_vector<T, N, Alloc>::capacity() const
+  {
+    return mSegments.size() * N;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::clear()
+  {
+    //The segments are kept, so the container can be refilled without allocating.
+    Destroy(0);
+    mSize = 0;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  template<class ... Args>
+  inline void segmented_vector<T, N, Alloc>::emplace_back(Args&&... args)
+  {
+    ::new ((void*) GetNextSlot()) value_type(std::forward<Args>(args)...);
+    ++mSize;
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline bool segmented_vector<T, N, Alloc>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::iterator segmented_vector<T, N, Alloc>::end()
+  {
+    return iterator(mSegments.begin(), mSize);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_iterator segmented_vector<T, N, Alloc>::end() const
+  {
+    return const_iterator(mSegments.begin(), mSize);
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<class Function>
+  inline Function segmented_vector<T, N, Alloc>::for_each_segment(Function f)
+  {
+    //f is called as f(first, last) with the pointer range of each segment that holds elements.
+    size_type remaining = mSize;
+    for (size_type i = 0; remaining; ++i)
+    {
+      const size_type n = (remaining < N) ? remaining : N;
+      f(mSegments[i], mSegments[i] + n);
+      remaining -= n;
+    }
+    return f;
+  }
+
+  template<class T, size_t N, class Alloc>
+  template<class Function>
+  inline Function segmented_vector<T, N, Alloc>::for_each_segment(Function f) const
+  {
+    size_type remaining = mSize;
+    for (size_type i = 0; remaining; ++i)
+    {
+      const size_type n = (remaining < N) ? remaining : N;
+      f((const_pointer) mSegments[i], (const_pointer) mSegments[i] + n);
+      remaining -= n;
+    }
+    return f;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reference segmented_vector<T, N, Alloc>::front()
+  {
+    return mSegments[0][0];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reference segmented_vector<T, N, Alloc>::front() const
+  {
+    return mSegments[0][0];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::size_type segmented_vector<T, N, Alloc>::max_size() const
+  {
+    return mSegments.max_size();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>& segmented_vector<T, N, Alloc>::operator=(const segmented_vector<T, N, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      assign(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>& segmented_vector<T, N, Alloc>::operator=(segmented_vector<T, N, Alloc>&& obj)
+  {
+    swap(obj);
+    return *this;
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline segmented_vector<T, N, Alloc>& segmented_vector<T, N, Alloc>::operator=(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reference segmented_vector<T, N, Alloc>::operator[](size_type n)
+  {
+    return mSegments[n / N][n % N];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reference segmented_vector<T, N, Alloc>::operator[](
+      size_type n) const
+  {
+    return mSegments[n / N][n % N];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::pop_back()
+  {
+    --mSize;
+    operator[](mSize).~value_type();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::push_back(const value_type& val)
+  {
+    //Growth never moves existing elements, so val may safely refer to an element of this container.
+    ::new ((void*) GetNextSlot()) value_type(val);
+    ++mSize;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::push_back(value_type&& val)
+  {
+    ::new ((void*) GetNextSlot()) value_type(std::move(val));
+    ++mSize;
+  }
+#endif
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reverse_iterator segmented_vector<T, N, Alloc>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reverse_iterator segmented_vector<T, N, Alloc>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::reverse_iterator segmented_vector<T, N, Alloc>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_reverse_iterator segmented_vector<T, N, Alloc>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::reserve(size_type n)
+  {
+    const size_type count = (n + N - 1) / N;
+    if (count > mSegments.size())
+    {
+      mSegments.reserve(count);
+      while (mSegments.size() < count)
+      {
+        mSegments.push_back(AllocateSegment());
+      }
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::resize(size_type n, const value_type& val)
+  {
+    if (n < mSize)
+    {
+      Destroy(n);
+      mSize = n;
+    }
+    else
+    {
+      reserve(n);
+      for (; mSize < n; ++mSize)
+      {
+        ::new ((void*) GetNextSlot()) value_type(val);
+      }
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::size_type segmented_vector<T, N, Alloc>::segment_count() const
+  {
+    return mSegments.size();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::pointer segmented_vector<T, N, Alloc>::segment_data(size_type i)
+  {
+    return mSegments[i];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::const_pointer segmented_vector<T, N, Alloc>::segment_data(
+      size_type i) const
+  {
+    return mSegments[i];
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::size_type segmented_vector<T, N, Alloc>::segment_size(size_type i) const
+  {
+    //Returns the number of elements held by segment i.  Only the last used segment may be partially filled.
+    const size_type first = i * N;
+    if (first >= mSize)
+    {
+      return 0;
+    }
+    return ((mSize - first) < N) ? (mSize - first) : N;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::shrink_to_fit()
+  {
+    //Unused segments are released to the allocator rather than kept in the pool.  The elements stay in place.
+    const size_type count = (mSize + N - 1) / N;
+    while (mSegments.size() > count)
+    {
+      mPool.deallocate(mSegments.back());
+      mSegments.pop_back();
+    }
+    mPool.shrink_to_fit();
+    mSegments.shrink_to_fit();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::size_type segmented_vector<T, N, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::swap(segmented_vector<T, N, Alloc>& obj)
+  {
+    //Each segment must be returned to the allocator that provided it, so the pools, and the allocators they
+    //hold, move along with the directories.
+    mSegments.swap(obj.mSegments);
+    mPool.swap(obj.mPool);
+    std::swap(mSize, obj.mSize);
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::pointer segmented_vector<T, N, Alloc>::AllocateSegment()
+  {
+    return (pointer) mPool.allocate();
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline void segmented_vector<T, N, Alloc>::Destroy(size_type first)
+  {
+    //Destroys the elements in [first, size()) a segment at a time.  mSize is left unchanged.
+    while (first < mSize)
+    {
+      const size_type offset = first % N;
+      const size_type n = ((mSize - first) < (N - offset)) ? (mSize - first) : (N - offset);
+      pointer segment = mSegments[first / N];
+      flex::destruct_range(segment + offset, segment + offset + n);
+      first += n;
+    }
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline typename segmented_vector<T, N, Alloc>::pointer segmented_vector<T, N, Alloc>::GetNextSlot()
+  {
+    //Returns the uninitialized slot at index size(), adding a segment when the last one is full.
+    const size_type offset = mSize % N;
+    if (FLEX_UNLIKELY(mSize == capacity()))
+    {
+      mSegments.push_back(AllocateSegment());
+    }
+    return mSegments[mSize / N] + offset;
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline bool operator==(const segmented_vector<T, N, Alloc>& lhs, const segmented_vector<T, N, Alloc>& rhs)
+  {
+    return ((lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+
+  template<class T, size_t N, class Alloc>
+  inline bool operator!=(const segmented_vector<T, N, Alloc>& lhs, const segmented_vector<T, N, Alloc>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_SEGMENTED_VECTOR_H */
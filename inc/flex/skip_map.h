@@ -0,0 +1,1023 @@
+#ifndef FLEX_SKIP_MAP_H
+#define FLEX_SKIP_MAP_H
+
+#include <flex/pool.h>
+#include <flex/initializer_list.h>
+#include <flex/internal/skip_map_iterator.h>
+
+#include <stdint.h>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace flex
+{
+
+  //A pool of skip_map towers of one size class.  Like unrolled_list's chunk pool, it may be handed a buffer,
+  //after which it is fixed and only reaches the allocator on overflow.
+  template<class Tower, class Alloc>
+  struct skip_map_pool: public pool<Tower,
+      typename Alloc::template rebind<typename pool<Tower>::node_type>::other>
+  {
+    typedef pool<Tower, typename Alloc::template rebind<typename pool<Tower>::node_type>::other> base_type;
+    typedef typename base_type::node_type node_type;
+
+    skip_map_pool();
+
+    void AddBuffer(node_type* first, node_type* last);
+    bool fixed() const;
+    void ReleaseOverflow(const void* first, const void* last);
+  };
+
+  template<class Tower, class Alloc>
+  inline skip_map_pool<Tower, Alloc>::skip_map_pool() :
+      base_type()
+  {
+  }
+
+  template<class Tower, class Alloc>
+  inline void skip_map_pool<Tower, Alloc>::AddBuffer(node_type* first, node_type* last)
+  {
+    this->mFixed = true;
+    for (node_type* it = first; it != last; ++it)
+    {
+      this->deallocate((void*) it);
+    }
+  }
+
+  template<class Tower, class Alloc>
+  inline bool skip_map_pool<Tower, Alloc>::fixed() const
+  {
+    return this->mFixed;
+  }
+
+  template<class Tower, class Alloc>
+  inline void skip_map_pool<Tower, Alloc>::ReleaseOverflow(const void* first, const void* last)
+  {
+    //Matches ~fixed_pool().  Towers outside [first, last) were allocated after the buffer ran out.
+#ifndef FLEX_RELEASE
+    if (FLEX_UNLIKELY(this->mOverflow))
+    {
+      while (this->mHead)
+      {
+        node_type* ptr = (node_type*) this->allocate();
+        if (((const char*) ptr < (const char*) first) || ((const char*) ptr >= (const char*) last))
+        {
+          this->mAllocator.deallocate(ptr, 1);
+        }
+      }
+    }
+#endif
+  }
+
+  //A skip_map is an ordered map kept as a skip list.  Each node is a tower of links, one per level, with a random
+  //height: a node reaches level i with probability 4^-i.  A search walks each level from the top until the next
+  //key is not less than the one sought, so lookups, insertions and erasures take O(log n) expected steps and
+  //never rebalance.  Level 0 is a doubly linked list of every element, so iteration in either direction is a
+  //plain pointer chase, and erasing a range costs O(log n) to find it plus O(1) per element.
+  //
+  //Towers are taken from pools in five size classes of 1, 2, 4, 8 and 16 links.  Most nodes have a single
+  //link, so the small classes do nearly all the work.  Iterators stay valid until their element is erased.
+  //
+  //Alloc is rebound for each size class.
+  template<class Key, class T, class Compare = std::less<Key>, class Alloc = allocator<char> >
+  class skip_map: public guarded_object
+  {
+  public:
+    typedef skip_map<Key, T, Compare, Alloc> this_type;
+
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Compare key_compare;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef skip_map_node<value_type> node_type;
+    typedef skip_map_iterator<value_type> iterator;
+    typedef skip_map_iterator<value_type, const value_type*, const value_type&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    //The most links a tower may have.  With 4^16 expected elements per top-level node, this covers any map
+    //that fits in memory.
+    static const size_type MAX_HEIGHT = 16;
+
+    //The number of tower size classes, holding 1, 2, 4, 8 and 16 links.
+    static const size_type CLASS_COUNT = 5;
+
+    skip_map();
+    explicit skip_map(const Compare& comp);
+    template<typename InputIterator> skip_map(InputIterator first, InputIterator last,
+        const Compare& comp = Compare());
+    skip_map(const skip_map<Key, T, Compare, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    skip_map(skip_map<Key, T, Compare, Alloc>&& obj);
+#endif
+    skip_map(std::initializer_list<value_type> il, const Compare& comp = Compare());
+    ~skip_map();
+
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    void clear();
+    size_type count(const Key& key) const;
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    std::pair<iterator, iterator> equal_range(const Key& key);
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const Key& key);
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    bool fixed() const;
+    std::pair<iterator, bool> insert(const value_type& val);
+    template<typename InputIterator> void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> il);
+    key_compare key_comp() const;
+    iterator lower_bound(const Key& key);
+    const_iterator lower_bound(const Key& key) const;
+    size_type max_size() const;
+    skip_map<Key, T, Compare, Alloc>& operator=(const skip_map<Key, T, Compare, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    skip_map<Key, T, Compare, Alloc>& operator=(skip_map<Key, T, Compare, Alloc>&& obj);
+#endif
+    skip_map<Key, T, Compare, Alloc>& operator=(std::initializer_list<value_type> il);
+    T& operator[](const Key& key);
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    size_type size() const;
+    void swap(skip_map<Key, T, Compare, Alloc>& obj);
+    iterator upper_bound(const Key& key);
+    const_iterator upper_bound(const Key& key) const;
+
+  protected:
+    typedef skip_map_pool<skip_map_tower<value_type, 1>, Alloc> pool1_type;
+    typedef skip_map_pool<skip_map_tower<value_type, 2>, Alloc> pool2_type;
+    typedef skip_map_pool<skip_map_tower<value_type, 4>, Alloc> pool4_type;
+    typedef skip_map_pool<skip_map_tower<value_type, 8>, Alloc> pool8_type;
+    typedef skip_map_pool<skip_map_tower<value_type, 16>, Alloc> pool16_type;
+
+    skip_map(void* buffer, size_type n, const Compare& comp);
+
+    static size_type ClassOf(size_type height);
+    static size_type TowerCount(size_type n, size_type c);
+
+    node_type* AllocateNode(size_type height);
+    void Append(const_iterator first, const_iterator last);
+    node_type* CreateNode(const value_type& val);
+    void DestroyNode(node_type* node);
+    bool Exhausted(size_type c) const;
+    node_type* Head() const;
+    void InitHead();
+    void LastNodes(node_type** last) const;
+    void Link(node_type* node, node_type** update);
+    node_type* LowerBound(const Key& key) const;
+    size_type RandomHeight();
+    void ReleaseOverflow(const void* first, const void* last);
+    node_type* Search(const Key& key, node_type** update) const;
+    void Unlink(node_type* node, node_type** update);
+    node_type* UpperBound(const Key& key) const;
+
+    /*
+     * The head is a tower of MAX_HEIGHT links whose value is never constructed.  Every level ends by linking
+     * back to it, and it is the end() node, so its mPrev is the last element.
+     */
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(skip_map_tower<value_type, MAX_HEIGHT>),
+        alignof(skip_map_tower<value_type, MAX_HEIGHT>)>::type mHead;
+#else
+    union
+    {
+      char mHead[sizeof(skip_map_tower<value_type, MAX_HEIGHT>)];
+      long double dummy;
+    };
+#endif
+    size_type mSize;
+    size_type mLevel;
+    uint32_t mSeed;
+    Compare mCompare;
+    pool1_type mPool1;
+    pool2_type mPool2;
+    pool4_type mPool4;
+    pool8_type mPool8;
+    pool16_type mPool16;
+  };
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::MAX_HEIGHT;
+
+  template<class Key, class T, class Compare, class Alloc>
+  const typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::CLASS_COUNT;
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map() :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare()
+  {
+    InitHead();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(const Compare& comp) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(comp)
+  {
+    InitHead();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(InputIterator first, InputIterator last, const Compare& comp) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(comp)
+  {
+    InitHead();
+    insert(first, last);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(const skip_map<Key, T, Compare, Alloc>& obj) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(obj.mCompare)
+  {
+    InitHead();
+    Append(obj.begin(), obj.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(skip_map<Key, T, Compare, Alloc>&& obj) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(obj.mCompare)
+  {
+    InitHead();
+    if (obj.fixed())
+    {
+      Append(obj.begin(), obj.end());
+      obj.clear();
+    }
+    else
+    {
+      swap(obj);
+    }
+  }
+#endif
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(std::initializer_list<value_type> il, const Compare& comp) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(comp)
+  {
+    InitHead();
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::~skip_map()
+  {
+    clear();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline T& skip_map<Key, T, Compare, Alloc>::at(const Key& key)
+  {
+    node_type* const node = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((node == Head()) || mCompare(key, node->mValue.first),
+        "flex::skip_map.at() - key not found");
+    return node->mValue.second;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline const T& skip_map<Key, T, Compare, Alloc>::at(const Key& key) const
+  {
+    node_type* const node = LowerBound(key);
+    FLEX_THROW_OUT_OF_RANGE_IF((node == Head()) || mCompare(key, node->mValue.first),
+        "flex::skip_map.at() - key not found");
+    return node->mValue.second;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::begin()
+  {
+    return iterator(Head()->mNext[0]);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::begin() const
+  {
+    return const_iterator(Head()->mNext[0]);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::cbegin() const
+  {
+    return const_iterator(Head()->mNext[0]);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::cend() const
+  {
+    return const_iterator(Head());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_reverse_iterator skip_map<Key, T, Compare, Alloc>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_reverse_iterator skip_map<Key, T, Compare, Alloc>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::clear()
+  {
+    node_type* const head = Head();
+    node_type* node = head->mNext[0];
+    while (node != head)
+    {
+      node_type* const next = node->mNext[0];
+      DestroyNode(node);
+      node = next;
+    }
+    InitHead();
+    mSize = 0;
+    mLevel = 1;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::count(
+      const Key& key) const
+  {
+    return (find(key) != end()) ? 1 : 0;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool skip_map<Key, T, Compare, Alloc>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::end()
+  {
+    return iterator(Head());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::end() const
+  {
+    return const_iterator(Head());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename skip_map<Key, T, Compare, Alloc>::iterator,
+      typename skip_map<Key, T, Compare, Alloc>::iterator> skip_map<Key, T, Compare, Alloc>::equal_range(
+      const Key& key)
+  {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename skip_map<Key, T, Compare, Alloc>::const_iterator,
+      typename skip_map<Key, T, Compare, Alloc>::const_iterator> skip_map<Key, T, Compare, Alloc>::equal_range(
+      const Key& key) const
+  {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::erase(
+      const_iterator position)
+  {
+    node_type* update[MAX_HEIGHT];
+    node_type* const node = position.mNode;
+    node_type* const next = node->mNext[0];
+    Search(node->mValue.first, update);
+    Unlink(node, update);
+    DestroyNode(node);
+    return iterator(next);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::erase(
+      const_iterator first, const_iterator last)
+  {
+    if (first != last)
+    {
+      //The predecessors of first on each level are also the predecessors of every node after it in the range,
+      //since those are erased too, so one search serves the whole range.
+      node_type* update[MAX_HEIGHT];
+      Search(first->first, update);
+      node_type* node = first.mNode;
+      while (node != last.mNode)
+      {
+        node_type* const next = node->mNext[0];
+        Unlink(node, update);
+        DestroyNode(node);
+        node = next;
+      }
+    }
+    return iterator(last.mNode);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::erase(const Key& key)
+  {
+    node_type* update[MAX_HEIGHT];
+    node_type* const node = Search(key, update);
+    if ((node == Head()) || mCompare(key, node->mValue.first))
+    {
+      return 0;
+    }
+    Unlink(node, update);
+    DestroyNode(node);
+    return 1;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::find(const Key& key)
+  {
+    node_type* const node = LowerBound(key);
+    return ((node == Head()) || mCompare(key, node->mValue.first)) ? end() : iterator(node);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::find(
+      const Key& key) const
+  {
+    node_type* const node = LowerBound(key);
+    return ((node == Head()) || mCompare(key, node->mValue.first)) ? end() : const_iterator(node);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool skip_map<Key, T, Compare, Alloc>::fixed() const
+  {
+    return mPool1.fixed();
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline std::pair<typename skip_map<Key, T, Compare, Alloc>::iterator, bool> skip_map<Key, T, Compare, Alloc>::insert(
+      const value_type& val)
+  {
+    node_type* update[MAX_HEIGHT];
+    node_type* node = Search(val.first, update);
+    if ((node != Head()) && !mCompare(val.first, node->mValue.first))
+    {
+      return std::make_pair(iterator(node), false);
+    }
+    node = CreateNode(val);
+    Link(node, update);
+    return std::make_pair(iterator(node), true);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  template<typename InputIterator>
+  inline void skip_map<Key, T, Compare, Alloc>::insert(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+    {
+      insert(*first);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(), il.end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::key_compare skip_map<Key, T, Compare, Alloc>::key_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::lower_bound(
+      const Key& key)
+  {
+    return iterator(LowerBound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::lower_bound(
+      const Key& key) const
+  {
+    return const_iterator(LowerBound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::max_size() const
+  {
+    return size_type(-1) / sizeof(node_type);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>& skip_map<Key, T, Compare, Alloc>::operator=(
+      const skip_map<Key, T, Compare, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      mCompare = obj.mCompare;
+      Append(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>& skip_map<Key, T, Compare, Alloc>::operator=(
+      skip_map<Key, T, Compare, Alloc>&& obj)
+  {
+    if (this != &obj)
+    {
+      if (fixed() || obj.fixed())
+      {
+        *this = obj;
+        obj.clear();
+      }
+      else
+      {
+        clear();
+        swap(obj);
+      }
+    }
+    return *this;
+  }
+#endif
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>& skip_map<Key, T, Compare, Alloc>::operator=(
+      std::initializer_list<value_type> il)
+  {
+    clear();
+    insert(il.begin(), il.end());
+    return *this;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline T& skip_map<Key, T, Compare, Alloc>::operator[](const Key& key)
+  {
+    node_type* update[MAX_HEIGHT];
+    node_type* node = Search(key, update);
+    if ((node == Head()) || mCompare(key, node->mValue.first))
+    {
+      node = CreateNode(value_type(key, T()));
+      Link(node, update);
+    }
+    return node->mValue.second;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::reverse_iterator skip_map<Key, T, Compare, Alloc>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_reverse_iterator skip_map<Key, T, Compare, Alloc>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::reverse_iterator skip_map<Key, T, Compare, Alloc>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_reverse_iterator skip_map<Key, T, Compare, Alloc>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::swap(skip_map<Key, T, Compare, Alloc>& obj)
+  {
+    if (this == &obj)
+    {
+      return;
+    }
+
+    if (fixed() || obj.fixed())
+    {
+      //Towers can't leave a fixed buffer, so the values are exchanged in place, and whichever map is longer
+      //hands the rest of its values to the other.
+      node_type* lhs = Head()->mNext[0];
+      node_type* rhs = obj.Head()->mNext[0];
+      while ((lhs != Head()) && (rhs != obj.Head()))
+      {
+        value_type tmp(lhs->mValue);
+        lhs->mValue.~value_type();
+        new ((void*) &lhs->mValue) value_type(rhs->mValue);
+        rhs->mValue.~value_type();
+        new ((void*) &rhs->mValue) value_type(tmp);
+        lhs = lhs->mNext[0];
+        rhs = rhs->mNext[0];
+      }
+      if (lhs != Head())
+      {
+        obj.Append(const_iterator(lhs), end());
+        erase(const_iterator(lhs), end());
+      }
+      else
+      {
+        Append(const_iterator(rhs), obj.end());
+        obj.erase(const_iterator(rhs), obj.end());
+      }
+      std::swap(mCompare, obj.mCompare);
+      return;
+    }
+
+    //Exchange the head links, then point the nodes that linked back to one head at the other.
+    node_type* lhs_last[MAX_HEIGHT];
+    node_type* rhs_last[MAX_HEIGHT];
+    LastNodes(lhs_last);
+    obj.LastNodes(rhs_last);
+
+    node_type* const lhs = Head();
+    node_type* const rhs = obj.Head();
+    std::swap(lhs->mPrev, rhs->mPrev);
+    for (size_type i = 0; i < MAX_HEIGHT; ++i)
+    {
+      std::swap(lhs->mNext[i], rhs->mNext[i]);
+      if (lhs->mNext[i] == rhs)
+      {
+        lhs->mNext[i] = lhs;
+      }
+      else
+      {
+        rhs_last[i]->mNext[i] = lhs;
+      }
+      if (rhs->mNext[i] == lhs)
+      {
+        rhs->mNext[i] = rhs;
+      }
+      else
+      {
+        lhs_last[i]->mNext[i] = rhs;
+      }
+    }
+    if (lhs->mPrev == rhs)
+    {
+      lhs->mPrev = lhs;
+    }
+    else
+    {
+      lhs->mNext[0]->mPrev = lhs;
+    }
+    if (rhs->mPrev == lhs)
+    {
+      rhs->mPrev = rhs;
+    }
+    else
+    {
+      rhs->mNext[0]->mPrev = rhs;
+    }
+
+    std::swap(mSize, obj.mSize);
+    std::swap(mLevel, obj.mLevel);
+    std::swap(mCompare, obj.mCompare);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::iterator skip_map<Key, T, Compare, Alloc>::upper_bound(
+      const Key& key)
+  {
+    return iterator(UpperBound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::const_iterator skip_map<Key, T, Compare, Alloc>::upper_bound(
+      const Key& key) const
+  {
+    return const_iterator(UpperBound(key));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline skip_map<Key, T, Compare, Alloc>::skip_map(void* buffer, size_type n, const Compare& comp) :
+      mSize(0), mLevel(1), mSeed(2463534242u), mCompare(comp)
+  {
+    //The buffer holds the towers of each size class in turn, TowerCount() of each.
+    InitHead();
+    typename pool1_type::node_type* const first1 = (typename pool1_type::node_type*) buffer;
+    typename pool2_type::node_type* const first2 = (typename pool2_type::node_type*) (first1 + TowerCount(n, 0));
+    typename pool4_type::node_type* const first4 = (typename pool4_type::node_type*) (first2 + TowerCount(n, 1));
+    typename pool8_type::node_type* const first8 = (typename pool8_type::node_type*) (first4 + TowerCount(n, 2));
+    typename pool16_type::node_type* const first16 = (typename pool16_type::node_type*) (first8 + TowerCount(n, 3));
+    mPool1.AddBuffer(first1, first1 + TowerCount(n, 0));
+    mPool2.AddBuffer(first2, first2 + TowerCount(n, 1));
+    mPool4.AddBuffer(first4, first4 + TowerCount(n, 2));
+    mPool8.AddBuffer(first8, first8 + TowerCount(n, 3));
+    mPool16.AddBuffer(first16, first16 + TowerCount(n, 4));
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::ClassOf(
+      size_type height)
+  {
+    return (height <= 1) ? 0 : (height <= 2) ? 1 : (height <= 4) ? 2 : (height <= 8) ? 3 : 4;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::TowerCount(
+      size_type n, size_type c)
+  {
+    //The towers a fixed map of n elements keeps for class c.  Class 0 has room for every element.  A node
+    //needs class c > 0 with probability under 2^-(2^c), so each taller class gets twice its expected share.
+    //fixed_skip_map sizes its buffer with the same counts.
+    return (c == 0) ? n : (n >> ((size_type(1) << c) - 1)) + 1;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::AllocateNode(
+      size_type height)
+  {
+    //A fixed map never takes a tall tower from the allocator.  When a class runs out, the node is made short
+    //enough for the next class down, which costs a little search speed but keeps memory within the buffer.
+    size_type c = ClassOf(height);
+    while ((c > 0) && Exhausted(c))
+    {
+      --c;
+    }
+
+    node_type* node;
+    switch (c)
+    {
+    case 0:
+      node = (node_type*) mPool1.allocate();
+      break;
+    case 1:
+      node = (node_type*) mPool2.allocate();
+      break;
+    case 2:
+      node = (node_type*) mPool4.allocate();
+      break;
+    case 3:
+      node = (node_type*) mPool8.allocate();
+      break;
+    default:
+      node = (node_type*) mPool16.allocate();
+      break;
+    }
+    node->mHeight = std::min(height, size_type(1) << c);
+    return node;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::Append(const_iterator first, const_iterator last)
+  {
+    //[first, last) must be in order and follow every key in the map, so each node is linked in after the last
+    //node on each of its levels.
+    node_type* update[MAX_HEIGHT];
+    LastNodes(update);
+    for (; first != last; ++first)
+    {
+      Link(CreateNode(*first), update);
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::CreateNode(
+      const value_type& val)
+  {
+    node_type* const node = AllocateNode(RandomHeight());
+    new ((void*) &node->mValue) value_type(val);
+    return node;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::DestroyNode(node_type* node)
+  {
+    node->mValue.~value_type();
+    switch (ClassOf(node->mHeight))
+    {
+    case 0:
+      mPool1.deallocate(node);
+      break;
+    case 1:
+      mPool2.deallocate(node);
+      break;
+    case 2:
+      mPool4.deallocate(node);
+      break;
+    case 3:
+      mPool8.deallocate(node);
+      break;
+    default:
+      mPool16.deallocate(node);
+      break;
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool skip_map<Key, T, Compare, Alloc>::Exhausted(size_type c) const
+  {
+    switch (c)
+    {
+    case 0:
+      return mPool1.fixed() && mPool1.empty();
+    case 1:
+      return mPool2.fixed() && mPool2.empty();
+    case 2:
+      return mPool4.fixed() && mPool4.empty();
+    case 3:
+      return mPool8.fixed() && mPool8.empty();
+    default:
+      return mPool16.fixed() && mPool16.empty();
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::Head() const
+  {
+    return (node_type*) &mHead;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::InitHead()
+  {
+    node_type* const head = Head();
+    head->mPrev = head;
+    head->mHeight = MAX_HEIGHT;
+    for (size_type i = 0; i < MAX_HEIGHT; ++i)
+    {
+      head->mNext[i] = head;
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::LastNodes(node_type** last) const
+  {
+    //Fills last[i] with the last node on level i, or the head if the level is empty.
+    node_type* const head = Head();
+    node_type* x = head;
+    for (size_type i = MAX_HEIGHT; i-- > 0;)
+    {
+      while (x->mNext[i] != head)
+      {
+        x = x->mNext[i];
+      }
+      last[i] = x;
+    }
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::Link(node_type* node, node_type** update)
+  {
+    //Links node in after update[i] on each of its levels, and leaves update[i] pointing at node.
+    const size_type height = node->mHeight;
+    for (size_type i = mLevel; i < height; ++i)
+    {
+      update[i] = Head();
+    }
+    if (height > mLevel)
+    {
+      mLevel = height;
+    }
+
+    node->mPrev = update[0];
+    update[0]->mNext[0]->mPrev = node;
+    for (size_type i = 0; i < height; ++i)
+    {
+      node->mNext[i] = update[i]->mNext[i];
+      update[i]->mNext[i] = node;
+      update[i] = node;
+    }
+    ++mSize;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::LowerBound(
+      const Key& key) const
+  {
+    node_type* const head = Head();
+    node_type* x = head;
+    for (size_type i = mLevel; i-- > 0;)
+    {
+      node_type* next;
+      while (((next = x->mNext[i]) != head) && mCompare(next->mValue.first, key))
+      {
+        x = next;
+      }
+    }
+    return x->mNext[0];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::size_type skip_map<Key, T, Compare, Alloc>::RandomHeight()
+  {
+    //A xorshift generator.  Each pair of low zero bits adds a level, so a node reaches level i with
+    //probability 4^-i.
+    mSeed ^= mSeed << 13;
+    mSeed ^= mSeed >> 17;
+    mSeed ^= mSeed << 5;
+    uint32_t bits = mSeed;
+    size_type height = 1;
+    while (((bits & 3) == 0) && (height < MAX_HEIGHT))
+    {
+      ++height;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::ReleaseOverflow(const void* first, const void* last)
+  {
+    mPool1.ReleaseOverflow(first, last);
+    mPool2.ReleaseOverflow(first, last);
+    mPool4.ReleaseOverflow(first, last);
+    mPool8.ReleaseOverflow(first, last);
+    mPool16.ReleaseOverflow(first, last);
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::Search(
+      const Key& key, node_type** update) const
+  {
+    //Fills update[i] with the last node on level i whose key is less than key, for each level in use.  Returns
+    //the first node whose key is not less than key.
+    node_type* const head = Head();
+    node_type* x = head;
+    for (size_type i = mLevel; i-- > 0;)
+    {
+      node_type* next;
+      while (((next = x->mNext[i]) != head) && mCompare(next->mValue.first, key))
+      {
+        x = next;
+      }
+      update[i] = x;
+    }
+    return x->mNext[0];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline void skip_map<Key, T, Compare, Alloc>::Unlink(node_type* node, node_type** update)
+  {
+    //update[i] must be node's predecessor on each of its levels.
+    for (size_type i = 0; i < node->mHeight; ++i)
+    {
+      update[i]->mNext[i] = node->mNext[i];
+    }
+    node->mNext[0]->mPrev = node->mPrev;
+
+    node_type* const head = Head();
+    while ((mLevel > 1) && (head->mNext[mLevel - 1] == head))
+    {
+      --mLevel;
+    }
+    --mSize;
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline typename skip_map<Key, T, Compare, Alloc>::node_type* skip_map<Key, T, Compare, Alloc>::UpperBound(
+      const Key& key) const
+  {
+    node_type* const head = Head();
+    node_type* x = head;
+    for (size_type i = mLevel; i-- > 0;)
+    {
+      node_type* next;
+      while (((next = x->mNext[i]) != head) && !mCompare(key, next->mValue.first))
+      {
+        x = next;
+      }
+    }
+    return x->mNext[0];
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool operator==(const skip_map<Key, T, Compare, Alloc>& lhs, const skip_map<Key, T, Compare, Alloc>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  template<class Key, class T, class Compare, class Alloc>
+  inline bool operator!=(const skip_map<Key, T, Compare, Alloc>& lhs, const skip_map<Key, T, Compare, Alloc>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_SKIP_MAP_H */
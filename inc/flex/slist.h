@@ -0,0 +1,1059 @@
+#ifndef FLEX_SLIST_H
+#define FLEX_SLIST_H
+
+#include <flex/internal/slist_iterator.h>
+#include <flex/internal/list_node_pool.h>
+#include <flex/allocator.h>
+#include <flex/initializer_list.h>
+
+#include <algorithm>
+
+namespace flex
+{
+
+  /*
+   * A singly linked list.  Each node carries one link instead of the two of list, which halves the link overhead
+   * for stack and queue usage.  A tail pointer is kept so push_back() is O(1), but there is no pop_back().  As
+   * with std::forward_list, insertions and erasures take the position before the affected elements.  Node
+   * pooling and the fixed buffer of fixed_slist come from list_node_pool, which list and fixed_list share.
+   */
+  template<class T, class Alloc = allocator<slist_node<T> > > class slist: public list_node_pool<T, slist_node<T>,
+      Alloc>
+  {
+  public:
+    typedef slist<T, Alloc> this_type;
+    typedef list_node_pool<T, slist_node<T>, Alloc> node_pool_type;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef slist_node<T> node_type;
+    typedef slist_node_base base_node_type;
+    typedef slist_iterator<T, T*, T&> iterator;
+    typedef slist_iterator<T, const T*, const T&> const_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Alloc allocator_type;
+
+    slist();
+    explicit slist(size_t size, const T& val = T());
+    slist(int size, const T& val);
+    template<typename InputIterator> slist(InputIterator first, InputIterator last);
+    slist(const slist<T, Alloc> & obj);
+#ifdef FLEX_HAS_CXX11
+    slist(slist<T, Alloc>&& x);
+#endif
+    slist(std::initializer_list<value_type> il);
+    ~slist();
+
+    void assign(size_t size, const_reference val);
+    void assign(int size, const_reference val);
+    template<typename InputIterator> void assign(InputIterator first, InputIterator last);
+    void assign(std::initializer_list<value_type> il);
+    reference back();
+    const_reference back() const;
+    iterator before_begin();
+    const_iterator before_begin() const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbefore_begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    size_type capacity();
+    void clear();
+#ifdef FLEX_HAS_CXX11
+    template<class...Args> iterator emplace_after(iterator position, Args&&... val);
+    template<class...Args> void emplace_back(Args&&... val);
+    template<class...Args> void emplace_front(Args&&... val);
+#endif
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    iterator erase_after(iterator position);
+    iterator erase_after(iterator first, iterator last);
+    bool fixed() const;
+    reference front();
+    const_reference front() const;
+    bool full() const;
+    allocator_type get_allocator() const;
+    iterator insert_after(iterator position, const_reference val);
+#ifdef FLEX_HAS_CXX11
+    iterator insert_after(iterator position, value_type&& val);
+#endif
+    iterator insert_after(iterator position, size_type n, const_reference val);
+    iterator insert_after(iterator position, int n, const_reference val);
+    template<typename InputIterator> iterator insert_after(iterator position, InputIterator first,
+        InputIterator last);
+    size_type max_size() const;
+    void merge(this_type& x);
+    template<typename Compare> void merge(this_type& x, Compare comp);
+    slist<T, Alloc>& operator=(const slist<T, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    slist<T, Alloc>& operator=(slist<T, Alloc>&& x);
+#endif
+    slist<T, Alloc>& operator=(std::initializer_list<value_type> il);
+    void pop_front();
+    void push_back(const_reference val);
+    void push_front(const_reference val);
+#ifdef FLEX_HAS_CXX11
+    void push_back(value_type&& val);
+    void push_front(value_type&& val);
+#endif
+    void remove(const T& x);
+    template<typename Predicate> void remove_if(Predicate pred);
+    void reserve(size_type n);
+    void resize(size_type n, const value_type& val = value_type());
+    void reverse(void);
+    void shrink_to_fit();
+    size_t size() const;
+    void sort();
+    template<typename Compare> void sort(Compare comp);
+    void splice_after(iterator position, this_type& x);
+    void splice_after(iterator position, this_type& x, iterator i);
+    void splice_after(iterator position, this_type& x, iterator first, iterator last);
+    void swap(slist<T, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    void swap(slist<T, Alloc>&& obj);
+#endif
+    void unique();
+    template<typename BinaryPredicate> void unique(BinaryPredicate binary_pred);
+  protected:
+    using node_pool_type::mNodePool;
+    using node_pool_type::mFixedBegin;
+    using node_pool_type::mFixedEnd;
+    using node_pool_type::mAllocator;
+    using node_pool_type::mFixed;
+    using node_pool_type::mOverflow;
+    using node_pool_type::AllocateNode;
+    using node_pool_type::RetrieveNode;
+    using node_pool_type::GetNodePoolSize;
+    using node_pool_type::FillNodePool;
+    using node_pool_type::PushToNodePool;
+    using node_pool_type::PurgeNodePool;
+    using node_pool_type::PurgeOverflowNodes;
+
+    slist(node_type* first, node_type* last);
+
+    /*
+     * Internal methods used by the public sort() and merge() methods.  They work on chains of nodes terminated
+     * by NULL, and keep track of each chain's last node so the tail pointer can be restored without a walk.
+     */
+    void LinkChain(base_node_type* head, base_node_type* last);
+    template<typename Compare> static base_node_type* MergeChains(base_node_type* a, base_node_type* a_last,
+        base_node_type* b, base_node_type* b_last, Compare comp, base_node_type*& last);
+
+    void LinkAfter(base_node_type* position, node_type* new_node);
+    void PushRangeToNodePool(base_node_type* first, base_node_type* last);
+
+    /*
+     * The anchor node's mNext is the head of the list, which is terminated by NULL.  It acts as the node before
+     * begin(), so insertions and erasures at the front need no special case.  mTail points to the last node, or
+     * to the anchor when the list is empty.
+     */
+    base_node_type mAnchor;
+    base_node_type* mTail;
+    size_type mSize;
+
+  private:
+
+  };
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist() :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(size_type size, const T& val) :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    insert_after(before_begin(), size, val);
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(int size, const T& val) :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    insert_after(before_begin(), (size_type) size, val);
+  }
+
+  template<class T, class Alloc>
+  template<typename InputIterator>
+  inline slist<T, Alloc>::slist(InputIterator first, InputIterator last) :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    insert_after(before_begin(), first, last);
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(const slist<T, Alloc> & obj) :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    insert_after(before_begin(), obj.cbegin(), obj.cend());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(slist<T, Alloc> && obj):
+  mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    swap(std::move(obj));
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(std::initializer_list<value_type> il) :
+      mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+    insert_after(before_begin(), il.begin(), il.end());
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::~slist()
+  {
+    flex::destruct_range(begin(), end());
+
+    if (!mFixed)
+    {
+      for (iterator it = begin(); it != end();)
+      {
+        iterator tmp = it;
+        ++it;
+        mAllocator.deallocate(tmp.mNode, 1);
+      }
+
+      PurgeNodePool();
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::assign(size_t n, const_reference val)
+  {
+    base_node_type* prev = &mAnchor;
+    for (; (n > 0) && (prev->mNext != NULL); --n)
+    {
+      prev = prev->mNext;
+      static_cast<node_type*>(prev)->mValue = val;
+    }
+
+    if (n)
+    {
+      insert_after(iterator(prev), n, val);
+    }
+    else
+    {
+      erase_after(iterator(prev), end());
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::assign(int n, const_reference val)
+  {
+    //The purpose of this method is to prevent ambiguity issues in the case where
+    //both n and val are type int.  Without this method, the compiler will incorrectly
+    //use the templated assign() method assuming n and val are type InputIterator.
+    assign((size_type) n, val);
+  }
+
+  template<class T, class Alloc>
+  template<typename InputIterator>
+  inline void slist<T, Alloc>::assign(InputIterator first, InputIterator last)
+  {
+    base_node_type* prev = &mAnchor;
+    for (; (first != last) && (prev->mNext != NULL); ++first)
+    {
+      prev = prev->mNext;
+      static_cast<node_type*>(prev)->mValue = *first;
+    }
+
+    if (first != last)
+    {
+      insert_after(iterator(prev), first, last);
+    }
+    else
+    {
+      erase_after(iterator(prev), end());
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::assign(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::reference slist<T, Alloc>::back()
+  {
+    return static_cast<node_type*>(mTail)->mValue;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_reference slist<T, Alloc>::back() const
+  {
+    return static_cast<const node_type*>(mTail)->mValue;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::before_begin()
+  {
+    return iterator(&mAnchor);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::before_begin() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::begin()
+  {
+    return iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::begin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::cbefore_begin() const
+  {
+    return const_iterator(&mAnchor);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::cbegin() const
+  {
+    return const_iterator(mAnchor.mNext);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::cend() const
+  {
+    return const_iterator(NULL);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::size_type slist<T, Alloc>::capacity()
+  {
+    return mSize + GetNodePoolSize() + (mFixedEnd - mFixedBegin);
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::clear()
+  {
+    erase_after(before_begin(), end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  template<class...Args>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::emplace_after(iterator position, Args&&... args)
+  {
+    node_type* new_node = RetrieveNode(std::forward<Args>(args)...);
+    LinkAfter(position.mNode, new_node);
+    return iterator(new_node);
+  }
+
+  template<class T, class Alloc>
+  template<class...Args>
+  inline void slist<T, Alloc>::emplace_back(Args&&... args)
+  {
+    LinkAfter(mTail, RetrieveNode(std::forward<Args>(args)...));
+  }
+
+  template<class T, class Alloc>
+  template<class...Args>
+  inline void slist<T, Alloc>::emplace_front(Args&&... args)
+  {
+    LinkAfter(&mAnchor, RetrieveNode(std::forward<Args>(args)...));
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline bool slist<T, Alloc>::empty() const
+  {
+    return (0 == mSize);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::end()
+  {
+    return iterator(NULL);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_iterator slist<T, Alloc>::end() const
+  {
+    return const_iterator(NULL);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::erase_after(iterator position)
+  {
+    base_node_type* const prev = position.mNode;
+    node_type* const ptr = static_cast<node_type*>(prev->mNext);
+    prev->mNext = ptr->mNext;
+    if (mTail == ptr)
+    {
+      mTail = prev;
+    }
+
+    PushToNodePool(ptr);
+    --mSize;
+
+    return iterator(prev->mNext);
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::erase_after(iterator first, iterator last)
+  {
+    base_node_type* const prev = first.mNode;
+    if (prev->mNext != last.mNode)
+    {
+      PushRangeToNodePool(prev->mNext, last.mNode);
+      prev->mNext = last.mNode;
+      if (last.mNode == NULL)
+      {
+        mTail = prev;
+      }
+    }
+
+    return last;
+  }
+
+  template<class T, class Alloc>
+  inline bool slist<T, Alloc>::fixed() const
+  {
+    return mFixed;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::reference slist<T, Alloc>::front()
+  {
+    return static_cast<node_type*>(mAnchor.mNext)->mValue;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::const_reference slist<T, Alloc>::front() const
+  {
+    return static_cast<node_type*>(mAnchor.mNext)->mValue;
+  }
+
+  template<class T, class Alloc>
+  inline bool slist<T, Alloc>::full() const
+  {
+    return ((NULL == mNodePool) && (mFixedBegin == mFixedEnd));
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::allocator_type slist<T, Alloc>::get_allocator() const
+  {
+    return mAllocator;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::insert_after(iterator position, const_reference val)
+  {
+    node_type* new_node = RetrieveNode(val);
+    LinkAfter(position.mNode, new_node);
+    return iterator(new_node);
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::insert_after(iterator position, value_type&& val)
+  {
+    node_type* new_node = RetrieveNode(std::move(val));
+    LinkAfter(position.mNode, new_node);
+    return iterator(new_node);
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::insert_after(iterator position, size_type n,
+      const_reference val)
+  {
+    //Each node is linked in as soon as it is constructed, so the list stays valid if an allocation throws.
+    for (; n > 0; --n)
+    {
+      position = insert_after(position, val);
+    }
+    return position;
+  }
+
+  template<class T, class Alloc>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::insert_after(iterator position, int n,
+      const_reference val)
+  {
+    //The purpose of this method is to prevent ambiguity issues in the case where
+    //both n and val are type int.  Without this method, the compiler will incorrectly
+    //use the templated insert_after() method assuming n and val are type InputIterator.
+    return insert_after(position, (size_type) n, val);
+  }
+
+  template<class T, class Alloc>
+  template<typename InputIterator>
+  inline typename slist<T, Alloc>::iterator slist<T, Alloc>::insert_after(iterator position, InputIterator first,
+      InputIterator last)
+  {
+    for (; first != last; ++first)
+    {
+      position = insert_after(position, *first);
+    }
+    return position;
+  }
+
+  template<class T, class Alloc>
+  inline size_t slist<T, Alloc>::max_size() const
+  {
+    return mAllocator.max_size();
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::merge(this_type& x)
+  {
+    merge(x, std::less<value_type>());
+  }
+
+  template<class T, class Alloc>
+  template<typename Compare>
+  inline void slist<T, Alloc>::merge(this_type& x, Compare comp)
+  {
+    if ((this == &x) || (x.mSize == 0))
+    {
+      return;
+    }
+
+    if ((!mFixed) && (!x.fixed()))
+    {
+      base_node_type* head = x.mAnchor.mNext;
+      base_node_type* last = x.mTail;
+      if (mSize)
+      {
+        head = MergeChains(mAnchor.mNext, mTail, head, last, comp, last);
+      }
+      LinkChain(head, last);
+      mSize += x.mSize;
+      x.mAnchor.mNext = NULL;
+      x.mTail = &x.mAnchor;
+      x.mSize = 0;
+    }
+    else
+    {
+      //Nodes can't leave a fixed buffer, so the elements of x are copied in and x is cleared.
+      base_node_type* prev = &mAnchor;
+      for (iterator it = x.begin(); it != x.end(); ++it)
+      {
+        while ((prev->mNext != NULL) && !comp(*it, static_cast<node_type*>(prev->mNext)->mValue))
+        {
+          prev = prev->mNext;
+        }
+        prev = insert_after(iterator(prev), *it).mNode;
+      }
+      x.clear();
+    }
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>& slist<T, Alloc>::operator=(const slist<T, Alloc>& obj)
+  {
+    assign(obj.begin(), obj.end());
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline slist<T, Alloc>& slist<T, Alloc>::operator=(slist<T, Alloc>&& obj)
+  {
+    swap(std::move(obj));
+    return *this;
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>& slist<T, Alloc>::operator=(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::pop_front()
+  {
+    erase_after(before_begin());
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::push_back(const T& val)
+  {
+    LinkAfter(mTail, RetrieveNode(val));
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::push_front(const T& val)
+  {
+    LinkAfter(&mAnchor, RetrieveNode(val));
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::push_back(value_type&& val)
+  {
+    LinkAfter(mTail, RetrieveNode(std::move(val)));
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::push_front(value_type&& val)
+  {
+    LinkAfter(&mAnchor, RetrieveNode(std::move(val)));
+  }
+#endif
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::remove(const value_type& value)
+  {
+    base_node_type* prev = &mAnchor;
+    while (prev->mNext != NULL)
+    {
+      if (static_cast<node_type*>(prev->mNext)->mValue == value)
+      {
+        erase_after(iterator(prev));
+      }
+      else
+      {
+        prev = prev->mNext;
+      }
+    }
+  }
+
+  template<typename T, typename Alloc>
+  template<typename Predicate>
+  inline void slist<T, Alloc>::remove_if(Predicate pred)
+  {
+    base_node_type* prev = &mAnchor;
+    while (prev->mNext != NULL)
+    {
+      if (pred(static_cast<node_type*>(prev->mNext)->mValue))
+      {
+        erase_after(iterator(prev));
+      }
+      else
+      {
+        prev = prev->mNext;
+      }
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::reserve(size_type n)
+  {
+    size_type current_capacity = capacity();
+    if (n > current_capacity)
+    {
+      FillNodePool(n - current_capacity);
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::resize(size_type n, const value_type& val)
+  {
+    if (n < mSize)
+    {
+      iterator it(&mAnchor);
+      for (; n > 0; --n)
+      {
+        ++it;
+      }
+      erase_after(it, end());
+    }
+    else if (n > mSize)
+    {
+      insert_after(iterator(mTail), n - mSize, val);
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::reverse()
+  {
+    base_node_type* node = mAnchor.mNext;
+    base_node_type* reversed = NULL;
+    if (node != NULL)
+    {
+      mTail = node;
+    }
+    while (node != NULL)
+    {
+      base_node_type* const next = node->mNext;
+      node->mNext = reversed;
+      reversed = node;
+      node = next;
+    }
+    mAnchor.mNext = reversed;
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::shrink_to_fit()
+  {
+    if (!mFixed)
+    {
+      PurgeNodePool();
+    }
+  }
+
+  template<class T, class Alloc>
+  inline size_t slist<T, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::sort()
+  {
+    sort(std::less<value_type>());
+  }
+
+  template<typename T, typename Alloc>
+  template<typename Compare>
+  inline void slist<T, Alloc>::sort(Compare comp)
+  {
+    if (mSize < 2)
+    {
+      return;
+    }
+
+    //Bottom-up merge sort, as in list::sort().  bins[k] holds a sorted chain of 2^k nodes and bin_last[k] its
+    //last node, so merging a new node in works like incrementing a binary counter.
+    base_node_type* bins[sizeof(size_type) * 8 + 1];
+    base_node_type* bin_last[sizeof(size_type) * 8 + 1];
+    size_t bin_count = 0;
+
+    base_node_type* node = mAnchor.mNext;
+    while (node)
+    {
+      base_node_type* carry = node;
+      base_node_type* carry_last = node;
+      node = node->mNext;
+      carry->mNext = NULL;
+
+      size_t k = 0;
+      for (; (k < bin_count) && bins[k]; ++k)
+      {
+        carry = MergeChains(bins[k], bin_last[k], carry, carry_last, comp, carry_last);
+        bins[k] = NULL;
+      }
+      if (k == bin_count)
+      {
+        ++bin_count;
+      }
+      bins[k] = carry;
+      bin_last[k] = carry_last;
+    }
+
+    //Lower bins hold the later elements, so each is merged in as the right hand side to keep the sort stable.
+    base_node_type* head = NULL;
+    base_node_type* last = NULL;
+    for (size_t k = 0; k < bin_count; ++k)
+    {
+      if (bins[k])
+      {
+        if (head)
+        {
+          head = MergeChains(bins[k], bin_last[k], head, last, comp, last);
+        }
+        else
+        {
+          head = bins[k];
+          last = bin_last[k];
+        }
+      }
+    }
+    LinkChain(head, last);
+  }
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::splice_after(iterator position, this_type& x)
+  {
+    splice_after(position, x, x.before_begin(), x.end());
+  }
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::splice_after(iterator position, this_type& x, iterator i)
+  {
+    iterator last(i);
+    ++last;
+    if ((position != i) && (last != end()) && (position != last))
+    {
+      splice_after(position, x, i, ++last);
+    }
+  }
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::splice_after(iterator position, this_type& x, iterator first, iterator last)
+  {
+    //Moves the elements in (first, last) to follow position.
+    base_node_type* const head = first.mNode->mNext;
+    if (head == last.mNode)
+    {
+      return;
+    }
+
+    if ((this == &x) || ((!mFixed) && (!x.fixed())))
+    {
+      size_type n = 1;
+      base_node_type* tail = head;
+      for (; tail->mNext != last.mNode; tail = tail->mNext)
+      {
+        ++n;
+      }
+
+      first.mNode->mNext = last.mNode;
+      if (x.mTail == tail)
+      {
+        x.mTail = first.mNode;
+      }
+      tail->mNext = position.mNode->mNext;
+      position.mNode->mNext = head;
+      if (mTail == position.mNode)
+      {
+        mTail = tail;
+      }
+      mSize += n;
+      x.mSize -= n;
+    }
+    else
+    {
+      //Nodes can't leave a fixed buffer, so the elements are copied and then erased from x.
+      insert_after(position, iterator(head), last);
+      x.erase_after(first, last);
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::swap(slist<T, Alloc>& obj)
+  {
+    if ((!mFixed) && (!obj.fixed()))
+    {
+      std::swap(mAnchor.mNext, obj.mAnchor.mNext);
+      std::swap(mTail, obj.mTail);
+      std::swap(mSize, obj.mSize);
+      std::swap(mNodePool, obj.mNodePool);
+
+      //An empty list's tail is its own anchor.
+      if (mTail == &obj.mAnchor)
+      {
+        mTail = &mAnchor;
+      }
+      if (obj.mTail == &mAnchor)
+      {
+        obj.mTail = &obj.mAnchor;
+      }
+    }
+    else
+    {
+      base_node_type* lhs = &mAnchor;
+      base_node_type* rhs = &obj.mAnchor;
+      while ((lhs->mNext != NULL) && (rhs->mNext != NULL))
+      {
+        lhs = lhs->mNext;
+        rhs = rhs->mNext;
+        std::swap(static_cast<node_type*>(lhs)->mValue, static_cast<node_type*>(rhs)->mValue);
+      }
+      if (lhs->mNext != NULL)
+      {
+        obj.insert_after(iterator(rhs), iterator(lhs->mNext), end());
+        erase_after(iterator(lhs), end());
+      }
+      else
+      {
+        insert_after(iterator(lhs), iterator(rhs->mNext), end());
+        obj.erase_after(iterator(rhs), end());
+      }
+    }
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::swap(slist<T, Alloc>&& obj)
+  {
+    if ((!mFixed) && (!obj.fixed()))
+    {
+      swap(obj);
+    }
+    else
+    {
+      assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+      obj.clear();
+    }
+  }
+#endif
+
+  template<typename T, typename Alloc>
+  inline void slist<T, Alloc>::unique()
+  {
+    //Deletes all but the first element of each consecutive group of equal elements.
+    base_node_type* node = mAnchor.mNext;
+    while ((node != NULL) && (node->mNext != NULL))
+    {
+      if (static_cast<node_type*>(node->mNext)->mValue == static_cast<node_type*>(node)->mValue)
+      {
+        erase_after(iterator(node));
+      }
+      else
+      {
+        node = node->mNext;
+      }
+    }
+  }
+
+  template<typename T, typename Alloc>
+  template<typename BinaryPredicate>
+  inline void slist<T, Alloc>::unique(BinaryPredicate binary_pred)
+  {
+    //Deletes all but the first element of each consecutive group of equal elements.
+    base_node_type* node = mAnchor.mNext;
+    while ((node != NULL) && (node->mNext != NULL))
+    {
+      if (binary_pred(static_cast<node_type*>(node)->mValue, static_cast<node_type*>(node->mNext)->mValue))
+      {
+        erase_after(iterator(node));
+      }
+      else
+      {
+        node = node->mNext;
+      }
+    }
+  }
+
+  template<class T, class Alloc>
+  inline slist<T, Alloc>::slist(node_type* first, node_type* last) :
+      node_pool_type(first, last), mTail(&mAnchor), mSize(0)
+  {
+    mAnchor.mNext = NULL;
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::LinkChain(base_node_type* head, base_node_type* last)
+  {
+    //Makes the chain from head to last the contents of the list.
+    mAnchor.mNext = head;
+    mTail = last;
+    mTail->mNext = NULL;
+  }
+
+  template<class T, class Alloc>
+  template<typename Compare>
+  inline slist_node_base* slist<T, Alloc>::MergeChains(base_node_type* a, base_node_type* a_last,
+      base_node_type* b, base_node_type* b_last, Compare comp, base_node_type*& last)
+  {
+    //Merges two non-empty sorted chains.  Ties are taken from a.  The chain left over when the other runs
+    //out supplies the last node.
+    base_node_type* head;
+    base_node_type** tail = &head;
+    while (a && b)
+    {
+      if (comp(static_cast<node_type*>(b)->mValue, static_cast<node_type*>(a)->mValue))
+      {
+        *tail = b;
+        tail = &b->mNext;
+        b = b->mNext;
+      }
+      else
+      {
+        *tail = a;
+        tail = &a->mNext;
+        a = a->mNext;
+      }
+    }
+    *tail = a ? a : b;
+    last = a ? a_last : b_last;
+    return head;
+  }
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::LinkAfter(base_node_type* position, node_type* new_node)
+  {
+    new_node->mNext = position->mNext;
+    position->mNext = new_node;
+    if (mTail == position)
+    {
+      mTail = new_node;
+    }
+    ++mSize;
+  }
+
+#ifdef FLEX_HAS_CXX11
+#endif
+
+  template<class T, class Alloc>
+  inline void slist<T, Alloc>::PushRangeToNodePool(base_node_type* first, base_node_type* last)
+  {
+    FLEX_ASSERT(first != last);
+    //Destroys the values of [first,last) and links the nodes onto the front of the pool.  The caller relinks
+    //the list around them.
+    base_node_type* node = first;
+    for (;;)
+    {
+      static_cast<node_type*>(node)->mValue.~value_type();
+      --mSize;
+      if (node->mNext == last)
+      {
+        break;
+      }
+      node = node->mNext;
+    }
+    node->mNext = mNodePool;
+    mNodePool = static_cast<node_type*>(first);
+  }
+
+  template<class T, class Alloc>
+  bool operator==(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  template<class T, class Alloc>
+  bool operator<(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  template<class T, class Alloc>
+  bool operator!=(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  template<class T, class Alloc>
+  bool operator>(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  template<class T, class Alloc>
+  bool operator<=(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  template<class T, class Alloc>
+  bool operator>=(const slist<T, Alloc>& lhs, const slist<T, Alloc>& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+} //namespace flex
+#endif /* FLEX_SLIST_H */
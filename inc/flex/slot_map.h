@@ -0,0 +1,614 @@
+#ifndef FLEX_SLOT_MAP_H
+#define FLEX_SLOT_MAP_H
+
+#include <flex/allocator.h>
+
+#include <algorithm>
+#include <memory>
+#include <iterator>
+
+#include <stdint.h>
+
+namespace flex
+{
+
+  //A slot_map hands out handles rather than pointers.  A handle is a 32-bit slot index paired with a 32-bit
+  //generation.  Every time a slot is reused its generation is bumped, so a handle to an erased object is
+  //detected in O(1) instead of silently aliasing whatever object was constructed in its place.
+  struct slot_map_handle
+  {
+    uint32_t mIndex;
+    uint32_t mGeneration;
+
+    slot_map_handle() :
+        mIndex(0xFFFFFFFF), mGeneration(0)
+    {
+    }
+
+    slot_map_handle(uint32_t index, uint32_t generation) :
+        mIndex(index), mGeneration(generation)
+    {
+    }
+  };
+
+  inline bool operator==(const slot_map_handle& lhs, const slot_map_handle& rhs)
+  {
+    return (lhs.mIndex == rhs.mIndex) && (lhs.mGeneration == rhs.mGeneration);
+  }
+
+  inline bool operator!=(const slot_map_handle& lhs, const slot_map_handle& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //Each slot maps a handle to the dense array.  While the slot is in use mIndex is the position of the
+  //object in the dense array.  Once the slot is freed, mIndex links to the next free slot, which works just
+  //like the pool_link free list.  The generation is odd while the slot is in use and even while it is free,
+  //so handles (which are always odd) never match a free slot.
+  struct slot_map_slot
+  {
+    uint32_t mIndex;
+    uint32_t mGeneration;
+  };
+
+  //Objects are stored densely, so iterating over every live object is a linear scan of a contiguous array.
+  //Erasing an object moves the last object into its place, therefore erase() invalidates iterators and
+  //pointers (but never handles) and the iteration order is unspecified.
+  template<class T, class Alloc = allocator<T> >
+  class slot_map: public guarded_object
+  {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<T*> reverse_iterator;
+    typedef std::reverse_iterator<const T*> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Alloc allocator_type;
+    typedef slot_map_handle handle_type;
+    typedef slot_map_slot slot_type;
+    typedef typename Alloc::template rebind<slot_type>::other slot_allocator_type;
+    typedef typename Alloc::template rebind<uint32_t>::other index_allocator_type;
+
+    static const uint32_t npos = 0xFFFFFFFF;
+
+    slot_map();
+    explicit slot_map(size_type capacity);
+    slot_map(const slot_map<T, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    slot_map(slot_map<T, Alloc> && obj);
+#endif
+    ~slot_map();
+
+    reference at(handle_type handle);
+    const_reference at(handle_type handle) const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    size_type capacity() const;
+    void clear();
+    bool contains(handle_type handle) const;
+    pointer data();
+    const_pointer data() const;
+#ifdef FLEX_HAS_CXX11
+    template<class...Args> handle_type emplace(Args&&... args);
+#endif
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    bool erase(handle_type handle);
+    iterator erase(iterator position);
+    pointer find(handle_type handle);
+    const_pointer find(handle_type handle) const;
+    bool fixed() const;
+    handle_type get_handle(const_iterator position) const;
+    handle_type insert(const value_type& val);
+#ifdef FLEX_HAS_CXX11
+    handle_type insert(value_type&& val);
+#endif
+    size_type max_size() const;
+    slot_map<T, Alloc>& operator=(const slot_map<T, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    slot_map<T, Alloc>& operator=(slot_map<T, Alloc>&& obj);
+#endif
+    reference operator[](handle_type handle);
+    const_reference operator[](handle_type handle) const;
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    void reserve(size_type n);
+    size_type size() const;
+
+  protected:
+    pointer mBegin;
+    pointer mEnd;
+    pointer mCapacity;
+    slot_type* mSlots;
+    uint32_t* mErase;
+    uint32_t mSlotCount;
+    uint32_t mFreeHead;
+    Alloc mAllocator;
+    slot_allocator_type mSlotAllocator;
+    index_allocator_type mIndexAllocator;
+    bool mFixed;
+
+    slot_map(pointer values, slot_type* slots, uint32_t* erase, size_type capacity);
+
+    uint32_t AcquireSlot();
+    void Deallocate();
+    size_type GetNewCapacity(size_type min_size);
+    void Reallocate(size_type new_capacity);
+  };
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::slot_map() :
+      mBegin(NULL), mEnd(NULL), mCapacity(NULL), mSlots(NULL), mErase(NULL), mSlotCount(0), mFreeHead(npos), mFixed(
+          false)
+  {
+  }
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::slot_map(size_type capacity) :
+      mBegin(NULL), mEnd(NULL), mCapacity(NULL), mSlots(NULL), mErase(NULL), mSlotCount(0), mFreeHead(npos), mFixed(
+          false)
+  {
+    reserve(capacity);
+  }
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::slot_map(const slot_map<T, Alloc>& obj) :
+      mBegin(NULL), mEnd(NULL), mCapacity(NULL), mSlots(NULL), mErase(NULL), mSlotCount(0), mFreeHead(npos), mFixed(
+          false)
+  {
+    *this = obj;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::slot_map(slot_map<T, Alloc> && obj) :
+  mBegin(NULL), mEnd(NULL), mCapacity(NULL), mSlots(NULL), mErase(NULL), mSlotCount(0), mFreeHead(npos), mFixed(
+      false)
+  {
+    *this = std::move(obj);
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::~slot_map()
+  {
+    flex::destruct_range(mBegin, mEnd);
+    if (!mFixed)
+    {
+      Deallocate();
+    }
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::reference slot_map<T, Alloc>::at(handle_type handle)
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(!contains(handle), "flex::slot_map.at() - invalid handle");
+    return mBegin[mSlots[handle.mIndex].mIndex];
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reference slot_map<T, Alloc>::at(handle_type handle) const
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(!contains(handle), "flex::slot_map.at() - invalid handle");
+    return mBegin[mSlots[handle.mIndex].mIndex];
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::iterator slot_map<T, Alloc>::begin()
+  {
+    return mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_iterator slot_map<T, Alloc>::begin() const
+  {
+    return mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_iterator slot_map<T, Alloc>::cbegin() const
+  {
+    return mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_iterator slot_map<T, Alloc>::cend() const
+  {
+    return mEnd;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reverse_iterator slot_map<T, Alloc>::crbegin() const
+  {
+    return const_reverse_iterator(mEnd);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reverse_iterator slot_map<T, Alloc>::crend() const
+  {
+    return const_reverse_iterator(mBegin);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::size_type slot_map<T, Alloc>::capacity() const
+  {
+    return mCapacity - mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline void slot_map<T, Alloc>::clear()
+  {
+    //Free the slot of every live object so that outstanding handles become stale.
+    for (uint32_t* it = mErase; it != mErase + size(); ++it)
+    {
+      slot_type& slot = mSlots[*it];
+      ++slot.mGeneration;
+      slot.mIndex = mFreeHead;
+      mFreeHead = *it;
+    }
+    flex::destruct_range(mBegin, mEnd);
+    mEnd = mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline bool slot_map<T, Alloc>::contains(handle_type handle) const
+  {
+    return (handle.mIndex < mSlotCount) && (mSlots[handle.mIndex].mGeneration == handle.mGeneration);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::pointer slot_map<T, Alloc>::data()
+  {
+    return mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_pointer slot_map<T, Alloc>::data() const
+  {
+    return mBegin;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  template<class... Args>
+  inline typename slot_map<T, Alloc>::handle_type slot_map<T, Alloc>::emplace(Args&&... args)
+  {
+    if (mEnd == mCapacity)
+    {
+      Reallocate(GetNewCapacity(size() + 1));
+    }
+
+    new ((void*) mEnd) value_type(std::forward<Args>(args)...);
+    uint32_t index = AcquireSlot();
+    ++mEnd;
+    return handle_type(index, mSlots[index].mGeneration);
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline bool slot_map<T, Alloc>::empty() const
+  {
+    return (mBegin == mEnd);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::iterator slot_map<T, Alloc>::end()
+  {
+    return mEnd;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_iterator slot_map<T, Alloc>::end() const
+  {
+    return mEnd;
+  }
+
+  template<class T, class Alloc>
+  inline bool slot_map<T, Alloc>::erase(handle_type handle)
+  {
+    if (contains(handle))
+    {
+      erase(mBegin + mSlots[handle.mIndex].mIndex);
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::iterator slot_map<T, Alloc>::erase(iterator position)
+  {
+    uint32_t dense = position - mBegin;
+    uint32_t last = size() - 1;
+
+    //Free the slot of the erased object.
+    uint32_t index = mErase[dense];
+    slot_type& slot = mSlots[index];
+    ++slot.mGeneration;
+    slot.mIndex = mFreeHead;
+    mFreeHead = index;
+
+    //Fill the hole with the last object to keep the storage dense.
+    if (dense != last)
+    {
+      *position = FLEX_MOVE(mBegin[last]);
+      mErase[dense] = mErase[last];
+      mSlots[mErase[dense]].mIndex = dense;
+    }
+    (--mEnd)->~value_type();
+    return position;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::pointer slot_map<T, Alloc>::find(handle_type handle)
+  {
+    return contains(handle) ? (mBegin + mSlots[handle.mIndex].mIndex) : NULL;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_pointer slot_map<T, Alloc>::find(handle_type handle) const
+  {
+    return contains(handle) ? (mBegin + mSlots[handle.mIndex].mIndex) : NULL;
+  }
+
+  template<class T, class Alloc>
+  inline bool slot_map<T, Alloc>::fixed() const
+  {
+    return mFixed;
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::handle_type slot_map<T, Alloc>::get_handle(const_iterator position) const
+  {
+    uint32_t index = mErase[position - mBegin];
+    return handle_type(index, mSlots[index].mGeneration);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::handle_type slot_map<T, Alloc>::insert(const value_type& val)
+  {
+    if (mEnd == mCapacity)
+    {
+      //The value may live inside this container, so copy it before the storage moves.
+      value_type tmp(val);
+      Reallocate(GetNewCapacity(size() + 1));
+      new ((void*) mEnd) value_type(FLEX_MOVE(tmp));
+    }
+    else
+    {
+      new ((void*) mEnd) value_type(val);
+    }
+
+    uint32_t index = AcquireSlot();
+    ++mEnd;
+    return handle_type(index, mSlots[index].mGeneration);
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::handle_type slot_map<T, Alloc>::insert(value_type&& val)
+  {
+    return emplace(std::move(val));
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::size_type slot_map<T, Alloc>::max_size() const
+  {
+    if (mFixed)
+    {
+      return capacity();
+    }
+    else
+    {
+      return npos - 1;
+    }
+  }
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>& slot_map<T, Alloc>::operator=(const slot_map<T, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      //Handles are preserved by the copy, so the slot table is copied verbatim.
+      flex::destruct_range(mBegin, mEnd);
+      mEnd = mBegin;
+      if (capacity() < obj.mSlotCount)
+      {
+        Reallocate(obj.mSlotCount);
+      }
+
+      mEnd = std::uninitialized_copy(obj.mBegin, obj.mEnd, mBegin);
+      std::copy(obj.mSlots, obj.mSlots + obj.mSlotCount, mSlots);
+      std::copy(obj.mErase, obj.mErase + obj.size(), mErase);
+      mSlotCount = obj.mSlotCount;
+      mFreeHead = obj.mFreeHead;
+    }
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>& slot_map<T, Alloc>::operator=(slot_map<T, Alloc>&& obj)
+  {
+    if ((!mFixed) && (!obj.fixed()))
+    {
+      std::swap(mBegin, obj.mBegin);
+      std::swap(mEnd, obj.mEnd);
+      std::swap(mCapacity, obj.mCapacity);
+      std::swap(mSlots, obj.mSlots);
+      std::swap(mErase, obj.mErase);
+      std::swap(mSlotCount, obj.mSlotCount);
+      std::swap(mFreeHead, obj.mFreeHead);
+    }
+    else
+    {
+      *this = obj;
+    }
+    return *this;
+  }
+#endif
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::reference slot_map<T, Alloc>::operator[](handle_type handle)
+  {
+    FLEX_ASSERT(contains(handle));
+    return mBegin[mSlots[handle.mIndex].mIndex];
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reference slot_map<T, Alloc>::operator[](handle_type handle) const
+  {
+    FLEX_ASSERT(contains(handle));
+    return mBegin[mSlots[handle.mIndex].mIndex];
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::reverse_iterator slot_map<T, Alloc>::rbegin()
+  {
+    return reverse_iterator(mEnd);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reverse_iterator slot_map<T, Alloc>::rbegin() const
+  {
+    return const_reverse_iterator(mEnd);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::reverse_iterator slot_map<T, Alloc>::rend()
+  {
+    return reverse_iterator(mBegin);
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::const_reverse_iterator slot_map<T, Alloc>::rend() const
+  {
+    return const_reverse_iterator(mBegin);
+  }
+
+  template<class T, class Alloc>
+  inline void slot_map<T, Alloc>::reserve(size_type n)
+  {
+    if (n > capacity())
+    {
+      Reallocate(n);
+    }
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::size_type slot_map<T, Alloc>::size() const
+  {
+    return mEnd - mBegin;
+  }
+
+  template<class T, class Alloc>
+  inline slot_map<T, Alloc>::slot_map(pointer values, slot_type* slots, uint32_t* erase, size_type capacity) :
+      mBegin(values), mEnd(values), mCapacity(values + capacity), mSlots(slots), mErase(erase), mSlotCount(0), mFreeHead(
+          npos), mFixed(true)
+  {
+  }
+
+  template<class T, class Alloc>
+  inline uint32_t slot_map<T, Alloc>::AcquireSlot()
+  {
+    //Reuse a free slot before growing the slot table.  A fresh slot starts with generation zero.  The
+    //slot table never outgrows the dense capacity as a new slot is only created when none are free.
+    uint32_t index;
+    if (mFreeHead != npos)
+    {
+      index = mFreeHead;
+      mFreeHead = mSlots[index].mIndex;
+    }
+    else
+    {
+      index = mSlotCount++;
+      mSlots[index].mGeneration = 0;
+    }
+
+    uint32_t dense = mEnd - mBegin;
+    mSlots[index].mIndex = dense;
+    ++mSlots[index].mGeneration;
+    mErase[dense] = index;
+    return index;
+  }
+
+  template<class T, class Alloc>
+  inline void slot_map<T, Alloc>::Deallocate()
+  {
+    size_type n = capacity();
+    if (n)
+    {
+      mAllocator.deallocate(mBegin, n);
+      mSlotAllocator.deallocate(mSlots, n);
+      mIndexAllocator.deallocate(mErase, n);
+    }
+  }
+
+  template<class T, class Alloc>
+  inline typename slot_map<T, Alloc>::size_type slot_map<T, Alloc>::GetNewCapacity(size_type min_size)
+  {
+    // This needs to return a value of at least currentCapacity and at least 1.
+    size_type new_capacity = (capacity() > 0) ? (2 * capacity()) : 1;
+
+    // If we are still less than the min_size, just set to the min_size.
+    if (new_capacity < min_size)
+    {
+      return min_size;
+    }
+    else
+    {
+      return new_capacity;
+    }
+  }
+
+  template<class T, class Alloc>
+  inline void slot_map<T, Alloc>::Reallocate(size_type new_capacity)
+  {
+    pointer new_begin = mAllocator.allocate(new_capacity);
+    slot_type* new_slots = mSlotAllocator.allocate(new_capacity);
+    uint32_t* new_erase = mIndexAllocator.allocate(new_capacity);
+
+    pointer new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+    std::copy(mSlots, mSlots + mSlotCount, new_slots);
+    std::copy(mErase, mErase + size(), new_erase);
+    flex::destruct_range(mBegin, mEnd);
+
+    if (FLEX_UNLIKELY(mFixed))
+    {
+      //The fixed buffer is never deallocated.
+      mFixed = false;
+#ifndef FLEX_RELEASE
+      flex::error_msg("flex::fixed_slot_map - capacity exceeded");
+#endif
+    }
+    else
+    {
+      Deallocate();
+    }
+
+    mBegin = new_begin;
+    mEnd = new_end;
+    mCapacity = mBegin + new_capacity;
+    mSlots = new_slots;
+    mErase = new_erase;
+  }
+
+} //namespace flex
+
+#endif /* FLEX_SLOT_MAP_H */
@@ -0,0 +1,292 @@
+#ifndef FLEX_SMALL_VECTOR_H
+#define FLEX_SMALL_VECTOR_H
+
+#include <flex/vector.h>
+
+namespace flex
+{
+
+  //A small_vector stores up to N elements in an inline buffer and spills to the heap once it grows past
+  //that.  Unlike a fixed_vector, spilling is expected and is not reported as an error.  Once spilled,
+  //clear() and shrink_to_fit() return the container to its inline buffer when the elements fit.
+  template<class T, size_t N, class Alloc = allocator<T>, class Growth = double_growth> class small_vector: public vector<T, Alloc, Growth>
+  {
+  public:
+    typedef vector<T, Alloc, Growth> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+
+    using base_type::mBegin;
+    using base_type::mEnd;
+    using base_type::mCapacity;
+    using base_type::mAllocator;
+    using base_type::mFixed;
+    using base_type::mSmall;
+    using base_type::assign;
+    using base_type::capacity;
+    using base_type::size;
+
+    small_vector();
+    explicit small_vector(size_type size, const value_type& val = value_type());
+    small_vector(int size, const value_type& val);
+    template<typename InputIterator> small_vector(InputIterator first, InputIterator last);
+    small_vector(const small_vector<T, N, Alloc, Growth> & obj);
+    small_vector(const vector<T, Alloc, Growth> & obj);
+    small_vector(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    small_vector(small_vector<T, N, Alloc, Growth> && obj);
+    small_vector(vector<T, Alloc, Growth> && obj);
+#endif
+
+    void clear();
+    bool is_inline() const;
+    small_vector<T, N, Alloc, Growth>& operator=(const small_vector<T, N, Alloc, Growth>& obj);
+    small_vector<T, N, Alloc, Growth>& operator=(const vector<T, Alloc, Growth>& obj);
+    small_vector<T, N, Alloc, Growth>& operator=(std::initializer_list<value_type> il);
+#ifdef FLEX_HAS_CXX11
+    small_vector<T, N, Alloc, Growth>& operator=(small_vector<T, N, Alloc, Growth>&& obj);
+    small_vector<T, N, Alloc, Growth>& operator=(vector<T, Alloc, Growth>&& obj);
+#endif
+    void shrink_to_fit();
+
+  protected:
+    void ReturnToBuffer();
+#ifdef FLEX_HAS_CXX11
+    void StealOrMove(small_vector<T, N, Alloc, Growth>& obj);
+#endif
+
+  private:
+#ifdef FLEX_HAS_CXX11
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+#else
+    union
+    {
+      char mBuffer[N * sizeof(T)];
+      long double dummy;
+    };
+#endif
+  };
+
+  //The base class is always constructed over the empty inline buffer.  The elements are added in the body,
+  //once mSmall is set, so a spill during construction is not reported as a fixed_vector overflow.
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector() :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(size_type size, const value_type& val) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign(size, val);
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(int size, const value_type& val) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign((size_type) size, val);
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  template<typename InputIterator>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(InputIterator first, InputIterator last) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign(first, last);
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(const small_vector<T, N, Alloc, Growth> & obj) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign(obj.begin(), obj.end());
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(const vector<T, Alloc, Growth> & obj) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign(obj.begin(), obj.end());
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(std::initializer_list<value_type> il) :
+      vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    assign(il.begin(), il.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(small_vector<T, N, Alloc, Growth> && obj) :
+  vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    StealOrMove(obj);
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>::small_vector(vector<T, Alloc, Growth> && obj) :
+  vector<T, Alloc, Growth>((pointer) mBuffer, (pointer) mBuffer, N)
+  {
+    mSmall = true;
+    if ((!obj.fixed()) && (obj.capacity() > N))
+    {
+      //Give up the inline buffer so the base swap() exchanges pointers with the heap buffer of obj.
+      mBegin = mEnd = mCapacity = NULL;
+      mFixed = false;
+      base_type::swap(obj);
+    }
+    else
+    {
+      mEnd = std::uninitialized_copy(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()), mBegin);
+      obj.clear();
+    }
+  }
+#endif
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline void small_vector<T, N, Alloc, Growth>::clear()
+  {
+    flex::destruct_range(mBegin, mEnd);
+    mEnd = mBegin;
+    if (!mFixed)
+    {
+      ReturnToBuffer();
+    }
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline bool small_vector<T, N, Alloc, Growth>::is_inline() const
+  {
+    return mFixed;
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>& small_vector<T, N, Alloc, Growth>::operator=(const small_vector<T, N, Alloc, Growth>& obj)
+  {
+    assign(obj.begin(), obj.end());
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>& small_vector<T, N, Alloc, Growth>::operator=(const vector<T, Alloc, Growth>& obj)
+  {
+    assign(obj.begin(), obj.end());
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>& small_vector<T, N, Alloc, Growth>::operator=(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>& small_vector<T, N, Alloc, Growth>::operator=(small_vector<T, N, Alloc, Growth>&& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      StealOrMove(obj);
+    }
+    return *this;
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline small_vector<T, N, Alloc, Growth>& small_vector<T, N, Alloc, Growth>::operator=(vector<T, Alloc, Growth>&& obj)
+  {
+    if ((!obj.fixed()) && (obj.capacity() > N))
+    {
+      clear();
+      mBegin = mEnd = mCapacity = NULL;
+      mFixed = false;
+      base_type::swap(obj);
+    }
+    else
+    {
+      assign(std::make_move_iterator(obj.begin()), std::make_move_iterator(obj.end()));
+      obj.clear();
+    }
+    return *this;
+  }
+#endif
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline void small_vector<T, N, Alloc, Growth>::shrink_to_fit()
+  {
+    if ((!mFixed) && (size() <= N))
+    {
+      pointer new_end = flex::uninitialized_relocate(mBegin, mEnd, (pointer) mBuffer);
+      ReturnToBuffer();
+      mEnd = new_end;
+    }
+    else
+    {
+      base_type::shrink_to_fit();
+    }
+  }
+
+  template<class T, size_t N, class Alloc, class Growth>
+  inline void small_vector<T, N, Alloc, Growth>::ReturnToBuffer()
+  {
+    //Releases the heap buffer, whose elements must already be destroyed, and points the container
+    //back at the (empty) inline buffer.
+    if (mBegin)
+    {
+      mAllocator.deallocate(mBegin, mCapacity - mBegin);
+    }
+    mBegin = mEnd = (pointer) mBuffer;
+    mCapacity = mBegin + N;
+    mFixed = true;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t N, class Alloc, class Growth>
+  inline void small_vector<T, N, Alloc, Growth>::StealOrMove(small_vector<T, N, Alloc, Growth>& obj)
+  {
+    //This container must be empty and inline.  A spilled obj hands over its heap buffer, otherwise the
+    //elements are relocated (which is a memcpy for trivially relocatable types) out of its inline buffer.
+    if (!obj.mFixed)
+    {
+      mBegin = obj.mBegin;
+      mEnd = obj.mEnd;
+      mCapacity = obj.mCapacity;
+      mFixed = false;
+
+      obj.mBegin = obj.mEnd = (pointer) obj.mBuffer;
+      obj.mCapacity = obj.mBegin + N;
+      obj.mFixed = true;
+    }
+    else
+    {
+      mEnd = flex::uninitialized_relocate(obj.mBegin, obj.mEnd, mBegin);
+      obj.mEnd = obj.mBegin;
+    }
+  }
+#endif
+
+} //namespace flex
+
+#endif /* FLEX_SMALL_VECTOR_H */
@@ -0,0 +1,753 @@
+#ifndef FLEX_SOA_VECTOR_H
+#define FLEX_SOA_VECTOR_H
+
+#include <flex/config.h>
+
+#ifdef FLEX_HAS_CXX11
+
+#include <cstddef>//For std::max_align_t used in the column alignment
+#include <tuple>
+
+#include <flex/allocator.h>
+#include <flex/growth_policy.h>
+#include <flex/internal/relocate.h>
+
+namespace flex
+{
+
+  //Compile time list of column indices, used to expand an operation over every column.
+  template<size_t... Is> struct soa_index_sequence
+  {
+  };
+
+  template<size_t N, size_t... Is> struct soa_make_index_sequence: soa_make_index_sequence<N - 1, N - 1, Is...>
+  {
+  };
+
+  template<size_t... Is> struct soa_make_index_sequence<0, Is...>
+  {
+    typedef soa_index_sequence<Is...> type;
+  };
+
+  //Every column starts on a boundary suitable for any type, so a column loop sees the same alignment as one
+  //over a plain array.
+  constexpr size_t soa_align(size_t n)
+  {
+    return (n + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+  }
+
+  //Computes the placement of the columns in a single buffer holding n rows.
+  template<class... Fields> struct soa_layout;
+
+  template<> struct soa_layout<>
+  {
+    static constexpr size_t bytes(size_t)
+    {
+      return 0;
+    }
+
+    static constexpr size_t offset(size_t, size_t)
+    {
+      return 0;
+    }
+  };
+
+  template<class F, class... Rest> struct soa_layout<F, Rest...>
+  {
+    //Size of the buffer holding n rows.
+    static constexpr size_t bytes(size_t n)
+    {
+      return soa_align(n * sizeof(F)) + soa_layout<Rest...>::bytes(n);
+    }
+
+    //Offset of column i in the buffer holding n rows.
+    static constexpr size_t offset(size_t i, size_t n)
+    {
+      return (i == 0) ? 0 : soa_align(n * sizeof(F)) + soa_layout<Rest...>::offset(i - 1, n);
+    }
+  };
+
+  //A view of one column of a soa_vector.  It is invalidated when the container reallocates.
+  template<class T> struct soa_span
+  {
+    typedef T value_type;
+    typedef T* iterator;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef size_t size_type;
+
+    pointer mData;
+    size_type mSize;
+
+    soa_span(pointer data, size_type size) :
+        mData(data), mSize(size)
+    {
+    }
+
+    iterator begin() const
+    {
+      return mData;
+    }
+
+    pointer data() const
+    {
+      return mData;
+    }
+
+    bool empty() const
+    {
+      return (mSize == 0);
+    }
+
+    iterator end() const
+    {
+      return mData + mSize;
+    }
+
+    reference operator[](size_type n) const
+    {
+      return mData[n];
+    }
+
+    size_type size() const
+    {
+      return mSize;
+    }
+  };
+
+  //A soa_vector is a vector of rows whose fields are stored column by column: each field lives in its own
+  //contiguous array, and all the arrays share a single allocation.  A loop that reads only some of the fields
+  //streams just those columns, and the columns can be passed to vectorized code through column<I>() or
+  //data<I>().  Rows are addressed by index.  operator[] returns a tuple of references to the fields of a row,
+  //so a row can be read with std::get, assigned from a value_type, or copied into a value_type.
+  //
+  //Alloc allocates the buffer and must be an allocator of char.  Growth is the growth policy (see
+  //growth_policy.h).  Since the fields are a parameter pack, these come first, and soa_vector names the
+  //container with the default allocator and double_growth.
+  template<class Alloc, class Growth, class... Fields> class basic_soa_vector: public guarded_object
+  {
+  public:
+    typedef std::tuple<Fields...> value_type;
+    typedef std::tuple<Fields&...> reference;
+    typedef std::tuple<const Fields&...> const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Alloc allocator_type;
+    typedef Growth growth_policy;
+    template<size_t I> using field_type = typename std::tuple_element<I, value_type>::type;
+
+    basic_soa_vector();
+    explicit basic_soa_vector(size_type size);
+    basic_soa_vector(size_type size, const value_type& val);
+    basic_soa_vector(const basic_soa_vector<Alloc, Growth, Fields...>& obj);
+    basic_soa_vector(basic_soa_vector<Alloc, Growth, Fields...>&& obj);
+    ~basic_soa_vector();
+
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+    reference back();
+    const_reference back() const;
+    size_type capacity() const;
+    void clear();
+    template<size_t I> soa_span<field_type<I> > column();
+    template<size_t I> soa_span<const field_type<I> > column() const;
+    template<size_t I> field_type<I>* data();
+    template<size_t I> const field_type<I>* data() const;
+    template<class... Args> void emplace_back(Args&&... args);
+    bool empty() const;
+    void erase(size_type position);
+    void erase(size_type first, size_type last);
+    bool fixed() const;
+    reference front();
+    const_reference front() const;
+    template<size_t I> field_type<I>& get(size_type n);
+    template<size_t I> const field_type<I>& get(size_type n) const;
+    size_type max_size() const;
+    basic_soa_vector<Alloc, Growth, Fields...>& operator=(const basic_soa_vector<Alloc, Growth, Fields...>& obj);
+    basic_soa_vector<Alloc, Growth, Fields...>& operator=(basic_soa_vector<Alloc, Growth, Fields...>&& obj);
+    reference operator[](size_type n);
+    const_reference operator[](size_type n) const;
+    void pop_back();
+    void push_back(const value_type& val);
+    void push_back(value_type&& val);
+    void reserve(size_type n);
+    void resize(size_type n);
+    void resize(size_type n, const value_type& val);
+    void shrink_to_fit();
+    size_type size() const;
+
+    //Size of the buffer needed to hold n rows.
+    static constexpr size_type bytes(size_type n)
+    {
+      return soa_layout<Fields...>::bytes(n);
+    }
+
+  protected:
+    typedef std::tuple<Fields*...> columns_type;
+    typedef typename soa_make_index_sequence<sizeof...(Fields)>::type indices;
+
+    columns_type mColumns;
+    char* mBuffer;
+    size_type mSize;
+    size_type mCapacity;
+    allocator_type mAllocator;
+    bool mFixed;
+
+    basic_soa_vector(char* buffer, size_type capacity);
+
+    template<class... Args, size_t... Is> static void ConstructRow(columns_type& columns, size_type n,
+        soa_index_sequence<Is...>, Args&&... args);
+    template<size_t... Is> void ConstructDefault(size_type n, soa_index_sequence<Is...>);
+    template<size_t... Is> void CopyRow(const value_type& val, size_type n, soa_index_sequence<Is...>);
+    template<size_t... Is> void CopyRows(const basic_soa_vector<Alloc, Growth, Fields...>& obj,
+        soa_index_sequence<Is...>);
+    void Deallocate();
+    template<size_t... Is> void Destroy(size_type first, size_type last, soa_index_sequence<Is...>);
+    template<size_t... Is> void EraseRows(size_type first, size_type last, soa_index_sequence<Is...>);
+    size_type GetNewCapacity(size_type min_size);
+    template<size_t... Is> static columns_type MakeColumns(char* buffer, size_type capacity, soa_index_sequence<Is...>);
+    template<size_t... Is> reference MakeReference(size_type n, soa_index_sequence<Is...>);
+    template<size_t... Is> const_reference MakeReference(size_type n, soa_index_sequence<Is...>) const;
+    template<size_t... Is> void MoveRow(value_type& val, soa_index_sequence<Is...>);
+    template<size_t... Is> void PushRow(const value_type& val, soa_index_sequence<Is...>);
+    void Reallocate(size_type capacity);
+    template<size_t... Is> void Relocate(columns_type& columns, soa_index_sequence<Is...>);
+  };
+
+  template<class... Fields> using soa_vector = basic_soa_vector<allocator<char>, double_growth, Fields...>;
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector() :
+      mColumns(), mBuffer(NULL), mSize(0), mCapacity(0), mFixed(false)
+  {
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector(size_type size) :
+      mColumns(), mBuffer(NULL), mSize(0), mCapacity(0), mFixed(false)
+  {
+    resize(size);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector(size_type size, const value_type& val) :
+      mColumns(), mBuffer(NULL), mSize(0), mCapacity(0), mFixed(false)
+  {
+    resize(size, val);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector(const basic_soa_vector<Alloc, Growth,
+      Fields...>& obj) :
+      mColumns(), mBuffer(NULL), mSize(0), mCapacity(0), mFixed(false)
+  {
+    CopyRows(obj, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector(basic_soa_vector<Alloc, Growth,
+      Fields...>&& obj) :
+      mColumns(), mBuffer(NULL), mSize(0), mCapacity(0), mFixed(false)
+  {
+    operator=(std::move(obj));
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::~basic_soa_vector()
+  {
+    Destroy(0, mSize, indices());
+    if ((!mFixed) && mBuffer)
+    {
+      mAllocator.deallocate(mBuffer, bytes(mCapacity));
+    }
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::reference basic_soa_vector<Alloc, Growth,
+      Fields...>::at(size_type n)
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(n >= mSize, "flex::soa_vector.at() - index out-of-bounds");
+    return MakeReference(n, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::const_reference basic_soa_vector<Alloc, Growth,
+      Fields...>::at(size_type n) const
+  {
+    FLEX_THROW_OUT_OF_RANGE_IF(n >= mSize, "flex::soa_vector.at() - index out-of-bounds");
+    return MakeReference(n, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::reference basic_soa_vector<Alloc, Growth,
+      Fields...>::back()
+  {
+    return MakeReference(mSize - 1, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::const_reference basic_soa_vector<Alloc, Growth,
+      Fields...>::back() const
+  {
+    return MakeReference(mSize - 1, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::size_type basic_soa_vector<Alloc, Growth,
+      Fields...>::capacity() const
+  {
+    return mCapacity;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::clear()
+  {
+    Destroy(0, mSize, indices());
+    mSize = 0;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline soa_span<typename basic_soa_vector<Alloc, Growth, Fields...>::template field_type<I> > basic_soa_vector<Alloc,
+      Growth, Fields...>::column()
+  {
+    return soa_span<field_type<I> >(std::get<I>(mColumns), mSize);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline soa_span<const typename basic_soa_vector<Alloc, Growth,
+      Fields...>::template field_type<I> > basic_soa_vector<Alloc, Growth, Fields...>::column() const
+  {
+    return soa_span<const field_type<I> >(std::get<I>(mColumns), mSize);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::template field_type<I>* basic_soa_vector<Alloc, Growth,
+      Fields...>::data()
+  {
+    return std::get<I>(mColumns);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline const typename basic_soa_vector<Alloc, Growth, Fields...>::template field_type<I>* basic_soa_vector<Alloc,
+      Growth, Fields...>::data() const
+  {
+    return std::get<I>(mColumns);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<class... Args>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::emplace_back(Args&&... args)
+  {
+    //Takes one argument per field, each forwarded to the constructor of its column's element.
+    static_assert(sizeof...(Args) == sizeof...(Fields), "flex::soa_vector.emplace_back() requires one argument per field");
+    if (FLEX_UNLIKELY(mSize == mCapacity))
+    {
+      //The row is constructed in the new buffer before the old rows are relocated, since the arguments may
+      //refer to fields of this container.
+      const size_type capacity = GetNewCapacity(mSize + 1);
+      char* buffer = mAllocator.allocate(bytes(capacity));
+      columns_type columns = MakeColumns(buffer, capacity, indices());
+      ConstructRow(columns, mSize, indices(), std::forward<Args>(args)...);
+      Relocate(columns, indices());
+      Deallocate();
+      mColumns = columns;
+      mBuffer = buffer;
+      mCapacity = capacity;
+    }
+    else
+    {
+      ConstructRow(mColumns, mSize, indices(), std::forward<Args>(args)...);
+    }
+    ++mSize;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline bool basic_soa_vector<Alloc, Growth, Fields...>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::erase(size_type position)
+  {
+    EraseRows(position, position + 1, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::erase(size_type first, size_type last)
+  {
+    EraseRows(first, last, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline bool basic_soa_vector<Alloc, Growth, Fields...>::fixed() const
+  {
+    return mFixed;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::reference basic_soa_vector<Alloc, Growth,
+      Fields...>::front()
+  {
+    return MakeReference(0, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::const_reference basic_soa_vector<Alloc, Growth,
+      Fields...>::front() const
+  {
+    return MakeReference(0, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::template field_type<I>& basic_soa_vector<Alloc, Growth,
+      Fields...>::get(size_type n)
+  {
+    return std::get<I>(mColumns)[n];
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t I>
+  inline const typename basic_soa_vector<Alloc, Growth, Fields...>::template field_type<I>& basic_soa_vector<Alloc,
+      Growth, Fields...>::get(size_type n) const
+  {
+    return std::get<I>(mColumns)[n];
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::size_type basic_soa_vector<Alloc, Growth,
+      Fields...>::max_size() const
+  {
+    return mAllocator.max_size() / bytes(1);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>& basic_soa_vector<Alloc, Growth,
+      Fields...>::operator=(const basic_soa_vector<Alloc, Growth, Fields...>& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      CopyRows(obj, indices());
+    }
+    return *this;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>& basic_soa_vector<Alloc, Growth,
+      Fields...>::operator=(basic_soa_vector<Alloc, Growth, Fields...>&& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      if ((!mFixed) && (!obj.mFixed))
+      {
+        //Both buffers are on the heap, so the buffer of obj is taken over.
+        Deallocate();
+        mColumns = obj.mColumns;
+        mBuffer = obj.mBuffer;
+        mSize = obj.mSize;
+        mCapacity = obj.mCapacity;
+
+        obj.mColumns = columns_type();
+        obj.mBuffer = NULL;
+        obj.mSize = obj.mCapacity = 0;
+      }
+      else
+      {
+        reserve(obj.mSize);
+        obj.Relocate(mColumns, indices());
+        mSize = obj.mSize;
+        obj.mSize = 0;
+      }
+    }
+    return *this;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::reference basic_soa_vector<Alloc, Growth,
+      Fields...>::operator[](size_type n)
+  {
+    return MakeReference(n, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::const_reference basic_soa_vector<Alloc, Growth,
+      Fields...>::operator[](size_type n) const
+  {
+    return MakeReference(n, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::pop_back()
+  {
+    Destroy(mSize - 1, mSize, indices());
+    --mSize;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::push_back(const value_type& val)
+  {
+    PushRow(val, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::push_back(value_type&& val)
+  {
+    MoveRow(val, indices());
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::reserve(size_type n)
+  {
+    if (n > mCapacity)
+    {
+      Reallocate(n);
+    }
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::resize(size_type n)
+  {
+    if (n < mSize)
+    {
+      Destroy(n, mSize, indices());
+    }
+    else
+    {
+      reserve(n);
+      for (size_type i = mSize; i < n; ++i)
+      {
+        ConstructDefault(i, indices());
+      }
+    }
+    mSize = n;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::resize(size_type n, const value_type& val)
+  {
+    if (n < mSize)
+    {
+      Destroy(n, mSize, indices());
+    }
+    else
+    {
+      reserve(n);
+      for (size_type i = mSize; i < n; ++i)
+      {
+        CopyRow(val, i, indices());
+      }
+    }
+    mSize = n;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::shrink_to_fit()
+  {
+    if ((!mFixed) && (mSize < mCapacity))
+    {
+      Reallocate(mSize);
+    }
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::size_type basic_soa_vector<Alloc, Growth,
+      Fields...>::size() const
+  {
+    return mSize;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline basic_soa_vector<Alloc, Growth, Fields...>::basic_soa_vector(char* buffer, size_type capacity) :
+      mColumns(MakeColumns(buffer, capacity, indices())), mBuffer(buffer), mSize(0), mCapacity(capacity), mFixed(true)
+  {
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<class... Args, size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::ConstructRow(columns_type& columns, size_type n,
+      soa_index_sequence<Is...>,
+      Args&&... args)
+  {
+    int expand[] = { 0, (::new ((void*) (std::get<Is>(columns) + n)) Fields(std::forward<Args>(args)), 0)... };
+    (void) expand;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::ConstructDefault(size_type n, soa_index_sequence<Is...>)
+  {
+    int expand[] = { 0, (::new ((void*) (std::get<Is>(mColumns) + n)) Fields(), 0)... };
+    (void) expand;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::CopyRow(const value_type& val, size_type n,
+      soa_index_sequence<Is...>)
+  {
+    ConstructRow(mColumns, n, indices(), std::get<Is>(val)...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::CopyRows(const basic_soa_vector<Alloc, Growth,
+      Fields...>& obj, soa_index_sequence<Is...>)
+  {
+    //This container must be empty.
+    reserve(obj.mSize);
+    for (size_type i = 0; i < obj.mSize; ++i)
+    {
+      ConstructRow(mColumns, i, indices(), std::get<Is>(obj.mColumns)[i]...);
+    }
+    mSize = obj.mSize;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::Deallocate()
+  {
+    //Releases the buffer without destroying its rows.  This is used once the rows have been relocated to a
+    //new buffer.
+    if (FLEX_UNLIKELY(mFixed))
+    {
+      //The fixed buffer is never deallocated.
+      mFixed = false;
+#ifndef FLEX_RELEASE
+      flex::error_msg("flex::fixed_soa_vector - capacity exceeded");
+#endif
+    }
+    else if (mBuffer)
+    {
+      mAllocator.deallocate(mBuffer, bytes(mCapacity));
+    }
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::Destroy(size_type first, size_type last,
+      soa_index_sequence<Is...>)
+  {
+    int expand[] = { 0, (flex::destruct_range(std::get<Is>(mColumns) + first, std::get<Is>(mColumns) + last), 0)... };
+    (void) expand;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::EraseRows(size_type first, size_type last,
+      soa_index_sequence<Is...>)
+  {
+    //The rows past last are moved down column by column, then the vacated rows at the end are destroyed.
+    int expand[] = { 0, (std::move(std::get<Is>(mColumns) + last, std::get<Is>(mColumns) + mSize,
+        std::get<Is>(mColumns) + first), 0)... };
+    (void) expand;
+    Destroy(mSize - (last - first), mSize, indices());
+    mSize -= (last - first);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::size_type basic_soa_vector<Alloc, Growth,
+      Fields...>::GetNewCapacity(size_type min_size)
+  {
+    //The row size is passed as the element size, so a policy rounding the allocation sees roughly its true size.
+    return growth_policy::new_capacity(mCapacity, min_size, bytes(1), 0, mAllocator);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::columns_type basic_soa_vector<Alloc, Growth,
+      Fields...>::MakeColumns(char* buffer,
+      size_type capacity, soa_index_sequence<Is...>)
+  {
+    return columns_type((Fields*) (buffer + soa_layout<Fields...>::offset(Is, capacity))...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::reference basic_soa_vector<Alloc, Growth,
+      Fields...>::MakeReference(size_type n,
+      soa_index_sequence<Is...>)
+  {
+    return reference(std::get<Is>(mColumns)[n]...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline typename basic_soa_vector<Alloc, Growth, Fields...>::const_reference basic_soa_vector<Alloc, Growth,
+      Fields...>::MakeReference(size_type n,
+      soa_index_sequence<Is...>) const
+  {
+    return const_reference(std::get<Is>(mColumns)[n]...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::MoveRow(value_type& val, soa_index_sequence<Is...>)
+  {
+    emplace_back(std::move(std::get<Is>(val))...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::PushRow(const value_type& val, soa_index_sequence<Is...>)
+  {
+    emplace_back(std::get<Is>(val)...);
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::Reallocate(size_type capacity)
+  {
+    char* buffer = capacity ? mAllocator.allocate(bytes(capacity)) : NULL;
+    columns_type columns = MakeColumns(buffer, capacity, indices());
+    Relocate(columns, indices());
+    Deallocate();
+    mColumns = columns;
+    mBuffer = buffer;
+    mCapacity = capacity;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  template<size_t... Is>
+  inline void basic_soa_vector<Alloc, Growth, Fields...>::Relocate(columns_type& columns, soa_index_sequence<Is...>)
+  {
+    //Each column is relocated separately, which is a single memcpy for trivially relocatable fields.
+    int expand[] = { 0, (flex::uninitialized_relocate(std::get<Is>(mColumns), std::get<Is>(mColumns) + mSize,
+        std::get<Is>(columns)), 0)... };
+    (void) expand;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline bool operator==(const basic_soa_vector<Alloc, Growth, Fields...>& lhs, const basic_soa_vector<Alloc, Growth,
+      Fields...>& rhs)
+  {
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+      if (lhs[i] != rhs[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<class Alloc, class Growth, class... Fields>
+  inline bool operator!=(const basic_soa_vector<Alloc, Growth, Fields...>& lhs, const basic_soa_vector<Alloc, Growth,
+      Fields...>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+} //namespace flex
+
+#endif //FLEX_HAS_CXX11
+
+#endif /* FLEX_SOA_VECTOR_H */
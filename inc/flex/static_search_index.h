@@ -0,0 +1,268 @@
+#ifndef FLEX_STATIC_SEARCH_INDEX_H
+#define FLEX_STATIC_SEARCH_INDEX_H
+
+#include <flex/vector.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace flex
+{
+
+  //A static_search_index answers lower_bound and find queries over a sorted table that rarely changes, such
+  //as a price ladder or a fee schedule held in a fixed_vector.  The keys are copied into Eytzinger order: the
+  //array is an implicit binary tree where node k has children 2k and 2k+1.  The first levels of the search are
+  //shared by every query and stay in cache, and the nodes of the next few levels sit next to each other, so they
+  //can be prefetched a cache line at a time while the current level is compared.  A binary search over the
+  //sorted table instead touches a new cache line at nearly every level.
+  //
+  //Queries return the position of the key in the sorted table the index was built from, so the table itself
+  //(and any columns parallel to it) can be indexed with the result.  A key that is not found yields size().
+  //The position is computed from the node number, so the index stores nothing but the keys.  Tables of many
+  //millions of keys also benefit from a hugepage_allocator, since each query touches a new page near the bottom.
+  template<class T, class Compare = std::less<T>, class Alloc = allocator<T> > class static_search_index: public guarded_object
+  {
+  public:
+    typedef T key_type;
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    static_search_index();
+    explicit static_search_index(const Compare& comp);
+    template<typename ForwardIterator> static_search_index(ForwardIterator first, ForwardIterator last,
+        const Compare& comp = Compare());
+
+    template<typename ForwardIterator> void assign(ForwardIterator first, ForwardIterator last);
+    void clear();
+    size_type count(const T& key) const;
+    bool empty() const;
+    size_type find(const T& key) const;
+    key_compare key_comp() const;
+    size_type lower_bound(const T& key) const;
+    size_type size() const;
+    void swap(static_search_index<T, Compare, Alloc>& obj);
+    size_type upper_bound(const T& key) const;
+
+  protected:
+    template<typename ForwardIterator> void Build(ForwardIterator& it, size_type k);
+    static size_type Climb(size_type k);
+    static size_type Log2(size_type k);
+    size_type LowerBoundNode(const T& key) const;
+    size_type Rank(size_type k) const;
+    size_type UpperBoundNode(const T& key) const;
+
+    //Node k's descendants PREFETCH_STRIDE levels down start at index k * PREFETCH_STRIDE and fill one cache line.
+    static const size_type PREFETCH_STRIDE = (sizeof(T) < FLEX_CACHE_LINE_SIZE) ? FLEX_CACHE_LINE_SIZE / sizeof(T) : 1;
+
+    vector<T, Alloc> mKeys; //Index 0 is unused so that the root is node 1.
+    size_type mSize;
+    size_type mHeight; //Number of levels in the tree.
+    size_type mLeaves; //Number of nodes on the bottom level, which may be partially filled.
+    Compare mCompare;
+  };
+
+  template<class T, class Compare, class Alloc>
+  inline static_search_index<T, Compare, Alloc>::static_search_index() :
+      mKeys(), mSize(0), mHeight(0), mLeaves(0), mCompare()
+  {
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline static_search_index<T, Compare, Alloc>::static_search_index(const Compare& comp) :
+      mKeys(), mSize(0), mHeight(0), mLeaves(0), mCompare(comp)
+  {
+  }
+
+  template<class T, class Compare, class Alloc>
+  template<typename ForwardIterator>
+  inline static_search_index<T, Compare, Alloc>::static_search_index(ForwardIterator first, ForwardIterator last,
+      const Compare& comp) :
+      mKeys(), mSize(0), mHeight(0), mLeaves(0), mCompare(comp)
+  {
+    assign(first, last);
+  }
+
+  template<class T, class Compare, class Alloc>
+  template<typename ForwardIterator>
+  inline void static_search_index<T, Compare, Alloc>::assign(ForwardIterator first, ForwardIterator last)
+  {
+    //The range must already be sorted by mCompare, as for std::lower_bound.
+    mSize = std::distance(first, last);
+    if (mSize == 0)
+    {
+      clear();
+      return;
+    }
+
+    mKeys.assign(mSize + 1, *first);
+    mHeight = Log2(mSize) + 1;
+    mLeaves = mSize - ((size_type(1) << (mHeight - 1)) - 1);
+    Build(first, 1);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline void static_search_index<T, Compare, Alloc>::clear()
+  {
+    mKeys.clear();
+    mSize = 0;
+    mHeight = 0;
+    mLeaves = 0;
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::count(
+      const T& key) const
+  {
+    return (find(key) != mSize) ? 1 : 0;
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline bool static_search_index<T, Compare, Alloc>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::find(
+      const T& key) const
+  {
+    const size_type k = LowerBoundNode(key);
+    return ((k != 0) && !mCompare(key, mKeys[k])) ? Rank(k) : mSize;
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::key_compare static_search_index<T, Compare, Alloc>::key_comp() const
+  {
+    return mCompare;
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::lower_bound(
+      const T& key) const
+  {
+    return Rank(LowerBoundNode(key));
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline void static_search_index<T, Compare, Alloc>::swap(static_search_index<T, Compare, Alloc>& obj)
+  {
+    mKeys.swap(obj.mKeys);
+    std::swap(mSize, obj.mSize);
+    std::swap(mHeight, obj.mHeight);
+    std::swap(mLeaves, obj.mLeaves);
+    std::swap(mCompare, obj.mCompare);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::upper_bound(
+      const T& key) const
+  {
+    return Rank(UpperBoundNode(key));
+  }
+
+  template<class T, class Compare, class Alloc>
+  template<typename ForwardIterator>
+  inline void static_search_index<T, Compare, Alloc>::Build(ForwardIterator& it, size_type k)
+  {
+    //An in-order walk of the implicit tree visits the nodes in sorted order.  The depth is log2(size()).
+    if (k <= mSize)
+    {
+      Build(it, 2 * k);
+      mKeys[k] = *it;
+      ++it;
+      Build(it, 2 * k + 1);
+    }
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::Climb(size_type k)
+  {
+    //The search walked off the bottom of the tree at k.  Each trailing 1 bit is a step taken to the right, past
+    //a key that compared less; the answer is the node where the last step to the left was taken.
+#if defined(__GNUC__) && (__GNUC__ >= 4)
+    return k >> (__builtin_ctzl(~static_cast<unsigned long>(k)) + 1);
+#else
+    while (k & 1)
+    {
+      k >>= 1;
+    }
+    return k >> 1;
+#endif
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::Log2(size_type k)
+  {
+#if defined(__GNUC__) && (__GNUC__ >= 4)
+    return (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(static_cast<unsigned long>(k));
+#else
+    size_type n = 0;
+    while (k >>= 1)
+    {
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::LowerBoundNode(
+      const T& key) const
+  {
+    const T* keys = mKeys.begin();
+    size_type k = 1;
+    while (k <= mSize)
+    {
+      FLEX_PREFETCH(keys + std::min(k * PREFETCH_STRIDE, mSize));
+      k = 2 * k + (mCompare(keys[k], key) ? 1 : 0);
+    }
+    return Climb(k);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::Rank(size_type k) const
+  {
+    if (k == 0)
+    {
+      return mSize;
+    }
+
+    //Position of node k in the in-order walk of a perfect tree of mHeight levels.  The bottom level holds the
+    //even positions, so subtract the bottom level slots left of k that are past mLeaves and therefore empty.
+    const size_type depth = Log2(k);
+    const size_type pos = ((2 * (k - (size_type(1) << depth)) + 1) << (mHeight - 1 - depth)) - 1;
+    const size_type slots = (pos + 1) / 2;
+    return pos - ((slots > mLeaves) ? slots - mLeaves : 0);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::UpperBoundNode(
+      const T& key) const
+  {
+    const T* keys = mKeys.begin();
+    size_type k = 1;
+    while (k <= mSize)
+    {
+      FLEX_PREFETCH(keys + std::min(k * PREFETCH_STRIDE, mSize));
+      k = 2 * k + (mCompare(key, keys[k]) ? 0 : 1);
+    }
+    return Climb(k);
+  }
+
+  template<class T, class Compare, class Alloc>
+  inline void swap(static_search_index<T, Compare, Alloc>& lhs, static_search_index<T, Compare, Alloc>& rhs)
+  {
+    lhs.swap(rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_STATIC_SEARCH_INDEX_H */
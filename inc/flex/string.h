@@ -81,7 +81,9 @@
 #define FLEX_STRING_H
 
 #include <flex/allocator.h>
+#include <flex/growth_policy.h>
 #include <flex/initializer_list.h>
+#include <flex/internal/relocate.h>
 
 #include <algorithm>
 #include <iterator>
@@ -94,9 +96,7 @@
 #include <string.h> // strlen, etc.
 
 typedef char char8_t;
-#ifdef FLEX_HAS_CXX11
-typedef <uchar.h>
-#else
+#ifndef FLEX_HAS_CXX11
 typedef uint16_t char16_t;
 typedef uint32_t char32_t;
 #endif
@@ -172,11 +172,11 @@ namespace flex
 ///     and result in exceptions during assignments that theoretically can't
 ///     occur with std containers.
 ///
-  template<typename T, typename Allocator = flex::allocator<T> >
+  template<typename T, typename Allocator = flex::allocator<T>, typename Growth = double_growth>
   class basic_string: public guarded_object
   {
   public:
-    typedef basic_string<T, Allocator> this_type;
+    typedef basic_string<T, Allocator, Growth> this_type;
     typedef T value_type;
     typedef T* pointer;
     typedef const T* const_pointer;
@@ -189,6 +189,7 @@ namespace flex
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
     typedef Allocator allocator_type;
+    typedef Growth growth_policy;
 
     static const size_type npos = (size_type) -1; /// 'npos' means non-valid position or simply non-position.
     static const size_type kMaxSize = (size_type) -2; /// -1 is reserved for 'npos'. It also happens to be slightly beneficial that kMaxSize is a value less than -1, as it helps us deal with potential integer wraparound issues.
@@ -282,6 +283,8 @@ namespace flex
     size_type capacity() const FLEX_NOEXCEPT; // Expanded in source code as: (size_type)((mCapacity - mBegin) - 1). Thus thus returns the max strlen the container can currently hold without resizing.
     void resize(size_type n, value_type c);
     void resize(size_type n);
+    void resize_default_init(size_type n); // Like resize(n), but the new characters are left uninitialized for the caller to write. The trailing 0 is still written.
+    void resize_uninitialized(size_type n); // Same as resize_default_init(n), since default initialization leaves a character uninitialized.
     void reserve(size_type = 0);
     void set_capacity(size_type n = npos); // Revises the capacity to the user-specified value. Resizes the container to match the capacity if the requested capacity n is less than the current size. If n == npos then the capacity is reallocated (if necessary) such that capacity == size.
     void shrink_to_fit();
@@ -313,6 +316,7 @@ namespace flex
     this_type& append(size_type n, value_type c);
     this_type& append(const value_type* pBegin, const value_type* pEnd);
     this_type& append(std::initializer_list<value_type> x);
+    template<class Function> size_type append_with(size_type n, Function f); // Calls f(p, n) with a window of n uninitialized characters past the end. f returns the number of characters it wrote, which are appended. The rest of the window may be used as scratch.
 
     void push_back(value_type c);
     void pop_back();
@@ -415,7 +419,7 @@ namespace flex
     // Helper functions for initialization/insertion operations.
     value_type* DoAllocate(size_type n);
     void DoFree(value_type* p, size_type n);
-    size_type GetNewCapacity(size_type currentCapacity);
+    size_type GetNewCapacity(size_type currentCapacity, size_type minCapacity);
     void AllocateSelf();
     void AllocateSelf(size_type n);
     void DeallocateSelf();
@@ -562,6 +566,15 @@ namespace flex
     return pDestination + (pSourceEnd - pSource);
   }
 
+  //Moves the characters of a string into a newly allocated buffer.  Character types are always trivially
+  //relocatable, so this resolves to a memcpy, which unlike CharStringUninitializedCopy may assume the
+  //source and destination do not overlap.
+  template<typename T>
+  inline T* CharStringRelocate(const T* pSource, const T* pSourceEnd, T* pDestination)
+  {
+    return flex::uninitialized_relocate(const_cast<T*>(pSource), const_cast<T*>(pSourceEnd), pDestination);
+  }
+
   inline char8_t* CharStringUninitializedFillN(char8_t* pDestination, size_t n, const char8_t c)
   {
     if (n) // Some compilers (e.g. GCC 4.3+) generate a warning (which can't be disabled) if you call memset with a size of 0.
@@ -616,29 +629,29 @@ namespace flex
 // basic_string
 ///////////////////////////////////////////////////////////////////////////////
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string() :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string() :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(), mFixed(false)
   {
     AllocateSelf();
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     AllocateSelf();
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(const this_type& x) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(const this_type& x) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(x.mAllocator), mFixed(false)
   {
     RangeInitialize(x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>::basic_string(const this_type& x, size_type position, size_type n) :
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>::basic_string(const this_type& x, size_type position, size_type n) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(x.mAllocator), mFixed(false)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(x.mEnd - x.mBegin),
@@ -647,30 +660,30 @@ namespace flex
     RangeInitialize(x.mBegin + position, x.mBegin + position + std::min(n, (size_type) (x.mEnd - x.mBegin) - position));
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(const value_type* p, size_type n, const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(const value_type* p, size_type n, const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     RangeInitialize(p, p + n);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(const value_type* p, const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(const value_type* p, const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     RangeInitialize(p);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(size_type n, value_type c, const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(size_type n, value_type c, const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     SizeInitialize(n, c);
   }
 
-  template<typename T, typename Allocator>
+  template<typename T, typename Allocator, typename Growth>
   template<class InputIterator>
-  inline basic_string<T, Allocator>::basic_string(InputIterator pBegin, InputIterator pEnd,
+  inline basic_string<T, Allocator, Growth>::basic_string(InputIterator pBegin, InputIterator pEnd,
       const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
@@ -679,8 +692,8 @@ namespace flex
 
 // CtorDoNotInitialize exists so that we can create a version that allocates but doesn't
 // initialize but also doesn't collide with any other constructor declaration.
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>::basic_string(CtorDoNotInitialize /*unused*/, size_type n, const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>::basic_string(CtorDoNotInitialize /*unused*/, size_type n, const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     // Note that we do not call SizeInitialize here.
@@ -688,16 +701,16 @@ namespace flex
     *mEnd = 0;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>::basic_string(std::initializer_list<value_type> init, const allocator_type& allocator) :
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>::basic_string(std::initializer_list<value_type> init, const allocator_type& allocator) :
       mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     RangeInitialize(init.begin(), init.end());
   }
 
 #if FLEX_HAS_CXX11
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator>::basic_string(this_type&& x) :
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>::basic_string(this_type&& x) :
   mBegin(NULL),mEnd(NULL), mCapacity(NULL), mFixed(false)
   {
     if(!mFixed && !x.mFixed) // If we can borrow from x...
@@ -714,8 +727,8 @@ namespace flex
     }
   }
 
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator>::basic_string(this_type&& x, const allocator_type& allocator) :
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>::basic_string(this_type&& x, const allocator_type& allocator) :
   mBegin(NULL), mEnd(NULL), mCapacity(NULL), mAllocator(allocator), mFixed(false)
   {
     if(!mFixed && !x.mFixed) // If we can borrow from x...
@@ -733,8 +746,8 @@ namespace flex
   }
 #endif
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::~basic_string()
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::~basic_string()
   {
     if (!mFixed)
     {
@@ -742,160 +755,160 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  inline const typename basic_string<T, Allocator>::allocator_type&
-  basic_string<T, Allocator>::get_allocator() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline const typename basic_string<T, Allocator, Growth>::allocator_type&
+  basic_string<T, Allocator, Growth>::get_allocator() const FLEX_NOEXCEPT
   {
     return mAllocator;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::allocator_type&
-  basic_string<T, Allocator>::get_allocator() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::allocator_type&
+  basic_string<T, Allocator, Growth>::get_allocator() FLEX_NOEXCEPT
   {
     return mAllocator;
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::set_allocator(const allocator_type& allocator)
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::set_allocator(const allocator_type& allocator)
   {
     mAllocator = allocator;
   }
 
-  template<typename T, typename Allocator>
-  inline const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::data() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::data() const FLEX_NOEXCEPT
   {
     return mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::c_str() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::c_str() const FLEX_NOEXCEPT
   {
     return mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::begin() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::begin() FLEX_NOEXCEPT
   {
     return mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::end() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::end() FLEX_NOEXCEPT
   {
     return mEnd;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_iterator basic_string<T, Allocator>::begin() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_iterator basic_string<T, Allocator, Growth>::begin() const FLEX_NOEXCEPT
   {
     return mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_iterator basic_string<T, Allocator>::cbegin() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_iterator basic_string<T, Allocator, Growth>::cbegin() const FLEX_NOEXCEPT
   {
     return mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_iterator basic_string<T, Allocator>::end() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_iterator basic_string<T, Allocator, Growth>::end() const FLEX_NOEXCEPT
   {
     return mEnd;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_iterator basic_string<T, Allocator>::cend() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_iterator basic_string<T, Allocator, Growth>::cend() const FLEX_NOEXCEPT
   {
     return mEnd;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reverse_iterator basic_string<T, Allocator>::rbegin() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reverse_iterator basic_string<T, Allocator, Growth>::rbegin() FLEX_NOEXCEPT
   {
     return reverse_iterator(mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reverse_iterator basic_string<T, Allocator>::rend() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reverse_iterator basic_string<T, Allocator, Growth>::rend() FLEX_NOEXCEPT
   {
     return reverse_iterator(mBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reverse_iterator basic_string<T, Allocator>::rbegin() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reverse_iterator basic_string<T, Allocator, Growth>::rbegin() const FLEX_NOEXCEPT
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reverse_iterator basic_string<T, Allocator>::crbegin() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reverse_iterator basic_string<T, Allocator, Growth>::crbegin() const FLEX_NOEXCEPT
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reverse_iterator basic_string<T, Allocator>::rend() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reverse_iterator basic_string<T, Allocator, Growth>::rend() const FLEX_NOEXCEPT
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reverse_iterator basic_string<T, Allocator>::crend() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reverse_iterator basic_string<T, Allocator, Growth>::crend() const FLEX_NOEXCEPT
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline bool basic_string<T, Allocator>::empty() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline bool basic_string<T, Allocator, Growth>::empty() const FLEX_NOEXCEPT
   {
     return (mBegin == mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::size() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::size() const FLEX_NOEXCEPT
   {
     return (size_type) (mEnd - mBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::length() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::length() const FLEX_NOEXCEPT
   {
     return (size_type) (mEnd - mBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::max_size() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::max_size() const FLEX_NOEXCEPT
   {
     return kMaxSize;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::capacity() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::capacity() const FLEX_NOEXCEPT
   {
     return (size_type) ((mCapacity - mBegin) - 1); // '-1' because we pretend that we didn't allocate memory for the terminating 0.
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reference basic_string<T, Allocator>::operator[](size_type n) const
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reference basic_string<T, Allocator, Growth>::operator[](size_type n) const
   {
     // We allow the user to reference the trailing 0 char without asserting. Perhaps we shouldn't.
     FLEX_ASSERT(n <= (static_cast<size_type>(mEnd - mBegin)));
     return mBegin[n]; // Sometimes done as *(mBegin + n)
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reference basic_string<T, Allocator>::operator[](size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reference basic_string<T, Allocator, Growth>::operator[](size_type n)
   {
     // We allow the user to reference the trailing 0 char without asserting. Perhaps we shouldn't.
     FLEX_ASSERT(n <= (static_cast<size_type>(mEnd - mBegin)));
     return mBegin[n]; // Sometimes done as *(mBegin + n)
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::this_type& basic_string<T, Allocator>::operator=(const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::this_type& basic_string<T, Allocator, Growth>::operator=(const this_type& x)
   {
     if (&x != this)
     {
@@ -904,35 +917,35 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::this_type& basic_string<T, Allocator>::operator=(const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::this_type& basic_string<T, Allocator, Growth>::operator=(const value_type* p)
   {
     return assign(p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::this_type& basic_string<T, Allocator>::operator=(value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::this_type& basic_string<T, Allocator, Growth>::operator=(value_type c)
   {
     return assign((size_type) 1, c);
   }
 
 #if FLEX_HAS_CXX11
-  template <typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::this_type& basic_string<T, Allocator>::operator=(this_type&& x)
+  template <typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::this_type& basic_string<T, Allocator, Growth>::operator=(this_type&& x)
   {
     return assign(std::move(x));
   }
 #endif
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::this_type& basic_string<T, Allocator>::operator=(
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::this_type& basic_string<T, Allocator, Growth>::operator=(
       std::initializer_list<value_type> ilist)
   {
     return assign(ilist.begin(), ilist.end());
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::resize(size_type n, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::resize(size_type n, value_type c)
   {
     const size_type s = (size_type) (mEnd - mBegin);
 
@@ -942,8 +955,8 @@ namespace flex
       append(n - s, c);
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::resize(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::resize(size_type n)
   {
     const size_type s = (size_type) (mEnd - mBegin);
 
@@ -955,8 +968,31 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::reserve(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::resize_default_init(size_type n)
+  {
+    const size_type s = (size_type) (mEnd - mBegin);
+
+    if (n < s)
+      erase(mBegin + n, mEnd);
+    else if (n > s)
+    {
+      const size_type nCapacity = (size_type) ((mCapacity - mBegin) - 1);
+      if (n > nCapacity)
+        reserve(GetNewCapacity(nCapacity, n));
+      mEnd = mBegin + n;
+      *mEnd = 0;
+    }
+  }
+
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::resize_uninitialized(size_type n)
+  {
+    resize_default_init(n);
+  }
+
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::reserve(size_type n)
   {
     FLEX_THROW_LENGTH_ERROR_IF(n > kMaxSize, "flex::basic_string - reserve() invalid length");
 
@@ -975,8 +1011,8 @@ namespace flex
       set_capacity(n);
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::set_capacity(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::set_capacity(size_type n)
   {
     if (n == npos) // If the user wants to set the capacity to equal the current size... // '-1' because we pretend that we didn't allocate memory for the terminating 0.
       n = (size_type) (mEnd - mBegin);
@@ -990,7 +1026,7 @@ namespace flex
         pointer pNewBegin = DoAllocate(n + 1); // We need the + 1 to accomodate the trailing 0.
         pointer pNewEnd = pNewBegin;
 
-        pNewEnd = CharStringUninitializedCopy(mBegin, mEnd, pNewBegin);
+        pNewEnd = CharStringRelocate(mBegin, mEnd, pNewBegin);
         *pNewEnd = 0;
 
         DeallocateSelf();
@@ -1006,8 +1042,8 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::shrink_to_fit()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::shrink_to_fit()
   {
     if (!mFixed)
     {
@@ -1019,7 +1055,7 @@ namespace flex
           pointer pNewBegin = DoAllocate(n + 1); // We need the + 1 to accomodate the trailing 0.
           pointer pNewEnd = pNewBegin;
 
-          pNewEnd = CharStringUninitializedCopy(mBegin, mEnd, pNewBegin);
+          pNewEnd = CharStringRelocate(mBegin, mEnd, pNewBegin);
           *pNewEnd = 0;
 
           DeallocateSelf();
@@ -1036,8 +1072,8 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::clear() FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::clear() FLEX_NOEXCEPT
   {
     if (mBegin != mEnd)
     {
@@ -1046,107 +1082,130 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reference basic_string<T, Allocator>::at(size_type n) const
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reference basic_string<T, Allocator, Growth>::at(size_type n) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= (size_type ) (mEnd - mBegin), "flex::string.at() - index out-of-bounds");
     return mBegin[n];
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reference basic_string<T, Allocator>::at(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reference basic_string<T, Allocator, Growth>::at(size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= (size_type ) (mEnd - mBegin), "flex::string.at() - index out-of-bounds");
     return mBegin[n];
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reference basic_string<T, Allocator>::front()
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reference basic_string<T, Allocator, Growth>::front()
   {
     FLEX_ASSERT(mBegin < mEnd);
     return *mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reference basic_string<T, Allocator>::front() const
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reference basic_string<T, Allocator, Growth>::front() const
   {
     FLEX_ASSERT(mBegin < mEnd);
     return *mBegin;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reference basic_string<T, Allocator>::back()
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reference basic_string<T, Allocator, Growth>::back()
   {
     FLEX_ASSERT(mBegin < mEnd);
     return *(mEnd - 1);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::const_reference basic_string<T, Allocator>::back() const
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::const_reference basic_string<T, Allocator, Growth>::back() const
   {
     FLEX_ASSERT(mBegin < mEnd);
     return *(mEnd - 1);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::operator+=(const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::operator+=(const this_type& x)
   {
     return append(x);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::operator+=(std::initializer_list<value_type> x)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::operator+=(std::initializer_list<value_type> x)
   {
     return append(x);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::operator+=(const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::operator+=(const value_type* p)
   {
     return append(p);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::operator+=(value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::operator+=(value_type c)
   {
     push_back(c);
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::append(const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(const this_type& x)
   {
     return append(x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::append(std::initializer_list<value_type> x)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(std::initializer_list<value_type> x)
   {
     return append(x.begin(), x.end());
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::append(const this_type& x, size_type position,
+  template<typename T, typename Allocator, typename Growth>
+  template<class Function>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::append_with(size_type n,
+      Function f)
+  {
+    const size_type s = (size_type) (mEnd - mBegin);
+
+    FLEX_THROW_LENGTH_ERROR_IF((n > kMaxSize) || (s > (kMaxSize - n)), "basic_string -- length_error");
+
+    const size_type nCapacity = (size_type) ((mCapacity - mBegin) - 1);
+
+    if ((s + n) > nCapacity)
+      reserve(GetNewCapacity(nCapacity, s + n));
+
+    // The window is followed by the room for the trailing 0, so it is always safe to terminate after it.
+    const size_type nCount = (size_type) f(mEnd, n);
+    FLEX_ASSERT(nCount <= n);
+    // f may have written over the old terminator even if it produced nothing.
+    mEnd += nCount;
+    *mEnd = 0;
+    return nCount;
+  }
+
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(const this_type& x, size_type position,
       size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(x.mEnd - x.mBegin), "basic_string -- out of range");
     return append(x.mBegin + position, x.mBegin + position + std::min(n, (size_type) (x.mEnd - x.mBegin) - position));
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::append(const value_type* p, size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(const value_type* p, size_type n)
   {
     return append(p, p + n);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::append(const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(const value_type* p)
   {
     return append(p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::append(size_type n, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(size_type n, value_type c)
   {
     const size_type s = (size_type) (mEnd - mBegin);
 
@@ -1155,7 +1214,7 @@ namespace flex
     const size_type nCapacity = (size_type) ((mCapacity - mBegin) - 1);
 
     if ((s + n) > nCapacity)
-      reserve(std::max((size_type) GetNewCapacity(nCapacity), (size_type) (s + n)));
+      reserve(GetNewCapacity(nCapacity, (size_type) (s + n)));
 
     if (n > 0)
     {
@@ -1168,8 +1227,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::append(const value_type* pBegin, const value_type* pEnd)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::append(const value_type* pBegin, const value_type* pEnd)
   {
     if (pBegin != pEnd)
     {
@@ -1183,12 +1242,12 @@ namespace flex
 
       if ((nOldSize + n) > nCapacity)
       {
-        const size_type nLength = std::max((size_type) GetNewCapacity(nCapacity), (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
+        const size_type nLength = GetNewCapacity(nCapacity, (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
 
         pointer pNewBegin = DoAllocate(nLength);
         pointer pNewEnd = pNewBegin;
 
-        pNewEnd = CharStringUninitializedCopy(mBegin, mEnd, pNewBegin);
+        pNewEnd = CharStringRelocate(mBegin, mEnd, pNewBegin);
         pNewEnd = CharStringUninitializedCopy(pBegin, pEnd, pNewEnd);
         *pNewEnd = 0;
 
@@ -1211,32 +1270,32 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::push_back(value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::push_back(value_type c)
   {
     if ((mEnd + 1) == mCapacity) // If we are out of space... (note that we test for + 1 because we have a trailing 0)
-      reserve(std::max(GetNewCapacity((size_type) ((mCapacity - mBegin) - 1)), (size_type) (mEnd - mBegin) + 1));
+      reserve(GetNewCapacity((size_type) ((mCapacity - mBegin) - 1), (size_type) (mEnd - mBegin) + 1));
     *mEnd++ = c;
     *mEnd = 0;
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::pop_back()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::pop_back()
   {
     FLEX_ASSERT(mBegin < mEnd);
     mEnd[-1] = value_type(0);
     --mEnd;
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(const this_type& x)
   {
     // The C++11 Standard 21.4.6.3 p6 specifies that assign from this_type assigns contents only and not the allocator.
     return assign(x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(const this_type& x, size_type position,
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(const this_type& x, size_type position,
       size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(x.mEnd - x.mBegin), "basic_string -- out of range");
@@ -1244,20 +1303,20 @@ namespace flex
     return assign(x.mBegin + position, x.mBegin + position + std::min(n, (size_type) (x.mEnd - x.mBegin) - position));
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(const value_type* p, size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(const value_type* p, size_type n)
   {
     return assign(p, p + n);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(const value_type* p)
   {
     return assign(p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::assign(size_type n, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(size_type n, value_type c)
   {
     if (n <= (size_type) (mEnd - mBegin))
     {
@@ -1272,8 +1331,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::assign(const value_type* pBegin, const value_type* pEnd)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(const value_type* pBegin, const value_type* pEnd)
   {
     const ptrdiff_t n = pEnd - pBegin;
     if (static_cast<size_type>(n) <= (size_type) (mEnd - mBegin))
@@ -1289,15 +1348,15 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(std::initializer_list<value_type> ilist)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(std::initializer_list<value_type> ilist)
   {
     return assign(ilist.begin(), ilist.end());
   }
 
 #if FLEX_HAS_CXX11
-  template <typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::assign(this_type&& x)
+  template <typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::assign(this_type&& x)
   {
     if(!mFixed && !x.mFixed)
     {
@@ -1312,8 +1371,8 @@ namespace flex
   }
 #endif
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::insert(size_type position, const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::insert(size_type position, const this_type& x)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     FLEX_THROW_LENGTH_ERROR_IF((size_type )(mEnd - mBegin) > (kMaxSize - (size_type )(x.mEnd - x.mBegin)),
@@ -1322,8 +1381,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::insert(size_type position, const this_type& x, size_type beg,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::insert(size_type position, const this_type& x, size_type beg,
       size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
@@ -1333,8 +1392,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::insert(size_type position, const value_type* p, size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::insert(size_type position, const value_type* p, size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     FLEX_THROW_LENGTH_ERROR_IF((size_type )(mEnd - mBegin) > (kMaxSize - n), "basic_string -- length_error");
@@ -1342,8 +1401,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::insert(size_type position, const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::insert(size_type position, const value_type* p)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     size_type nLength = (size_type) CharStrlen(p);
@@ -1352,8 +1411,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::insert(size_type position, size_type n, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::insert(size_type position, size_type n, value_type c)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     FLEX_THROW_LENGTH_ERROR_IF((size_type )(mEnd - mBegin) > (kMaxSize - n), "basic_string -- length_error");
@@ -1361,8 +1420,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::insert(const_iterator p,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::insert(const_iterator p,
       value_type c)
   {
     if (p == mEnd)
@@ -1373,8 +1432,8 @@ namespace flex
     return InsertInternal(p, c);
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::insert(const_iterator p, size_type n,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::insert(const_iterator p, size_type n,
       value_type c)
   {
     const ptrdiff_t nPosition = (p - mBegin); // Save this because we might reallocate.
@@ -1409,14 +1468,14 @@ namespace flex
       {
         const size_type nOldSize = (size_type) (mEnd - mBegin);
         const size_type nOldCap = (size_type) ((mCapacity - mBegin) - 1);
-        const size_type nLength = std::max((size_type) GetNewCapacity(nOldCap), (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
+        const size_type nLength = GetNewCapacity(nOldCap, (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
 
         iterator pNewBegin = DoAllocate(nLength);
         iterator pNewEnd = pNewBegin;
 
-        pNewEnd = CharStringUninitializedCopy(mBegin, p, pNewBegin);
+        pNewEnd = CharStringRelocate(mBegin, p, pNewBegin);
         pNewEnd = CharStringUninitializedFillN(pNewEnd, n, c);
-        pNewEnd = CharStringUninitializedCopy(p, mEnd, pNewEnd);
+        pNewEnd = CharStringRelocate(p, mEnd, pNewEnd);
         *pNewEnd = 0;
 
         DeallocateSelf();
@@ -1429,8 +1488,8 @@ namespace flex
     return mBegin + nPosition;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::insert(const_iterator p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::insert(const_iterator p,
       const value_type* pBegin, const value_type* pEnd)
   {
     const ptrdiff_t nPosition = (p - mBegin); // Save this because we might reallocate.
@@ -1482,14 +1541,14 @@ namespace flex
         if (bCapacityIsSufficient) // If bCapacityIsSufficient is true, then bSourceIsFromSelf must be false.
           nLength = nOldSize + n + 1; // + 1 to accomodate the trailing 0.
         else
-          nLength = std::max((size_type) GetNewCapacity(nOldCap), (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
+          nLength = GetNewCapacity(nOldCap, (size_type) (nOldSize + n)) + 1; // + 1 to accomodate the trailing 0.
 
         pointer pNewBegin = DoAllocate(nLength);
         pointer pNewEnd = pNewBegin;
 
-        pNewEnd = CharStringUninitializedCopy(mBegin, p, pNewBegin);
+        pNewEnd = CharStringRelocate(mBegin, p, pNewBegin);
         pNewEnd = CharStringUninitializedCopy(pBegin, pEnd, pNewEnd);
-        pNewEnd = CharStringUninitializedCopy(p, mEnd, pNewEnd);
+        pNewEnd = CharStringRelocate(p, mEnd, pNewEnd);
         *pNewEnd = 0;
 
         DeallocateSelf();
@@ -1502,23 +1561,23 @@ namespace flex
     return mBegin + nPosition;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::insert(const_iterator p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::insert(const_iterator p,
       std::initializer_list<value_type> ilist)
   {
     return insert(p, ilist.begin(), ilist.end());
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::erase(size_type position, size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::erase(size_type position, size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");FLEX_ASSERT(position <= (size_type)(mEnd - mBegin));
     erase(mBegin + position, mBegin + position + std::min(n, (size_type) (mEnd - mBegin) - position));
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::erase(const_iterator p)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::erase(const_iterator p)
   {
     FLEX_ASSERT((mBegin <= p) && (p < mEnd));
     memmove(const_cast<value_type*>(p), p + 1, (size_t) (mEnd - p) * sizeof(value_type));
@@ -1526,8 +1585,8 @@ namespace flex
     return const_cast<value_type*>(p);
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::erase(const_iterator pBegin,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::erase(const_iterator pBegin,
       const_iterator pEnd)
   {
     FLEX_ASSERT((pBegin >= mBegin) && (pBegin <= mEnd) && (pEnd >= mBegin) && (pEnd <= mEnd) && (pEnd >= pBegin));
@@ -1540,22 +1599,22 @@ namespace flex
     return const_cast<value_type*>(pBegin);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::reverse_iterator basic_string<T, Allocator>::erase(
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::reverse_iterator basic_string<T, Allocator, Growth>::erase(
       reverse_iterator position)
   {
     return reverse_iterator(erase((++position).base()));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::reverse_iterator basic_string<T, Allocator>::erase(reverse_iterator first,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::reverse_iterator basic_string<T, Allocator, Growth>::erase(reverse_iterator first,
       reverse_iterator last)
   {
     return reverse_iterator(erase((++last).base(), (++first).base()));
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(size_type position, size_type n, const this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(size_type position, size_type n, const this_type& x)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     const size_type nLength = std::min(n, (size_type) (mEnd - mBegin) - position);
@@ -1564,8 +1623,8 @@ namespace flex
     return replace(mBegin + position, mBegin + position + nLength, x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(size_type pos1, size_type n1, const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(size_type pos1, size_type n1, const this_type& x,
       size_type pos2, size_type n2)
   {
     FLEX_THROW_OUT_OF_RANGE_IF((pos1 > (size_type )(mEnd - mBegin)) || (pos2 > (size_type )(x.mEnd - x.mBegin)),
@@ -1577,8 +1636,8 @@ namespace flex
     return replace(mBegin + pos1, mBegin + pos1 + nLength1, x.mBegin + pos2, x.mBegin + pos2 + nLength2);
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(size_type position, size_type n1, const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(size_type position, size_type n1, const value_type* p,
       size_type n2)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
@@ -1588,8 +1647,8 @@ namespace flex
     return replace(mBegin + position, mBegin + position + nLength, p, p + n2);
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(size_type position, size_type n1, const value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(size_type position, size_type n1, const value_type* p)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     const size_type nLength = std::min(n1, (size_type) (mEnd - mBegin) - position);
@@ -1603,8 +1662,8 @@ namespace flex
     return replace(mBegin + position, mBegin + position + nLength, p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(size_type position, size_type n1, size_type n2,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(size_type position, size_type n1, size_type n2,
       value_type c)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
@@ -1614,36 +1673,36 @@ namespace flex
     return replace(mBegin + position, mBegin + position + nLength, n2, c);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin, const_iterator pEnd,
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin, const_iterator pEnd,
       const this_type& x)
   {
     return replace(pBegin, pEnd, x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin, const_iterator pEnd,
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin, const_iterator pEnd,
       std::initializer_list<value_type> x)
   {
     return replace(pBegin, pEnd, x.begin(), x.end());
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin, const_iterator pEnd,
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin, const_iterator pEnd,
       const value_type* p, size_type n)
   {
     return replace(pBegin, pEnd, p, p + n);
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin, const_iterator pEnd,
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin, const_iterator pEnd,
       const value_type* p)
   {
     return replace(pBegin, pEnd, p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin, const_iterator pEnd,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin, const_iterator pEnd,
       size_type n, value_type c)
   {
     FLEX_ASSERT((pBegin >= mBegin) && (pBegin <= mEnd) && (pEnd >= mBegin) && (pEnd <= mEnd) && (pEnd >= pBegin));
@@ -1663,8 +1722,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator>& basic_string<T, Allocator>::replace(const_iterator pBegin1, const_iterator pEnd1,
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth>& basic_string<T, Allocator, Growth>::replace(const_iterator pBegin1, const_iterator pEnd1,
       const value_type* pBegin2, const value_type* pEnd2)
   {
     FLEX_ASSERT((pBegin1 >= mBegin) && (pBegin1 <= mEnd) && (pEnd1 >= mBegin) && (pEnd1 <= mEnd) && (pEnd1 >= pBegin1));
@@ -1696,15 +1755,14 @@ namespace flex
         // I can't think of any easy way of doing this without allocating temporary memory.
         const size_type nOldSize = (size_type) (mEnd - mBegin);
         const size_type nOldCap = (size_type) ((mCapacity - mBegin) - 1);
-        const size_type nNewCapacity = std::max((size_type) GetNewCapacity(nOldCap),
-            (size_type) (nOldSize + (nLength2 - nLength1))) + 1; // + 1 to accomodate the trailing 0.
+        const size_type nNewCapacity = GetNewCapacity(nOldCap, (size_type) (nOldSize + (nLength2 - nLength1))) + 1; // + 1 to accomodate the trailing 0.
 
         pointer pNewBegin = DoAllocate(nNewCapacity);
         pointer pNewEnd = pNewBegin;
 
-        pNewEnd = CharStringUninitializedCopy(mBegin, pBegin1, pNewBegin);
+        pNewEnd = CharStringRelocate(mBegin, pBegin1, pNewBegin);
         pNewEnd = CharStringUninitializedCopy(pBegin2, pEnd2, pNewEnd);
-        pNewEnd = CharStringUninitializedCopy(pEnd1, mEnd, pNewEnd);
+        pNewEnd = CharStringRelocate(pEnd1, mEnd, pNewEnd);
         *pNewEnd = 0;
 
         DeallocateSelf();
@@ -1716,8 +1774,8 @@ namespace flex
     return *this;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::copy(value_type* p, size_type n,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::copy(value_type* p, size_type n,
       size_type position) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
@@ -1730,8 +1788,8 @@ namespace flex
     return nLength;
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::swap(this_type& x)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::swap(this_type& x)
   {
     if (!mFixed && !x.mFixed) // If allocators are equivalent...
     {
@@ -1757,22 +1815,22 @@ namespace flex
     }
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find(const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find(const this_type& x,
       size_type position) const FLEX_NOEXCEPT
   {
     return find(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find(const value_type* p,
       size_type position) const
   {
     return find(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find(const value_type* p,
       size_type position, size_type n) const
   {
     if (FLEX_LIKELY(((npos - n) >= position) && (position + n) <= (size_type ) (mEnd - mBegin))) // If the range is valid...
@@ -1785,8 +1843,8 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     if (FLEX_LIKELY(position < (size_type )(mEnd - mBegin))) // If the position is valid...
@@ -1799,22 +1857,22 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::rfind(const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::rfind(const this_type& x,
       size_type position) const FLEX_NOEXCEPT
   {
     return rfind(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::rfind(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::rfind(const value_type* p,
       size_type position) const
   {
     return rfind(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::rfind(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::rfind(const value_type* p,
       size_type position, size_type n) const
   {
     // Note that a search for a zero length string starting at position = end() returns end() and not npos.
@@ -1840,8 +1898,8 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::rfind(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::rfind(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     // If n is zero or position is >= size, we return npos.
@@ -1858,22 +1916,22 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_of(const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_of(const this_type& x,
       size_type position) const FLEX_NOEXCEPT
   {
     return find_first_of(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_of(const value_type* p,
       size_type position) const
   {
     return find_first_of(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_of(const value_type* p,
       size_type position, size_type n) const
   {
 // If position is >= size, we return npos.
@@ -1888,29 +1946,29 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_of(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_of(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     return find(c, position);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_of(const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_of(const this_type& x,
       size_type position) const FLEX_NOEXCEPT
   {
     return find_last_of(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_of(const value_type* p,
       size_type position) const
   {
     return find_last_of(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_of(const value_type* p,
       size_type position, size_type n) const
   {
 // If n is zero or position is >= size, we return npos.
@@ -1927,29 +1985,29 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_of(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_of(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     return rfind(c, position);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_not_of(
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_not_of(
       const this_type& x, size_type position) const FLEX_NOEXCEPT
   {
     return find_first_not_of(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_not_of(
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_not_of(
       const value_type* p, size_type position) const
   {
     return find_first_not_of(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_not_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_not_of(const value_type* p,
       size_type position, size_type n) const
   {
     if (FLEX_LIKELY(position <= (size_type ) (mEnd - mBegin)))
@@ -1962,8 +2020,8 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_first_not_of(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_first_not_of(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     if (FLEX_LIKELY(position <= (size_type )(mEnd - mBegin)))
@@ -1977,22 +2035,22 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_not_of(const this_type& x,
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_not_of(const this_type& x,
       size_type position) const FLEX_NOEXCEPT
   {
     return find_last_not_of(x.mBegin, position, (size_type) (x.mEnd - x.mBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_not_of(
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_not_of(
       const value_type* p, size_type position) const
   {
     return find_last_not_of(p, position, (size_type) CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_not_of(const value_type* p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_not_of(const value_type* p,
       size_type position, size_type n) const
   {
     const size_type nLength = (size_type) (mEnd - mBegin);
@@ -2008,8 +2066,8 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::find_last_not_of(value_type c,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::find_last_not_of(value_type c,
       size_type position) const FLEX_NOEXCEPT
   {
     const size_type nLength = (size_type) (mEnd - mBegin);
@@ -2026,29 +2084,29 @@ namespace flex
     return npos;
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator> basic_string<T, Allocator>::substr(size_type position, size_type n) const
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth> basic_string<T, Allocator, Growth>::substr(size_type position, size_type n) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(position > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     return basic_string(mBegin + position, mBegin + position + std::min(n, (size_type) (mEnd - mBegin) - position),
         mAllocator);
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(const this_type& x) const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(const this_type& x) const FLEX_NOEXCEPT
   {
     return compare(mBegin, mEnd, x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(size_type pos1, size_type n1, const this_type& x) const
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(size_type pos1, size_type n1, const this_type& x) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(pos1 > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     return compare(mBegin + pos1, mBegin + pos1 + std::min(n1, (size_type) (mEnd - mBegin) - pos1), x.mBegin, x.mEnd);
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(size_type pos1, size_type n1, const this_type& x, size_type pos2,
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(size_type pos1, size_type n1, const this_type& x, size_type pos2,
       size_type n2) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF((pos1 > (size_type )(mEnd - mBegin)) || (pos2 > (size_type )(x.mEnd - x.mBegin)),
@@ -2057,22 +2115,22 @@ namespace flex
         x.mBegin + pos2 + std::min(n2, (size_type) (x.mEnd - x.mBegin) - pos2));
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(const value_type* p) const
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(const value_type* p) const
   {
     return compare(mBegin, mEnd, p, p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(size_type pos1, size_type n1, const value_type* p) const
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(size_type pos1, size_type n1, const value_type* p) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(pos1 > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     return compare(mBegin + pos1, mBegin + pos1 + std::min(n1, (size_type) (mEnd - mBegin) - pos1), p,
         p + CharStrlen(p));
   }
 
-  template<typename T, typename Allocator>
-  inline int basic_string<T, Allocator>::compare(size_type pos1, size_type n1, const value_type* p, size_type n2) const
+  template<typename T, typename Allocator, typename Growth>
+  inline int basic_string<T, Allocator, Growth>::compare(size_type pos1, size_type n1, const value_type* p, size_type n2) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(pos1 > (size_type )(mEnd - mBegin), "basic_string -- out of range");
     return compare(mBegin + pos1, mBegin + pos1 + std::min(n1, (size_type) (mEnd - mBegin) - pos1), p, p + n2);
@@ -2081,8 +2139,8 @@ namespace flex
 // make_lower
 // This is a very simple ASCII-only case conversion function
 // Anything more complicated should use a more powerful separate library.
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::make_lower()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::make_lower()
   {
     for (pointer p = mBegin; p < mEnd; ++p)
       *p = (value_type) CharToLower(*p);
@@ -2091,36 +2149,36 @@ namespace flex
 // make_upper
 // This is a very simple ASCII-only case conversion function
 // Anything more complicated should use a more powerful separate library.
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::make_upper()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::make_upper()
   {
     for (pointer p = mBegin; p < mEnd; ++p)
       *p = (value_type) CharToUpper(*p);
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::ltrim()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::ltrim()
   {
     const value_type array[] = { ' ', '\t', 0 }; // This is a pretty simplistic view of whitespace.
     erase(0, find_first_not_of(array));
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::rtrim()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::rtrim()
   {
     const value_type array[] = { ' ', '\t', 0 }; // This is a pretty simplistic view of whitespace.
     erase(find_last_not_of(array) + 1);
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::trim()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::trim()
   {
     ltrim();
     rtrim();
   }
 
-  template<typename T, typename Allocator>
-  int basic_string<T, Allocator>::compare(const value_type* pBegin1, const value_type* pEnd1, const value_type* pBegin2,
+  template<typename T, typename Allocator, typename Growth>
+  int basic_string<T, Allocator, Growth>::compare(const value_type* pBegin1, const value_type* pEnd1, const value_type* pBegin2,
       const value_type* pEnd2)
   {
     const ptrdiff_t n1 = pEnd1 - pBegin1;
@@ -2131,8 +2189,8 @@ namespace flex
     return (cmp != 0 ? cmp : (n1 < n2 ? -1 : (n1 > n2 ? 1 : 0)));
   }
 
-  template<typename T, typename Allocator>
-  typename basic_string<T, Allocator>::iterator basic_string<T, Allocator>::InsertInternal(const_iterator p,
+  template<typename T, typename Allocator, typename Growth>
+  typename basic_string<T, Allocator, Growth>::iterator basic_string<T, Allocator, Growth>::InsertInternal(const_iterator p,
       value_type c)
   {
     iterator pNewPosition = const_cast<value_type*>(p);
@@ -2148,16 +2206,16 @@ namespace flex
     {
       const size_type nOldSize = (size_type) (mEnd - mBegin);
       const size_type nOldCap = (size_type) ((mCapacity - mBegin) - 1);
-      const size_type nLength = std::max((size_type) GetNewCapacity(nOldCap), (size_type) (nOldSize + 1)) + 1; // The second + 1 is to accomodate the trailing 0.
+      const size_type nLength = GetNewCapacity(nOldCap, (size_type) (nOldSize + 1)) + 1; // The second + 1 is to accomodate the trailing 0.
 
       iterator pNewBegin = DoAllocate(nLength);
       iterator pNewEnd = pNewBegin;
 
-      pNewPosition = CharStringUninitializedCopy(mBegin, p, pNewBegin);
+      pNewPosition = CharStringRelocate(mBegin, p, pNewBegin);
       *pNewPosition = c;
 
       pNewEnd = pNewPosition + 1;
-      pNewEnd = CharStringUninitializedCopy(p, mEnd, pNewEnd);
+      pNewEnd = CharStringRelocate(p, mEnd, pNewEnd);
       *pNewEnd = 0;
 
       DeallocateSelf();
@@ -2168,8 +2226,8 @@ namespace flex
     return pNewPosition;
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::SizeInitialize(size_type n, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::SizeInitialize(size_type n, value_type c)
   {
     AllocateSelf((size_type) (n + 1)); // '+1' so that we have room for the terminating 0.
 
@@ -2177,9 +2235,9 @@ namespace flex
     *mEnd = 0;
   }
 
-  template<typename T, typename Allocator>
+  template<typename T, typename Allocator, typename Growth>
   template<class InputIterator>
-  void basic_string<T, Allocator>::RangeInitialize(InputIterator pBegin, InputIterator pEnd)
+  void basic_string<T, Allocator, Growth>::RangeInitialize(InputIterator pBegin, InputIterator pEnd)
   {
     FLEX_THROW_INVALID_ARGUMENT_IF(!pBegin && (pEnd < pBegin), "basic_string -- invalid argument"); // 21.4.2 p7
 
@@ -2191,15 +2249,15 @@ namespace flex
     *mEnd = 0;
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::RangeInitialize(const value_type* pBegin)
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::RangeInitialize(const value_type* pBegin)
   {
     FLEX_THROW_INVALID_ARGUMENT_IF(!pBegin, "basic_string -- invalid argument");
     RangeInitialize(pBegin, pBegin + CharStrlen(pBegin));
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(pointer new_begin, pointer new_end, size_type capacity) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(pointer new_begin, pointer new_end, size_type capacity) :
       mBegin(new_begin), mEnd(new_end), mCapacity(mBegin + capacity), mFixed(true)
   {
 #ifndef FLEX_RELEASE
@@ -2215,22 +2273,22 @@ namespace flex
 #endif
   }
 
-  template<typename T, typename Allocator>
-  inline basic_string<T, Allocator>::basic_string(pointer new_begin, size_type n, bool fixed) :
+  template<typename T, typename Allocator, typename Growth>
+  inline basic_string<T, Allocator, Growth>::basic_string(pointer new_begin, size_type n, bool fixed) :
       mBegin(new_begin), mEnd(new_begin + n), mCapacity(mEnd), mFixed(fixed)
   {
 
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::DoAllocate(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::DoAllocate(size_type n)
   {
     return (value_type*) mAllocator.allocate(n);
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::DoFree(value_type* p, size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::DoFree(value_type* p, size_type n)
   {
 #ifndef FLEX_RELEASE
     if (FLEX_UNLIKELY(mFixed))
@@ -2244,15 +2302,20 @@ namespace flex
       mAllocator.deallocate(p, n);
   }
 
-  template<typename T, typename Allocator>
-  inline typename basic_string<T, Allocator>::size_type basic_string<T, Allocator>::GetNewCapacity(
-      size_type currentCapacity) // This needs to return a value of at least currentCapacity and at least 1.
+  template<typename T, typename Allocator, typename Growth>
+  inline typename basic_string<T, Allocator, Growth>::size_type basic_string<T, Allocator, Growth>::GetNewCapacity(
+      size_type currentCapacity, size_type minCapacity) // This needs to return a value of at least minCapacity and at least 1.
   {
-    return (currentCapacity > FLEX_STRING_INITIAL_CAPACITY) ? (2 * currentCapacity) : FLEX_STRING_INITIAL_CAPACITY;
+    // Small strings jump straight to FLEX_STRING_INITIAL_CAPACITY.  Beyond that the Growth policy decides, with
+    // the trailing 0 passed as the overhead.  See growth_policy.h.
+    if (currentCapacity > FLEX_STRING_INITIAL_CAPACITY)
+      return (size_type) Growth::new_capacity(currentCapacity, minCapacity, sizeof(T), 1, mAllocator);
+    else
+      return std::max((size_type) FLEX_STRING_INITIAL_CAPACITY, minCapacity);
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::AllocateSelf()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::AllocateSelf()
   {
     FLEX_ASSERT(gEmptyString.mUint32 == 0);
     mBegin = const_cast<value_type*>(GetEmptyString(value_type())); // In const_cast-int this, we promise not to modify it.
@@ -2260,8 +2323,8 @@ namespace flex
     mCapacity = mBegin + 1; // When we are using gEmptyString, mCapacity is always mEnd + 1. This is an important distinguising characteristic.
   }
 
-  template<typename T, typename Allocator>
-  void basic_string<T, Allocator>::AllocateSelf(size_type n)
+  template<typename T, typename Allocator, typename Growth>
+  void basic_string<T, Allocator, Growth>::AllocateSelf(size_type n)
   {
     FLEX_ASSERT(n < 0x40000000);
     FLEX_THROW_LENGTH_ERROR_IF(n > kMaxSize, "basic_string -- length_error");
@@ -2276,8 +2339,8 @@ namespace flex
       AllocateSelf();
   }
 
-  template<typename T, typename Allocator>
-  inline void basic_string<T, Allocator>::DeallocateSelf()
+  template<typename T, typename Allocator, typename Growth>
+  inline void basic_string<T, Allocator, Growth>::DeallocateSelf()
   {
     // Note that we compare mCapacity to mEnd instead of comparing
     // mBegin to &gEmptyString. This is important because we may have
@@ -2290,9 +2353,9 @@ namespace flex
 // CharTypeStringFindEnd
 // Specialized char version of STL find() from back function.
 // Not the same as RFind because search range is specified as forward iterators.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringFindEnd(const value_type* pBegin, const value_type* pEnd, value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringFindEnd(const value_type* pBegin, const value_type* pEnd, value_type c)
   {
     const value_type* pTemp = pEnd;
     while (--pTemp >= pBegin)
@@ -2306,9 +2369,9 @@ namespace flex
 
 // CharTypeStringRFind
 // Specialized value_type version of STL find() function in reverse.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringRFind(const value_type* pRBegin, const value_type* pREnd,
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringRFind(const value_type* pRBegin, const value_type* pREnd,
       const value_type c)
   {
     while (pRBegin > pREnd)
@@ -2323,9 +2386,9 @@ namespace flex
 // CharTypeStringRSearch
 // Specialized value_type version of STL find_end() function (which really is a reverse search function).
 // Purpose: find last instance of p2 within p1. Return p1End if not found or if either string is zero length.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringRSearch(const value_type* p1Begin, const value_type* p1End,
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringRSearch(const value_type* p1Begin, const value_type* p1End,
       const value_type* p2Begin, const value_type* p2End)
   {
     // Test for zero length strings, in which case we have a match or a failure,
@@ -2372,9 +2435,9 @@ namespace flex
 // CharTypeStringRFindFirstOf
 // Specialized value_type version of STL find_first_of() function in reverse.
 // This function is much like the C runtime strtok function, except the strings aren't null-terminated.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringRFindFirstOf(const value_type* p1RBegin, const value_type* p1REnd,
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringRFindFirstOf(const value_type* p1RBegin, const value_type* p1REnd,
       const value_type* p2Begin, const value_type* p2End)
   {
     for (; p1RBegin != p1REnd; --p1RBegin)
@@ -2390,9 +2453,9 @@ namespace flex
 
 // CharTypeStringFindFirstNotOf
 // Specialized value_type version of STL find_first_not_of() function.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringFindFirstNotOf(const value_type* p1Begin, const value_type* p1End,
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringFindFirstNotOf(const value_type* p1Begin, const value_type* p1End,
       const value_type* p2Begin, const value_type* p2End)
   {
     for (; p1Begin != p1End; ++p1Begin)
@@ -2411,9 +2474,9 @@ namespace flex
 
 // CharTypeStringRFindFirstNotOf
 // Specialized value_type version of STL find_first_not_of() function in reverse.
-  template<typename T, typename Allocator>
-  const typename basic_string<T, Allocator>::value_type*
-  basic_string<T, Allocator>::CharTypeStringRFindFirstNotOf(const value_type* p1RBegin, const value_type* p1REnd,
+  template<typename T, typename Allocator, typename Growth>
+  const typename basic_string<T, Allocator, Growth>::value_type*
+  basic_string<T, Allocator, Growth>::CharTypeStringRFindFirstNotOf(const value_type* p1RBegin, const value_type* p1REnd,
       const value_type* p2Begin, const value_type* p2End)
   {
     for (; p1RBegin != p1REnd; --p1RBegin)
@@ -2431,124 +2494,124 @@ namespace flex
   }
 
 // iterator operators
-  template<typename T, typename Allocator>
-  inline bool operator==(const typename basic_string<T, Allocator>::reverse_iterator& r1,
-      const typename basic_string<T, Allocator>::reverse_iterator& r2)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator==(const typename basic_string<T, Allocator, Growth>::reverse_iterator& r1,
+      const typename basic_string<T, Allocator, Growth>::reverse_iterator& r2)
   {
     return r1.mpCurrent == r2.mpCurrent;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator!=(const typename basic_string<T, Allocator>::reverse_iterator& r1,
-      const typename basic_string<T, Allocator>::reverse_iterator& r2)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator!=(const typename basic_string<T, Allocator, Growth>::reverse_iterator& r1,
+      const typename basic_string<T, Allocator, Growth>::reverse_iterator& r2)
   {
     return r1.mpCurrent != r2.mpCurrent;
   }
 
 // Operator +
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
-    typedef typename basic_string<T, Allocator>::CtorDoNotInitialize CtorDoNotInitialize;
+    typedef typename basic_string<T, Allocator, Growth>::CtorDoNotInitialize CtorDoNotInitialize;
     CtorDoNotInitialize cDNI; // GCC 2.x forces us to declare a named temporary like this.
-    basic_string<T, Allocator> result(cDNI, a.size() + b.size(),
-        const_cast<basic_string<T, Allocator>&>(a).get_allocator()); // Note that we choose to assign a's allocator.
+    basic_string<T, Allocator, Growth> result(cDNI, a.size() + b.size(),
+        const_cast<basic_string<T, Allocator, Growth>&>(a).get_allocator()); // Note that we choose to assign a's allocator.
     result.append(a);
     result.append(b);
     return result;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(const typename basic_string<T, Allocator>::value_type* p,
-      const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(const typename basic_string<T, Allocator, Growth>::value_type* p,
+      const basic_string<T, Allocator, Growth>& b)
   {
-    typedef typename basic_string<T, Allocator>::CtorDoNotInitialize CtorDoNotInitialize;
+    typedef typename basic_string<T, Allocator, Growth>::CtorDoNotInitialize CtorDoNotInitialize;
     CtorDoNotInitialize cDNI; // GCC 2.x forces us to declare a named temporary like this.
-    const typename basic_string<T, Allocator>::size_type n =
-        (typename basic_string<T, Allocator>::size_type) CharStrlen(p);
-    basic_string<T, Allocator> result(cDNI, n + b.size(), const_cast<basic_string<T, Allocator>&>(b).get_allocator());
+    const typename basic_string<T, Allocator, Growth>::size_type n =
+        (typename basic_string<T, Allocator, Growth>::size_type) CharStrlen(p);
+    basic_string<T, Allocator, Growth> result(cDNI, n + b.size(), const_cast<basic_string<T, Allocator, Growth>&>(b).get_allocator());
     result.append(p, p + n);
     result.append(b);
     return result;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(typename basic_string<T, Allocator>::value_type c,
-      const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(typename basic_string<T, Allocator, Growth>::value_type c,
+      const basic_string<T, Allocator, Growth>& b)
   {
-    typedef typename basic_string<T, Allocator>::CtorDoNotInitialize CtorDoNotInitialize;
+    typedef typename basic_string<T, Allocator, Growth>::CtorDoNotInitialize CtorDoNotInitialize;
     CtorDoNotInitialize cDNI; // GCC 2.x forces us to declare a named temporary like this.
-    basic_string<T, Allocator> result(cDNI, 1 + b.size(), const_cast<basic_string<T, Allocator>&>(b).get_allocator());
+    basic_string<T, Allocator, Growth> result(cDNI, 1 + b.size(), const_cast<basic_string<T, Allocator, Growth>&>(b).get_allocator());
     result.push_back(c);
     result.append(b);
     return result;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(const basic_string<T, Allocator>& a,
-      const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(const basic_string<T, Allocator, Growth>& a,
+      const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
-    typedef typename basic_string<T, Allocator>::CtorDoNotInitialize CtorDoNotInitialize;
+    typedef typename basic_string<T, Allocator, Growth>::CtorDoNotInitialize CtorDoNotInitialize;
     CtorDoNotInitialize cDNI; // GCC 2.x forces us to declare a named temporary like this.
-    const typename basic_string<T, Allocator>::size_type n =
-        (typename basic_string<T, Allocator>::size_type) CharStrlen(p);
-    basic_string<T, Allocator> result(cDNI, a.size() + n, const_cast<basic_string<T, Allocator>&>(a).get_allocator());
+    const typename basic_string<T, Allocator, Growth>::size_type n =
+        (typename basic_string<T, Allocator, Growth>::size_type) CharStrlen(p);
+    basic_string<T, Allocator, Growth> result(cDNI, a.size() + n, const_cast<basic_string<T, Allocator, Growth>&>(a).get_allocator());
     result.append(a);
     result.append(p, p + n);
     return result;
   }
 
-  template<typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(const basic_string<T, Allocator>& a,
-      typename basic_string<T, Allocator>::value_type c)
+  template<typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(const basic_string<T, Allocator, Growth>& a,
+      typename basic_string<T, Allocator, Growth>::value_type c)
   {
-    typedef typename basic_string<T, Allocator>::CtorDoNotInitialize CtorDoNotInitialize;
+    typedef typename basic_string<T, Allocator, Growth>::CtorDoNotInitialize CtorDoNotInitialize;
     CtorDoNotInitialize cDNI; // GCC 2.x forces us to declare a named temporary like this.
-    basic_string<T, Allocator> result(cDNI, a.size() + 1, const_cast<basic_string<T, Allocator>&>(a).get_allocator());
+    basic_string<T, Allocator, Growth> result(cDNI, a.size() + 1, const_cast<basic_string<T, Allocator, Growth>&>(a).get_allocator());
     result.append(a);
     result.push_back(c);
     return result;
   }
 
 #if FLEX_HAS_CXX11
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(basic_string<T, Allocator>&& a, basic_string<T, Allocator>&& b)
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(basic_string<T, Allocator, Growth>&& a, basic_string<T, Allocator, Growth>&& b)
   {
     a.append(b); // Using an rvalue by name results in it becoming an lvalue.
     return a;
   }
 
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(basic_string<T, Allocator>&& a, const basic_string<T, Allocator>& b)
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(basic_string<T, Allocator, Growth>&& a, const basic_string<T, Allocator, Growth>& b)
   {
     a.append(b);
     return a;
   }
 
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(const typename basic_string<T, Allocator>::value_type* p, basic_string<T, Allocator>&& b)
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(const typename basic_string<T, Allocator, Growth>::value_type* p, basic_string<T, Allocator, Growth>&& b)
   {
     b.insert(0, p);
     return b;
   }
 
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(basic_string<T, Allocator>&& a, const typename basic_string<T, Allocator>::value_type* p)
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(basic_string<T, Allocator, Growth>&& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
     a.append(p);
     return a;
   }
 
-  template <typename T, typename Allocator>
-  basic_string<T, Allocator> operator+(basic_string<T, Allocator>&& a, typename basic_string<T, Allocator>::value_type c)
+  template <typename T, typename Allocator, typename Growth>
+  basic_string<T, Allocator, Growth> operator+(basic_string<T, Allocator, Growth>&& a, typename basic_string<T, Allocator, Growth>::value_type c)
   {
     a.push_back(c);
     return a;
   }
 #endif
 
-  template<typename T, typename Allocator>
-  inline bool basic_string<T, Allocator>::validate() const FLEX_NOEXCEPT
+  template<typename T, typename Allocator, typename Growth>
+  inline bool basic_string<T, Allocator, Growth>::validate() const FLEX_NOEXCEPT
   {
     if ((mBegin == NULL) || (mEnd == NULL))
       return false;
@@ -2564,126 +2627,126 @@ namespace flex
 ///////////////////////////////////////////////////////////////////////
 
 // Operator== and operator!=
-  template<typename T, typename Allocator>
-  inline bool operator==(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator==(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
     return ((a.size() == b.size())
-        && (memcmp(a.data(), b.data(), (size_t) a.size() * sizeof(typename basic_string<T, Allocator>::value_type)) == 0));
+        && (memcmp(a.data(), b.data(), (size_t) a.size() * sizeof(typename basic_string<T, Allocator, Growth>::value_type)) == 0));
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator==(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator==(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
-    typedef typename basic_string<T, Allocator>::size_type size_type;
+    typedef typename basic_string<T, Allocator, Growth>::size_type size_type;
     const size_type n = (size_type) CharStrlen(p);
     return ((n == b.size()) && (memcmp(p, b.data(), (size_t) n * sizeof(*p)) == 0));
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator==(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator==(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
-    typedef typename basic_string<T, Allocator>::size_type size_type;
+    typedef typename basic_string<T, Allocator, Growth>::size_type size_type;
     const size_type n = (size_type) CharStrlen(p);
     return ((a.size() == n) && (memcmp(a.data(), p, (size_t) n * sizeof(*p)) == 0));
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator!=(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator!=(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
     return !(a == b);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator!=(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator!=(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
     return !(p == b);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator!=(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator!=(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
     return !(a == p);
   }
 
 // Operator< (and also >, <=, and >=).
-  template<typename T, typename Allocator>
-  inline bool operator<(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
-    return basic_string<T, Allocator>::compare(a.begin(), a.end(), b.begin(), b.end()) < 0;
+    return basic_string<T, Allocator, Growth>::compare(a.begin(), a.end(), b.begin(), b.end()) < 0;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator<(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
-    typedef typename basic_string<T, Allocator>::size_type size_type;
+    typedef typename basic_string<T, Allocator, Growth>::size_type size_type;
     const size_type n = (size_type) CharStrlen(p);
-    return basic_string<T, Allocator>::compare(p, p + n, b.begin(), b.end()) < 0;
+    return basic_string<T, Allocator, Growth>::compare(p, p + n, b.begin(), b.end()) < 0;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator<(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
-    typedef typename basic_string<T, Allocator>::size_type size_type;
+    typedef typename basic_string<T, Allocator, Growth>::size_type size_type;
     const size_type n = (size_type) CharStrlen(p);
-    return basic_string<T, Allocator>::compare(a.begin(), a.end(), p, p + n) < 0;
+    return basic_string<T, Allocator, Growth>::compare(a.begin(), a.end(), p, p + n) < 0;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
     return b < a;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
     return b < p;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
     return p < a;
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator<=(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<=(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
     return !(b < a);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator<=(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<=(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
     return !(b < p);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator<=(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator<=(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
     return !(p < a);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>=(const basic_string<T, Allocator>& a, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>=(const basic_string<T, Allocator, Growth>& a, const basic_string<T, Allocator, Growth>& b)
   {
     return !(a < b);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>=(const typename basic_string<T, Allocator>::value_type* p, const basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>=(const typename basic_string<T, Allocator, Growth>::value_type* p, const basic_string<T, Allocator, Growth>& b)
   {
     return !(p < b);
   }
 
-  template<typename T, typename Allocator>
-  inline bool operator>=(const basic_string<T, Allocator>& a, const typename basic_string<T, Allocator>::value_type* p)
+  template<typename T, typename Allocator, typename Growth>
+  inline bool operator>=(const basic_string<T, Allocator, Growth>& a, const typename basic_string<T, Allocator, Growth>::value_type* p)
   {
     return !(a < p);
   }
 
-  template<typename T, typename Allocator>
-  inline void swap(basic_string<T, Allocator>& a, basic_string<T, Allocator>& b)
+  template<typename T, typename Allocator, typename Growth>
+  inline void swap(basic_string<T, Allocator, Growth>& a, basic_string<T, Allocator, Growth>& b)
   {
     a.swap(b);
   }
@@ -0,0 +1,440 @@
+#ifndef FLEX_TIMER_WHEEL_H
+#define FLEX_TIMER_WHEEL_H
+
+#include <flex/fixed_pool.h>
+#include <flex/internal/list_iterator.h>
+
+#include <stdint.h>
+
+namespace flex
+{
+
+  //A node of a timer_wheel.  The list links chain the timers that share a slot.  mSerial is zero once the timer
+  //has fired or been cancelled, so a stale handle never matches the node.
+  template<class T>
+  struct timer_wheel_node: public list_node<T>
+  {
+    uint64_t mExpires;
+    uint64_t mSerial;
+  };
+
+  //A handle to a timer scheduled on a timer_wheel.  Every timer is given a new serial number, so the handle of a
+  //timer that has fired or been cancelled stops matching its node even after the node is reused.
+  struct timer_wheel_handle
+  {
+    void* mNode;
+    uint64_t mSerial;
+
+    timer_wheel_handle() :
+        mNode(NULL), mSerial(0)
+    {
+    }
+
+    timer_wheel_handle(void* node, uint64_t serial) :
+        mNode(node), mSerial(serial)
+    {
+    }
+  };
+
+  inline bool operator==(const timer_wheel_handle& lhs, const timer_wheel_handle& rhs)
+  {
+    return (lhs.mNode == rhs.mNode) && (lhs.mSerial == rhs.mSerial);
+  }
+
+  inline bool operator!=(const timer_wheel_handle& lhs, const timer_wheel_handle& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //The default expiry handler of a timer_wheel, which ignores expired timers.
+  struct timer_wheel_no_expiry
+  {
+    template<class T>
+    void operator()(T&) const
+    {
+    }
+  };
+
+  //A hierarchical timer wheel of up to N timers, each carrying a Payload.  Time advances in whole ticks.  The
+  //wheel has LEVELS levels of SLOTS slots, and each level's slots span SLOTS times as many ticks as the level
+  //below.  A timer is chained into the slot of the lowest level that covers its delay, and as the lower levels
+  //wrap around, the next slot up is cascaded: its timers are moved down to the level that now covers them.
+  //schedule() and cancel() link and unlink a single node, and each timer is cascaded at most LEVELS - 1 times,
+  //so both they and tick() cost O(1) per timer however many timers are pending.
+  //
+  //Each tick() detaches the whole slot that is due and hands every timer in it to ExpiryHandler in the order
+  //they were scheduled, or last rescheduled.  Cascaded timers are placed ahead of those already in the slot
+  //they move to, which were all scheduled later.  A handler may schedule and cancel timers, but must not tick
+  //the wheel and must not throw: the rest of the detached slot is held in a list local to tick(), which an
+  //exception would leave the remaining timers linked to.  Once its handler starts, a timer is no longer
+  //pending and cancelling it does nothing.
+  //
+  //Timer nodes come from a fixed_pool held in the wheel, so nothing is allocated after construction.  As with
+  //the fixed containers, scheduling more than N timers reports an error and falls back to the heap.  The wheel
+  //holds N nodes and LEVELS * SLOTS list heads, so a large wheel should be static or allocated once.  Delays up
+  //to 2^32 - 1 ticks are exact, and longer ones are parked in the top level until they come within range.
+  template<class Payload, size_t N, class ExpiryHandler = timer_wheel_no_expiry>
+  class timer_wheel: public guarded_object
+  {
+  public:
+    typedef timer_wheel<Payload, N, ExpiryHandler> this_type;
+
+    typedef Payload value_type;
+    typedef Payload* pointer;
+    typedef const Payload* const_pointer;
+    typedef Payload& reference;
+    typedef const Payload& const_reference;
+    typedef timer_wheel_node<Payload> node_type;
+    typedef timer_wheel_handle handle_type;
+    typedef size_t size_type;
+    typedef uint64_t tick_type;
+    typedef ExpiryHandler expiry_handler_type;
+
+    static const size_t SLOT_BITS = 8;
+    static const size_t SLOTS = 1 << SLOT_BITS;
+    static const size_t LEVELS = 4;
+
+    explicit timer_wheel(const ExpiryHandler& on_expire = ExpiryHandler());
+    ~timer_wheel();
+
+    size_type advance(tick_type ticks);
+    bool cancel(const handle_type& handle);
+    size_type capacity() const;
+    void clear();
+    bool empty() const;
+    tick_type expires(const handle_type& handle) const;
+    pointer get(const handle_type& handle);
+    const_pointer get(const handle_type& handle) const;
+    expiry_handler_type& get_expiry_handler();
+    size_type max_size() const;
+    tick_type now() const;
+    bool pending(const handle_type& handle) const;
+    bool reschedule(const handle_type& handle, tick_type delay);
+    handle_type schedule(tick_type delay, const value_type& val);
+#ifdef FLEX_HAS_CXX11
+    handle_type schedule(tick_type delay, value_type&& val);
+#endif
+    size_type size() const;
+    size_type tick();
+
+  protected:
+    void Cascade(size_t level, size_t index);
+    node_type* Find(const handle_type& handle) const;
+    void Link(node_type* node);
+    void Release(node_type* node);
+    list_node_base* Slot(const node_type* node);
+
+    list_node_base mSlots[LEVELS][SLOTS];
+    tick_type mNow;
+    uint64_t mSerial;
+    size_type mSize;
+    ExpiryHandler mOnExpire;
+    fixed_pool<node_type, N> mPool;
+
+  private:
+    //The slot heads point at themselves, so a wheel can be neither copied nor assigned.
+    timer_wheel(const this_type& obj);
+    this_type& operator=(const this_type& obj);
+  };
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  const size_t timer_wheel<Payload, N, ExpiryHandler>::SLOT_BITS;
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  const size_t timer_wheel<Payload, N, ExpiryHandler>::SLOTS;
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  const size_t timer_wheel<Payload, N, ExpiryHandler>::LEVELS;
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline timer_wheel<Payload, N, ExpiryHandler>::timer_wheel(const ExpiryHandler& on_expire) :
+      mNow(0), mSerial(0), mSize(0), mOnExpire(on_expire)
+  {
+    for (size_t level = 0; level < LEVELS; ++level)
+    {
+      for (size_t i = 0; i < SLOTS; ++i)
+      {
+        mSlots[level][i].mNext = mSlots[level][i].mPrev = &mSlots[level][i];
+      }
+    }
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline timer_wheel<Payload, N, ExpiryHandler>::~timer_wheel()
+  {
+    clear();
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::size_type timer_wheel<Payload, N, ExpiryHandler>::advance(
+      tick_type ticks)
+  {
+    size_type expired = 0;
+    for (; ticks > 0; --ticks)
+    {
+      expired += tick();
+    }
+    return expired;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline bool timer_wheel<Payload, N, ExpiryHandler>::cancel(const handle_type& handle)
+  {
+    node_type* const node = Find(handle);
+    if (node)
+    {
+      node->remove();
+      Release(node);
+      return true;
+    }
+    return false;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::size_type timer_wheel<Payload, N, ExpiryHandler>::capacity() const
+  {
+    return N;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline void timer_wheel<Payload, N, ExpiryHandler>::clear()
+  {
+    //Cancels every pending timer without calling the expiry handler.
+    for (size_t level = 0; (level < LEVELS) && mSize; ++level)
+    {
+      for (size_t i = 0; i < SLOTS; ++i)
+      {
+        list_node_base* const slot = &mSlots[level][i];
+        while (slot->mNext != slot)
+        {
+          node_type* const node = static_cast<node_type*>(slot->mNext);
+          node->remove();
+          Release(node);
+        }
+      }
+    }
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline bool timer_wheel<Payload, N, ExpiryHandler>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::tick_type timer_wheel<Payload, N, ExpiryHandler>::expires(
+      const handle_type& handle) const
+  {
+    const node_type* const node = Find(handle);
+    return node ? node->mExpires : 0;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::pointer timer_wheel<Payload, N, ExpiryHandler>::get(
+      const handle_type& handle)
+  {
+    node_type* const node = Find(handle);
+    return node ? &node->mValue : NULL;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::const_pointer timer_wheel<Payload, N, ExpiryHandler>::get(
+      const handle_type& handle) const
+  {
+    const node_type* const node = Find(handle);
+    return node ? &node->mValue : NULL;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::expiry_handler_type& timer_wheel<Payload, N, ExpiryHandler>::get_expiry_handler()
+  {
+    return mOnExpire;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::size_type timer_wheel<Payload, N, ExpiryHandler>::max_size() const
+  {
+    return N;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::tick_type timer_wheel<Payload, N, ExpiryHandler>::now() const
+  {
+    return mNow;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline bool timer_wheel<Payload, N, ExpiryHandler>::pending(const handle_type& handle) const
+  {
+    return (Find(handle) != NULL);
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline bool timer_wheel<Payload, N, ExpiryHandler>::reschedule(const handle_type& handle, tick_type delay)
+  {
+    //Moves a pending timer to expire delay ticks from now, keeping its handle and payload.
+    node_type* const node = Find(handle);
+    if (node)
+    {
+      node->remove();
+      node->mExpires = mNow + (delay ? delay : 1);
+      Link(node);
+      return true;
+    }
+    return false;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::handle_type timer_wheel<Payload, N, ExpiryHandler>::schedule(
+      tick_type delay, const value_type& val)
+  {
+    //A delay of zero expires on the next tick, as there is no earlier tick left to expire on.
+    node_type* const node = (node_type*) mPool.allocate();
+    new ((void*) &node->mValue) value_type(val);
+    node->mExpires = mNow + (delay ? delay : 1);
+    node->mSerial = ++mSerial;
+    Link(node);
+    ++mSize;
+    return handle_type(node, node->mSerial);
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::handle_type timer_wheel<Payload, N, ExpiryHandler>::schedule(
+      tick_type delay, value_type&& val)
+  {
+    node_type* const node = (node_type*) mPool.allocate();
+    new ((void*) &node->mValue) value_type(std::move(val));
+    node->mExpires = mNow + (delay ? delay : 1);
+    node->mSerial = ++mSerial;
+    Link(node);
+    ++mSize;
+    return handle_type(node, node->mSerial);
+  }
+#endif
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::size_type timer_wheel<Payload, N, ExpiryHandler>::size() const
+  {
+    return mSize;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::size_type timer_wheel<Payload, N, ExpiryHandler>::tick()
+  {
+    ++mNow;
+
+    //When a level wraps around, the next level's current slot comes within range of the levels below it.
+    const size_t index = (size_t) (mNow & (SLOTS - 1));
+    if (index == 0)
+    {
+      for (size_t level = 1; level < LEVELS; ++level)
+      {
+        const size_t upper = (size_t) ((mNow >> (level * SLOT_BITS)) & (SLOTS - 1));
+        Cascade(level, upper);
+        if (upper != 0)
+        {
+          break;
+        }
+      }
+    }
+
+    //Detach the due slot first, so timers the handler schedules for the next wrap of the wheel land in the
+    //now-empty slot rather than in this batch.
+    list_node_base* const slot = &mSlots[0][index];
+    if (slot->mNext == slot)
+    {
+      return 0;
+    }
+    //The handler must not throw, or the timers left in the batch would stay linked to this stack frame.
+    list_node_base batch;
+    batch.mNext = batch.mPrev = &batch;
+    batch.splice(slot->mNext, slot);
+
+    size_type expired = 0;
+    while (batch.mNext != &batch)
+    {
+      node_type* const node = static_cast<node_type*>(batch.mNext);
+      node->remove();
+      node->mSerial = 0;
+      mOnExpire(node->mValue);
+      node->mValue.~value_type();
+      mPool.deallocate(node);
+      --mSize;
+      ++expired;
+    }
+    return expired;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline void timer_wheel<Payload, N, ExpiryHandler>::Cascade(size_t level, size_t index)
+  {
+    //Moves every timer in the slot down to the level that covers what is left of its delay.  A timer that is
+    //cascaded was scheduled before any timer linked directly into the slot it moves to, so the timers are
+    //taken from the back and each is put at the front of its new slot, which keeps every slot in the order
+    //its timers were scheduled.
+    list_node_base* const slot = &mSlots[level][index];
+    if (slot->mNext == slot)
+    {
+      return;
+    }
+    list_node_base moved;
+    moved.mNext = moved.mPrev = &moved;
+    moved.splice(slot->mNext, slot);
+    while (moved.mPrev != &moved)
+    {
+      node_type* const node = static_cast<node_type*>(moved.mPrev);
+      node->remove();
+      node->insert(Slot(node)->mNext);
+    }
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline typename timer_wheel<Payload, N, ExpiryHandler>::node_type* timer_wheel<Payload, N, ExpiryHandler>::Find(
+      const handle_type& handle) const
+  {
+    //The node memory stays in the pool after a timer is released, so reading its serial is always safe.
+    node_type* const node = (node_type*) handle.mNode;
+    return (node && (handle.mSerial != 0) && (node->mSerial == handle.mSerial)) ? node : NULL;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline void timer_wheel<Payload, N, ExpiryHandler>::Link(node_type* node)
+  {
+    //Chains the node at the back of its slot.
+    node->insert(Slot(node));
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline void timer_wheel<Payload, N, ExpiryHandler>::Release(node_type* node)
+  {
+    //Destroys the payload of an unlinked timer and returns its node to the pool.
+    node->mSerial = 0;
+    node->mValue.~value_type();
+    mPool.deallocate(node);
+    --mSize;
+  }
+
+  template<class Payload, size_t N, class ExpiryHandler>
+  inline list_node_base* timer_wheel<Payload, N, ExpiryHandler>::Slot(const node_type* node)
+  {
+    //Returns the slot of the lowest level whose span covers the node's delay.  Delays past the top level are
+    //parked in its furthest slot and placed again when that slot cascades.
+    const tick_type delay = node->mExpires - mNow;
+    size_t level = 0;
+    while ((level < LEVELS - 1) && (delay >> ((level + 1) * SLOT_BITS)))
+    {
+      ++level;
+    }
+    tick_type expires = node->mExpires;
+    if (delay >> (LEVELS * SLOT_BITS))
+    {
+      expires = mNow + ((tick_type(1) << (LEVELS * SLOT_BITS)) - 1);
+    }
+    const size_t index = (size_t) ((expires >> (level * SLOT_BITS)) & (SLOTS - 1));
+    return &mSlots[level][index];
+  }
+
+} //namespace flex
+
+#endif /* FLEX_TIMER_WHEEL_H */
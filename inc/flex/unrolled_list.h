@@ -0,0 +1,993 @@
+#ifndef FLEX_UNROLLED_LIST_H
+#define FLEX_UNROLLED_LIST_H
+
+#include <flex/pool.h>
+#include <flex/initializer_list.h>
+#include <flex/internal/relocate.h>
+#include <flex/internal/unrolled_list_iterator.h>
+
+#include <algorithm>
+
+namespace flex
+{
+
+  //An unrolled_list is a doubly linked list of chunks, each holding up to K elements in an array.  Traversal
+  //walks the array of each chunk before following a link, so it takes roughly one cache miss per chunk
+  //rather than one per element.  Chunks are taken from a pool.
+  //
+  //Inserting into a chunk shifts the elements after the position within that chunk; a full chunk is first
+  //split in half with a new chunk.  Erasing shifts the remainder of the chunk down.  Every chunk but the first
+  //and last is kept at least half full: one that falls below half is merged with a neighbour when they fit
+  //together, and otherwise takes elements from it.  The first and last chunks are merged once a quarter full
+  //or less.  Both are O(K) regardless of the size of the list.  An insertion or erasure invalidates iterators
+  //and references to the elements of the chunks it touches; elements in every other chunk are unaffected.
+  //
+  //Alloc allocates the chunks.  Like pool, it is an allocator of pool nodes (see node_type).
+  template<class T, size_t K = unrolled_list_default_size<T>::value,
+      class Alloc = allocator<typename pool<unrolled_list_chunk<T, K> >::node_type> >
+  class unrolled_list: public guarded_object
+  {
+  public:
+    typedef unrolled_list<T, K, Alloc> this_type;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef unrolled_list_chunk<T, K> chunk_type;
+    typedef unrolled_list_iterator<T, K, T*, T&> iterator;
+    typedef unrolled_list_iterator<T, K, const T*, const T&> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Alloc allocator_type;
+    typedef pool<chunk_type, Alloc> pool_type;
+    typedef typename pool_type::node_type node_type;
+
+#ifdef FLEX_HAS_CXX11
+    static_assert(K >= 2, "flex::unrolled_list requires at least 2 elements per chunk");
+#endif
+
+    unrolled_list();
+    explicit unrolled_list(size_type size, const value_type& val = value_type());
+    unrolled_list(int size, const value_type& val);
+    template<typename InputIterator> unrolled_list(InputIterator first, InputIterator last);
+    unrolled_list(const unrolled_list<T, K, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    unrolled_list(unrolled_list<T, K, Alloc>&& obj);
+#endif
+    unrolled_list(std::initializer_list<value_type> il);
+    ~unrolled_list();
+
+    void assign(size_type size, const_reference val);
+    void assign(int size, const_reference val);
+    template<typename InputIterator> void assign(InputIterator first, InputIterator last);
+    void assign(std::initializer_list<value_type> il);
+    reference back();
+    const_reference back() const;
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    size_type chunk_count() const;
+    void clear();
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+#ifdef FLEX_HAS_CXX11
+    template<class...Args> iterator emplace(iterator position, Args&&... val);
+    template<class...Args> void emplace_back(Args&&... val);
+    template<class...Args> void emplace_front(Args&&... val);
+#endif
+    bool empty() const;
+    iterator end();
+    const_iterator end() const;
+    iterator erase(iterator position);
+    iterator erase(iterator first, iterator last);
+    bool fixed() const;
+    reference front();
+    const_reference front() const;
+    iterator insert(iterator position, const_reference val);
+#ifdef FLEX_HAS_CXX11
+    iterator insert(iterator position, value_type&& val);
+#endif
+    void insert(iterator position, size_type n, const_reference val);
+    void insert(iterator position, int n, const_reference val);
+    template<typename InputIterator> void insert(iterator position, InputIterator first, InputIterator last);
+    size_type max_size() const;
+    unrolled_list<T, K, Alloc>& operator=(const unrolled_list<T, K, Alloc>& obj);
+#ifdef FLEX_HAS_CXX11
+    unrolled_list<T, K, Alloc>& operator=(unrolled_list<T, K, Alloc>&& obj);
+#endif
+    unrolled_list<T, K, Alloc>& operator=(std::initializer_list<value_type> il);
+    void pop_back();
+    void pop_front();
+    void push_back(const_reference val);
+    void push_front(const_reference val);
+#ifdef FLEX_HAS_CXX11
+    void push_back(value_type&& val);
+    void push_front(value_type&& val);
+#endif
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+    void remove(const value_type& val);
+    template<typename Predicate> void remove_if(Predicate pred);
+    void resize(size_type n, const value_type& val = value_type());
+    size_type size() const;
+    void swap(unrolled_list<T, K, Alloc>& obj);
+
+  protected:
+    //pool only lets derived classes supply a fixed buffer, so fixed_unrolled_list reaches it through this.
+    struct chunk_pool: public pool_type
+    {
+      chunk_pool();
+      chunk_pool(node_type* first, node_type* last);
+
+      bool fixed() const;
+      void ReleaseOverflow(node_type* first, node_type* last);
+    };
+
+    //Predicate for remove().  It holds a copy, since the value passed in may be an element of the list.
+    struct equal_to_value
+    {
+      explicit equal_to_value(const value_type& val) :
+          mValue(val)
+      {
+      }
+
+      bool operator()(const value_type& x) const
+      {
+        return (x == mValue);
+      }
+
+      value_type mValue;
+    };
+
+    unrolled_list(node_type* first, node_type* last);
+
+    static pointer Values(list_node_base* node);
+    chunk_type* AllocateChunk(list_node_base* position);
+    void Balance(chunk_type* left, chunk_type* right);
+    void FreeChunk(chunk_type* chunk);
+    iterator InsertSlot(iterator position);
+    chunk_type* MergeIntoPrevious(chunk_type* chunk);
+    iterator Rebalance(chunk_type* chunk, size_type index);
+
+    //See list::mAnchor.  The anchor is never dereferenced as a chunk.
+    list_node_base mAnchor;
+    size_type mSize;
+    chunk_pool mPool;
+  };
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::chunk_pool::chunk_pool() :
+      pool_type()
+  {
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::chunk_pool::chunk_pool(node_type* first, node_type* last) :
+      pool_type(first, last)
+  {
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool unrolled_list<T, K, Alloc>::chunk_pool::fixed() const
+  {
+    return this->mFixed;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::chunk_pool::ReleaseOverflow(node_type* first, node_type* last)
+  {
+    //Matches ~fixed_pool().  Chunks outside [first, last) were allocated after the buffer ran out.
+#ifndef FLEX_RELEASE
+    if (FLEX_UNLIKELY(this->mOverflow))
+    {
+      while (this->mHead)
+      {
+        node_type* ptr = (node_type*) this->allocate();
+        if ((ptr < first) || (ptr >= last))
+        {
+          this->mAllocator.deallocate(ptr, 1);
+        }
+      }
+    }
+#endif
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list() :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(size_type size, const value_type& val) :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    insert(end(), size, val);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(int size, const value_type& val) :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    insert(end(), (size_type) size, val);
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<typename InputIterator>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(InputIterator first, InputIterator last) :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    insert(end(), first, last);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(const unrolled_list<T, K, Alloc>& obj) :
+      guarded_object(), mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    insert(end(), obj.begin(), obj.end());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(unrolled_list<T, K, Alloc>&& obj) :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    swap(obj);
+  }
+#endif
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(std::initializer_list<value_type> il) :
+      mSize(0), mPool()
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    insert(end(), il.begin(), il.end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::~unrolled_list()
+  {
+    clear();
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::assign(size_type n, const_reference val)
+  {
+    iterator it = begin();
+    for (; (n > 0) && (it != end()); --n, ++it)
+    {
+      *it = val;
+    }
+
+    if (n)
+    {
+      insert(end(), n, val);
+    }
+    else
+    {
+      erase(it, end());
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::assign(int n, const_reference val)
+  {
+    //Prevents the templated assign() from being chosen when n and val are both int.
+    assign((size_type) n, val);
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<typename InputIterator>
+  inline void unrolled_list<T, K, Alloc>::assign(InputIterator first, InputIterator last)
+  {
+    iterator it = begin();
+    for (; (first != last) && (it != end()); ++first, ++it)
+    {
+      *it = *first;
+    }
+
+    if (first != last)
+    {
+      insert(end(), first, last);
+    }
+    else
+    {
+      erase(it, end());
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::assign(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::reference unrolled_list<T, K, Alloc>::back()
+  {
+    return Values(mAnchor.mPrev)[static_cast<chunk_type*>(mAnchor.mPrev)->mCount - 1];
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reference unrolled_list<T, K, Alloc>::back() const
+  {
+    return Values(mAnchor.mPrev)[static_cast<chunk_type*>(mAnchor.mPrev)->mCount - 1];
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::begin()
+  {
+    return iterator(mAnchor.mNext, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_iterator unrolled_list<T, K, Alloc>::begin() const
+  {
+    return const_iterator(mAnchor.mNext, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_iterator unrolled_list<T, K, Alloc>::cbegin() const
+  {
+    return const_iterator(mAnchor.mNext, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_iterator unrolled_list<T, K, Alloc>::cend() const
+  {
+    return const_iterator(&mAnchor, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::size_type unrolled_list<T, K, Alloc>::chunk_count() const
+  {
+    size_type n = 0;
+    for (const list_node_base* node = mAnchor.mNext; node != &mAnchor; node = node->mNext)
+    {
+      ++n;
+    }
+    return n;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::clear()
+  {
+    list_node_base* node = mAnchor.mNext;
+    while (node != &mAnchor)
+    {
+      chunk_type* const chunk = static_cast<chunk_type*>(node);
+      node = node->mNext;
+      flex::destruct_range(Values(chunk), Values(chunk) + chunk->mCount);
+      mPool.deallocate(chunk);
+    }
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+    mSize = 0;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reverse_iterator unrolled_list<T, K, Alloc>::crbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reverse_iterator unrolled_list<T, K, Alloc>::crend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t K, class Alloc>
+  template<class...Args>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::emplace(iterator position,
+      Args&&... args)
+  {
+    iterator it = InsertSlot(position);
+    new ((void*) &*it) value_type(std::forward<Args>(args)...);
+    return it;
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<class...Args>
+  inline void unrolled_list<T, K, Alloc>::emplace_back(Args&&... args)
+  {
+    emplace(end(), std::forward<Args>(args)...);
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<class...Args>
+  inline void unrolled_list<T, K, Alloc>::emplace_front(Args&&... args)
+  {
+    emplace(begin(), std::forward<Args>(args)...);
+  }
+#endif
+
+  template<class T, size_t K, class Alloc>
+  inline bool unrolled_list<T, K, Alloc>::empty() const
+  {
+    return (mSize == 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::end()
+  {
+    return iterator(&mAnchor, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_iterator unrolled_list<T, K, Alloc>::end() const
+  {
+    return const_iterator(&mAnchor, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::erase(iterator position)
+  {
+    chunk_type* const chunk = static_cast<chunk_type*>(position.mNode);
+    const pointer values = Values(chunk);
+    std::copy(FLEX_MOVE_ITERATOR(values + position.mIndex + 1), FLEX_MOVE_ITERATOR(values + chunk->mCount),
+        values + position.mIndex);
+    values[--chunk->mCount].~value_type();
+    --mSize;
+    return Rebalance(chunk, position.mIndex);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::erase(iterator first,
+      iterator last)
+  {
+    //last is invalidated as soon as its chunk is shifted, so the range is counted up front and removed a
+    //chunk at a time.
+    size_type n = (size_type) std::distance(first, last);
+    list_node_base* node = first.mNode;
+    size_type index = first.mIndex;
+    chunk_type* head = NULL;
+    while (n)
+    {
+      chunk_type* const chunk = static_cast<chunk_type*>(node);
+      const pointer values = Values(chunk);
+      const size_type m = std::min(n, chunk->mCount - index);
+      std::copy(FLEX_MOVE_ITERATOR(values + index + m), FLEX_MOVE_ITERATOR(values + chunk->mCount),
+          values + index);
+      flex::destruct_range(values + chunk->mCount - m, values + chunk->mCount);
+      chunk->mCount -= m;
+      mSize -= m;
+      n -= m;
+
+      if (chunk->mCount == 0)
+      {
+        node = node->mNext;
+        FreeChunk(chunk);
+      }
+      else if (index == chunk->mCount)
+      {
+        head = chunk;
+        node = node->mNext;
+        index = 0;
+      }
+    }
+
+    //Only the chunk the range started in and the one it ended in can be left sparse.  If they differ, they are
+    //now neighbours, and are merged or balanced with each other.
+    if (!head)
+    {
+      return (node == &mAnchor) ? end() : Rebalance(static_cast<chunk_type*>(node), index);
+    }
+    const size_type count = head->mCount;
+    if (node == &mAnchor)
+    {
+      return Rebalance(head, count);
+    }
+    chunk_type* const tail = static_cast<chunk_type*>(node);
+    if (count + tail->mCount <= K)
+    {
+      MergeIntoPrevious(tail);
+      return Rebalance(head, count);
+    }
+    Balance(head, tail);
+    return (count < head->mCount) ? iterator(head, count) : iterator(tail, count - head->mCount);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool unrolled_list<T, K, Alloc>::fixed() const
+  {
+    return mPool.fixed();
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::reference unrolled_list<T, K, Alloc>::front()
+  {
+    return Values(mAnchor.mNext)[0];
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reference unrolled_list<T, K, Alloc>::front() const
+  {
+    return Values(mAnchor.mNext)[0];
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::insert(iterator position,
+      const_reference val)
+  {
+    //Handle the case in which val is an element of the chunk that is about to be shifted or split.
+    if (position.mNode != &mAnchor)
+    {
+      const_pointer values = Values(position.mNode);
+      if ((&val >= values) && (&val < values + K))
+      {
+        const value_type tmp(val);
+        iterator it = InsertSlot(position);
+        new ((void*) &*it) value_type(tmp);
+        return it;
+      }
+    }
+
+    iterator it = InsertSlot(position);
+    new ((void*) &*it) value_type(val);
+    return it;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::insert(iterator position,
+      value_type&& val)
+  {
+    iterator it = InsertSlot(position);
+    new ((void*) &*it) value_type(std::move(val));
+    return it;
+  }
+#endif
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::insert(iterator position, size_type n, const_reference val)
+  {
+    //Each insertion may shift or split the chunk, so continue from the iterator it returns.
+    for (; n > 0; --n)
+    {
+      position = insert(position, val);
+      ++position;
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::insert(iterator position, int n, const_reference val)
+  {
+    //Prevents the templated insert() from being chosen when n and val are both int.
+    insert(position, (size_type) n, val);
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<typename InputIterator>
+  inline void unrolled_list<T, K, Alloc>::insert(iterator position, InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+    {
+      position = insert(position, *first);
+      ++position;
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::size_type unrolled_list<T, K, Alloc>::max_size() const
+  {
+    return (size_type) -1 / sizeof(chunk_type) * K;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>& unrolled_list<T, K, Alloc>::operator=(const unrolled_list<T, K, Alloc>& obj)
+  {
+    if (this != &obj)
+    {
+      assign(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>& unrolled_list<T, K, Alloc>::operator=(unrolled_list<T, K, Alloc>&& obj)
+  {
+    if (this != &obj)
+    {
+      clear();
+      swap(obj);
+    }
+    return *this;
+  }
+#endif
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>& unrolled_list<T, K, Alloc>::operator=(std::initializer_list<value_type> il)
+  {
+    assign(il.begin(), il.end());
+    return *this;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::pop_back()
+  {
+    erase(--end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::pop_front()
+  {
+    erase(begin());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::push_back(const_reference val)
+  {
+    insert(end(), val);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::push_front(const_reference val)
+  {
+    insert(begin(), val);
+  }
+
+#ifdef FLEX_HAS_CXX11
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::push_back(value_type&& val)
+  {
+    insert(end(), std::move(val));
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::push_front(value_type&& val)
+  {
+    insert(begin(), std::move(val));
+  }
+#endif
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::reverse_iterator unrolled_list<T, K, Alloc>::rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reverse_iterator unrolled_list<T, K, Alloc>::rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::reverse_iterator unrolled_list<T, K, Alloc>::rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::const_reverse_iterator unrolled_list<T, K, Alloc>::rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::remove(const value_type& val)
+  {
+    remove_if(equal_to_value(val));
+  }
+
+  template<class T, size_t K, class Alloc>
+  template<typename Predicate>
+  inline void unrolled_list<T, K, Alloc>::remove_if(Predicate pred)
+  {
+    //Compacts each chunk in a single pass, then folds it into the previous chunk if they fit together, or
+    //else balances the two if either is less than half full.  Only the last chunk can be left sparse.
+    list_node_base* node = mAnchor.mNext;
+    while (node != &mAnchor)
+    {
+      chunk_type* const chunk = static_cast<chunk_type*>(node);
+      node = node->mNext;
+
+      const pointer values = Values(chunk);
+      size_type kept = 0;
+      for (size_type i = 0; i < chunk->mCount; ++i)
+      {
+        if (!pred(values[i]))
+        {
+          if (kept != i)
+          {
+            values[kept] = FLEX_MOVE(values[i]);
+          }
+          ++kept;
+        }
+      }
+      flex::destruct_range(values + kept, values + chunk->mCount);
+      mSize -= chunk->mCount - kept;
+      chunk->mCount = kept;
+
+      if (kept == 0)
+      {
+        FreeChunk(chunk);
+      }
+      else if (chunk->mPrev != &mAnchor)
+      {
+        chunk_type* const prev = static_cast<chunk_type*>(chunk->mPrev);
+        if (prev->mCount + kept <= K)
+        {
+          MergeIntoPrevious(chunk);
+        }
+        else if ((prev->mCount < K / 2) || (kept < K / 2))
+        {
+          Balance(prev, chunk);
+        }
+      }
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::resize(size_type n, const value_type& val)
+  {
+    if (n < mSize)
+    {
+      iterator it = begin();
+      std::advance(it, n);
+      erase(it, end());
+    }
+    else if (n > mSize)
+    {
+      insert(end(), n - mSize, val);
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::size_type unrolled_list<T, K, Alloc>::size() const
+  {
+    return mSize;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::swap(unrolled_list<T, K, Alloc>& obj)
+  {
+    if (this == &obj)
+    {
+      return;
+    }
+
+    if ((!fixed()) && (!obj.fixed()))
+    {
+      //Chunks from either pool may be returned to the other, since neither owns a buffer.
+      list_node_base::swap(mAnchor, obj.mAnchor);
+      std::swap(mSize, obj.mSize);
+    }
+    else
+    {
+      iterator lhs_it = begin();
+      iterator rhs_it = obj.begin();
+      while ((lhs_it != end()) && (rhs_it != obj.end()))
+      {
+        std::swap(*lhs_it, *rhs_it);
+        ++lhs_it;
+        ++rhs_it;
+      }
+      if (lhs_it != end())
+      {
+        obj.insert(obj.end(), lhs_it, end());
+        erase(lhs_it, end());
+      }
+      else
+      {
+        insert(end(), rhs_it, obj.end());
+        obj.erase(rhs_it, obj.end());
+      }
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline unrolled_list<T, K, Alloc>::unrolled_list(node_type* first, node_type* last) :
+      mSize(0), mPool(first, last)
+  {
+    mAnchor.mNext = mAnchor.mPrev = &mAnchor;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::pointer unrolled_list<T, K, Alloc>::Values(list_node_base* node)
+  {
+    return (pointer) static_cast<chunk_type*>(node)->mBuffer;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::chunk_type* unrolled_list<T, K, Alloc>::AllocateChunk(
+      list_node_base* position)
+  {
+    chunk_type* const chunk = (chunk_type*) mPool.allocate();
+    chunk->mCount = 0;
+    chunk->insert(position);
+    return chunk;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::Balance(chunk_type* left, chunk_type* right)
+  {
+    //Moves elements between neighbouring chunks so that left holds half of them, rounded down.
+    const pointer lhs = Values(left);
+    const pointer rhs = Values(right);
+    const size_type half = (left->mCount + right->mCount) / 2;
+    if (left->mCount < half)
+    {
+      const size_type m = half - left->mCount;
+      flex::uninitialized_relocate(rhs, rhs + m, lhs + left->mCount);
+      for (size_type i = m; i < right->mCount; ++i)
+      {
+        new ((void*) (rhs + i - m)) value_type(FLEX_MOVE(rhs[i]));
+        rhs[i].~value_type();
+      }
+      left->mCount += m;
+      right->mCount -= m;
+    }
+    else if (left->mCount > half)
+    {
+      const size_type m = left->mCount - half;
+      for (size_type i = right->mCount; i > 0; --i)
+      {
+        new ((void*) (rhs + i - 1 + m)) value_type(FLEX_MOVE(rhs[i - 1]));
+        rhs[i - 1].~value_type();
+      }
+      flex::uninitialized_relocate(lhs + half, lhs + left->mCount, rhs);
+      left->mCount -= m;
+      right->mCount += m;
+    }
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline void unrolled_list<T, K, Alloc>::FreeChunk(chunk_type* chunk)
+  {
+    chunk->remove();
+    mPool.deallocate(chunk);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::InsertSlot(iterator position)
+  {
+    //Makes room for one element in front of position, and returns the uninitialized slot.
+    chunk_type* chunk;
+    size_type index = position.mIndex;
+    if ((index == 0) && (position.mNode->mPrev != &mAnchor)
+        && (static_cast<chunk_type*>(position.mNode->mPrev)->mCount < K))
+    {
+      //Appending to the previous chunk needs no shifting.
+      chunk = static_cast<chunk_type*>(position.mNode->mPrev);
+      index = chunk->mCount;
+    }
+    else if ((position.mNode == &mAnchor)
+        || ((index == 0) && (position.mNode->mPrev == &mAnchor)
+            && (static_cast<chunk_type*>(position.mNode)->mCount == K)))
+    {
+      //A new chunk is only started at either end of the list, behind a full chunk, so every chunk between
+      //the first and last stays at least half full.
+      chunk = AllocateChunk(position.mNode);
+    }
+    else
+    {
+      chunk = static_cast<chunk_type*>(position.mNode);
+      if (chunk->mCount == K)
+      {
+        //Split the full chunk, moving its upper half to a new chunk that follows it.
+        const size_type half = K / 2;
+        chunk_type* const next = AllocateChunk(chunk->mNext);
+        flex::uninitialized_relocate(Values(chunk) + half, Values(chunk) + K, Values(next));
+        next->mCount = K - half;
+        chunk->mCount = half;
+        if (index > half)
+        {
+          chunk = next;
+          index -= half;
+        }
+      }
+
+      if (index < chunk->mCount)
+      {
+        //Shift the elements after index up by one, leaving index destroyed.
+        const pointer values = Values(chunk);
+        new ((void*) (values + chunk->mCount)) value_type(FLEX_MOVE(values[chunk->mCount - 1]));
+        std::copy_backward(FLEX_MOVE_ITERATOR(values + index), FLEX_MOVE_ITERATOR(values + chunk->mCount - 1),
+            values + chunk->mCount);
+        values[index].~value_type();
+      }
+    }
+    ++chunk->mCount;
+    ++mSize;
+    return iterator(chunk, index);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::chunk_type* unrolled_list<T, K, Alloc>::MergeIntoPrevious(
+      chunk_type* chunk)
+  {
+    chunk_type* const prev = static_cast<chunk_type*>(chunk->mPrev);
+    flex::uninitialized_relocate(Values(chunk), Values(chunk) + chunk->mCount, Values(prev) + prev->mCount);
+    prev->mCount += chunk->mCount;
+    FreeChunk(chunk);
+    return prev;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline typename unrolled_list<T, K, Alloc>::iterator unrolled_list<T, K, Alloc>::Rebalance(chunk_type* chunk,
+      size_type index)
+  {
+    //Called after elements were removed from chunk.  Returns the iterator to what was at chunk[index].
+    if (chunk->mCount == 0)
+    {
+      list_node_base* const next = chunk->mNext;
+      FreeChunk(chunk);
+      return iterator(next, 0);
+    }
+
+    const bool inner = (chunk->mPrev != &mAnchor) && (chunk->mNext != &mAnchor);
+    if (inner ? (chunk->mCount < K / 2) : (chunk->mCount <= K / 4))
+    {
+      if ((chunk->mNext != &mAnchor) && (chunk->mCount + static_cast<chunk_type*>(chunk->mNext)->mCount <= K))
+      {
+        MergeIntoPrevious(static_cast<chunk_type*>(chunk->mNext));
+      }
+      else if ((chunk->mPrev != &mAnchor) && (static_cast<chunk_type*>(chunk->mPrev)->mCount + chunk->mCount <= K))
+      {
+        index += static_cast<chunk_type*>(chunk->mPrev)->mCount;
+        chunk = MergeIntoPrevious(chunk);
+      }
+      else if (inner)
+      {
+        //The next chunk doesn't fit, so it holds more than K/2 and can spare elements.
+        Balance(chunk, static_cast<chunk_type*>(chunk->mNext));
+      }
+    }
+    return (index < chunk->mCount) ? iterator(chunk, index) : iterator(chunk->mNext, 0);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator==(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator<(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator!=(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator>(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator<=(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  template<class T, size_t K, class Alloc>
+  inline bool operator>=(const unrolled_list<T, K, Alloc>& lhs, const unrolled_list<T, K, Alloc>& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+} //namespace flex
+
+#endif /* FLEX_UNROLLED_LIST_H */
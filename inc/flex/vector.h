@@ -2,7 +2,9 @@
 #define FLEX_VECTOR_H
 
 #include <flex/allocator.h>
+#include <flex/growth_policy.h>
 #include <flex/initializer_list.h>
+#include <flex/internal/relocate.h>
 
 #include <algorithm>
 #include <memory>
@@ -11,7 +13,7 @@
 namespace flex
 {
 
-  template<class T, class Alloc = allocator<T> >
+  template<class T, class Alloc = allocator<T>, class Growth = double_growth>
   class vector_base: public guarded_object
   {
   public:
@@ -27,6 +29,7 @@ namespace flex
     typedef size_t size_type;
     typedef std::ptrdiff_t difference_type;
     typedef Alloc allocator_type;
+    typedef Growth growth_policy;
 
   protected:
     iterator mBegin;
@@ -34,6 +37,7 @@ namespace flex
     pointer mCapacity;
     Alloc mAllocator;
     bool mFixed;
+    bool mSmall;
 
     vector_base();
     vector_base(size_type n);
@@ -41,15 +45,16 @@ namespace flex
     ~vector_base();
 
     pointer Allocate(size_type n);
+    void Deallocate();
     void DestroyAndDeallocate();
     size_type GetNewCapacity(size_type min);
   };
 
-  template<class T, class Alloc = allocator<T> >
-  class vector: public vector_base<T, Alloc>
+  template<class T, class Alloc = allocator<T>, class Growth = double_growth>
+  class vector: public vector_base<T, Alloc, Growth>
   {
-    typedef vector_base<T, Alloc> base_type;
-    typedef vector<T, Alloc> this_type;
+    typedef vector_base<T, Alloc, Growth> base_type;
+    typedef vector<T, Alloc, Growth> this_type;
 
   public:
     typedef typename base_type::value_type value_type;
@@ -64,13 +69,16 @@ namespace flex
     typedef typename base_type::size_type size_type;
     typedef typename base_type::difference_type difference_type;
     typedef typename base_type::allocator_type allocator_type;
+    typedef typename base_type::growth_policy growth_policy;
 
     using base_type::mAllocator;
     using base_type::mBegin;
     using base_type::mEnd;
     using base_type::mCapacity;
     using base_type::mFixed;
+    using base_type::mSmall;
     using base_type::Allocate;
+    using base_type::Deallocate;
     using base_type::DestroyAndDeallocate;
     using base_type::GetNewCapacity;
 
@@ -78,12 +86,13 @@ namespace flex
     explicit vector(size_type size, const value_type& val = value_type());
     vector(int size, const value_type& val);
     template<typename InputIterator> vector(InputIterator first, InputIterator last);
-    vector(const vector<T, Alloc> & obj);
+    vector(const vector<T, Alloc, Growth> & obj);
 #ifdef FLEX_HAS_CXX11
-    vector(vector<T, Alloc>&& x);
+    vector(vector<T, Alloc, Growth>&& x);
 #endif
     vector(std::initializer_list<value_type> il);
 
+    template<class Function> size_type append_with(size_type n, Function f);
     void assign(size_type size, const T& val);
     void assign(int size, const T& val);
     template<typename InputIterator>
@@ -110,6 +119,8 @@ namespace flex
     const_iterator end() const;
     iterator erase(iterator position);
     iterator erase(iterator first, iterator last);
+    template<class Predicate> size_type erase_if(Predicate pred);
+    iterator erase_unordered(iterator position);
     bool fixed() const;
     reference front();
     const_reference front() const;
@@ -122,11 +133,11 @@ namespace flex
     void insert(iterator position, int n, const value_type& val);
     template<typename InputIterator> void insert(iterator position, InputIterator first, InputIterator last);
     size_type max_size() const;
-    vector<T, Alloc>& operator=(const vector<T, Alloc>& obj);
+    vector<T, Alloc, Growth>& operator=(const vector<T, Alloc, Growth>& obj);
 #ifdef FLEX_HAS_CXX11
-    vector<T, Alloc>& operator=(vector<T, Alloc>&& x);
+    vector<T, Alloc, Growth>& operator=(vector<T, Alloc, Growth>&& x);
 #endif
-    vector<T, Alloc>& operator=(std::initializer_list<value_type> il);
+    vector<T, Alloc, Growth>& operator=(std::initializer_list<value_type> il);
     reference operator[](size_type n);
     const_reference operator[](size_type n) const;
     void pop_back();
@@ -140,11 +151,13 @@ namespace flex
     const_reverse_iterator rend() const;
     void reserve(size_type n);
     void resize(size_type n, const value_type& val = value_type());
+    void resize_default_init(size_type n);
+    void resize_uninitialized(size_type n);
     void shrink_to_fit();
     size_type size() const;
-    void swap(vector<T, Alloc>& obj);
+    void swap(vector<T, Alloc, Growth>& obj);
 #ifdef FLEX_HAS_CXX11
-    void swap(vector<T, Alloc>&& obj);
+    void swap(vector<T, Alloc, Growth>&& obj);
 #endif
 
   protected:
@@ -155,23 +168,23 @@ namespace flex
   /*
    * vector_base
    */
-  template<class T, class Alloc>
-  inline vector_base<T, Alloc>::vector_base() :
-      mBegin(NULL), mEnd(NULL), mCapacity(NULL), mFixed(false)
+  template<class T, class Alloc, class Growth>
+  inline vector_base<T, Alloc, Growth>::vector_base() :
+      mBegin(NULL), mEnd(NULL), mCapacity(NULL), mFixed(false), mSmall(false)
 
   {
   }
 
-  template<class T, class Alloc>
-  inline vector_base<T, Alloc>::vector_base(size_type n) :
-      mBegin(Allocate(n)), mEnd(mBegin + n), mCapacity(mEnd), mFixed(false)
+  template<class T, class Alloc, class Growth>
+  inline vector_base<T, Alloc, Growth>::vector_base(size_type n) :
+      mBegin(Allocate(n)), mEnd(mBegin + n), mCapacity(mEnd), mFixed(false), mSmall(false)
 
   {
   }
 
-  template<class T, class Alloc>
-  inline vector_base<T, Alloc>::vector_base(pointer new_begin, pointer new_end, size_type capacity) :
-      mBegin(new_begin), mEnd(new_end), mCapacity(mBegin + capacity), mFixed(true)
+  template<class T, class Alloc, class Growth>
+  inline vector_base<T, Alloc, Growth>::vector_base(pointer new_begin, pointer new_end, size_type capacity) :
+      mBegin(new_begin), mEnd(new_end), mCapacity(mBegin + capacity), mFixed(true), mSmall(false)
 
   {
 #ifndef FLEX_RELEASE
@@ -186,8 +199,8 @@ namespace flex
 #endif
   }
 
-  template<class T, class Alloc>
-  inline vector_base<T, Alloc>::~vector_base()
+  template<class T, class Alloc, class Growth>
+  inline vector_base<T, Alloc, Growth>::~vector_base()
   {
     flex::destruct_range(mBegin, mEnd);
     if (!mFixed)
@@ -196,101 +209,123 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename vector_base<T, Alloc>::pointer vector_base<T, Alloc>::Allocate(size_type n)
+  template<class T, class Alloc, class Growth>
+  inline typename vector_base<T, Alloc, Growth>::pointer vector_base<T, Alloc, Growth>::Allocate(size_type n)
   {
     return mAllocator.allocate(n);
   }
 
-  template<class T, class Alloc>
-  inline void vector_base<T, Alloc>::DestroyAndDeallocate()
+  template<class T, class Alloc, class Growth>
+  inline void vector_base<T, Alloc, Growth>::Deallocate()
   {
-    flex::destruct_range(mBegin, mEnd);
-
-#ifndef FLEX_RELEASE
+    //Releases the buffer without destroying its elements.  This is used once the elements have been
+    //relocated to a new buffer.
     if (FLEX_UNLIKELY(mFixed))
     {
+      //The fixed buffer is never deallocated.  A small_vector leaves it by design, whereas a fixed_vector
+      //reports that its capacity was exceeded.
       mFixed = false;
-      flex::error_msg("flex::fixed_vector - capacity exceeded");
+#ifndef FLEX_RELEASE
+      if (!mSmall)
+      {
+        flex::error_msg("flex::fixed_vector - capacity exceeded");
+      }
+#endif
     }
     else
-#endif
-    mAllocator.deallocate(mBegin, mCapacity - mBegin);
+    {
+      mAllocator.deallocate(mBegin, mCapacity - mBegin);
+    }
   }
 
-  template<class T, class Alloc>
-  inline typename vector_base<T, Alloc>::size_type vector_base<T, Alloc>::GetNewCapacity(size_type min_size)
+  template<class T, class Alloc, class Growth>
+  inline void vector_base<T, Alloc, Growth>::DestroyAndDeallocate()
   {
-    // This needs to return a value of at least currentCapacity and at least 1.
-    size_type new_capacity = ((mCapacity - mBegin) > 0) ? (2 * (mCapacity - mBegin)) : 1;
+    flex::destruct_range(mBegin, mEnd);
+    Deallocate();
+  }
 
-    // If we are still less than the min_size, just set to the min_size.
-    if (new_capacity < min_size)
-    {
-      return min_size;
-    }
-    else
-    {
-      return new_capacity;
-    }
+  template<class T, class Alloc, class Growth>
+  inline typename vector_base<T, Alloc, Growth>::size_type vector_base<T, Alloc, Growth>::GetNewCapacity(size_type min_size)
+  {
+    // The Growth policy returns a value of at least min_size.  See growth_policy.h.
+    return Growth::new_capacity(mCapacity - mBegin, min_size, sizeof(T), 0, mAllocator);
   }
 
   /*
    * vector
    */
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector() :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector() :
       base_type()
   {
   }
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(size_type size, const value_type& val) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(size_type size, const value_type& val) :
       base_type(size)
   {
     std::uninitialized_fill(mBegin, mEnd, val);
   }
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(int size, const value_type& val) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(int size, const value_type& val) :
       base_type(size)
   {
     std::uninitialized_fill(mBegin, mEnd, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline vector<T, Alloc>::vector(InputIterator first, InputIterator last) :
+  inline vector<T, Alloc, Growth>::vector(InputIterator first, InputIterator last) :
       base_type(std::distance(first, last))
   {
     std::uninitialized_copy(first, last, mBegin);
   }
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(const vector<T, Alloc> & obj) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(const vector<T, Alloc, Growth> & obj) :
       base_type(obj.size())
   {
     std::uninitialized_copy(obj.mBegin, obj.mEnd, mBegin);
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(vector<T, Alloc> && obj) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(vector<T, Alloc, Growth> && obj) :
   base_type()
   {
     swap(std::move(obj));
   }
 #endif
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(std::initializer_list<value_type> il) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(std::initializer_list<value_type> il) :
       base_type(il.size())
   {
     std::uninitialized_copy(il.begin(), il.end(), mBegin);
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::assign(size_type n, const T& val)
+  template<class T, class Alloc, class Growth>
+  template<class Function>
+  inline typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::append_with(size_type n, Function f)
+  {
+    //Room is made for n elements past the end, which are passed to f(p, n) as uninitialized memory.  f
+    //constructs (or for trivial types simply writes) the elements it produces, such as the bytes returned by
+    //read(), and returns their count.  Only those elements are appended.
+    if ((mEnd + n) > mCapacity)
+    {
+      reserve(size() + n);
+    }
+
+    size_type count = f(mEnd, n);
+    FLEX_ASSERT(count <= n);
+    mEnd += count;
+    return count;
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::assign(size_type n, const T& val)
   {
     if (n > capacity())
     {
@@ -326,15 +361,15 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::assign(int size, const T& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::assign(int size, const T& val)
   {
     assign((size_type) size, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline void vector<T, Alloc>::assign(InputIterator first, InputIterator last)
+  inline void vector<T, Alloc, Growth>::assign(InputIterator first, InputIterator last)
   {
     size_type n = std::distance(first, last);
     if (n > capacity())
@@ -370,91 +405,91 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::assign(std::initializer_list<value_type> il)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::assign(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reference vector<T, Alloc>::at(size_type n)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::at(size_type n)
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= size(), "flex::vector.at() - index out-of-bounds");
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reference vector<T, Alloc>::at(size_type n) const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::at(size_type n) const
   {
     FLEX_THROW_OUT_OF_RANGE_IF(n >= size(), "flex::vector.at() - index out-of-bounds");
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reference vector<T, Alloc>::back()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::back()
   {
     return *(mEnd - 1);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reference vector<T, Alloc>::back() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::back() const
   {
     return *(mEnd - 1);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::begin()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::begin()
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_iterator vector<T, Alloc>::begin() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::begin() const
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_iterator vector<T, Alloc>::cbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::cbegin() const
   {
     return mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_iterator vector<T, Alloc>::cend() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::cend() const
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::crbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::crbegin() const
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::crend() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::crend() const
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::size_type vector<T, Alloc>::capacity() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::capacity() const
   {
     return mCapacity - mBegin;
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::clear()
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::clear()
   {
     flex::destruct_range(mBegin, mEnd);
     mEnd = mBegin;
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<class... Args>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(iterator position, Args&&... args)
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::emplace(iterator position, Args&&... args)
   {
     if (mEnd == mCapacity)
     {
@@ -463,17 +498,15 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Construct the inserted value first, as the arguments may refer to elements of this container.
+      T* new_position = new_begin + (position - mBegin);
+      new ((void*) new_position) value_type(std::forward<Args>(args)...);
 
-      //Copy the inserted parameter val.
-      T* new_position = new_end;
-      new ((void*) new_end) value_type(std::forward<Args>(args)...);
-
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
+      //Relocate all values to the left and to the right of position.
+      flex::uninitialized_relocate(mBegin, position, new_begin);
+      T* new_end = flex::uninitialized_relocate(position, mEnd, new_position + 1);
 
-      DestroyAndDeallocate();
+      Deallocate();
 
       mBegin = new_begin;
       mEnd = new_end;
@@ -508,9 +541,9 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<class... Args>
-  inline void vector<T, Alloc>::emplace_back(Args&&... args)
+  inline void vector<T, Alloc, Growth>::emplace_back(Args&&... args)
   {
     if (mEnd == mCapacity)
     {
@@ -519,13 +552,14 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      T* new_end = new_begin + size();
       new ((void*) new_end) value_type(std::forward<Args>(args)...);
       ++new_end;
+      flex::uninitialized_relocate(mBegin, mEnd, new_begin);
 
       //Deallocate and reassign.
-      DestroyAndDeallocate();
+      Deallocate();
       mBegin = new_begin;
       mEnd = new_end;
       mCapacity = mBegin + new_capacity;
@@ -538,26 +572,26 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline bool vector<T, Alloc>::empty() const
+  template<class T, class Alloc, class Growth>
+  inline bool vector<T, Alloc, Growth>::empty() const
   {
     return (mBegin == mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::end()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::end()
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_iterator vector<T, Alloc>::end() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::end() const
   {
     return mEnd;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator position)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(iterator position)
   {
     //This copy will simply shift everything after position over to the left by one.
     //This will effectively overwrite position, erasing it from the container.
@@ -566,8 +600,8 @@ namespace flex
     return position;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator first, iterator last)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(iterator first, iterator last)
   {
     if (first != last)
     {
@@ -581,32 +615,70 @@ namespace flex
     return first;
   }
 
-  template<class T, class Alloc>
-  inline bool vector<T, Alloc>::fixed() const
+  template<class T, class Alloc, class Growth>
+  template<class Predicate>
+  inline typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::erase_if(Predicate pred)
+  {
+    //Each survivor after the first erased element is moved once, directly to its final position.
+    iterator dest = std::find_if(mBegin, mEnd, pred);
+    if (dest == mEnd)
+    {
+      return 0;
+    }
+    for (iterator it = dest + 1; it != mEnd; ++it)
+    {
+      if (!pred(*it))
+      {
+        *dest = FLEX_MOVE(*it);
+        ++dest;
+      }
+    }
+    const size_type n = mEnd - dest;
+    flex::destruct_range(dest, mEnd);
+    mEnd = dest;
+    return n;
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase_unordered(iterator position)
+  {
+    //The last element is moved into the hole rather than shifting the tail, so the order is not kept.
+    iterator last = mEnd - 1;
+    if (position != last)
+    {
+      *position = FLEX_MOVE(*last);
+    }
+    last->~value_type();
+    mEnd = last;
+    return position;
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline bool vector<T, Alloc, Growth>::fixed() const
   {
     return mFixed;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reference vector<T, Alloc>::front()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::front()
   {
     return *mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reference vector<T, Alloc>::front() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::front() const
   {
     return *mBegin;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::allocator_type vector<T, Alloc>::get_allocator() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::allocator_type vector<T, Alloc, Growth>::get_allocator() const
   {
     return mAllocator;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(iterator position, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(iterator position, const value_type& val)
   {
     if (mEnd == mCapacity)
     {
@@ -615,17 +687,15 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Construct the inserted value first, as val may refer to an element of this container.
+      T* new_position = new_begin + (position - mBegin);
+      new ((void*) new_position) value_type(val);
 
-      //Copy the inserted parameter val.
-      T* new_position = new_end;
-      new ((void*) new_end) value_type(val);
-
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
+      //Relocate all values to the left and to the right of position.
+      flex::uninitialized_relocate(mBegin, position, new_begin);
+      T* new_end = flex::uninitialized_relocate(position, mEnd, new_position + 1);
 
-      DestroyAndDeallocate();
+      Deallocate();
 
       mBegin = new_begin;
       mEnd = new_end;
@@ -659,8 +729,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(iterator position, value_type&& val)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(iterator position, value_type&& val)
   {
     if (mEnd == mCapacity)
     {
@@ -669,17 +739,15 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values to the left of position.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+      //Construct the inserted value first, as val may refer to an element of this container.
+      T* new_position = new_begin + (position - mBegin);
+      new ((void*) new_position) value_type(FLEX_MOVE(val));
 
-      //Copy the inserted parameter val.
-      T* new_position = new_end;
-      new ((void*) new_end) value_type(FLEX_MOVE(val));
+      //Relocate all values to the left and to the right of position.
+      flex::uninitialized_relocate(mBegin, position, new_begin);
+      T* new_end = flex::uninitialized_relocate(position, mEnd, new_position + 1);
 
-      //Copy all values that come after position.
-      new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), ++new_end);
-
-      DestroyAndDeallocate();
+      Deallocate();
 
       mBegin = new_begin;
       mEnd = new_end;
@@ -713,8 +781,8 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::insert(iterator position, size_type n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::insert(iterator position, size_type n, const value_type& val)
   {
 
     if (n > 0)
@@ -725,16 +793,15 @@ namespace flex
         size_type new_size = size() + n;
         size_type new_capacity = GetNewCapacity(new_size);
         T* new_begin = Allocate(new_capacity);
-        //Copy all values to the left of position.
-        T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
+        //Fill the parameter val first, as it may refer to an element of this container.
+        T* new_position = new_begin + (position - mBegin);
+        std::uninitialized_fill_n(new_position, n, val);
 
-        //Fill the parameter val.
-        std::uninitialized_fill_n(new_end, n, val);
+        //Relocate all values to the left and to the right of position.
+        flex::uninitialized_relocate(mBegin, position, new_begin);
+        T* new_end = flex::uninitialized_relocate(position, mEnd, new_position + n);
 
-        //Copy all values that come after position.
-        new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), new_end + n);
-
-        DestroyAndDeallocate();
+        Deallocate();
 
         mBegin = new_begin;
         mEnd = new_end;
@@ -768,15 +835,15 @@ namespace flex
 
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::insert(iterator position, int n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::insert(iterator position, int n, const value_type& val)
   {
     insert(position, (size_type) n, val);
   }
 
-  template<class T, class Alloc>
+  template<class T, class Alloc, class Growth>
   template<typename InputIterator>
-  inline void vector<T, Alloc>::insert(iterator position, InputIterator first, InputIterator last)
+  inline void vector<T, Alloc, Growth>::insert(iterator position, InputIterator first, InputIterator last)
   {
     if (first != last)
     {
@@ -788,17 +855,16 @@ namespace flex
         size_type new_capacity = GetNewCapacity(new_size);
         T* new_begin = Allocate(new_capacity);
 
-        //Copy all values to the left of position.
-        T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(position), new_begin);
-
-        //Copy the inserted parameter val.
-        new_end = std::uninitialized_copy(first, last, new_end);
+        //Copy the inserted range first, as it may refer to elements of this container.
+        T* new_position = new_begin + (position - mBegin);
+        std::uninitialized_copy(first, last, new_position);
 
-        //Copy all values that come after position.
-        new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(position), FLEX_MOVE_ITERATOR(mEnd), new_end);
+        //Relocate all values to the left and to the right of position.
+        flex::uninitialized_relocate(mBegin, position, new_begin);
+        T* new_end = flex::uninitialized_relocate(position, mEnd, new_position + n);
 
         //Deallocate and reassign
-        DestroyAndDeallocate();
+        Deallocate();
         mBegin = new_begin;
         mEnd = new_end;
         mCapacity = mBegin + new_capacity;
@@ -826,10 +892,10 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::size_type vector<T, Alloc>::max_size() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::max_size() const
   {
-    if (mFixed)
+    if (mFixed && !mSmall)
     {
       return capacity();
     }
@@ -839,49 +905,49 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& obj)
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(const vector<T, Alloc, Growth>& obj)
   {
     assign(obj.begin(), obj.end());
     return *this;
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline vector<T, Alloc>& vector<T, Alloc>::operator=(vector<T, Alloc>&& obj)
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(vector<T, Alloc, Growth>&& obj)
   {
     swap(std::move(obj));
     return *this;
   }
 #endif
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>& vector<T, Alloc>::operator=(std::initializer_list<value_type> il)
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(std::initializer_list<value_type> il)
   {
     assign(il.begin(), il.end());
     return *this;
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reference vector<T, Alloc>::operator[](size_type n)
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::operator[](size_type n)
   {
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reference vector<T, Alloc>::operator[](size_type n) const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::operator[](size_type n) const
   {
     return mBegin[n];
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::pop_back()
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::pop_back()
   {
     (--mEnd)->~value_type();
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::push_back(const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::push_back(const value_type& val)
   {
     if (mEnd == mCapacity)
     {
@@ -890,13 +956,14 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      T* new_end = new_begin + size();
       new ((void*) new_end) value_type(val);
       ++new_end;
+      flex::uninitialized_relocate(mBegin, mEnd, new_begin);
 
       //Deallocate and reassign.
-      DestroyAndDeallocate();
+      Deallocate();
       mBegin = new_begin;
       mEnd = new_end;
       mCapacity = mBegin + new_capacity;
@@ -909,8 +976,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::push_back(value_type&& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::push_back(value_type&& val)
   {
     if (mEnd == mCapacity)
     {
@@ -919,13 +986,14 @@ namespace flex
       size_type new_capacity = GetNewCapacity(new_size);
       T* new_begin = Allocate(new_capacity);
 
-      //Copy all values.
-      T* new_end = std::uninitialized_copy(FLEX_MOVE_ITERATOR(mBegin), FLEX_MOVE_ITERATOR(mEnd), new_begin);
+      //Construct the new value first, as it may refer to an element of this container.
+      T* new_end = new_begin + size();
       new ((void*) new_end) value_type(std::move(val));
       ++new_end;
+      flex::uninitialized_relocate(mBegin, mEnd, new_begin);
 
       //Deallocate and reassign.
-      DestroyAndDeallocate();
+      Deallocate();
       mBegin = new_begin;
       mEnd = new_end;
       mCapacity = mBegin + new_capacity;
@@ -938,32 +1006,32 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reverse_iterator vector<T, Alloc>::rbegin()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reverse_iterator vector<T, Alloc, Growth>::rbegin()
   {
     return reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::rbegin() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::rbegin() const
   {
     return const_reverse_iterator(mEnd);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::reverse_iterator vector<T, Alloc>::rend()
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::reverse_iterator vector<T, Alloc, Growth>::rend()
   {
     return reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::rend() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::rend() const
   {
     return const_reverse_iterator(mBegin);
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::reserve(size_type n)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::reserve(size_type n)
   {
     if (n > capacity())
     {
@@ -971,19 +1039,19 @@ namespace flex
       size_type new_capacity = GetNewCapacity(n);
       pointer new_begin = Allocate(new_capacity);
 
-      //Copy all current values.
-      pointer new_end = std::uninitialized_copy(mBegin, mEnd, new_begin);
+      //Relocate all current values.
+      pointer new_end = flex::uninitialized_relocate(mBegin, mEnd, new_begin);
 
       //Deallocate and reassign.
-      DestroyAndDeallocate();
+      Deallocate();
       mBegin = new_begin;
       mEnd = new_end;
       mCapacity = mBegin + new_capacity;
     }
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::resize(size_type n, const value_type& val)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::resize(size_type n, const value_type& val)
   {
     if (n < size())
     {
@@ -998,8 +1066,44 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::shrink_to_fit()
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::resize_default_init(size_type n)
+  {
+    //Like resize(), but new elements are default-initialized rather than value-initialized, so elements
+    //of trivial types, such as char, are left uninitialized instead of being zero filled.
+    if (n < size())
+    {
+      iterator new_end = mBegin + n;
+      flex::destruct_range(new_end, mEnd);
+      mEnd = new_end;
+    }
+    else if (n > size())
+    {
+      if (n > capacity())
+      {
+        reserve(n);
+      }
+
+      const iterator new_end = mBegin + n;
+      for (; mEnd != new_end; ++mEnd)
+      {
+        ::new ((void*) mEnd) value_type;
+      }
+    }
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::resize_uninitialized(size_type n)
+  {
+#ifdef FLEX_HAS_CXX11
+    static_assert(std::is_trivially_default_constructible<T>::value,
+        "flex::vector::resize_uninitialized() requires a trivially default constructible type");
+#endif
+    resize_default_init(n);
+  }
+
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::shrink_to_fit()
   {
     if (!mFixed)
     {
@@ -1014,15 +1118,15 @@ namespace flex
           new_capacity = size();
           new_begin = Allocate(new_capacity);
 
-          //Copy all values.
-          new_end = std::uninitialized_copy(mBegin, mEnd, new_begin);
+          //Relocate all values.
+          new_end = flex::uninitialized_relocate(mBegin, mEnd, new_begin);
         }
         else
         {
           new_begin = new_end = NULL;
           new_capacity = 0;
         }
-        DestroyAndDeallocate();
+        Deallocate();
         mBegin = new_begin;
         mEnd = new_end;
         mCapacity = mBegin + new_capacity;
@@ -1030,14 +1134,14 @@ namespace flex
     }
   }
 
-  template<class T, class Alloc>
-  inline typename vector<T, Alloc>::size_type vector<T, Alloc>::size() const
+  template<class T, class Alloc, class Growth>
+  inline typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::size() const
   {
     return mEnd - mBegin;
   }
 
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::swap(vector<T, Alloc>& obj)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth>& obj)
   {
     if ((!mFixed) && (!obj.fixed()))
     {
@@ -1063,8 +1167,8 @@ namespace flex
   }
 
 #ifdef FLEX_HAS_CXX11
-  template<class T, class Alloc>
-  inline void vector<T, Alloc>::swap(vector<T, Alloc>&& obj)
+  template<class T, class Alloc, class Growth>
+  inline void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth>&& obj)
   {
     if ((!mFixed) && (!obj.fixed()))
     {
@@ -1080,44 +1184,44 @@ namespace flex
   }
 #endif
 
-  template<class T, class Alloc>
-  inline vector<T, Alloc>::vector(pointer new_begin, pointer new_end, size_type capacity) :
+  template<class T, class Alloc, class Growth>
+  inline vector<T, Alloc, Growth>::vector(pointer new_begin, pointer new_end, size_type capacity) :
       base_type(new_begin, new_end, capacity)
   {
   }
 
-  template<class T, class Alloc>
-  inline bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
-  template<class T, class Alloc>
-  inline bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
   }
 
-  template<class T, class Alloc>
-  inline bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return !(lhs == rhs);
   }
 
-  template<class T, class Alloc>
-  inline bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return rhs < lhs;
   }
 
-  template<class T, class Alloc>
-  inline bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return !(rhs < lhs);
   }
 
-  template<class T, class Alloc>
-  inline bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+  template<class T, class Alloc, class Growth>
+  inline bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
   {
     return !(lhs < rhs);
   }
@@ -0,0 +1,308 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/algorithm.h"
+#include "flex/fixed_hash_map.h"
+#include "flex/fixed_list.h"
+#include "flex/fixed_ring.h"
+#include "flex/fixed_vector.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class algorithm_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  struct sum
+  {
+    long long mTotal;
+    size_t mCount;
+
+    sum() :
+        mTotal(0), mCount(0)
+    {
+    }
+
+    void operator()(int x)
+    {
+      mTotal += x;
+      ++mCount;
+    }
+
+    void operator()(const std::pair<const int, int>& x)
+    {
+      mTotal += x.first * 1000LL + x.second;
+      ++mCount;
+    }
+  };
+
+  struct twice
+  {
+    void operator()(int& x) const
+    {
+      x *= 2;
+    }
+
+    void operator()(std::pair<const int, int>& x) const
+    {
+      x.second *= 2;
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  //Compares every algorithm with its std equivalent for each length from 0 to 40, so both the vector loop
+  //and the scalar tail of each kernel are covered.
+  template<class T>
+  void check_vector()
+  {
+    for (int n = 0; n <= 40; ++n)
+    {
+      vector<T> a;
+      for (int i = 0; i < n; ++i)
+      {
+        a.push_back(static_cast<T>((i * 7) % 13) - 6);
+      }
+      const vector<T>& b = a;
+
+      for (int key = -7; key <= 7; ++key)
+      {
+        const T val = static_cast<T>(key);
+        TS_ASSERT_EQUALS(flex::find(b, val), std::find(b.begin(), b.end(), val));
+        TS_ASSERT_EQUALS(flex::count(b, val), (size_t ) std::count(b.begin(), b.end(), val));
+        TS_ASSERT_EQUALS(flex::contains(b, val), std::find(b.begin(), b.end(), val) != b.end());
+      }
+      TS_ASSERT_EQUALS(flex::min_element(b), std::min_element(b.begin(), b.end()));
+      TS_ASSERT_EQUALS(flex::max_element(b), std::max_element(b.begin(), b.end()));
+      TS_ASSERT_EQUALS(flex::accumulate(b, T(1)), std::accumulate(b.begin(), b.end(), T(1)));
+
+      vector<T> sorted(a);
+      std::sort(sorted.begin(), sorted.end());
+      for (int key = -7; key <= 7; ++key)
+      {
+        const T val = static_cast<T>(key);
+        TS_ASSERT_EQUALS(flex::simd::lower_bound(sorted.begin(), sorted.end(), val),
+            std::lower_bound(sorted.begin(), sorted.end(), val));
+      }
+    }
+  }
+
+  template<class T>
+  void check_ring()
+  {
+    //Each offset moves the wrap-around point through the elements.
+    for (int offset = 0; offset < 24; ++offset)
+    {
+      fixed_ring<T, 24> a;
+      for (int i = 0; i < offset; ++i)
+      {
+        a.push_back(T(0));
+      }
+      for (int i = 0; i < 24; ++i)
+      {
+        if (a.full())
+        {
+          a.pop_front();
+        }
+        a.push_back(static_cast<T>((i * 5) % 11));
+      }
+      while (a.size() > 20)
+      {
+        a.pop_front();
+      }
+      const fixed_ring<T, 24>& b = a;
+
+      for (int key = -1; key <= 11; ++key)
+      {
+        const T val = static_cast<T>(key);
+        TS_ASSERT(flex::find(b, val) == std::find(b.begin(), b.end(), val));
+        TS_ASSERT_EQUALS(flex::count(b, val), (size_t ) std::count(b.begin(), b.end(), val));
+        TS_ASSERT_EQUALS(flex::contains(b, val), std::find(b.begin(), b.end(), val) != b.end());
+      }
+      TS_ASSERT(flex::min_element(b) == std::min_element(b.begin(), b.end()));
+      TS_ASSERT(flex::max_element(b) == std::max_element(b.begin(), b.end()));
+      TS_ASSERT_EQUALS(flex::accumulate(b, T(0)), std::accumulate(b.begin(), b.end(), T(0)));
+    }
+  }
+
+  void test_vector()
+  {
+    check_vector<int>();
+    check_vector<long>();
+    check_vector<long long>();
+    check_vector<float>();
+    check_vector<double>();
+    check_vector<short>();
+  }
+
+  void test_ring()
+  {
+    check_ring<int>();
+    check_ring<long>();
+    check_ring<float>();
+    check_ring<double>();
+  }
+
+  void test_fixed_vector()
+  {
+    flex::allocation_guard::enable();
+    fixed_vector<int, 64> a;
+    for (int i = 0; i < 64; ++i)
+    {
+      a.push_back(i);
+    }
+
+    /*
+     * Case1: Results are mutable iterators into the container.
+     */
+    *flex::find(a, 40) = -1;
+    TS_ASSERT_EQUALS(a[40], -1);
+    TS_ASSERT_EQUALS(flex::min_element(a) - a.begin(), 40);
+    *flex::max_element(a) = 0;
+    TS_ASSERT_EQUALS(a[63], 0);
+    TS_ASSERT_EQUALS(flex::count(a, 0), 2);
+    TS_ASSERT(flex::find(a, 100) == a.end());
+    TS_ASSERT(!flex::contains(a, 100));
+
+    /*
+     * Case2: The sum may be accumulated into a wider type.
+     */
+    TS_ASSERT_EQUALS(flex::accumulate(a, 0LL), 2016 - 40 - 1 - 63);
+  }
+
+  void test_non_arithmetic()
+  {
+    vector<obj> a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a.push_back(obj(10 - i));
+    }
+    TS_ASSERT_EQUALS(flex::find(a, obj(4)) - a.begin(), 6);
+    TS_ASSERT_EQUALS(flex::count(a, obj(4)), 1);
+    TS_ASSERT_EQUALS(*flex::min_element(a), 1);
+    TS_ASSERT_EQUALS(*flex::max_element(a), 10);
+  }
+
+  void test_duplicates()
+  {
+    /*
+     * Case1: The first of several equal extremes is returned.
+     */
+    vector<double> a(37, 2.5);
+    a[5] = 1.0;
+    a[30] = 1.0;
+    a[9] = 7.0;
+    a[33] = 7.0;
+    TS_ASSERT_EQUALS(flex::min_element(a) - a.begin(), 5);
+    TS_ASSERT_EQUALS(flex::max_element(a) - a.begin(), 9);
+    TS_ASSERT_EQUALS(flex::count(a, 2.5), 33);
+  }
+
+  void test_kernels()
+  {
+#ifdef FLEX_HAS_SSE2
+    /*
+     * Case1: Each instruction set agrees with the std algorithms, whichever one the dispatch picks.
+     */
+    typedef flex::simd::sse2_ops<flex::simd::lane_i64> sse2_ops;
+    long long data[19];
+    for (int i = 0; i < 19; ++i)
+    {
+      data[i] = (i % 2) ? (1LL << 40) + i : -i;
+    }
+    const long long* last = data + 19;
+    TS_ASSERT_EQUALS(flex::simd::sse2::find<sse2_ops>(data, last, -6LL), data + 6);
+    TS_ASSERT_EQUALS((flex::simd::sse2::extreme_element<sse2_ops, true>(data, last)), data + 18);
+    TS_ASSERT_EQUALS((flex::simd::sse2::extreme_element<sse2_ops, false>(data, last)), data + 17);
+    TS_ASSERT_EQUALS(flex::simd::sse2::count_less<sse2_ops>(data, last, 0LL), 9);
+#ifdef FLEX_HAS_AVX2
+    typedef flex::simd::avx2_ops<flex::simd::lane_i64> avx2_ops;
+    if (flex::simd::has_avx2())
+    {
+      TS_ASSERT_EQUALS(flex::simd::avx2::find<avx2_ops>(data, last, -6LL), data + 6);
+      TS_ASSERT_EQUALS((flex::simd::avx2::extreme_element<avx2_ops, true>(data, last)), data + 18);
+      TS_ASSERT_EQUALS((flex::simd::avx2::extreme_element<avx2_ops, false>(data, last)), data + 17);
+      TS_ASSERT_EQUALS(flex::simd::avx2::count_less<avx2_ops>(data, last, 0LL), 9);
+    }
+#endif
+#endif
+  }
+
+  void test_for_each_prefetched()
+  {
+    /*
+     * Case1: Every element of a list is visited in order, whatever the distance.
+     */
+    list<int> a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a.push_back(i);
+    }
+    for (size_t distance = 0; distance < 120; distance += 7)
+    {
+      sum s = flex::for_each_prefetched(a, sum(), distance);
+      TS_ASSERT_EQUALS(s.mCount, 100);
+      TS_ASSERT_EQUALS(s.mTotal, 4950);
+    }
+    list<int>::iterator middle = a.begin();
+    std::advance(middle, 50);
+    TS_ASSERT_EQUALS(flex::for_each_prefetched(a.begin(), middle, sum()).mTotal, 1225);
+    TS_ASSERT_EQUALS(flex::for_each_prefetched(middle, middle, sum()).mCount, 0);
+
+    /*
+     * Case2: A fixed_list may be modified through the function.
+     */
+    list<int>::iterator sixteen = a.begin();
+    std::advance(sixteen, 16);
+    flex::allocation_guard::enable();
+    fixed_list<int, 16> b(a.begin(), sixteen);
+    flex::for_each_prefetched(b, twice(), 2);
+    TS_ASSERT_EQUALS(b.front(), 0);
+    TS_ASSERT_EQUALS(*++b.begin(), 2);
+    const fixed_list<int, 16>& c = b;
+    TS_ASSERT_EQUALS(flex::for_each_prefetched(c, sum()).mTotal, 240);
+    flex::allocation_guard::disable();
+
+    /*
+     * Case3: Every element of a hash_map is visited, including those sharing a bucket.
+     */
+    hash_map<int, int> d;
+    for (int i = 0; i < 1000; ++i)
+    {
+      d[i * 37] = i;
+    }
+    d.rehash(64);
+    sum expected = std::for_each(d.begin(), d.end(), sum());
+    for (size_t distance = 0; distance < 80; distance += 9)
+    {
+      sum s = flex::for_each_prefetched(d, sum(), distance);
+      TS_ASSERT_EQUALS(s.mCount, 1000);
+      TS_ASSERT_EQUALS(s.mTotal, expected.mTotal);
+    }
+
+    /*
+     * Case4: A fixed_hash_map may be modified through the function.
+     */
+    fixed_hash_map<int, int, 32> e;
+    TS_ASSERT_EQUALS(flex::for_each_prefetched(e, sum()).mCount, 0);
+    for (int i = 0; i < 32; ++i)
+    {
+      e[i] = i;
+    }
+    flex::for_each_prefetched(e, twice());
+    const fixed_hash_map<int, int, 32>& f = e;
+    TS_ASSERT_EQUALS(flex::for_each_prefetched(f, sum()).mTotal, 496000LL + 992);
+  }
+
+};
@@ -0,0 +1,219 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/arena.h"
+#include "flex/vector.h"
+#include "flex/list.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class arena_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+    arena a;
+    TS_ASSERT_EQUALS(a.size(), 0);
+    TS_ASSERT_EQUALS(a.capacity(), 0);
+    TS_ASSERT_EQUALS(a.block_size(), FLEX_ARENA_BLOCK_SIZE);
+    TS_ASSERT(!a.fixed());
+
+    arena b(256);
+    TS_ASSERT_EQUALS(b.block_size(), 256);
+  }
+
+  void test_allocate()
+  {
+    /*
+     * Case1: Allocations are aligned and do not overlap.
+     */
+    arena a(256);
+    char* p1 = (char*) a.allocate(3);
+    char* p2 = (char*) a.allocate(5);
+    TS_ASSERT_EQUALS((size_t )p1 % FLEX_ARENA_ALIGNMENT, 0);
+    TS_ASSERT_EQUALS((size_t )p2 % FLEX_ARENA_ALIGNMENT, 0);
+    TS_ASSERT_LESS_THAN_EQUALS(p1 + 3, p2);
+    TS_ASSERT_EQUALS(a.capacity(), 256);
+
+    /*
+     * Case2: Block is exhausted and a new one is chained.
+     */
+    for (int i = 0; i < 32; ++i)
+    {
+      a.allocate(16);
+    }
+    TS_ASSERT_LESS_THAN(256, a.capacity());
+
+    /*
+     * Case3: Request larger than the block size.
+     */
+    size_t capacity = a.capacity();
+    char* p3 = (char*) a.allocate(1000);
+    p3[999] = 'a';
+    TS_ASSERT_LESS_THAN_EQUALS(capacity + 1000, a.capacity());
+  }
+
+  void test_reset()
+  {
+    arena a(128);
+    for (int i = 0; i < 32; ++i)
+    {
+      a.allocate(16);
+    }
+    size_t capacity = a.capacity();
+    TS_ASSERT_LESS_THAN(0, a.size());
+
+    /*
+     * Case1: Blocks are retained and reused after reset.
+     */
+    flex::allocation_guard::enable();
+    a.reset();
+    TS_ASSERT_EQUALS(a.size(), 0);
+    for (int i = 0; i < 32; ++i)
+    {
+      a.allocate(16);
+    }
+    TS_ASSERT_EQUALS(a.capacity(), capacity);
+    TS_ASSERT(!errno);
+
+    /*
+     * Case2: Exceeding the retained blocks reports to the guard.
+     */
+    for (int i = 0; i < 32; ++i)
+    {
+      a.allocate(16);
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+  }
+
+  void test_shrink_to_fit()
+  {
+    arena a(128);
+    for (int i = 0; i < 32; ++i)
+    {
+      a.allocate(16);
+    }
+    a.reset();
+    a.shrink_to_fit();
+    TS_ASSERT_EQUALS(a.capacity(), 128);
+  }
+
+  void test_fixed_arena()
+  {
+    /*
+     * Case1: Allocations come from the fixed buffer.
+     */
+    flex::allocation_guard::enable();
+    fixed_arena<256> a;
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.capacity(), 256);
+    for (int i = 0; i < 16; ++i)
+    {
+      a.allocate(16);
+    }
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.size(), 256);
+
+    /*
+     * Case2: Overflow spills to the heap and reports the error.
+     */
+    a.allocate(16);
+    TS_ASSERT(!a.fixed());
+    TS_ASSERT(errno);
+    errno = 0;
+
+    /*
+     * Case3: Reset returns to the fixed buffer.
+     */
+    a.reset();
+    TS_ASSERT(a.fixed());
+    a.shrink_to_fit();
+    TS_ASSERT_EQUALS(a.capacity(), 256);
+  }
+
+  void test_scope()
+  {
+    arena a;
+    arena b;
+    TS_ASSERT_EQUALS(arena::current(), (arena* )NULL);
+    {
+      arena_scope scope_a(a);
+      TS_ASSERT_EQUALS(arena::current(), &a);
+      {
+        arena_scope scope_b(b);
+        TS_ASSERT_EQUALS(arena::current(), &b);
+      }
+      TS_ASSERT_EQUALS(arena::current(), &a);
+    }
+    TS_ASSERT_EQUALS(arena::current(), (arena* )NULL);
+  }
+
+  void test_allocator()
+  {
+    /*
+     * Case1: Allocator without an arena uses the heap.
+     */
+    arena_allocator<int> heap;
+    TS_ASSERT_EQUALS(heap.get_arena(), (arena* )NULL);
+    int* ptr = heap.allocate(4);
+    heap.deallocate(ptr, 4);
+
+    /*
+     * Case2: Allocator draws from the arena in scope.
+     */
+    fixed_arena<256> a;
+    arena_scope scope(a);
+    arena_allocator<int> alloc;
+    TS_ASSERT_EQUALS(alloc.get_arena(), &a);
+    ptr = alloc.allocate(4);
+    TS_ASSERT_EQUALS(a.size(), 4 * sizeof(int));
+
+    /*
+     * Case3: Rebound copies share the arena.
+     */
+    arena_allocator<char> rebound(alloc);
+    TS_ASSERT_EQUALS(rebound.get_arena(), &a);
+    TS_ASSERT(rebound == alloc);
+    TS_ASSERT(heap != alloc);
+  }
+
+  void test_containers()
+  {
+    fixed_arena<4096> a;
+    flex::allocation_guard::enable();
+    {
+      arena_scope scope(a);
+      vector<obj, arena_allocator<obj> > v;
+      list<obj, arena_allocator<list_node<obj> > > l;
+      for (int i = 0; i < 64; ++i)
+      {
+        v.push_back(obj(i));
+        l.push_back(obj(i));
+      }
+      for (int i = 0; i < 64; ++i)
+      {
+        TS_ASSERT_EQUALS(v[i], i);
+      }
+      TS_ASSERT_EQUALS(l.back(), 63);
+    }
+    TS_ASSERT(a.fixed());
+    a.reset();
+    TS_ASSERT_EQUALS(a.size(), 0);
+  }
+
+};
@@ -0,0 +1,476 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_btree_map.h"
+#include "flex/debug/obj.h"
+
+#include <map>
+#include <stdlib.h>
+
+class btree_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::btree_map<int, obj> btree_map_obj;
+  typedef flex::btree_map<int, int> btree_map_int;
+  typedef flex::fixed_btree_map<int, obj, 64> fixed_btree_map_obj;
+  typedef flex::fixed_btree_map<int, int, 64> fixed_btree_map_int;
+
+  struct greater
+  {
+    bool operator()(int a, int b) const
+    {
+      return a > b;
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class Map>
+  bool is_container_valid(const Map& map, const int* expected, size_t n)
+  {
+    //Walks the map forward and backward, so both leaf links are checked, and finds every key from the root.
+    //Each mapped value is expected to be ten times its key.
+    size_t i = 0;
+    for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it, ++i)
+    {
+      if ((i >= n) || (it->first != expected[i]) || !(it->second == expected[i] * 10))
+      {
+        return false;
+      }
+    }
+    if (i != n)
+    {
+      return false;
+    }
+    for (typename Map::const_reverse_iterator it = map.rbegin(); it != map.rend(); ++it)
+    {
+      if (it->first != expected[--i])
+      {
+        return false;
+      }
+    }
+    for (i = 0; i < n; ++i)
+    {
+      if ((map.find(expected[i]) == map.end()) || (map.find(expected[i])->first != expected[i]))
+      {
+        return false;
+      }
+    }
+    return (map.size() == n) && (map.empty() == (n == 0));
+  }
+
+  template<class Map>
+  void fill(Map& map, const int* keys, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      map.insert(typename Map::value_type(keys[i], keys[i] * 10));
+    }
+  }
+
+  void test_insert_find()
+  {
+    btree_map_obj a;
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    TS_ASSERT(a.find(1) == a.end());
+
+    /*
+     * Case1: Inserts in any order iterate in key order.
+     */
+    const int keys[] = { 5, 1, 9, 3, 7 };
+    fill(a, keys, 5);
+    const int sorted[] = { 1, 3, 5, 7, 9 };
+    TS_ASSERT(is_container_valid(a, sorted, 5));
+
+    /*
+     * Case2: Inserting an existing key returns it unchanged.
+     */
+    std::pair<btree_map_obj::iterator, bool> result = a.insert(btree_map_obj::value_type(3, obj(99)));
+    TS_ASSERT(!result.second);
+    TS_ASSERT_EQUALS(result.first->first, 3);
+    TS_ASSERT(is_container_valid(a, sorted, 5));
+
+    /*
+     * Case3: find(), count() and at() only match present keys.
+     */
+    TS_ASSERT_EQUALS(a.find(7)->second, 70);
+    TS_ASSERT(a.find(4) == a.end());
+    TS_ASSERT(a.find(10) == a.end());
+    TS_ASSERT_EQUALS(a.count(9), 1);
+    TS_ASSERT_EQUALS(a.count(0), 0);
+    TS_ASSERT_EQUALS(a.at(1), 10);
+    TS_ASSERT_THROWS(a.at(2), std::out_of_range);
+
+    /*
+     * Case4: operator[] inserts missing keys.
+     */
+    a[4] = obj(40);
+    TS_ASSERT_EQUALS(a[4], 40);
+    const int indexed[] = { 1, 3, 4, 5, 7, 9 };
+    TS_ASSERT(is_container_valid(a, indexed, 6));
+
+    /*
+     * Case5: Enough ascending and descending inserts to split leaves and internal nodes alike.
+     */
+    int many[4000];
+    for (int i = 0; i < 4000; ++i)
+    {
+      many[i] = i;
+    }
+    btree_map_obj b;
+    btree_map_obj c;
+    for (int i = 0; i < 4000; ++i)
+    {
+      b[i] = obj(i * 10);
+      c[3999 - i] = obj((3999 - i) * 10);
+    }
+    TS_ASSERT(is_container_valid(b, many, 4000));
+    TS_ASSERT(is_container_valid(c, many, 4000));
+  }
+
+  void test_bounds()
+  {
+    const int keys[] = { 10, 20, 30, 40 };
+    btree_map_int a;
+    fill(a, keys, 4);
+
+    /*
+     * Case1: lower_bound() finds the first key not less, upper_bound() the first key greater.
+     */
+    TS_ASSERT_EQUALS(a.lower_bound(20)->first, 20);
+    TS_ASSERT_EQUALS(a.upper_bound(20)->first, 30);
+    TS_ASSERT_EQUALS(a.lower_bound(25)->first, 30);
+    TS_ASSERT_EQUALS(a.upper_bound(25)->first, 30);
+    TS_ASSERT(a.lower_bound(5) == a.begin());
+    TS_ASSERT(a.lower_bound(41) == a.end());
+    TS_ASSERT(a.upper_bound(40) == a.end());
+
+    /*
+     * Case2: equal_range() spans one element for a present key and none for a missing one.
+     */
+    std::pair<btree_map_int::iterator, btree_map_int::iterator> range = a.equal_range(30);
+    TS_ASSERT_EQUALS(std::distance(range.first, range.second), 1);
+    range = a.equal_range(35);
+    TS_ASSERT(range.first == range.second);
+
+    /*
+     * Case3: Bounds that fall between leaves land on the first element of the next leaf.
+     */
+    btree_map_int b;
+    for (int i = 0; i < 1000; ++i)
+    {
+      b[i * 2] = i;
+    }
+    for (int i = 0; i < 999; ++i)
+    {
+      TS_ASSERT_EQUALS(b.lower_bound(i * 2 + 1)->first, i * 2 + 2);
+      TS_ASSERT_EQUALS(b.upper_bound(i * 2)->first, i * 2 + 2);
+    }
+    TS_ASSERT(b.upper_bound(1998) == b.end());
+
+    /*
+     * Case4: A custom comparator orders the map and its bounds.
+     */
+    flex::btree_map<int, int, greater> c;
+    for (int i = 0; i < 500; ++i)
+    {
+      c.insert(std::make_pair(i, i));
+    }
+    TS_ASSERT_EQUALS(c.begin()->first, 499);
+    TS_ASSERT_EQUALS(c.lower_bound(200)->first, 200);
+    TS_ASSERT_EQUALS(c.upper_bound(200)->first, 199);
+    TS_ASSERT_EQUALS(c.rbegin()->first, 0);
+
+    /*
+     * Case5: Keys without a SIMD lane are searched the same way.
+     */
+    flex::btree_map<short, int> d;
+    for (short i = 0; i < 500; ++i)
+    {
+      d[i * 3] = i;
+    }
+    TS_ASSERT_EQUALS(d.lower_bound(301)->first, 303);
+    TS_ASSERT_EQUALS(d.find(300)->second, 100);
+    TS_ASSERT(d.find(301) == d.end());
+  }
+
+  void test_erase()
+  {
+    const int keys[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    btree_map_obj a;
+    fill(a, keys, 8);
+
+    /*
+     * Case1: erase() by key and by position.
+     */
+    TS_ASSERT_EQUALS(a.erase(4), 1);
+    TS_ASSERT_EQUALS(a.erase(4), 0);
+    btree_map_obj::iterator it = a.erase(a.begin());
+    TS_ASSERT_EQUALS(it->first, 2);
+    it = a.erase(a.find(8));
+    TS_ASSERT(it == a.end());
+    const int erased[] = { 2, 3, 5, 6, 7 };
+    TS_ASSERT(is_container_valid(a, erased, 5));
+
+    /*
+     * Case2: Erasing a range between bounds.
+     */
+    it = a.erase(a.lower_bound(3), a.upper_bound(6));
+    TS_ASSERT_EQUALS(it->first, 7);
+    const int ranged[] = { 2, 7 };
+    TS_ASSERT(is_container_valid(a, ranged, 2));
+
+    /*
+     * Case3: An empty range erases nothing, and a full range empties the map.
+     */
+    a.erase(a.begin(), a.begin());
+    TS_ASSERT(is_container_valid(a, ranged, 2));
+    it = a.erase(a.begin(), a.end());
+    TS_ASSERT(it == a.end());
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    fill(a, keys, 3);
+    TS_ASSERT(is_container_valid(a, keys, 3));
+
+    /*
+     * Case4: Erasing the last element of a map returns end(), so an erase loop stops there.
+     */
+    btree_map_obj::iterator last = a.begin();
+    while (last != a.end())
+    {
+      last = a.erase(last);
+    }
+    TS_ASSERT(last == a.end());
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+
+    /*
+     * Case5: Erasing every other element of a deep tree merges leaves and returns the following element.
+     */
+    btree_map_int b;
+    for (int i = 0; i < 4000; ++i)
+    {
+      b[i] = i * 10;
+    }
+    btree_map_int::iterator next = b.begin();
+    while (next != b.end())
+    {
+      const int key = next->first;
+      next = b.erase(next);
+      TS_ASSERT((next == b.end()) || (next->first == key + 1));
+      if (next != b.end())
+      {
+        ++next;
+      }
+    }
+    int odd[2000];
+    for (int i = 0; i < 2000; ++i)
+    {
+      odd[i] = i * 2 + 1;
+    }
+    TS_ASSERT(is_container_valid(b, odd, 2000));
+    while (!b.empty())
+    {
+      b.erase(--b.end());
+    }
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+  }
+
+  void test_random()
+  {
+    /*
+     * Case1: Random inserts and erases agree with std::map, including range erases.
+     */
+    btree_map_int a;
+    std::map<int, int> b;
+    srand(7);
+    for (int i = 0; i < 20000; ++i)
+    {
+      const int key = rand() % 5000;
+      switch (rand() % 4)
+      {
+      case 0:
+        TS_ASSERT_EQUALS(a.erase(key), b.erase(key));
+        break;
+      case 1:
+        if (i % 64 == 0)
+        {
+          a.erase(a.lower_bound(key), a.upper_bound(key + 100));
+          b.erase(b.lower_bound(key), b.upper_bound(key + 100));
+        }
+        break;
+      default:
+        TS_ASSERT_EQUALS(a.insert(std::make_pair(key, key)).second, b.insert(std::make_pair(key, key)).second);
+        break;
+      }
+    }
+    TS_ASSERT_EQUALS(a.size(), b.size());
+    std::map<int, int>::iterator it = b.begin();
+    for (btree_map_int::iterator jt = a.begin(); jt != a.end(); ++jt, ++it)
+    {
+      TS_ASSERT_EQUALS(jt->first, it->first);
+      TS_ASSERT_EQUALS(jt->second, it->second);
+    }
+    for (int key = 0; key < 5000; key += 7)
+    {
+      TS_ASSERT_EQUALS(a.lower_bound(key) == a.end(), b.lower_bound(key) == b.end());
+      TS_ASSERT_EQUALS(a.count(key), b.count(key));
+    }
+  }
+
+  void test_copy_swap()
+  {
+    const int lhs_values[] = { 1, 2, 3 };
+    const int rhs_values[] = { 4, 5 };
+    btree_map_obj a;
+    btree_map_obj b;
+    fill(a, lhs_values, 3);
+    fill(b, rhs_values, 2);
+
+    /*
+     * Case1: Copies compare equal.
+     */
+    btree_map_obj c(a);
+    TS_ASSERT(c == a);
+    TS_ASSERT(b != a);
+    c = b;
+    TS_ASSERT(is_container_valid(c, rhs_values, 2));
+
+    /*
+     * Case2: swap() exchanges the trees, including with an empty map.
+     */
+    a.swap(b);
+    TS_ASSERT(is_container_valid(a, rhs_values, 2));
+    TS_ASSERT(is_container_valid(b, lhs_values, 3));
+    btree_map_obj empty;
+    a.swap(empty);
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    TS_ASSERT(is_container_valid(empty, rhs_values, 2));
+    a[6] = obj(60);
+    empty[6] = obj(60);
+    const int inserted[] = { 4, 5, 6 };
+    TS_ASSERT(is_container_valid(empty, inserted, 3));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case3: Moves leave the source empty.
+     */
+    btree_map_obj d(std::move(b));
+    TS_ASSERT(is_container_valid(d, lhs_values, 3));
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+    btree_map_obj e = { { 4, obj(40) }, { 5, obj(50) } };
+    TS_ASSERT(is_container_valid(e, rhs_values, 2));
+#endif
+  }
+
+  void test_fixed()
+  {
+    /*
+     * Case1: A fixed_btree_map holds N elements without allocating, whatever order they come and go in.
+     */
+    flex::allocation_guard::enable();
+    fixed_btree_map_obj a;
+    TS_ASSERT(a.fixed());
+    for (int i = 0; i < 64; ++i)
+    {
+      a[i] = obj(i * 10);
+    }
+    for (int i = 0; i < 10000; ++i)
+    {
+      a.erase(a.begin());
+      a[i + 64] = obj((i + 64) * 10);
+    }
+    TS_ASSERT_EQUALS(a.size(), 64);
+    TS_ASSERT_EQUALS(a.begin()->first, 10000);
+    TS_ASSERT_EQUALS(a.rbegin()->first, 10063);
+    TS_ASSERT_EQUALS(a.find(10030)->second, 100300);
+
+    flex::fixed_btree_map<int, int, 2000> b;
+    srand(11);
+    for (int i = 0; i < 50000; ++i)
+    {
+      const int key = rand() % 4000;
+      if ((b.size() < 2000) && (rand() % 2))
+      {
+        b[key] = key;
+      }
+      else
+      {
+        b.erase(key);
+      }
+    }
+    TS_ASSERT(b.size() <= 2000);
+
+    /*
+     * Case2: Copying and swapping fixed maps copies the elements.
+     */
+    const int lhs_values[] = { 1, 3, 5 };
+    const int rhs_values[] = { 2, 4 };
+    fixed_btree_map_int c;
+    fixed_btree_map_int d;
+    fill(c, lhs_values, 3);
+    fill(d, rhs_values, 2);
+    c.swap(d);
+    TS_ASSERT(is_container_valid(c, rhs_values, 2));
+    TS_ASSERT(is_container_valid(d, lhs_values, 3));
+    fixed_btree_map_int e(d);
+    TS_ASSERT(e == d);
+
+    int values[64];
+    for (int i = 0; i < 64; ++i)
+    {
+      values[i] = i;
+    }
+    fixed_btree_map_int f;
+    fill(f, values, 64);
+    f.swap(e);
+    TS_ASSERT(is_container_valid(f, lhs_values, 3));
+    TS_ASSERT(is_container_valid(e, values, 64));
+    f.swap(e);
+    TS_ASSERT(is_container_valid(e, lhs_values, 3));
+    TS_ASSERT(is_container_valid(f, values, 64));
+
+    flex::allocation_guard::disable();
+    btree_map_int g(d);
+    e = c;
+    TS_ASSERT(is_container_valid(e, rhs_values, 2));
+    fixed_btree_map_int h(g);
+    TS_ASSERT(is_container_valid(h, lhs_values, 3));
+    g.swap(f);
+    TS_ASSERT(is_container_valid(g, values, 64));
+    TS_ASSERT(is_container_valid(f, lhs_values, 3));
+
+    /*
+     * Case3: The buffers hold LEAF_COUNT leaves and INTERNAL_COUNT internal nodes.
+     */
+    TS_ASSERT_EQUALS(fixed_btree_map_int::LEAF_COUNT, 64 / fixed_btree_map_int::LEAF_MIN + 1);
+    TS_ASSERT(sizeof(fixed_btree_map_int) >= fixed_btree_map_int::LEAF_COUNT * FLEX_CACHE_LINE_SIZE);
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Exceeding N elements reports once and falls back to the heap.
+     */
+    fixed_btree_map_int a;
+    for (int i = 0; i < 1000; ++i)
+    {
+      a[i] = i * 10;
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 1000);
+    TS_ASSERT_EQUALS(a.rbegin()->first, 999);
+    a.erase(a.begin(), a.find(990));
+    TS_ASSERT_EQUALS(a.size(), 10);
+  }
+
+};
@@ -0,0 +1,365 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/compact_fixed_list.h"
+#include "flex/fixed_list.h"
+#include "flex/debug/obj.h"
+
+class compact_fixed_list_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::compact_fixed_list<obj, 32> compact_list_obj;
+  typedef flex::compact_fixed_list<int, 32> compact_list_int;
+
+  struct is_odd
+  {
+    bool operator()(int x) const
+    {
+      return (x % 2);
+    }
+  };
+
+  //Sorts on val / 10 only, so elements with the same tens digit compare equal.
+  struct tens_less
+  {
+    bool operator()(const obj& a, const obj& b) const
+    {
+      return (a.val / 10) < (b.val / 10);
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class List>
+  bool is_container_valid(const List& list, const int* expected, size_t n)
+  {
+    //Walks the list in both directions, checking the links agree and every element is initialized.
+    size_t i = 0;
+    typename List::const_iterator prev = list.end();
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it, ++i)
+    {
+      typename List::const_iterator back(it);
+      if ((i >= n) || !(*it == expected[i]) || (--back != prev))
+      {
+        return false;
+      }
+      prev = it;
+    }
+    typename List::const_iterator last(list.end());
+    return (i == n) && (list.size() == n) && (list.empty() == (n == 0)) && ((n == 0) || (--last == prev));
+  }
+
+  void test_node_size()
+  {
+    /*
+     * Case1: The index type is the narrowest that can address the buffer.
+     */
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint32_t, 1000>::index_type), 2);
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint32_t, 65534>::index_type), 2);
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint32_t, 65535>::index_type), 4);
+
+    /*
+     * Case2: Nodes are a fraction of the size of a list node.
+     */
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint32_t, 1000>::node_type), 8);
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint32_t, 100000>::node_type), 12);
+    TS_ASSERT_EQUALS(sizeof(flex::compact_fixed_list<uint16_t, 1000>::node_type), 6);
+    TS_ASSERT(sizeof(flex::compact_fixed_list<uint16_t, 1000>::node_type) * 4 <= sizeof(flex::list_node<uint16_t>));
+  }
+
+  void test_push_pop()
+  {
+    flex::allocation_guard::enable();
+    compact_list_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 32);
+    TS_ASSERT_EQUALS(a.max_size(), 32);
+
+    /*
+     * Case1: Push to either end.
+     */
+    a.push_back(obj(2));
+    a.push_back(obj(3));
+    a.push_front(obj(1));
+    const int expected[] = { 1, 2, 3 };
+    TS_ASSERT(is_container_valid(a, expected, 3));
+    TS_ASSERT_EQUALS(a.front(), 1);
+    TS_ASSERT_EQUALS(a.back(), 3);
+
+    /*
+     * Case2: Pop from either end.  Popped nodes are reused.
+     */
+    a.pop_front();
+    a.pop_back();
+    TS_ASSERT(is_container_valid(a, expected + 1, 1));
+    for (int i = 0; i < 31; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(a.full());
+    TS_ASSERT_EQUALS(a.size(), 32);
+
+    /*
+     * Case3: Reverse iteration.
+     */
+    compact_list_obj::const_reverse_iterator it = a.crbegin();
+    TS_ASSERT_EQUALS(*it, 30);
+    TS_ASSERT_EQUALS(*++it, 29);
+    TS_ASSERT_EQUALS(std::distance(a.rbegin(), a.rend()), 32);
+  }
+
+  void test_constructors()
+  {
+    const int data[] = { 4, 8, 15, 16, 23, 42 };
+
+    /*
+     * Case1: Fill and range constructors.
+     */
+    compact_list_int a(3, 7);
+    const int sevens[] = { 7, 7, 7 };
+    TS_ASSERT(is_container_valid(a, sevens, 3));
+    compact_list_int b(data, data + 6);
+    TS_ASSERT(is_container_valid(b, data, 6));
+
+    /*
+     * Case2: Copy constructor and assignment.
+     */
+    compact_list_int c(b);
+    TS_ASSERT(is_container_valid(c, data, 6));
+    TS_ASSERT(c == b);
+    c = a;
+    TS_ASSERT(is_container_valid(c, sevens, 3));
+    TS_ASSERT(c != b);
+    TS_ASSERT(b < c);
+
+    /*
+     * Case3: Assign.
+     */
+    c.assign(data, data + 6);
+    TS_ASSERT(is_container_valid(c, data, 6));
+    c.assign(2, 7);
+    TS_ASSERT(is_container_valid(c, sevens, 2));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case4: Move constructor, move assignment and initializer lists.
+     */
+    compact_list_int d(std::move(b));
+    TS_ASSERT(b.empty());
+    TS_ASSERT(is_container_valid(d, data, 6));
+    b = std::move(d);
+    TS_ASSERT(d.empty());
+    TS_ASSERT(is_container_valid(b, data, 6));
+    compact_list_int e( { 4, 8, 15, 16, 23, 42 });
+    TS_ASSERT(e == b);
+    e = { 7, 7, 7};
+    TS_ASSERT(e == a);
+#endif
+  }
+
+  void test_insert_erase()
+  {
+    compact_list_obj a;
+    for (int i = 0; i < 8; ++i)
+    {
+      a.push_back(obj(i));
+    }
+
+    /*
+     * Case1: Erase a single element and a range.
+     */
+    compact_list_obj::iterator it = a.begin();
+    std::advance(it, 2);
+    it = a.erase(it);
+    TS_ASSERT_EQUALS(*it, 3);
+    compact_list_obj::iterator last = it;
+    std::advance(last, 3);
+    it = a.erase(it, last);
+    TS_ASSERT_EQUALS(*it, 6);
+    const int erased[] = { 0, 1, 6, 7 };
+    TS_ASSERT(is_container_valid(a, erased, 4));
+
+    /*
+     * Case2: Insert reuses the erased nodes.
+     */
+    it = a.insert(it, obj(5));
+    TS_ASSERT_EQUALS(*it, 5);
+    a.insert(a.begin(), 2, obj(9));
+    const int inserted[] = { 9, 9, 0, 1, 5, 6, 7 };
+    TS_ASSERT(is_container_valid(a, inserted, 7));
+
+    /*
+     * Case3: Resize in both directions.
+     */
+    a.resize(3);
+    TS_ASSERT(is_container_valid(a, inserted, 3));
+    a.resize(5, obj(1));
+    const int resized[] = { 9, 9, 0, 1, 1 };
+    TS_ASSERT(is_container_valid(a, resized, 5));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case4: Emplace.
+     */
+    a.emplace_back(8);
+    a.emplace_front(3);
+    a.emplace(++a.begin(), 4);
+    const int emplaced[] = { 3, 4, 9, 9, 0, 1, 1, 8 };
+    TS_ASSERT(is_container_valid(a, emplaced, 8));
+#endif
+
+    /*
+     * Case5: Clear.
+     */
+    a.clear();
+    TS_ASSERT(is_container_valid(a, inserted, 0));
+  }
+
+  void test_remove_unique_reverse()
+  {
+    const int data[] = { 1, 1, 2, 3, 3, 3, 4, 5, 5, 6 };
+    compact_list_int a(data, data + 10);
+
+    /*
+     * Case1: Unique.
+     */
+    a.unique();
+    const int unique[] = { 1, 2, 3, 4, 5, 6 };
+    TS_ASSERT(is_container_valid(a, unique, 6));
+
+    /*
+     * Case2: Remove and remove_if.
+     */
+    a.remove(4);
+    a.remove_if(is_odd());
+    const int evens[] = { 2, 6 };
+    TS_ASSERT(is_container_valid(a, evens, 2));
+
+    /*
+     * Case3: Reverse.
+     */
+    a.assign(unique, unique + 6);
+    a.reverse();
+    const int reversed[] = { 6, 5, 4, 3, 2, 1 };
+    TS_ASSERT(is_container_valid(a, reversed, 6));
+  }
+
+  void test_sort()
+  {
+    /*
+     * Case1: Sort every size up to capacity, with nodes scattered through the buffer.
+     */
+    for (int n = 0; n <= 32; ++n)
+    {
+      compact_list_int a;
+      int expected[32];
+      for (int i = 0; i < n; ++i)
+      {
+        const int val = (i * 37 + 11) % 23;
+        expected[i] = val;
+        if (i % 2)
+        {
+          a.push_back(val);
+        }
+        else
+        {
+          a.push_front(val);
+        }
+      }
+      std::sort(expected, expected + n);
+      a.sort();
+      TS_ASSERT(is_container_valid(a, expected, n));
+    }
+
+    /*
+     * Case2: Sorting is stable.
+     */
+    compact_list_obj b;
+    const int data[] = { 31, 12, 35, 10, 33, 17, 1, 14, 30 };
+    for (int i = 0; i < 9; ++i)
+    {
+      b.push_back(obj(data[i]));
+    }
+    b.sort(tens_less());
+    const int stable[] = { 1, 12, 10, 17, 14, 31, 35, 33, 30 };
+    TS_ASSERT(is_container_valid(b, stable, 9));
+  }
+
+  void test_merge_splice()
+  {
+    const int odds[] = { 1, 3, 5, 7 };
+    const int evens[] = { 0, 2, 4, 6, 8 };
+
+    /*
+     * Case1: Merge.
+     */
+    compact_list_int a(odds, odds + 4);
+    compact_list_int b(evens, evens + 5);
+    a.merge(b);
+    const int merged[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    TS_ASSERT(is_container_valid(a, merged, 9));
+    TS_ASSERT(b.empty());
+
+    /*
+     * Case2: Splice within a list relinks the nodes.
+     */
+    compact_list_int::iterator first = a.begin();
+    compact_list_int::iterator last = first;
+    std::advance(last, 3);
+    int* const addr = &*first;
+    a.splice(a.end(), a, first, last);
+    const int rotated[] = { 3, 4, 5, 6, 7, 8, 0, 1, 2 };
+    TS_ASSERT(is_container_valid(a, rotated, 9));
+    TS_ASSERT_EQUALS(&*first, addr);
+    a.splice(a.begin(), a, --a.end());
+    const int moved[] = { 2, 3, 4, 5, 6, 7, 8, 0, 1 };
+    TS_ASSERT(is_container_valid(a, moved, 9));
+
+    /*
+     * Case3: Splice from another list moves the values.
+     */
+    b.assign(odds, odds + 4);
+    a.splice(a.begin(), b, b.begin());
+    const int b_rest[] = { 3, 5, 7 };
+    TS_ASSERT(is_container_valid(b, b_rest, 3));
+    TS_ASSERT_EQUALS(a.front(), 1);
+    a.splice(a.end(), b);
+    TS_ASSERT(b.empty());
+    TS_ASSERT_EQUALS(a.size(), 13);
+    TS_ASSERT_EQUALS(a.back(), 7);
+
+    /*
+     * Case4: Swap lists of different sizes.
+     */
+    b.assign(odds, odds + 4);
+    a.resize(2);
+    a.swap(b);
+    TS_ASSERT(is_container_valid(a, odds, 4));
+    const int swapped[] = { 1, 2 };
+    TS_ASSERT(is_container_valid(b, swapped, 2));
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: The list cannot grow past its buffer.
+     */
+    flex::compact_fixed_list<int, 4> a(4, 1);
+    TS_ASSERT(a.full());
+    TS_ASSERT_THROWS(a.push_back(2), std::bad_alloc);
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 4);
+  }
+
+};
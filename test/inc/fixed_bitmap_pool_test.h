@@ -0,0 +1,170 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_bitmap_pool.h"
+#include "flex/fixed_vector.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class fixed_bitmap_pool_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::fixed_bitmap_pool<obj, 100> pool_obj;
+
+  struct collect
+  {
+    flex::fixed_vector<const obj*, 128>* mPtrs;
+
+    collect(flex::fixed_vector<const obj*, 128>& ptrs) :
+        mPtrs(&ptrs)
+    {
+    }
+
+    void operator()(const obj& val)
+    {
+      mPtrs->push_back(&val);
+    }
+  };
+
+  struct destruct_odd
+  {
+    pool_obj* mPool;
+
+    destruct_odd(pool_obj& p) :
+        mPool(&p)
+    {
+    }
+
+    void operator()(obj& val)
+    {
+      if (val.val % 2)
+      {
+        mPool->destruct(&val);
+      }
+    }
+  };
+
+  void setUp()
+  {
+    flex::allocation_guard::enable();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+    pool_obj a;
+    TS_ASSERT_EQUALS(a.size(), 100);
+    TS_ASSERT_EQUALS(a.capacity(), 100);
+    TS_ASSERT(!a.empty());
+  }
+
+  void test_allocate()
+  {
+    /*
+     * Case1: Objects are handed out in address order.
+     */
+    pool_obj a;
+    void* first = a.allocate();
+    for (int i = 1; i < 100; ++i)
+    {
+      void* ptr = a.allocate();
+      TS_ASSERT_EQUALS((obj* )ptr, (obj* )first + i);
+    }
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.size(), 0);
+
+    /*
+     * Case2: The lowest free object is reused first.
+     */
+    a.deallocate((obj*) first + 70);
+    a.deallocate((obj*) first + 5);
+    TS_ASSERT_EQUALS(a.size(), 2);
+    TS_ASSERT_EQUALS((obj* )a.allocate(), (obj* )first + 5);
+    TS_ASSERT_EQUALS((obj* )a.allocate(), (obj* )first + 70);
+  }
+
+  void test_overflow()
+  {
+    flex::allocation_guard::disable();
+    pool_obj a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a.allocate();
+    }
+    TS_ASSERT(!errno);
+    void* ptr = a.allocate();
+    TS_ASSERT(errno);
+    TS_ASSERT(!a.is_live((obj*) ptr));
+    a.deallocate(ptr);
+    errno = 0;
+  }
+
+  void test_construct()
+  {
+    pool_obj a;
+    obj* ptr = a.construct(obj(5));
+    TS_ASSERT_EQUALS(*ptr, 5);
+    TS_ASSERT(a.is_live(ptr));
+    a.destruct(ptr);
+    TS_ASSERT(!a.is_live(ptr));
+    TS_ASSERT_EQUALS(a.size(), 100);
+  }
+
+  void test_for_each_live()
+  {
+    /*
+     * Case1: Live objects are visited in address order.
+     */
+    pool_obj a;
+    obj* ptrs[100];
+    for (int i = 0; i < 100; ++i)
+    {
+      ptrs[i] = a.construct(obj(i));
+    }
+    for (int i = 0; i < 100; i += 3)
+    {
+      a.destruct(ptrs[i]);
+    }
+
+    flex::fixed_vector<const obj*, 128> visited;
+    a.for_each_live(collect(visited));
+    TS_ASSERT_EQUALS(visited.size(), 66);
+    for (size_t i = 1; i < visited.size(); ++i)
+    {
+      TS_ASSERT_LESS_THAN(visited[i - 1], visited[i]);
+    }
+    for (size_t i = 0; i < visited.size(); ++i)
+    {
+      TS_ASSERT(visited[i]->val % 3);
+    }
+
+    /*
+     * Case2: Objects may be destructed while they are visited.
+     */
+    a.for_each_live(destruct_odd(a));
+    visited.clear();
+    a.for_each_live(collect(visited));
+    TS_ASSERT_EQUALS(visited.size(), 33);
+    for (size_t i = 0; i < visited.size(); ++i)
+    {
+      TS_ASSERT_EQUALS(visited[i]->val % 2, 0);
+    }
+
+    /*
+     * Case3: Const pool.
+     */
+    const pool_obj& b = a;
+    visited.clear();
+    b.for_each_live(collect(visited));
+    TS_ASSERT_EQUALS(visited.size(), 33);
+  }
+
+};
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_flat_map.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class fixed_flat_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::fixed_flat_map<int, obj, 16> map_obj;
+
+  void setUp()
+  {
+    flex::allocation_guard::enable();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_insert()
+  {
+    map_obj a;
+    for (int i = 15; i >= 0; --i)
+    {
+      a[i] = obj(i);
+    }
+    TS_ASSERT_EQUALS(a.size(), 16);
+    TS_ASSERT(a.keys().fixed());
+    TS_ASSERT(a.values().fixed());
+    for (int i = 0; i < 16; ++i)
+    {
+      TS_ASSERT_EQUALS(a.keys()[i], i);
+      TS_ASSERT_EQUALS(a.values()[i], i);
+    }
+  }
+
+  void test_insert_range()
+  {
+    /*
+     * Case1: Bulk insert doesn't allocate, and the first occurrence of a repeated key wins.
+     */
+    std::pair<int, obj> data[] = { std::make_pair(3, obj(3)), std::make_pair(1, obj(1)), std::make_pair(2, obj(2)),
+        std::make_pair(3, obj(30)) };
+    map_obj a(data, data + 4);
+    TS_ASSERT_EQUALS(a.size(), 3);
+    TS_ASSERT(a.keys().fixed());
+    TS_ASSERT_EQUALS(a.begin()->first, 1);
+    TS_ASSERT_EQUALS(a.at(3), 3);
+
+    std::pair<int, obj> mixed[] = { std::make_pair(9, obj(9)), std::make_pair(2, obj(20)), std::make_pair(0, obj(0)),
+        std::make_pair(9, obj(90)), std::make_pair(5, obj(5)), std::make_pair(0, obj(-1)) };
+    a.insert(mixed, mixed + 6);
+    TS_ASSERT_EQUALS(a.size(), 6);
+    const int keys[] = { 0, 1, 2, 3, 5, 9 };
+    const int values[] = { 0, 1, 2, 3, 5, 9 };
+    TS_ASSERT(std::equal(keys, keys + 6, a.keys().begin()));
+    TS_ASSERT(std::equal(values, values + 6, a.values().begin()));
+
+    /*
+     * Case2: Overflow is reported.
+     */
+    flex::allocation_guard::disable();
+    std::pair<int, obj> more[14];
+    for (int i = 0; i < 14; ++i)
+    {
+      more[i] = std::make_pair(10 + i, obj(i));
+    }
+    a.insert(more, more + 14);
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 20);
+    TS_ASSERT_EQUALS(a.at(23), 13);
+  }
+
+  void test_find()
+  {
+    map_obj a;
+    a[5] = obj(50);
+    a[7] = obj(70);
+    TS_ASSERT_EQUALS(a.find(7)->second, 70);
+    TS_ASSERT(a.find(6) == a.end());
+    a.erase(5);
+    TS_ASSERT_EQUALS(a.size(), 1);
+  }
+
+  void test_copy()
+  {
+    map_obj a;
+    a[1] = obj(1);
+    map_obj b(a);
+    TS_ASSERT(a == b);
+    TS_ASSERT(b.keys().fixed());
+  }
+
+};
@@ -0,0 +1,70 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_flat_set.h"
+
+using namespace flex;
+
+class fixed_flat_set_test: public CxxTest::TestSuite
+{
+public:
+
+  void setUp()
+  {
+    flex::allocation_guard::enable();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_insert()
+  {
+    fixed_flat_set<int, 8> a;
+    for (int i = 7; i >= 0; --i)
+    {
+      a.insert(i);
+    }
+    TS_ASSERT_EQUALS(a.size(), 8);
+    TS_ASSERT(a.keys().fixed());
+    TS_ASSERT_EQUALS(*a.begin(), 0);
+
+    /*
+     * Case1: Overflow is reported.
+     */
+    flex::allocation_guard::disable();
+    a.insert(8);
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 9);
+  }
+
+  void test_insert_range()
+  {
+    /*
+     * Case1: Bulk insert doesn't allocate and drops repeated and existing keys, even when the repeats alone
+     * would overflow the buffer.
+     */
+    fixed_flat_set<int, 8> a;
+    a.insert(4);
+    a.insert(1);
+    const int data[] = { 6, 1, 3, 6, 0, 6, 3, 6, 3, 4, 7, 7, 7, 7, 0, 7 };
+    a.insert(data, data + 16);
+    TS_ASSERT_EQUALS(a.size(), 6);
+    TS_ASSERT(a.keys().fixed());
+    const int keys[] = { 0, 1, 3, 4, 6, 7 };
+    TS_ASSERT(std::equal(keys, keys + 6, a.begin()));
+  }
+
+  void test_find()
+  {
+    fixed_flat_set<int, 8> a;
+    a.insert(4);
+    a.insert(2);
+    TS_ASSERT_EQUALS(*a.find(4), 4);
+    TS_ASSERT(a.find(3) == a.end());
+  }
+
+};
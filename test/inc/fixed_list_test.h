@@ -4,6 +4,8 @@
 #include "flex/debug/allocator.h"
 #include "flex/debug/obj.h"
 
+#include <algorithm>
+
 class fixed_list_test: public CxxTest::TestSuite
 {
   typedef flex::debug::obj obj;
@@ -1332,6 +1334,28 @@ public:
     TS_ASSERT(is_container_valid(a));
   }
 
+  struct int_key
+  {
+    int operator()(const obj& o) const
+    {
+      return o.val;
+    }
+  };
+
+  void test_radix_sort(void)
+  {
+    /*
+     * Case1: Radix sort relinks the nodes in place, without allocating.
+     */
+    fixed_list_obj a(OBJ_DATA, OBJ_DATA + 128);
+    obj expected[128];
+    std::copy(OBJ_DATA, OBJ_DATA + 128, expected);
+    std::sort(expected, expected + 128);
+    a.radix_sort(int_key());
+    TS_ASSERT(std::equal(a.begin(), a.end(), expected));
+    TS_ASSERT(is_container_valid(a));
+  }
+
   struct is_less_than
   {
     bool operator()(int a, int b)
@@ -0,0 +1,339 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_lru_cache.h"
+#include "flex/debug/obj.h"
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+class fixed_lru_cache_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  //Records the keys and values it is called with.
+  struct recorder
+  {
+    recorder() :
+        keys(NULL)
+    {
+    }
+
+    explicit recorder(std::vector<int>* k) :
+        keys(k)
+    {
+    }
+
+    void operator()(const int& key, obj& val)
+    {
+      keys->push_back(key);
+      keys->push_back(val.val);
+    }
+
+    std::vector<int>* keys;
+  };
+
+  typedef flex::fixed_lru_cache<int, obj, 4> cache_obj;
+  typedef flex::fixed_lru_cache<int, obj, 4, std::hash<int>, std::equal_to<int>, recorder> recording_cache;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  //Checks the keys run from the most to the least recently used, and that each maps to 10 times its key.
+  template<class Cache>
+  bool is_container_valid(const Cache& cache, const int* keys, size_t n)
+  {
+    size_t i = 0;
+    for (typename Cache::const_iterator it = cache.begin(); it != cache.end(); ++it, ++i)
+    {
+      if ((i >= n) || (it->first != keys[i]) || !(it->second == keys[i] * 10) || !cache.contains(keys[i]))
+      {
+        return false;
+      }
+    }
+    return (i == n) && (cache.size() == n) && (cache.empty() == (n == 0)) && (cache.full() == (n == cache.capacity()));
+  }
+
+  void test_get_put()
+  {
+    flex::allocation_guard::enable();
+    cache_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 4);
+    TS_ASSERT_EQUALS(cache_obj::BUCKET_COUNT, 4);
+
+    /*
+     * Case1: put() inserts entries as the most recently used.
+     */
+    for (int i = 1; i <= 3; ++i)
+    {
+      TS_ASSERT_EQUALS(a.put(i, obj(i * 10)), i * 10);
+    }
+    const int inserted[] = { 3, 2, 1 };
+    TS_ASSERT(is_container_valid(a, inserted, 3));
+
+    /*
+     * Case2: get() refreshes a hit and counts hits and misses.
+     */
+    obj* val = a.get(1);
+    TS_ASSERT(val);
+    TS_ASSERT_EQUALS(*val, 10);
+    TS_ASSERT(!a.get(4));
+    TS_ASSERT(!a.get(5));
+    const int refreshed[] = { 1, 3, 2 };
+    TS_ASSERT(is_container_valid(a, refreshed, 3));
+    TS_ASSERT_EQUALS(a.hits(), 1);
+    TS_ASSERT_EQUALS(a.misses(), 2);
+
+    /*
+     * Case3: peek() and contains() leave the order and the counters alone.
+     */
+    TS_ASSERT_EQUALS(*a.peek(2), 20);
+    TS_ASSERT(!a.peek(4));
+    TS_ASSERT(a.contains(2));
+    TS_ASSERT(!a.contains(4));
+    TS_ASSERT(is_container_valid(a, refreshed, 3));
+    TS_ASSERT_EQUALS(a.hits(), 1);
+    TS_ASSERT_EQUALS(a.misses(), 2);
+
+    /*
+     * Case4: put() on an existing key replaces the value and refreshes it.
+     */
+    a.put(2, obj(0));
+    TS_ASSERT_EQUALS(*a.peek(2), 0);
+    a.put(2, obj(20));
+    const int replaced[] = { 2, 1, 3 };
+    TS_ASSERT(is_container_valid(a, replaced, 3));
+
+    /*
+     * Case5: touch() refreshes without counting.
+     */
+    TS_ASSERT(a.touch(3));
+    TS_ASSERT(!a.touch(4));
+    const int touched[] = { 3, 2, 1 };
+    TS_ASSERT(is_container_valid(a, touched, 3));
+    TS_ASSERT_EQUALS(a.hits(), 1);
+
+    a.reset_stats();
+    TS_ASSERT_EQUALS(a.hits(), 0);
+    TS_ASSERT_EQUALS(a.misses(), 0);
+  }
+
+  void test_eviction()
+  {
+    flex::allocation_guard::enable();
+    std::vector<int> evicted;
+    evicted.reserve(16);
+    recording_cache a((recorder(&evicted)));
+    for (int i = 1; i <= 4; ++i)
+    {
+      a.put(i, obj(i * 10));
+    }
+    TS_ASSERT(a.full());
+
+    /*
+     * Case1: A put into a full cache evicts the least recently used entry.
+     */
+    a.put(5, obj(50));
+    TS_ASSERT_EQUALS(evicted.size(), 2);
+    TS_ASSERT_EQUALS(evicted[0], 1);
+    TS_ASSERT_EQUALS(evicted[1], 10);
+    TS_ASSERT_EQUALS(a.evictions(), 1);
+    const int first[] = { 5, 4, 3, 2 };
+    TS_ASSERT(is_container_valid(a, first, 4));
+
+    /*
+     * Case2: Refreshed entries are evicted last.
+     */
+    a.get(2);
+    a.touch(3);
+    a.put(6, obj(60));
+    a.put(7, obj(70));
+    TS_ASSERT_EQUALS(evicted.size(), 6);
+    TS_ASSERT_EQUALS(evicted[2], 4);
+    TS_ASSERT_EQUALS(evicted[4], 5);
+    TS_ASSERT_EQUALS(a.evictions(), 3);
+    const int second[] = { 7, 6, 3, 2 };
+    TS_ASSERT(is_container_valid(a, second, 4));
+
+    /*
+     * Case3: Replacing a value in a full cache does not evict.
+     */
+    a.put(2, obj(20));
+    TS_ASSERT_EQUALS(a.evictions(), 3);
+
+    /*
+     * Case4: erase() and clear() are not evictions.
+     */
+    TS_ASSERT(a.erase(6));
+    TS_ASSERT(!a.erase(6));
+    const int erased[] = { 2, 7, 3 };
+    TS_ASSERT(is_container_valid(a, erased, 3));
+    a.put(8, obj(80));
+    TS_ASSERT_EQUALS(a.evictions(), 3);
+    a.clear();
+    TS_ASSERT(is_container_valid(a, erased, 0));
+    TS_ASSERT_EQUALS(evicted.size(), 6);
+    TS_ASSERT_EQUALS(a.evictions(), 3);
+    a.reset_stats();
+    TS_ASSERT_EQUALS(a.evictions(), 0);
+  }
+
+  void test_put_evicted_value()
+  {
+    typedef flex::fixed_lru_cache<int, std::string, 2> string_cache;
+    const std::string one("a value long enough to live on the heap, 1");
+    const std::string two("a value long enough to live on the heap, 2");
+
+    /*
+     * Case1: put() may copy the value of the entry it evicts.
+     */
+    string_cache a;
+    a.put(1, one);
+    a.put(2, two);
+    a.put(3, *a.peek(1));
+    TS_ASSERT(!a.contains(1));
+    TS_ASSERT_EQUALS(*a.peek(3), one);
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case2: put() may move the value of the entry it evicts.
+     */
+    a.put(4, std::move(*a.peek(2)));
+    TS_ASSERT(!a.contains(2));
+    TS_ASSERT_EQUALS(*a.peek(4), two);
+#endif
+  }
+
+  void test_collisions()
+  {
+    /*
+     * Case1: Keys sharing a stride spread over the buckets and are all found.
+     */
+    flex::fixed_lru_cache<int, int, 64> a;
+    for (int i = 0; i < 64; ++i)
+    {
+      a.put(i * 1024, i);
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+      TS_ASSERT_EQUALS(*a.get(i * 1024), i);
+    }
+
+    /*
+     * Case2: Erasing from the middle of a chain keeps the rest reachable.
+     */
+    for (int i = 0; i < 64; i += 2)
+    {
+      TS_ASSERT(a.erase(i * 1024));
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+      TS_ASSERT_EQUALS(a.contains(i * 1024), (i % 2) == 1);
+    }
+    TS_ASSERT_EQUALS(a.size(), 32);
+  }
+
+  void test_copy()
+  {
+    cache_obj a;
+    for (int i = 1; i <= 4; ++i)
+    {
+      a.put(i, obj(i * 10));
+    }
+    a.get(1);
+    a.get(9);
+
+    /*
+     * Case1: Copies keep the recency order and the counters.
+     */
+    cache_obj b(a);
+    const int expected[] = { 1, 4, 3, 2 };
+    TS_ASSERT(is_container_valid(b, expected, 4));
+    TS_ASSERT_EQUALS(b.hits(), 1);
+    TS_ASSERT_EQUALS(b.misses(), 1);
+
+    cache_obj c;
+    c.put(7, obj(70));
+    c = a;
+    TS_ASSERT(is_container_valid(c, expected, 4));
+    TS_ASSERT_EQUALS(c.evictions(), 0);
+  }
+
+  void test_random()
+  {
+    /*
+     * Case1: Matches a cache built from std::list and std::map over a random mix of operations.
+     */
+    flex::fixed_lru_cache<int, int, 50> a;
+    std::list<std::pair<int, int> > order;
+    std::map<int, std::list<std::pair<int, int> >::iterator> index;
+    size_t evictions = 0;
+
+    unsigned seed = 1;
+    for (int step = 0; step < 20000; ++step)
+    {
+      seed = seed * 1103515245u + 12345u;
+      const int key = (seed >> 16) % 80;
+      const int op = (seed >> 8) % 4;
+      std::map<int, std::list<std::pair<int, int> >::iterator>::iterator it = index.find(key);
+      if (op < 2)
+      {
+        if (it != index.end())
+        {
+          order.erase(it->second);
+        }
+        else if (order.size() == 50)
+        {
+          index.erase(order.back().first);
+          order.pop_back();
+          ++evictions;
+        }
+        order.push_front(std::make_pair(key, step));
+        index[key] = order.begin();
+        a.put(key, step);
+      }
+      else if (op == 2)
+      {
+        int* val = a.get(key);
+        TS_ASSERT_EQUALS(val != NULL, it != index.end());
+        if (it != index.end())
+        {
+          TS_ASSERT_EQUALS(*val, it->second->second);
+          order.splice(order.begin(), order, it->second);
+        }
+      }
+      else
+      {
+        TS_ASSERT_EQUALS(a.erase(key), it != index.end());
+        if (it != index.end())
+        {
+          order.erase(it->second);
+          index.erase(it);
+        }
+      }
+    }
+
+    TS_ASSERT_EQUALS(a.size(), order.size());
+    TS_ASSERT_EQUALS(a.evictions(), evictions);
+    flex::fixed_lru_cache<int, int, 50>::iterator cache_it = a.begin();
+    for (std::list<std::pair<int, int> >::iterator list_it = order.begin(); list_it != order.end(); ++list_it)
+    {
+      TS_ASSERT_EQUALS(cache_it->first, list_it->first);
+      TS_ASSERT_EQUALS(cache_it->second, list_it->second);
+      ++cache_it;
+    }
+  }
+
+};
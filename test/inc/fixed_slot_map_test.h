@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_slot_map.h"
+#include "flex/debug/allocator.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class fixed_slot_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::fixed_slot_map<obj, 16, flex::debug::allocator<obj> > map_obj;
+  typedef map_obj::handle_type handle_type;
+
+  void setUp()
+  {
+    flex::allocation_guard::enable();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+    map_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.capacity(), 16);
+    TS_ASSERT_EQUALS(a.max_size(), 16);
+  }
+
+  void test_insert_erase()
+  {
+    /*
+     * Case1: Filling and churning the container never allocates.
+     */
+    map_obj a;
+    handle_type h[16];
+    for (int round = 0; round < 4; ++round)
+    {
+      for (int i = 0; i < 16; ++i)
+      {
+        h[i] = a.insert(obj(i));
+      }
+      TS_ASSERT_EQUALS(a.size(), 16);
+      for (int i = 0; i < 16; i += 2)
+      {
+        TS_ASSERT(a.erase(h[i]));
+      }
+      for (int i = 1; i < 16; i += 2)
+      {
+        TS_ASSERT_EQUALS(a[h[i]], i);
+      }
+      a.clear();
+    }
+    TS_ASSERT(a.fixed());
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Overflow spills to the heap and keeps handles valid.
+     */
+    flex::allocation_guard::disable();
+    map_obj a;
+    handle_type h[17];
+    for (int i = 0; i < 16; ++i)
+    {
+      h[i] = a.insert(obj(i));
+    }
+    TS_ASSERT(!errno);
+    h[16] = a.insert(obj(16));
+    TS_ASSERT(errno);
+    TS_ASSERT(!a.fixed());
+    for (int i = 0; i < 17; ++i)
+    {
+      TS_ASSERT_EQUALS(a[h[i]], i);
+    }
+    errno = 0;
+  }
+
+  void test_copy()
+  {
+    map_obj a;
+    handle_type h = a.insert(obj(4));
+    map_obj b(a);
+    TS_ASSERT(b.fixed());
+    TS_ASSERT_EQUALS(b[h], 4);
+    TS_ASSERT_DIFFERS(b.find(h), a.find(h));
+
+    map_obj c;
+    c = a;
+    TS_ASSERT_EQUALS(c[h], 4);
+  }
+
+};
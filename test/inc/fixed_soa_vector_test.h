@@ -0,0 +1,100 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_soa_vector.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class fixed_soa_vector_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    flex::allocation_guard::enable();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+#ifdef FLEX_HAS_CXX11
+    fixed_soa_vector<16, int, double> a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.capacity(), 16);
+    TS_ASSERT_EQUALS((size_t ) a.data<1>() % alignof(std::max_align_t), 0);
+#endif
+  }
+
+  void test_push_back()
+  {
+#ifdef FLEX_HAS_CXX11
+    fixed_soa_vector<16, int, obj> a;
+    for (int i = 0; i < 16; ++i)
+    {
+      a.emplace_back(i, obj(i));
+    }
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.get<1>(15), 15);
+
+    /*
+     * Case1: Overflow is reported and continues on the heap.
+     */
+    flex::allocation_guard::disable();
+    a.emplace_back(16, obj(16));
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT(!a.fixed());
+    for (int i = 0; i < 17; ++i)
+    {
+      TS_ASSERT_EQUALS(a.get<0>(i), i);
+      TS_ASSERT_EQUALS(a.get<1>(i), i);
+    }
+#endif
+  }
+
+  void test_copy()
+  {
+#ifdef FLEX_HAS_CXX11
+    fixed_soa_vector<16, int, obj> a(4, std::make_tuple(1, obj(2)));
+    fixed_soa_vector<16, int, obj> b(a);
+    TS_ASSERT(b.fixed());
+    TS_ASSERT(a == b);
+
+    fixed_soa_vector<16, int, obj> c(8);
+    c = a;
+    TS_ASSERT(a == c);
+#endif
+  }
+
+  void test_move()
+  {
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case1: Rows are moved between fixed buffers.
+     */
+    fixed_soa_vector<16, int, obj> a(4, std::make_tuple(1, obj(2)));
+    fixed_soa_vector<16, int, obj> b(std::move(a));
+    TS_ASSERT(b.fixed());
+    TS_ASSERT_EQUALS(b.size(), 4);
+    TS_ASSERT(a.empty());
+
+    /*
+     * Case2: Move into a heap container.
+     */
+    flex::allocation_guard::disable();
+    soa_vector<int, obj> c(std::move(b));
+    TS_ASSERT_EQUALS(c.size(), 4);
+    TS_ASSERT_EQUALS(c.get<1>(3), 2);
+#endif
+  }
+
+};
@@ -6,6 +6,25 @@ class fixed_string_test: public CxxTest::TestSuite
 {
   typedef flex::fixed_string<16> str;
 
+  //Copies up to mCount characters of mSrc into the window, like read() would.
+  struct reader
+  {
+    const char* mSrc;
+    size_t mCount;
+
+    reader(const char* src, size_t count) :
+        mSrc(src), mCount(count)
+    {
+    }
+
+    size_t operator()(char* p, size_t n)
+    {
+      size_t count = (n < mCount) ? n : mCount;
+      memcpy(p, mSrc, count);
+      return count;
+    }
+  };
+
 public:
 
   void setUp()
@@ -269,6 +288,26 @@ public:
     TS_ASSERT_EQUALS(a.c_str(), "01234567");
   }
 
+  void test_append_with()
+  {
+    /*
+     * Case1: Window fits within the fixed buffer.
+     */
+    str a("0123");
+    TS_ASSERT_EQUALS(a.append_with(12, reader("4567", 4)), 4);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.c_str(), "01234567");
+
+    /*
+     * Case2: Window exceeds the fixed buffer.
+     */
+    flex::allocation_guard::disable();
+    TS_ASSERT_EQUALS(a.append_with(32, reader("89", 2)), 2);
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.c_str(), "0123456789");
+  }
+
   void test_assign_string()
   {
     /*
@@ -0,0 +1,226 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/flat_map.h"
+#include "flex/debug/obj.h"
+
+#include <map>
+
+using namespace flex;
+
+class flat_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::flat_map<int, obj> map_obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  bool is_container_valid(const map_obj& c)
+  {
+    for (size_t i = 1; i < c.size(); ++i)
+    {
+      if (!(c.keys()[i - 1] < c.keys()[i]))
+      {
+        printf("Error: Expected (c.keys()[i - 1] < c.keys()[i]) when i=%zu\n", i);
+        return false;
+      }
+    }
+    if (c.keys().size() != c.values().size())
+    {
+      printf("Error: Expected (c.keys().size() == c.values().size())\n");
+      return false;
+    }
+    return true;
+  }
+
+  void test_branchless_search()
+  {
+    int a[] = { 1, 3, 3, 3, 5, 8, 13, 21 };
+    for (int n = 0; n <= 8; ++n)
+    {
+      for (int val = 0; val < 23; ++val)
+      {
+        TS_ASSERT_EQUALS(branchless_lower_bound(a, a + n, val), std::lower_bound(a, a + n, val));
+        TS_ASSERT_EQUALS(branchless_upper_bound(a, a + n, val), std::upper_bound(a, a + n, val));
+      }
+    }
+  }
+
+  void test_insert()
+  {
+    map_obj a;
+
+    /*
+     * Case1: New keys are inserted in order.
+     */
+    TS_ASSERT(a.insert(std::make_pair(5, obj(50))).second);
+    TS_ASSERT(a.insert(std::make_pair(1, obj(10))).second);
+    TS_ASSERT(a.insert(std::make_pair(3, obj(30))).second);
+    TS_ASSERT_EQUALS(a.size(), 3);
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Existing keys are not replaced.
+     */
+    std::pair<map_obj::iterator, bool> ret = a.insert(std::make_pair(3, obj(31)));
+    TS_ASSERT(!ret.second);
+    TS_ASSERT_EQUALS(ret.first->first, 3);
+    TS_ASSERT_EQUALS(ret.first->second, 30);
+    TS_ASSERT_EQUALS(a.size(), 3);
+  }
+
+  void test_insert_range()
+  {
+    map_obj a;
+    a.insert(std::make_pair(10, obj(100)));
+    a.insert(std::make_pair(20, obj(200)));
+    a.insert(std::make_pair(30, obj(300)));
+
+    /*
+     * Case1: Unsorted keys, repeats and existing keys.  The first occurrence wins.
+     */
+    std::pair<int, obj> data[] = { std::make_pair(25, obj(250)), std::make_pair(5, obj(50)), std::make_pair(20, obj(
+        201)), std::make_pair(35, obj(350)), std::make_pair(5, obj(51)), std::make_pair(15, obj(150)) };
+    a.insert(data, data + 6);
+    TS_ASSERT_EQUALS(a.size(), 7);
+    TS_ASSERT(is_container_valid(a));
+    int keys[] = { 5, 10, 15, 20, 25, 30, 35 };
+    int i = 0;
+    for (map_obj::iterator it = a.begin(); it != a.end(); ++it, ++i)
+    {
+      TS_ASSERT_EQUALS(it->first, keys[i]);
+      TS_ASSERT_EQUALS((*it).second, keys[i] * 10);
+    }
+
+    /*
+     * Case2: Matches std::map on random data.
+     */
+    std::map<int, int> expected;
+    flat_map<int, int> b;
+    vector<std::pair<int, int> > batch;
+    srand(7);
+    for (int round = 0; round < 10; ++round)
+    {
+      batch.clear();
+      for (int j = 0; j < 50; ++j)
+      {
+        std::pair<int, int> val(rand() % 200, j);
+        batch.push_back(val);
+        expected.insert(val);
+      }
+      b.insert(batch.begin(), batch.end());
+    }
+    TS_ASSERT_EQUALS(b.size(), expected.size());
+    size_t n = 0;
+    for (std::map<int, int>::iterator it = expected.begin(); it != expected.end(); ++it, ++n)
+    {
+      TS_ASSERT_EQUALS(b.keys()[n], it->first);
+      TS_ASSERT_EQUALS(b.at(it->first), it->second);
+    }
+  }
+
+  void test_find()
+  {
+    map_obj a;
+    for (int i = 0; i < 20; i += 2)
+    {
+      a[i] = obj(i);
+    }
+
+    TS_ASSERT_EQUALS(a.find(4)->second, 4);
+    TS_ASSERT(a.find(5) == a.end());
+    TS_ASSERT_EQUALS(a.count(6), 1);
+    TS_ASSERT_EQUALS(a.count(7), 0);
+    TS_ASSERT_EQUALS(a.lower_bound(5)->first, 6);
+    TS_ASSERT_EQUALS(a.upper_bound(6)->first, 8);
+    TS_ASSERT_EQUALS(a.equal_range(6).second - a.equal_range(6).first, 1);
+    TS_ASSERT_EQUALS(a.equal_range(7).second - a.equal_range(7).first, 0);
+    TS_ASSERT_EQUALS(a.at(18), 18);
+    TS_ASSERT_THROWS(a.at(19), std::out_of_range);
+
+    const map_obj& b = a;
+    TS_ASSERT_EQUALS(b.find(2)->second, 2);
+    TS_ASSERT(b.find(3) == b.end());
+  }
+
+  void test_operator_index()
+  {
+    map_obj a;
+    a[3] = obj(3);
+    a[1].val = 1;
+    TS_ASSERT_EQUALS(a.size(), 2);
+    TS_ASSERT_EQUALS(a[1], 1);
+    TS_ASSERT_EQUALS(a[3], 3);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_erase()
+  {
+    map_obj a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a[i] = obj(i);
+    }
+
+    TS_ASSERT_EQUALS(a.erase(3), 1);
+    TS_ASSERT_EQUALS(a.erase(3), 0);
+    map_obj::iterator it = a.erase(a.find(5));
+    TS_ASSERT_EQUALS(it->first, 6);
+    it = a.erase(a.find(7), a.end());
+    TS_ASSERT(it == a.end());
+    TS_ASSERT_EQUALS(a.size(), 5);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_iterator()
+  {
+    map_obj a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a[i] = obj(i);
+    }
+
+    /*
+     * Case1: Values are written through the iterator.
+     */
+    for (map_obj::iterator it = a.begin(); it != a.end(); ++it)
+    {
+      it->second.val *= 2;
+    }
+    TS_ASSERT_EQUALS(a[9], 18);
+
+    /*
+     * Case2: Random access and reverse iteration.
+     */
+    map_obj::const_iterator it = a.cbegin() + 4;
+    TS_ASSERT_EQUALS(it[2].first, 6);
+    TS_ASSERT_EQUALS(a.cend() - it, 6);
+    TS_ASSERT_EQUALS(a.rbegin()->first, 9);
+  }
+
+  void test_copy()
+  {
+    map_obj a;
+    a[1] = obj(1);
+    a[2] = obj(2);
+    map_obj b(a);
+    TS_ASSERT(a == b);
+    b[3] = obj(3);
+    TS_ASSERT(a != b);
+    a = b;
+    TS_ASSERT(a == b);
+    a.swap(b);
+    TS_ASSERT(a == b);
+  }
+
+};
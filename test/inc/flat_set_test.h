@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/flat_set.h"
+
+#include <set>
+
+using namespace flex;
+
+class flat_set_test: public CxxTest::TestSuite
+{
+public:
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+  }
+
+  void test_insert()
+  {
+    flat_set<int> a;
+    TS_ASSERT(a.insert(5).second);
+    TS_ASSERT(a.insert(1).second);
+    TS_ASSERT(!a.insert(5).second);
+    TS_ASSERT_EQUALS(a.size(), 2);
+    TS_ASSERT_EQUALS(*a.begin(), 1);
+  }
+
+  void test_insert_range()
+  {
+    std::set<int> expected;
+    flat_set<int> a;
+    int batch[64];
+    srand(11);
+    for (int round = 0; round < 10; ++round)
+    {
+      for (int i = 0; i < 64; ++i)
+      {
+        batch[i] = rand() % 300;
+        expected.insert(batch[i]);
+      }
+      a.insert(batch, batch + 64);
+      TS_ASSERT_EQUALS(a.size(), expected.size());
+      TS_ASSERT(std::equal(a.begin(), a.end(), expected.begin()));
+    }
+  }
+
+  void test_find()
+  {
+    int data[] = { 2, 4, 6, 8 };
+    flat_set<int> a(data, data + 4);
+    TS_ASSERT_EQUALS(*a.find(4), 4);
+    TS_ASSERT(a.find(5) == a.end());
+    TS_ASSERT_EQUALS(a.count(8), 1);
+    TS_ASSERT_EQUALS(*a.lower_bound(5), 6);
+    TS_ASSERT_EQUALS(*a.upper_bound(6), 8);
+    TS_ASSERT_EQUALS(*a.rbegin(), 8);
+  }
+
+  void test_erase()
+  {
+    int data[] = { 1, 2, 3, 4, 5 };
+    flat_set<int> a(data, data + 5);
+    TS_ASSERT_EQUALS(a.erase(3), 1);
+    TS_ASSERT_EQUALS(a.erase(3), 0);
+    TS_ASSERT_EQUALS(*a.erase(a.begin()), 2);
+    a.erase(a.find(4), a.end());
+    TS_ASSERT_EQUALS(a.size(), 1);
+    TS_ASSERT_EQUALS(*a.begin(), 2);
+  }
+
+  void test_compare()
+  {
+    int data[] = { 1, 3, 2 };
+    flat_set<int, std::greater<int> > a(data, data + 3);
+    TS_ASSERT_EQUALS(a.keys()[0], 3);
+    TS_ASSERT_EQUALS(a.keys()[2], 1);
+    TS_ASSERT_EQUALS(*a.lower_bound(2), 2);
+
+    flat_set<int, std::greater<int> > b(a);
+    TS_ASSERT(a == b);
+  }
+
+};
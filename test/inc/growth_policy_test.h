@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/growth_policy.h"
+#include "flex/ring.h"
+#include "flex/string.h"
+#include "flex/vector.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class growth_policy_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+  }
+
+  void test_factor_growth()
+  {
+    allocator<int> alloc;
+
+    /*
+     * Case1: Double growth.
+     */
+    TS_ASSERT_EQUALS(double_growth::new_capacity(0, 1, sizeof(int), 0, alloc), 1);
+    TS_ASSERT_EQUALS(double_growth::new_capacity(8, 9, sizeof(int), 0, alloc), 16);
+    TS_ASSERT_EQUALS(double_growth::new_capacity(8, 100, sizeof(int), 0, alloc), 100);
+
+    /*
+     * Case2: 1.5x growth always grows by at least one element.
+     */
+    TS_ASSERT_EQUALS(one_and_half_growth::new_capacity(0, 1, sizeof(int), 0, alloc), 1);
+    TS_ASSERT_EQUALS(one_and_half_growth::new_capacity(1, 2, sizeof(int), 0, alloc), 2);
+    TS_ASSERT_EQUALS(one_and_half_growth::new_capacity(100, 101, sizeof(int), 0, alloc), 150);
+  }
+
+  void test_page_growth()
+  {
+    allocator<int> alloc;
+
+    /*
+     * Case1: Allocations smaller than a page are not rounded.
+     */
+    TS_ASSERT_EQUALS(page_growth<>::new_capacity(8, 9, sizeof(int), 0, alloc), 16);
+
+    /*
+     * Case2: Allocations are rounded up to whole pages.
+     */
+    TS_ASSERT_EQUALS(page_growth<>::new_capacity(600, 601, sizeof(int), 0, alloc), 2048);
+    TS_ASSERT_EQUALS(page_growth<one_and_half_growth>::new_capacity(1100, 1101, sizeof(int), 0, alloc), 2048);
+
+    /*
+     * Case3: The overhead is part of the rounded allocation.
+     */
+    TS_ASSERT_EQUALS(page_growth<>::new_capacity(600, 601, sizeof(int), 1, alloc), 2047);
+
+    /*
+     * Case4: Huge pages.
+     */
+    TS_ASSERT_EQUALS(hugepage_growth<>::new_capacity(300000, 300001, sizeof(int), 0, alloc), 1024 * 1024);
+  }
+
+  void test_size_class_growth()
+  {
+    allocator<char> alloc;
+
+    /*
+     * Case1: good_size rounds to size classes.
+     */
+    TS_ASSERT_LESS_THAN_EQUALS(100, good_size(alloc, 100));
+#ifndef FLEX_USE_JEMALLOC
+    TS_ASSERT_EQUALS(good_size(alloc, 1), 8);
+    TS_ASSERT_EQUALS(good_size(alloc, 100), 112);
+    TS_ASSERT_EQUALS(good_size(alloc, 129), 160);
+    TS_ASSERT_EQUALS(good_size(alloc, 256), 256);
+    TS_ASSERT_EQUALS(good_size(alloc, 257), 320);
+    TS_ASSERT_EQUALS(good_size(alloc, 5000), 5120);
+#endif
+
+    /*
+     * Case2: The capacity fills the size class.
+     */
+    size_t n = size_class_growth<>::new_capacity(64, 65, 12, 0, alloc);
+    TS_ASSERT_LESS_THAN_EQUALS(128, n);
+    TS_ASSERT_EQUALS(good_size(alloc, n * 12) / 12, n);
+  }
+
+  void test_vector()
+  {
+    vector<int, allocator<int>, page_growth<> > a;
+    for (int i = 0; i < 2000; ++i)
+    {
+      a.push_back(i);
+      TS_ASSERT((a.capacity() * sizeof(int) < 4096) || (a.capacity() * sizeof(int) % 4096 == 0));
+    }
+    TS_ASSERT_EQUALS(a.capacity(), 2048);
+    TS_ASSERT_EQUALS(a[1999], 1999);
+
+    vector<obj, allocator<obj>, one_and_half_growth> b;
+    for (int i = 0; i < 10; ++i)
+    {
+      b.push_back(obj(i));
+    }
+    TS_ASSERT_EQUALS(b.capacity(), 13);
+  }
+
+  void test_ring()
+  {
+    ring<int, allocator<int>, page_growth<> > a;
+    for (int i = 0; i < 2000; ++i)
+    {
+      a.push_back(i);
+    }
+    TS_ASSERT_EQUALS(a.capacity(), 2047);
+    TS_ASSERT_EQUALS(a.back(), 1999);
+  }
+
+  void test_string()
+  {
+    basic_string<char, allocator<char>, size_class_growth<> > a;
+    for (int i = 0; i < 1000; ++i)
+    {
+      a.push_back('a' + (i % 26));
+    }
+    TS_ASSERT_EQUALS(a.size(), 1000);
+    TS_ASSERT_EQUALS(good_size(a.get_allocator(), a.capacity() + 1), a.capacity() + 1);
+  }
+
+};
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/hugepage_allocator.h"
+#include "flex/fixed_vector.h"
+#include "flex/vector.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class hugepage_allocator_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_allocate()
+  {
+    /*
+     * Case1: Memory is huge page aligned and writable.
+     */
+    hugepage_allocator<int> a;
+    int* ptr = a.allocate(1024);
+    TS_ASSERT_EQUALS((size_t )ptr % FLEX_HUGEPAGE_SIZE, 0);
+    for (int i = 0; i < 1024; ++i)
+    {
+      ptr[i] = i;
+    }
+    TS_ASSERT_EQUALS(ptr[1023], 1023);
+    a.deallocate(ptr, 1024);
+
+    /*
+     * Case2: Pre-faulted allocation.
+     */
+    hugepage_allocator<int, hugepage_populate> b;
+    ptr = b.allocate(1024);
+    TS_ASSERT_EQUALS((size_t )ptr % FLEX_HUGEPAGE_SIZE, 0);
+    ptr[0] = 1;
+    b.deallocate(ptr, 1024);
+  }
+
+  void test_allocation_guard()
+  {
+    flex::allocation_guard::enable();
+    hugepage_allocator<int> a;
+    int* ptr = a.allocate(1);
+    TS_ASSERT(errno);
+    a.deallocate(ptr, 1);
+    errno = 0;
+  }
+
+  void test_rebind()
+  {
+    hugepage_allocator<int, hugepage_populate>::rebind<char>::other a;
+    hugepage_allocator<int, hugepage_populate> b(a);
+    TS_ASSERT(a == b);
+  }
+
+  void test_vector()
+  {
+    vector<obj, hugepage_allocator<obj> > v;
+    v.reserve(4096);
+    for (int i = 0; i < 4096; ++i)
+    {
+      v.push_back(obj(i));
+    }
+    TS_ASSERT_EQUALS(v.capacity(), 4096);
+    TS_ASSERT_EQUALS(v[4095], 4095);
+  }
+
+  void test_hugepage_new()
+  {
+    typedef fixed_vector<int, 100000> vec_type;
+    vec_type* v = hugepage_new<vec_type>();
+    TS_ASSERT(v->empty());
+    TS_ASSERT_EQUALS((size_t )v % 4096, 0);
+    touch_pages(v, sizeof(vec_type));
+    v->push_back(5);
+    TS_ASSERT(v->fixed());
+    TS_ASSERT_EQUALS(v->front(), 5);
+    hugepage_delete(v);
+  }
+
+  void test_touch_pages()
+  {
+    static char buffer[3 * 4096 + 10];
+    buffer[4096] = 'a';
+    touch_pages(buffer, sizeof(buffer));
+    TS_ASSERT_EQUALS(buffer[4096], 'a');
+  }
+
+};
@@ -0,0 +1,337 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/intrusive_list.h"
+#include "flex/fixed_vector.h"
+
+class intrusive_list_test: public CxxTest::TestSuite
+{
+public:
+
+  struct by_price;
+  struct by_time;
+
+  //An order that is indexed on two lists at once, one per hook.
+  struct order: public flex::intrusive_list_hook<by_price>, public flex::intrusive_list_hook<by_time>
+  {
+    int val;
+
+    order(int v = 0) :
+        val(v)
+    {
+    }
+  };
+
+  struct auto_node: public flex::intrusive_list_hook<void, true>
+  {
+    int val;
+
+    auto_node(int v = 0) :
+        val(v)
+    {
+    }
+  };
+
+  typedef flex::intrusive_list_hook<by_price> price_hook;
+  typedef flex::intrusive_list_hook<by_time> time_hook;
+  typedef flex::intrusive_list<order, price_hook> price_list;
+  typedef flex::intrusive_list<order, time_hook> time_list;
+  typedef flex::intrusive_list<auto_node, flex::intrusive_list_hook<void, true> > auto_list;
+
+  struct is_odd
+  {
+    bool operator()(const order& x) const
+    {
+      return (x.val % 2);
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class List>
+  bool is_container_valid(const List& list, const int* expected, size_t n)
+  {
+    size_t i = 0;
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it, ++i)
+    {
+      if ((i >= n) || (it->val != expected[i]) || (it.mNode->mNext->mPrev != it.mNode))
+      {
+        return false;
+      }
+    }
+    return (i == n) && (list.size() == n) && (list.empty() == (n == 0));
+  }
+
+  void test_push_pop()
+  {
+    flex::allocation_guard::enable();
+    order a(1), b(2), c(3);
+    {
+      price_list l;
+      TS_ASSERT(l.empty());
+
+      /*
+       * Case1: Elements are linked in place and never copied.
+       */
+      l.push_back(b);
+      l.push_back(c);
+      l.push_front(a);
+      const int expected[] = { 1, 2, 3 };
+      TS_ASSERT(is_container_valid(l, expected, 3));
+      TS_ASSERT_EQUALS(&l.front(), &a);
+      TS_ASSERT_EQUALS(&l.back(), &c);
+      TS_ASSERT(static_cast<price_hook&>(b).is_linked());
+      TS_ASSERT(!static_cast<time_hook&>(b).is_linked());
+
+      /*
+       * Case2: Popping unlinks the element's hook.
+       */
+      l.pop_front();
+      l.pop_back();
+      TS_ASSERT(!static_cast<price_hook&>(a).is_linked());
+      TS_ASSERT(!static_cast<price_hook&>(c).is_linked());
+      TS_ASSERT(is_container_valid(l, expected + 1, 1));
+
+      /*
+       * Case3: Reverse iteration.
+       */
+      l.push_back(c);
+      l.push_front(a);
+      price_list::reverse_iterator it = l.rbegin();
+      TS_ASSERT_EQUALS(it->val, 3);
+      ++it;
+      TS_ASSERT_EQUALS(it->val, 2);
+      ++it;
+      TS_ASSERT_EQUALS(it->val, 1);
+      ++it;
+      TS_ASSERT(it == l.rend());
+    }
+
+    /*
+     * Case4: Destroying the list unlinks its elements.
+     */
+    TS_ASSERT(!static_cast<price_hook&>(a).is_linked());
+    TS_ASSERT(!static_cast<price_hook&>(b).is_linked());
+    TS_ASSERT(!static_cast<price_hook&>(c).is_linked());
+  }
+
+  void test_multiple_hooks()
+  {
+    flex::allocation_guard::enable();
+    flex::fixed_vector<order, 6> orders;
+    for (int i = 0; i < 6; ++i)
+    {
+      orders.push_back(order(i));
+    }
+
+    price_list by_price_list;
+    time_list by_time_list;
+    for (int i = 0; i < 6; ++i)
+    {
+      by_price_list.push_back(orders[5 - i]);
+      by_time_list.push_back(orders[i]);
+    }
+
+    /*
+     * Case1: Each list has its own order over the same objects.
+     */
+    const int price_order[] = { 5, 4, 3, 2, 1, 0 };
+    const int time_order[] = { 0, 1, 2, 3, 4, 5 };
+    TS_ASSERT(is_container_valid(by_price_list, price_order, 6));
+    TS_ASSERT(is_container_valid(by_time_list, time_order, 6));
+
+    /*
+     * Case2: Unlinking from one list leaves the other untouched.
+     */
+    static_cast<price_hook&>(orders[2]).unlink();
+    price_list::unlink(orders[4]);
+    const int price_remaining[] = { 5, 3, 1, 0 };
+    TS_ASSERT(is_container_valid(by_price_list, price_remaining, 4));
+    TS_ASSERT(is_container_valid(by_time_list, time_order, 6));
+
+    /*
+     * Case3: iterator_to finds an element in constant time.
+     */
+    time_list::iterator it = time_list::iterator_to(orders[3]);
+    TS_ASSERT_EQUALS(&*it, &orders[3]);
+    it = by_time_list.erase(it);
+    TS_ASSERT_EQUALS(it->val, 4);
+    const int time_remaining[] = { 0, 1, 2, 4, 5 };
+    TS_ASSERT(is_container_valid(by_time_list, time_remaining, 5));
+
+    by_price_list.clear();
+    by_time_list.clear();
+  }
+
+  void test_erase()
+  {
+    order objs[8];
+    price_list l;
+    for (int i = 0; i < 8; ++i)
+    {
+      objs[i].val = i;
+      l.push_back(objs[i]);
+    }
+
+    /*
+     * Case1: Erase a range.
+     */
+    price_list::iterator first = price_list::iterator_to(objs[2]);
+    price_list::iterator last = price_list::iterator_to(objs[5]);
+    TS_ASSERT(l.erase(first, last) == last);
+    const int expected[] = { 0, 1, 5, 6, 7 };
+    TS_ASSERT(is_container_valid(l, expected, 5));
+    TS_ASSERT(!static_cast<price_hook&>(objs[3]).is_linked());
+
+    /*
+     * Case2: remove_if.
+     */
+    l.remove_if(is_odd());
+    const int evens[] = { 0, 6 };
+    TS_ASSERT(is_container_valid(l, evens, 2));
+
+    /*
+     * Case3: An unlinked element may be inserted again.
+     */
+    l.insert(price_list::iterator_to(objs[6]), objs[3]);
+    const int reinserted[] = { 0, 3, 6 };
+    TS_ASSERT(is_container_valid(l, reinserted, 3));
+
+    /*
+     * Case4: Reverse.
+     */
+    l.reverse();
+    const int reversed[] = { 6, 3, 0 };
+    TS_ASSERT(is_container_valid(l, reversed, 3));
+    l.clear();
+  }
+
+  void test_splice()
+  {
+    order objs[6];
+    price_list a;
+    price_list b;
+    for (int i = 0; i < 6; ++i)
+    {
+      objs[i].val = i;
+      ((i < 3) ? a : b).push_back(objs[i]);
+    }
+
+    /*
+     * Case1: Splice a single element.
+     */
+    a.splice(a.begin(), b, price_list::iterator_to(objs[4]));
+    const int a1[] = { 4, 0, 1, 2 };
+    const int b1[] = { 3, 5 };
+    TS_ASSERT(is_container_valid(a, a1, 4));
+    TS_ASSERT(is_container_valid(b, b1, 2));
+
+    /*
+     * Case2: Splice a range within the same list.
+     */
+    a.splice(a.end(), a, a.begin(), price_list::iterator_to(objs[1]));
+    const int a2[] = { 1, 2, 4, 0 };
+    TS_ASSERT(is_container_valid(a, a2, 4));
+    a.splice(price_list::iterator_to(objs[0]), a, a.begin(), price_list::iterator_to(objs[0]));
+    TS_ASSERT(is_container_valid(a, a2, 4));
+
+    /*
+     * Case3: Splice a whole list.
+     */
+    a.splice(price_list::iterator_to(objs[4]), b);
+    const int a3[] = { 1, 2, 3, 5, 4, 0 };
+    TS_ASSERT(is_container_valid(a, a3, 6));
+    TS_ASSERT(b.empty());
+
+    /*
+     * Case4: Swap.
+     */
+    a.swap(b);
+    TS_ASSERT(a.empty());
+    TS_ASSERT(is_container_valid(b, a3, 6));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case5: Move.
+     */
+    price_list c(std::move(b));
+    TS_ASSERT(b.empty());
+    TS_ASSERT(is_container_valid(c, a3, 6));
+    a = std::move(c);
+    TS_ASSERT(c.empty());
+    TS_ASSERT(is_container_valid(a, a3, 6));
+#endif
+    b.clear();
+    a.clear();
+  }
+
+  void test_auto_unlink()
+  {
+    auto_list l;
+    auto_node a(1);
+    l.push_back(a);
+    {
+      auto_node b(2);
+      auto_node c(3);
+      l.push_back(b);
+      l.push_back(c);
+      TS_ASSERT_EQUALS(l.size(), 3);
+    }
+
+    /*
+     * Case1: Destroyed elements remove themselves from the list.
+     */
+    TS_ASSERT_EQUALS(l.size(), 1);
+    TS_ASSERT_EQUALS(&l.back(), &a);
+
+    /*
+     * Case2: A copy of a linked element is not linked.
+     */
+    auto_node d(a);
+    TS_ASSERT(!d.is_linked());
+    d = a;
+    TS_ASSERT(!d.is_linked());
+    l.clear();
+  }
+
+  void test_safe_mode()
+  {
+    price_list l;
+    flex::fixed_vector<order, 1> storage;
+
+    /*
+     * Case1: Destroying an element after it has been unlinked is fine.
+     */
+    storage.push_back(order(1));
+    l.push_back(storage[0]);
+    l.pop_back();
+    storage.pop_back();
+    TS_ASSERT(!errno);
+
+    /*
+     * Case2: Destroying an element that is still linked is reported.
+     */
+    storage.push_back(order(2));
+    l.push_back(storage[0]);
+    storage.pop_back();
+    TS_ASSERT(errno);
+    errno = 0;
+    l.clear();
+
+    /*
+     * Case3: Unlinking an element that is not linked does nothing.
+     */
+    order a(3);
+    static_cast<price_hook&>(a).unlink();
+    TS_ASSERT(!static_cast<price_hook&>(a).is_linked());
+  }
+
+};
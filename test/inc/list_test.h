@@ -4,6 +4,9 @@
 #include "flex/debug/allocator.h"
 #include "flex/debug/obj.h"
 
+#include <algorithm>
+#include <vector>
+
 class list_test: public CxxTest::TestSuite
 {
 
@@ -1750,6 +1753,125 @@ public:
     TS_ASSERT(is_container_valid(a));
   }
 
+  //Orders by the tens digit only, so elements with the same tens digit compare equal.
+  struct tens_less
+  {
+    bool operator()(const obj& a, const obj& b) const
+    {
+      return (a.val / 10) < (b.val / 10);
+    }
+  };
+
+  struct int_key
+  {
+    int operator()(const obj& o) const
+    {
+      return o.val;
+    }
+  };
+
+  struct unsigned_key
+  {
+    unsigned operator()(const obj& o) const
+    {
+      return (unsigned) o.val;
+    }
+  };
+
+  struct tens_key
+  {
+    short operator()(const obj& o) const
+    {
+      return (short) (o.val / 10);
+    }
+  };
+
+  bool is_sequence(const list_obj& list, const std::vector<obj>& expected)
+  {
+    return (list.size() == expected.size()) && std::equal(list.begin(), list.end(), expected.begin());
+  }
+
+  void test_sort_large(void)
+  {
+    /*
+     * Case1: Sort every size up to 128 elements.
+     */
+    for (size_t n = 0; n <= 128; ++n)
+    {
+      list_obj a(OBJ_DATA, OBJ_DATA + n);
+      std::vector<obj> expected(OBJ_DATA, OBJ_DATA + n);
+      std::sort(expected.begin(), expected.end());
+      a.sort();
+      TS_ASSERT(is_sequence(a, expected));
+      TS_ASSERT(is_container_valid(a));
+    }
+
+    /*
+     * Case2: Sorting is stable.
+     */
+    list_obj b;
+    std::vector<obj> expected;
+    for (int i = 0; i < 100; ++i)
+    {
+      const obj val((i * 37) % 100);
+      b.push_back(val);
+      expected.push_back(val);
+    }
+    std::stable_sort(expected.begin(), expected.end(), tens_less());
+    b.sort(tens_less());
+    TS_ASSERT(is_sequence(b, expected));
+    TS_ASSERT(is_container_valid(b));
+  }
+
+  void test_radix_sort(void)
+  {
+    /*
+     * Case1: Sort an empty list and a single element.
+     */
+    list_obj a;
+    a.radix_sort(int_key());
+    TS_ASSERT(is_container_valid(a));
+    a.push_back(OBJ_DATA[0]);
+    a.radix_sort(int_key());
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Signed keys, including negative ones, sort in numeric order.
+     */
+    a.assign(OBJ_DATA, OBJ_DATA + 128);
+    std::vector<obj> expected(OBJ_DATA, OBJ_DATA + 128);
+    std::sort(expected.begin(), expected.end());
+    a.radix_sort(int_key());
+    TS_ASSERT(is_sequence(a, expected));
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case3: Unsigned keys place the negative values last.
+     */
+    a.assign(OBJ_DATA, OBJ_DATA + 128);
+    std::vector<obj>::iterator negative = std::upper_bound(expected.begin(), expected.end(), obj(-1));
+    std::rotate(expected.begin(), negative, expected.end());
+    a.radix_sort(unsigned_key());
+    TS_ASSERT(is_sequence(a, expected));
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case4: Radix sort is stable.
+     */
+    a.clear();
+    expected.clear();
+    for (int i = 0; i < 100; ++i)
+    {
+      const obj val((i * 37) % 100 - 50);
+      a.push_back(val);
+      expected.push_back(val);
+    }
+    std::stable_sort(expected.begin(), expected.end(), tens_less());
+    a.radix_sort(tens_key());
+    TS_ASSERT(is_sequence(a, expected));
+    TS_ASSERT(is_container_valid(a));
+  }
+
   void test_splice_list(void)
   {
     list_obj a;
@@ -0,0 +1,176 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/pmr.h"
+#include "flex/fixed_pool.h"
+#include "flex/debug/obj.h"
+
+#ifdef FLEX_HAS_CXX17
+#include <list>
+#endif
+
+using namespace flex;
+
+class pmr_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_allocator()
+  {
+#ifdef FLEX_HAS_CXX17
+    /*
+     * Case1: Default constructed allocator uses the default resource.
+     */
+    pmr_allocator<int> a;
+    TS_ASSERT_EQUALS(a.resource(), std::pmr::get_default_resource());
+
+    /*
+     * Case2: Allocator draws from the given resource.
+     */
+    char buffer[256];
+    std::pmr::monotonic_buffer_resource res(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    pmr_allocator<int> b(&res);
+    int* ptr = b.allocate(4);
+    TS_ASSERT((char* )ptr >= buffer);
+    TS_ASSERT((char* )ptr < buffer + sizeof(buffer));
+    b.deallocate(ptr, 4);
+
+    /*
+     * Case3: Rebound copies share the resource.
+     */
+    pmr_allocator<char> c(b);
+    TS_ASSERT_EQUALS(c.resource(), &res);
+    TS_ASSERT(c == b);
+    TS_ASSERT(a != b);
+
+    /*
+     * Case4: Byte allocations are aligned for any node type.
+     */
+    char* bytes = c.allocate(3);
+    TS_ASSERT_EQUALS((size_t )bytes % alignof(std::max_align_t), 0);
+#endif
+  }
+
+  void test_resource_scope()
+  {
+#ifdef FLEX_HAS_CXX17
+    std::pmr::memory_resource* previous = std::pmr::get_default_resource();
+    std::pmr::monotonic_buffer_resource res;
+    {
+      pmr::resource_scope scope(&res);
+      pmr_allocator<int> a;
+      TS_ASSERT_EQUALS(a.resource(), &res);
+    }
+    TS_ASSERT_EQUALS(std::pmr::get_default_resource(), previous);
+#endif
+  }
+
+  void test_containers()
+  {
+#ifdef FLEX_HAS_CXX17
+    char buffer[16384];
+    std::pmr::monotonic_buffer_resource res(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    pmr::resource_scope scope(&res);
+    flex::allocation_guard::enable();
+
+    /*
+     * Case1: vector
+     */
+    pmr::vector<obj> v;
+    for (int i = 0; i < 32; ++i)
+    {
+      v.push_back(obj(i));
+    }
+    TS_ASSERT_EQUALS(v.size(), 32);
+    TS_ASSERT_EQUALS(v[31], 31);
+
+    /*
+     * Case2: list
+     */
+    pmr::list<obj> l;
+    for (int i = 0; i < 32; ++i)
+    {
+      l.push_back(obj(i));
+    }
+    TS_ASSERT_EQUALS(l.size(), 32);
+    TS_ASSERT_EQUALS(l.front(), 0);
+    TS_ASSERT_EQUALS(l.back(), 31);
+
+    /*
+     * Case3: string
+     */
+    pmr::string s("hello");
+    s += " world, this string is long enough to reallocate";
+    TS_ASSERT_EQUALS(s.c_str(), "hello world, this string is long enough to reallocate");
+
+    /*
+     * Case4: hash_map
+     */
+    pmr::hash_map<int, int> m;
+    for (int i = 0; i < 32; ++i)
+    {
+      m[i] = i * 2;
+    }
+    TS_ASSERT_EQUALS(m.size(), 32);
+    TS_ASSERT_EQUALS(m[7], 14);
+#endif
+  }
+
+  void test_pool_resource()
+  {
+#ifdef FLEX_HAS_CXX17
+    typedef std::aligned_storage<64, alignof(std::max_align_t)>::type node;
+    pool_resource<fixed_pool<node, 16> > res(std::pmr::null_memory_resource());
+    TS_ASSERT_EQUALS(res.upstream_resource(), std::pmr::null_memory_resource());
+    TS_ASSERT_EQUALS(res.get_pool().size(), 16);
+
+    /*
+     * Case1: std containers draw their nodes from the pool.
+     */
+    {
+      std::pmr::list<int> l(&res);
+      for (int i = 0; i < 8; ++i)
+      {
+        l.push_back(i);
+      }
+      TS_ASSERT_EQUALS(res.get_pool().size(), 8);
+    }
+    TS_ASSERT_EQUALS(res.get_pool().size(), 16);
+
+    /*
+     * Case2: Requests larger than a node go upstream.
+     */
+    std::pmr::monotonic_buffer_resource upstream;
+    pool_resource<fixed_pool<node, 16> > res2(&upstream);
+    void* ptr = res2.allocate(1024);
+    TS_ASSERT_EQUALS(res2.get_pool().size(), 16);
+    res2.deallocate(ptr, 1024);
+
+    /*
+     * Case3: Resources are only equal to themselves.
+     */
+    TS_ASSERT(res.is_equal(res));
+    TS_ASSERT(!res.is_equal(res2));
+
+    /*
+     * Case4: Deallocating null storage doesn't reach the resource.
+     */
+    pmr_allocator<node> a(&res);
+    a.deallocate(NULL, 0);
+    TS_ASSERT_EQUALS(res.get_pool().size(), 16);
+#endif
+  }
+
+};
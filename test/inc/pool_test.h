@@ -294,4 +294,23 @@ public:
     TS_ASSERT_EQUALS(a.size(), 40);
   }
 
+  void test_shrink_to_fit()
+  {
+    /*
+     * Case1: Available objects are released.
+     */
+    pool_obj a(16);
+    obj* ptr = a.construct(obj(1));
+    TS_ASSERT_EQUALS(a.size(), 15);
+    a.shrink_to_fit();
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(*ptr, 1);
+
+    /*
+     * Case2: Objects returned afterwards are kept by the pool.
+     */
+    a.destruct(ptr);
+    TS_ASSERT_EQUALS(a.size(), 1);
+  }
+
 };
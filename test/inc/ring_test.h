@@ -4,9 +4,43 @@
 #include "flex/debug/allocator.h"
 #include "flex/debug/obj.h"
 
+//A type with a user-defined copy constructor that is declared trivially relocatable.  The copy count
+//shows whether the ring relocated it with memcpy or copied it.
+struct ring_test_relocatable
+{
+  int val;
+  int copies;
+
+  ring_test_relocatable(int v) :
+      val(v), copies(0)
+  {
+  }
+
+  ring_test_relocatable(const ring_test_relocatable& obj) :
+      val(obj.val), copies(obj.copies + 1)
+  {
+  }
+};
+
+namespace flex
+{
+  template<> struct is_trivially_relocatable<ring_test_relocatable> : std::true_type
+  {
+  };
+}
+
 class ring_test: public CxxTest::TestSuite
 {
 
+  //Predicate for erase_if().
+  struct is_odd
+  {
+    bool operator()(const flex::debug::obj& o) const
+    {
+      return (o.val % 2) != 0;
+    }
+  };
+
   typedef flex::debug::obj obj;
   typedef flex::ring<obj, flex::debug::allocator<obj> > ring_obj;
 
@@ -809,6 +843,76 @@ public:
     } //for: SIZE_COUNT
   }
 
+  void test_erase_if()
+  {
+    ring_obj a;
+    TS_ASSERT_EQUALS(a.erase_if(is_odd()), 0);
+
+    //Each offset moves the wrap-around point through the elements.
+    a.reserve(40);
+    for (unsigned offset = 0; offset < 40; ++offset)
+    {
+      a.clear();
+      for (unsigned i = 0; i < offset; ++i)
+      {
+        a.push_back(obj(0));
+        a.pop_front();
+      }
+      for (unsigned i = 0; i < 30; ++i)
+      {
+        a.push_back(OBJ_DATA[i]);
+      }
+
+      ring_obj expected;
+      for (unsigned i = 0; i < a.size(); ++i)
+      {
+        if (!is_odd()(a[i]))
+        {
+          expected.push_back(a[i]);
+        }
+      }
+      mark_move_only(a);
+      clear_copy_flags(a);
+      TS_ASSERT_EQUALS(a.erase_if(is_odd()), 30 - expected.size());
+      TS_ASSERT(is_container_valid(a));
+      TS_ASSERT(a == expected);
+    }
+  }
+
+  void test_erase_unordered()
+  {
+    ring_obj a(OBJ_DATA, OBJ_DATA + 10);
+    a.pop_front();
+    a.push_back(OBJ_DATA[10]);
+
+    /*
+     * Case1: The last element fills the hole.
+     */
+    mark_move_only(a);
+    clear_copy_flags(a);
+    ring_obj::iterator it = a.erase_unordered(a.begin() + 2);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.size(), 9);
+    TS_ASSERT_EQUALS(*it, OBJ_DATA[10]);
+    TS_ASSERT_EQUALS(a[1], 2);
+    TS_ASSERT_EQUALS(a[3], 4);
+
+    /*
+     * Case2: Erasing the last element.
+     */
+    it = a.erase_unordered(a.end() - 1);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT(it == a.end());
+    TS_ASSERT_EQUALS(a.size(), 8);
+    TS_ASSERT_EQUALS(a.back(), 8);
+
+    while (!a.empty())
+    {
+      a.erase_unordered(a.begin());
+    }
+    TS_ASSERT(is_container_valid(a));
+  }
+
   void test_front(void)
   {
     for (unsigned s = 1; s < SIZE_COUNT; ++s)
@@ -1184,6 +1288,47 @@ public:
     }
   }
 
+  void test_relocate(void)
+  {
+    /*
+     * Case1: A wrapped ring is relocated in two spans when it grows.
+     */
+    flex::ring<ring_test_relocatable> a;
+    a.reserve(4);
+    for (int i = 0; i < 4; ++i)
+    {
+      a.push_back(ring_test_relocatable(i));
+    }
+    a.pop_front();
+    a.pop_front();
+    a.push_back(ring_test_relocatable(4));
+    a.push_back(ring_test_relocatable(5));
+    TS_ASSERT(&a.front() > &a.back());
+    a.push_back(ring_test_relocatable(6));
+    a.push_front(ring_test_relocatable(1));
+    TS_ASSERT_EQUALS(a.size(), 6);
+    for (int i = 0; i < 6; ++i)
+    {
+      TS_ASSERT_EQUALS(a[i].val, i + 1);
+      TS_ASSERT_EQUALS(a[i].copies, 1);
+    }
+
+    /*
+     * Case2: Inserting an element of the container itself when it grows.
+     */
+    ring_obj b(OBJ_DATA, OBJ_DATA + 4);
+    b.push_back(b[0]);
+    TS_ASSERT_EQUALS(b.back(), OBJ_DATA[0]);
+    b.shrink_to_fit();
+    b.push_front(b[4]);
+    TS_ASSERT_EQUALS(b.front(), OBJ_DATA[0]);
+    b.shrink_to_fit();
+    b.insert(b.begin() + 1, b[3]);
+    TS_ASSERT_EQUALS(b[1], OBJ_DATA[2]);
+    TS_ASSERT_EQUALS(b.size(), 7);
+    TS_ASSERT(is_container_valid(b));
+  }
+
   void test_rbegin_and_rend(void)
   {
     for (unsigned s = 0; s < SIZE_COUNT; ++s)
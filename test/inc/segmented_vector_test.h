@@ -0,0 +1,324 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/segmented_vector.h"
+#include "flex/debug/allocator.h"
+#include "flex/debug/obj.h"
+#include "flex/fixed_pool.h"
+#include "flex/pmr.h"
+
+using namespace flex;
+
+class segmented_vector_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::segmented_vector<obj, 4> seg_obj;
+  typedef flex::debug::allocator<flex::pool<segmented_vector_segment<obj, 4> >::node_type> debug_alloc;
+  typedef flex::segmented_vector<obj, 4, debug_alloc> debug_seg_obj;
+
+  struct summer
+  {
+    int sum;
+    int calls;
+
+    summer() :
+        sum(0), calls(0)
+    {
+    }
+
+    void operator()(const obj* first, const obj* last)
+    {
+      ++calls;
+      for (; first != last; ++first)
+      {
+        sum += first->val;
+      }
+    }
+  };
+
+  void setUp()
+  {
+    debug_alloc::clear();
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+
+    //This ensures that all memory allocated by the container is properly freed.
+    TS_ASSERT(debug_alloc::mAllocatedPointers.empty());
+  }
+
+  bool is_container_valid(const seg_obj& c)
+  {
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+      if (c[i].init != obj::INIT_KEY)
+      {
+        printf("Error: Expected (c[i].init == obj::INIT_KEY) when i=%zu\n", i);
+        return false;
+      }
+    }
+    if ((size_t) std::distance(c.begin(), c.end()) != c.size())
+    {
+      printf("Error: Expected (distance(c.begin(), c.end()) == c.size())\n");
+      return false;
+    }
+    return true;
+  }
+
+  void test_default_constructor()
+  {
+    flex::allocation_guard::enable();
+    seg_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 0);
+    TS_ASSERT_EQUALS(a.segment_count(), 0);
+    TS_ASSERT(a.begin() == a.end());
+  }
+
+  void test_fill_constructor()
+  {
+    seg_obj a(10, obj(3));
+    TS_ASSERT_EQUALS(a.size(), 10);
+    TS_ASSERT_EQUALS(a.segment_count(), 3);
+    TS_ASSERT_EQUALS(a.capacity(), 12);
+    TS_ASSERT_EQUALS(a[9], 3);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_push_back()
+  {
+    seg_obj a;
+    a.push_back(obj(0));
+    obj* first = &a[0];
+
+    /*
+     * Case1: Growth never moves existing elements.
+     */
+    for (int i = 1; i < 100; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT_EQUALS(&a[0], first);
+    TS_ASSERT_EQUALS(a.segment_count(), 25);
+    for (int i = 0; i < 100; ++i)
+    {
+      TS_ASSERT_EQUALS(a[i], i);
+    }
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Pushing an element of the container onto itself.
+     */
+    a.push_back(a[3]);
+    TS_ASSERT_EQUALS(a.back(), 3);
+  }
+
+  void test_reserve()
+  {
+    seg_obj a;
+    a.reserve(10);
+    TS_ASSERT_EQUALS(a.capacity(), 12);
+
+    /*
+     * Case1: No allocations within the reserved capacity.
+     */
+    flex::allocation_guard::enable();
+    for (int i = 0; i < 12; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_pop_back()
+  {
+    seg_obj a(6, obj(1));
+    a.pop_back();
+    a.pop_back();
+    a.pop_back();
+    TS_ASSERT_EQUALS(a.size(), 3);
+    TS_ASSERT_EQUALS(a.capacity(), 8);
+    a.push_back(obj(7));
+    TS_ASSERT_EQUALS(a.back(), 7);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_resize()
+  {
+    seg_obj a(3, obj(1));
+
+    /*
+     * Case1: Grow.
+     */
+    a.resize(9, obj(2));
+    TS_ASSERT_EQUALS(a.size(), 9);
+    TS_ASSERT_EQUALS(a[2], 1);
+    TS_ASSERT_EQUALS(a[8], 2);
+
+    /*
+     * Case2: Shrink across segments.
+     */
+    a.resize(2);
+    TS_ASSERT_EQUALS(a.size(), 2);
+    TS_ASSERT_EQUALS(a.capacity(), 12);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_clear()
+  {
+    seg_obj a(10, obj(1));
+    a.clear();
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 12);
+
+    /*
+     * Case1: Segments are reused after clear.
+     */
+    flex::allocation_guard::enable();
+    for (int i = 0; i < 12; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_shrink_to_fit()
+  {
+    debug_seg_obj a(20, obj(1));
+    obj* ptr = &a[0];
+    a.resize(5);
+    TS_ASSERT_EQUALS(debug_alloc::mAllocatedPointers.size(), 5);
+    a.shrink_to_fit();
+    TS_ASSERT_EQUALS(a.capacity(), 8);
+    TS_ASSERT_EQUALS(debug_alloc::mAllocatedPointers.size(), 2);
+    TS_ASSERT_EQUALS(&a[0], ptr);
+    TS_ASSERT_EQUALS(a[4], 1);
+  }
+
+  void test_segments()
+  {
+    seg_obj a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a.push_back(obj(i));
+    }
+
+    /*
+     * Case1: Segment sizes.
+     */
+    TS_ASSERT_EQUALS(a.segment_size(0), 4);
+    TS_ASSERT_EQUALS(a.segment_size(1), 4);
+    TS_ASSERT_EQUALS(a.segment_size(2), 2);
+    TS_ASSERT_EQUALS(a.segment_size(3), 0);
+    TS_ASSERT_EQUALS(a.segment_data(2), &a[8]);
+
+    /*
+     * Case2: for_each_segment visits each used segment once.
+     */
+    const seg_obj& b = a;
+    summer s = b.for_each_segment(summer());
+    TS_ASSERT_EQUALS(s.calls, 3);
+    TS_ASSERT_EQUALS(s.sum, 45);
+  }
+
+  void test_iterator()
+  {
+    seg_obj a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a.push_back(obj(i));
+    }
+
+    int i = 0;
+    for (seg_obj::iterator it = a.begin(); it != a.end(); ++it, ++i)
+    {
+      TS_ASSERT_EQUALS(*it, i);
+    }
+    TS_ASSERT_EQUALS(i, 10);
+
+    seg_obj::const_iterator it = a.cbegin() + 5;
+    TS_ASSERT_EQUALS(*it, 5);
+    TS_ASSERT_EQUALS(it[3], 8);
+    TS_ASSERT_EQUALS(a.cend() - it, 5);
+    TS_ASSERT(it < a.end());
+    TS_ASSERT_EQUALS(*a.rbegin(), 9);
+    TS_ASSERT_EQUALS(std::lower_bound(a.begin(), a.end(), obj(7)) - a.begin(), 7);
+  }
+
+  void test_copy()
+  {
+    seg_obj a(10, obj(1));
+    seg_obj b(a);
+    TS_ASSERT(a == b);
+    TS_ASSERT(is_container_valid(b));
+
+    seg_obj c(3, obj(2));
+    c = a;
+    TS_ASSERT(a == c);
+    c[0] = obj(5);
+    TS_ASSERT(a != c);
+  }
+
+  void test_move()
+  {
+#ifdef FLEX_HAS_CXX11
+    seg_obj a(10, obj(1));
+    obj* ptr = &a[0];
+    seg_obj b(std::move(a));
+    TS_ASSERT_EQUALS(&b[0], ptr);
+    TS_ASSERT(a.empty());
+
+    seg_obj c(3, obj(2));
+    c = std::move(b);
+    TS_ASSERT_EQUALS(&c[0], ptr);
+    TS_ASSERT_EQUALS(c.size(), 10);
+#endif
+  }
+
+  void test_swap()
+  {
+    /*
+     * Case1: swap() exchanges the contents.
+     */
+    seg_obj a(10, obj(1));
+    seg_obj b(3, obj(2));
+    obj* ptr = &a[0];
+    a.swap(b);
+    TS_ASSERT_EQUALS(a.size(), 3);
+    TS_ASSERT_EQUALS(a[2], 2);
+    TS_ASSERT_EQUALS(b.size(), 10);
+    TS_ASSERT_EQUALS(&b[0], ptr);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT(is_container_valid(b));
+
+#ifdef FLEX_HAS_CXX17
+    /*
+     * Case2: Segments are returned to the allocator that provided them.
+     */
+    typedef segmented_vector_segment<size_t, 4> segment;
+    typedef flex::pool_resource<flex::fixed_pool<segment, 4> > resource;
+    typedef flex::segmented_vector<size_t, 4, flex::pmr_allocator<flex::pool<segment>::node_type> > pmr_seg;
+    resource r1(std::pmr::null_memory_resource());
+    resource r2(std::pmr::null_memory_resource());
+    {
+      flex::pmr::resource_scope s1(&r1);
+      pmr_seg c(12, size_t(1));
+      {
+        flex::pmr::resource_scope s2(&r2);
+        pmr_seg d(4, size_t(2));
+        c.swap(d);
+        TS_ASSERT_EQUALS(c.size(), 4);
+        TS_ASSERT_EQUALS(d.size(), 12);
+      }
+    }
+    TS_ASSERT_EQUALS(r1.get_pool().size(), 4);
+    TS_ASSERT_EQUALS(r2.get_pool().size(), 4);
+#endif
+  }
+
+};
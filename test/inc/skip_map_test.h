@@ -0,0 +1,336 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_skip_map.h"
+#include "flex/debug/obj.h"
+
+#include <map>
+#include <stdlib.h>
+
+class skip_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::skip_map<int, obj> skip_map_obj;
+  typedef flex::skip_map<int, int> skip_map_int;
+  typedef flex::fixed_skip_map<int, obj, 64> fixed_skip_map_obj;
+  typedef flex::fixed_skip_map<int, int, 64> fixed_skip_map_int;
+
+  struct greater
+  {
+    bool operator()(int a, int b) const
+    {
+      return a > b;
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class Map>
+  bool is_container_valid(const Map& map, const int* expected, size_t n)
+  {
+    //Walks the map forward and backward, so both the level 0 links and the back links are checked.  Each
+    //mapped value is expected to be ten times its key.
+    size_t i = 0;
+    for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it, ++i)
+    {
+      if ((i >= n) || (it->first != expected[i]) || !(it->second == expected[i] * 10))
+      {
+        return false;
+      }
+    }
+    if (i != n)
+    {
+      return false;
+    }
+    for (typename Map::const_reverse_iterator it = map.rbegin(); it != map.rend(); ++it)
+    {
+      if (it->first != expected[--i])
+      {
+        return false;
+      }
+    }
+    return (map.size() == n) && (map.empty() == (n == 0));
+  }
+
+  template<class Map>
+  void fill(Map& map, const int* keys, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      map.insert(typename Map::value_type(keys[i], keys[i] * 10));
+    }
+  }
+
+  void test_insert_find()
+  {
+    skip_map_obj a;
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    TS_ASSERT(a.find(1) == a.end());
+
+    /*
+     * Case1: Inserts in any order iterate in key order.
+     */
+    const int keys[] = { 5, 1, 9, 3, 7 };
+    fill(a, keys, 5);
+    const int sorted[] = { 1, 3, 5, 7, 9 };
+    TS_ASSERT(is_container_valid(a, sorted, 5));
+
+    /*
+     * Case2: Inserting an existing key returns it unchanged.
+     */
+    std::pair<skip_map_obj::iterator, bool> result = a.insert(skip_map_obj::value_type(3, obj(99)));
+    TS_ASSERT(!result.second);
+    TS_ASSERT_EQUALS(result.first->first, 3);
+    TS_ASSERT(is_container_valid(a, sorted, 5));
+
+    /*
+     * Case3: find(), count() and at() only match present keys.
+     */
+    TS_ASSERT_EQUALS(a.find(7)->second, 70);
+    TS_ASSERT(a.find(4) == a.end());
+    TS_ASSERT(a.find(10) == a.end());
+    TS_ASSERT_EQUALS(a.count(9), 1);
+    TS_ASSERT_EQUALS(a.count(0), 0);
+    TS_ASSERT_EQUALS(a.at(1), 10);
+    TS_ASSERT_THROWS(a.at(2), std::out_of_range);
+
+    /*
+     * Case4: operator[] inserts missing keys.
+     */
+    a[4] = obj(40);
+    TS_ASSERT_EQUALS(a[4], 40);
+    const int indexed[] = { 1, 3, 4, 5, 7, 9 };
+    TS_ASSERT(is_container_valid(a, indexed, 6));
+  }
+
+  void test_bounds()
+  {
+    const int keys[] = { 10, 20, 30, 40 };
+    skip_map_int a;
+    fill(a, keys, 4);
+
+    /*
+     * Case1: lower_bound() finds the first key not less, upper_bound() the first key greater.
+     */
+    TS_ASSERT_EQUALS(a.lower_bound(20)->first, 20);
+    TS_ASSERT_EQUALS(a.upper_bound(20)->first, 30);
+    TS_ASSERT_EQUALS(a.lower_bound(25)->first, 30);
+    TS_ASSERT_EQUALS(a.upper_bound(25)->first, 30);
+    TS_ASSERT(a.lower_bound(5) == a.begin());
+    TS_ASSERT(a.lower_bound(41) == a.end());
+    TS_ASSERT(a.upper_bound(40) == a.end());
+
+    /*
+     * Case2: equal_range() spans one element for a present key and none for a missing one.
+     */
+    std::pair<skip_map_int::iterator, skip_map_int::iterator> range = a.equal_range(30);
+    TS_ASSERT_EQUALS(std::distance(range.first, range.second), 1);
+    range = a.equal_range(35);
+    TS_ASSERT(range.first == range.second);
+
+    /*
+     * Case3: A custom comparator orders the map and its bounds.
+     */
+    flex::skip_map<int, int, greater> b;
+    for (int i = 0; i < 5; ++i)
+    {
+      b.insert(std::make_pair(i, i));
+    }
+    TS_ASSERT_EQUALS(b.begin()->first, 4);
+    TS_ASSERT_EQUALS(b.lower_bound(2)->first, 2);
+    TS_ASSERT_EQUALS(b.upper_bound(2)->first, 1);
+  }
+
+  void test_erase()
+  {
+    const int keys[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    skip_map_obj a;
+    fill(a, keys, 8);
+
+    /*
+     * Case1: erase() by key and by position.
+     */
+    TS_ASSERT_EQUALS(a.erase(4), 1);
+    TS_ASSERT_EQUALS(a.erase(4), 0);
+    skip_map_obj::iterator it = a.erase(a.begin());
+    TS_ASSERT_EQUALS(it->first, 2);
+    it = a.erase(a.find(8));
+    TS_ASSERT(it == a.end());
+    const int erased[] = { 2, 3, 5, 6, 7 };
+    TS_ASSERT(is_container_valid(a, erased, 5));
+
+    /*
+     * Case2: Erasing a range between bounds.
+     */
+    it = a.erase(a.lower_bound(3), a.upper_bound(6));
+    TS_ASSERT_EQUALS(it->first, 7);
+    const int ranged[] = { 2, 7 };
+    TS_ASSERT(is_container_valid(a, ranged, 2));
+
+    /*
+     * Case3: An empty range erases nothing, and a full range empties the map.
+     */
+    a.erase(a.begin(), a.begin());
+    TS_ASSERT(is_container_valid(a, ranged, 2));
+    a.erase(a.begin(), a.end());
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    fill(a, keys, 3);
+    TS_ASSERT(is_container_valid(a, keys, 3));
+  }
+
+  void test_random()
+  {
+    /*
+     * Case1: Random inserts and erases agree with std::map, including range erases.
+     */
+    skip_map_int a;
+    std::map<int, int> b;
+    srand(7);
+    for (int i = 0; i < 20000; ++i)
+    {
+      const int key = rand() % 1000;
+      switch (rand() % 4)
+      {
+      case 0:
+        TS_ASSERT_EQUALS(a.erase(key), b.erase(key));
+        break;
+      case 1:
+        if (i % 64 == 0)
+        {
+          a.erase(a.lower_bound(key), a.upper_bound(key + 20));
+          b.erase(b.lower_bound(key), b.upper_bound(key + 20));
+        }
+        break;
+      default:
+        TS_ASSERT_EQUALS(a.insert(std::make_pair(key, key)).second, b.insert(std::make_pair(key, key)).second);
+        break;
+      }
+    }
+    TS_ASSERT_EQUALS(a.size(), b.size());
+    TS_ASSERT(std::equal(b.begin(), b.end(), a.begin()));
+    TS_ASSERT_EQUALS(a.lower_bound(500) == a.end(), b.lower_bound(500) == b.end());
+  }
+
+  void test_copy_swap()
+  {
+    const int lhs_values[] = { 1, 2, 3 };
+    const int rhs_values[] = { 4, 5 };
+    skip_map_obj a;
+    skip_map_obj b;
+    fill(a, lhs_values, 3);
+    fill(b, rhs_values, 2);
+
+    /*
+     * Case1: Copies compare equal.
+     */
+    skip_map_obj c(a);
+    TS_ASSERT(c == a);
+    TS_ASSERT(b != a);
+    c = b;
+    TS_ASSERT(is_container_valid(c, rhs_values, 2));
+
+    /*
+     * Case2: swap() relinks both heads, including with an empty map.
+     */
+    a.swap(b);
+    TS_ASSERT(is_container_valid(a, rhs_values, 2));
+    TS_ASSERT(is_container_valid(b, lhs_values, 3));
+    skip_map_obj empty;
+    a.swap(empty);
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    TS_ASSERT(is_container_valid(empty, rhs_values, 2));
+    a[6] = obj(60);
+    empty[6] = obj(60);
+    const int inserted[] = { 4, 5, 6 };
+    TS_ASSERT(is_container_valid(empty, inserted, 3));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case3: Moves leave the source empty.
+     */
+    skip_map_obj d(std::move(b));
+    TS_ASSERT(is_container_valid(d, lhs_values, 3));
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+    skip_map_obj e = { { 4, obj(40) }, { 5, obj(50) } };
+    TS_ASSERT(is_container_valid(e, rhs_values, 2));
+#endif
+  }
+
+  void test_fixed()
+  {
+    /*
+     * Case1: A fixed_skip_map holds N elements without allocating, whatever heights they draw.
+     */
+    flex::allocation_guard::enable();
+    fixed_skip_map_obj a;
+    TS_ASSERT(a.fixed());
+    for (int i = 0; i < 64; ++i)
+    {
+      a[i] = obj(i * 10);
+    }
+    for (int i = 0; i < 10000; ++i)
+    {
+      a.erase(a.begin());
+      a[i + 64] = obj((i + 64) * 10);
+    }
+    TS_ASSERT_EQUALS(a.size(), 64);
+    TS_ASSERT_EQUALS(a.begin()->first, 10000);
+    TS_ASSERT_EQUALS(a.rbegin()->first, 10063);
+    TS_ASSERT_EQUALS(a.find(10030)->second, 100300);
+
+    /*
+     * Case2: Copying and swapping fixed maps copies the elements.
+     */
+    const int lhs_values[] = { 1, 3, 5 };
+    const int rhs_values[] = { 2, 4 };
+    fixed_skip_map_int b;
+    fixed_skip_map_int c;
+    fill(b, lhs_values, 3);
+    fill(c, rhs_values, 2);
+    b.swap(c);
+    TS_ASSERT(is_container_valid(b, rhs_values, 2));
+    TS_ASSERT(is_container_valid(c, lhs_values, 3));
+    fixed_skip_map_int d(c);
+    TS_ASSERT(d == c);
+    flex::allocation_guard::disable();
+    skip_map_int e(c);
+    d = b;
+    TS_ASSERT(is_container_valid(d, rhs_values, 2));
+    fixed_skip_map_int f(e);
+    TS_ASSERT(is_container_valid(f, lhs_values, 3));
+
+    /*
+     * Case3: The buffer size is fixed by N.
+     */
+    TS_ASSERT(sizeof(fixed_skip_map_int) >= fixed_skip_map_int::BUFFER_SIZE);
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Exceeding N elements reports once and falls back to the heap.
+     */
+    fixed_skip_map_int a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a[i] = i * 10;
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 100);
+    TS_ASSERT_EQUALS(a.rbegin()->first, 99);
+    a.erase(a.begin(), a.find(90));
+    TS_ASSERT_EQUALS(a.size(), 10);
+  }
+
+};
@@ -0,0 +1,486 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_slist.h"
+#include "flex/debug/obj.h"
+
+#include <list>
+
+class slist_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::slist<obj> slist_obj;
+  typedef flex::slist<int> slist_int;
+  typedef flex::fixed_slist<obj, 16> fixed_slist_obj;
+  typedef flex::fixed_slist<int, 16> fixed_slist_int;
+
+  struct is_odd
+  {
+    bool operator()(int x) const
+    {
+      return (x % 2);
+    }
+  };
+
+  struct greater
+  {
+    bool operator()(int a, int b) const
+    {
+      return a > b;
+    }
+  };
+
+  struct same_tens
+  {
+    bool operator()(int a, int b) const
+    {
+      return (a / 10) == (b / 10);
+    }
+  };
+
+  //Orders by the tens digit only, so the ones digit shows whether equal elements kept their order.
+  struct tens_less
+  {
+    bool operator()(int a, int b) const
+    {
+      return (a / 10) < (b / 10);
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class List>
+  bool is_container_valid(const List& list, const int* expected, size_t n)
+  {
+    //Walks the list and checks that back() is the last element, which is where the tail pointer must point.
+    size_t i = 0;
+    typename List::const_iterator last = list.before_begin();
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it, ++i)
+    {
+      if ((i >= n) || !(*it == expected[i]))
+      {
+        return false;
+      }
+      last = it;
+    }
+    return (i == n) && (list.size() == n) && (list.empty() == (n == 0)) && ((n == 0) || (&list.back() == &*last));
+  }
+
+  void test_push_pop()
+  {
+    slist_obj a;
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+
+    /*
+     * Case1: push_back() appends through the tail pointer, push_front() prepends.
+     */
+    a.push_back(obj(2));
+    a.push_back(obj(3));
+    a.push_front(obj(1));
+    const int pushed[] = { 1, 2, 3 };
+    TS_ASSERT(is_container_valid(a, pushed, 3));
+    TS_ASSERT_EQUALS(a.front(), 1);
+    TS_ASSERT_EQUALS(a.back(), 3);
+
+    /*
+     * Case2: pop_front() down to empty resets the tail, so push_back() works again.
+     */
+    a.pop_front();
+    a.pop_front();
+    a.pop_front();
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    a.push_back(obj(4));
+    const int refilled[] = { 4 };
+    TS_ASSERT(is_container_valid(a, refilled, 1));
+
+    /*
+     * Case3: Used as a queue, the tail follows the back across many cycles.
+     */
+    for (int i = 5; i < 100; ++i)
+    {
+      a.push_back(obj(i));
+      TS_ASSERT_EQUALS(a.front(), i - 1);
+      a.pop_front();
+      TS_ASSERT_EQUALS(a.back(), i);
+    }
+    TS_ASSERT_EQUALS(a.size(), 1);
+  }
+
+  void test_insert_erase()
+  {
+    const int values[] = { 1, 2, 3 };
+    slist_obj a(values, values + 3);
+
+    /*
+     * Case1: insert_after() the last element moves the tail.
+     */
+    slist_obj::iterator it = a.insert_after(a.before_begin(), obj(0));
+    TS_ASSERT_EQUALS(*it, 0);
+    slist_obj::iterator last = a.begin();
+    std::advance(last, 3);
+    it = a.insert_after(last, 2, obj(4));
+    TS_ASSERT_EQUALS(*it, 4);
+    a.push_back(obj(5));
+    const int inserted[] = { 0, 1, 2, 3, 4, 4, 5 };
+    TS_ASSERT(is_container_valid(a, inserted, 7));
+
+    /*
+     * Case2: erase_after() returns the element after the erased one.
+     */
+    it = a.erase_after(a.begin());
+    TS_ASSERT_EQUALS(*it, 2);
+    const int erased[] = { 0, 2, 3, 4, 4, 5 };
+    TS_ASSERT(is_container_valid(a, erased, 6));
+
+    /*
+     * Case3: Erasing through the end moves the tail back.
+     */
+    it = a.begin();
+    ++it;
+    TS_ASSERT(a.erase_after(it, a.end()) == a.end());
+    a.push_back(obj(9));
+    const int truncated[] = { 0, 2, 9 };
+    TS_ASSERT(is_container_valid(a, truncated, 3));
+
+    /*
+     * Case4: An empty range erases nothing.
+     */
+    it = a.begin();
+    ++it;
+    slist_obj::iterator next = it;
+    ++next;
+    TS_ASSERT(a.erase_after(it, next) == next);
+    TS_ASSERT(is_container_valid(a, truncated, 3));
+
+    a.clear();
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+  }
+
+  void test_assign_resize()
+  {
+    slist_obj a(3, obj(7));
+    const int filled[] = { 7, 7, 7 };
+    TS_ASSERT(is_container_valid(a, filled, 3));
+
+    /*
+     * Case1: assign() reuses nodes, adding or erasing at the end.
+     */
+    const int values[] = { 1, 2, 3, 4, 5 };
+    a.assign(values, values + 5);
+    TS_ASSERT(is_container_valid(a, values, 5));
+    a.assign(values, values + 2);
+    TS_ASSERT(is_container_valid(a, values, 2));
+    a.assign(4, obj(6));
+    const int sixes[] = { 6, 6, 6, 6 };
+    TS_ASSERT(is_container_valid(a, sixes, 4));
+
+    /*
+     * Case2: resize() grows at the tail and shrinks from it.
+     */
+    a.resize(1);
+    a.resize(3, obj(8));
+    const int resized[] = { 6, 8, 8 };
+    TS_ASSERT(is_container_valid(a, resized, 3));
+    a.resize(0);
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+
+    /*
+     * Case3: Erased nodes are pooled and counted by capacity().
+     */
+    slist_obj b(4, obj(1));
+    b.resize(1);
+    TS_ASSERT_EQUALS(b.capacity(), 4);
+    b.shrink_to_fit();
+    TS_ASSERT_EQUALS(b.capacity(), 1);
+    b.reserve(8);
+    TS_ASSERT_EQUALS(b.capacity(), 8);
+  }
+
+  void test_remove_unique_reverse()
+  {
+    const int values[] = { 1, 2, 2, 3, 4, 4, 4, 5 };
+    slist_int a(values, values + 8);
+
+    /*
+     * Case1: unique() keeps the first of each run.
+     */
+    a.unique();
+    const int uniqued[] = { 1, 2, 3, 4, 5 };
+    TS_ASSERT(is_container_valid(a, uniqued, 5));
+
+    /*
+     * Case2: remove_if() at the end moves the tail back.
+     */
+    a.remove_if(is_odd());
+    const int evens[] = { 2, 4 };
+    TS_ASSERT(is_container_valid(a, evens, 2));
+    a.push_back(6);
+    a.remove(4);
+    a.remove(6);
+    a.push_back(8);
+    const int removed[] = { 2, 8 };
+    TS_ASSERT(is_container_valid(a, removed, 2));
+
+    /*
+     * Case3: reverse() makes the first element the tail.
+     */
+    a.push_front(0);
+    a.reverse();
+    a.push_back(-1);
+    const int reversed[] = { 8, 2, 0, -1 };
+    TS_ASSERT(is_container_valid(a, reversed, 4));
+
+    /*
+     * Case4: unique() with a predicate compares against the first of the run.
+     */
+    const int tens[] = { 10, 11, 19, 20, 25, 31 };
+    a.assign(tens, tens + 6);
+    a.unique(same_tens());
+    const int first_of_tens[] = { 10, 20, 31 };
+    TS_ASSERT(is_container_valid(a, first_of_tens, 3));
+  }
+
+  void test_splice_after()
+  {
+    const int lhs_values[] = { 1, 2, 3 };
+    const int rhs_values[] = { 4, 5, 6 };
+    slist_obj a(lhs_values, lhs_values + 3);
+    slist_obj b(rhs_values, rhs_values + 3);
+
+    /*
+     * Case1: Splicing a whole list after the tail moves the tail to the spliced list's last element.
+     */
+    slist_obj::iterator last = a.begin();
+    std::advance(last, 2);
+    flex::allocation_guard::enable();
+    a.splice_after(last, b);
+    flex::allocation_guard::disable();
+    const int joined[] = { 1, 2, 3, 4, 5, 6 };
+    TS_ASSERT(is_container_valid(a, joined, 6));
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+
+    /*
+     * Case2: Splicing a single element out of the end of a list moves that list's tail.
+     */
+    last = a.begin();
+    std::advance(last, 4);
+    b.splice_after(b.before_begin(), a, last);
+    const int single[] = { 6 };
+    TS_ASSERT(is_container_valid(b, single, 1));
+    TS_ASSERT(is_container_valid(a, joined, 5));
+
+    /*
+     * Case3: Splicing a range within the same list.
+     */
+    slist_obj::iterator first = a.begin();
+    last = a.begin();
+    std::advance(last, 3);
+    a.splice_after(a.before_begin(), a, first, last);
+    const int rotated[] = { 2, 3, 1, 4, 5 };
+    TS_ASSERT(is_container_valid(a, rotated, 5));
+
+    /*
+     * Case4: Moving the head element behind the tail.
+     */
+    last = a.begin();
+    std::advance(last, 4);
+    a.splice_after(last, a, a.before_begin());
+    const int moved[] = { 3, 1, 4, 5, 2 };
+    TS_ASSERT(is_container_valid(a, moved, 5));
+
+    /*
+     * Case5: Splicing an element after itself or its predecessor is a no-op.
+     */
+    a.splice_after(a.begin(), a, a.begin());
+    a.splice_after(a.before_begin(), a, a.before_begin());
+    TS_ASSERT(is_container_valid(a, moved, 5));
+  }
+
+  void test_sort_merge()
+  {
+    /*
+     * Case1: sort() is stable and leaves the tail on the last element.
+     */
+    const int values[] = { 31, 10, 22, 11, 30, 20, 12, 21 };
+    slist_int a(values, values + 8);
+    a.sort(tens_less());
+    const int stable[] = { 10, 11, 12, 22, 20, 21, 31, 30 };
+    TS_ASSERT(is_container_valid(a, stable, 8));
+    a.push_back(99);
+    TS_ASSERT_EQUALS(a.size(), 9);
+    TS_ASSERT_EQUALS(a.back(), 99);
+
+    /*
+     * Case2: sort() agrees with std::list::sort() on larger inputs.
+     */
+    slist_int b;
+    std::list<int> expected;
+    unsigned seed = 1;
+    for (int i = 0; i < 1000; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      b.push_front((int) (seed >> 16) % 500);
+      expected.push_front(b.front());
+    }
+    b.sort(greater());
+    expected.sort(greater());
+    TS_ASSERT(std::equal(expected.begin(), expected.end(), b.begin()));
+    TS_ASSERT_EQUALS(b.back(), expected.back());
+
+    /*
+     * Case3: merge() takes equal elements from this list first, and the tail follows the merged list.
+     */
+    const int lhs_values[] = { 10, 20, 30 };
+    const int rhs_values[] = { 11, 21, 31, 41 };
+    slist_int c(lhs_values, lhs_values + 3);
+    slist_int d(rhs_values, rhs_values + 4);
+    c.merge(d, tens_less());
+    const int merged[] = { 10, 11, 20, 21, 30, 31, 41 };
+    TS_ASSERT(is_container_valid(c, merged, 7));
+    TS_ASSERT(is_container_valid(d, NULL, 0));
+
+    /*
+     * Case4: merge() into an empty list.
+     */
+    slist_int e;
+    e.merge(c);
+    TS_ASSERT(is_container_valid(e, merged, 7));
+  }
+
+  void test_copy_swap()
+  {
+    const int lhs_values[] = { 1, 2, 3 };
+    const int rhs_values[] = { 4, 5 };
+    slist_obj a(lhs_values, lhs_values + 3);
+    slist_obj b(rhs_values, rhs_values + 2);
+
+    /*
+     * Case1: Copies compare equal.
+     */
+    slist_obj c(a);
+    TS_ASSERT(c == a);
+    TS_ASSERT(b != a);
+    TS_ASSERT(a < b);
+    c = b;
+    TS_ASSERT(is_container_valid(c, rhs_values, 2));
+
+    /*
+     * Case2: swap() exchanges contents and tails.
+     */
+    a.swap(b);
+    TS_ASSERT(is_container_valid(a, rhs_values, 2));
+    TS_ASSERT(is_container_valid(b, lhs_values, 3));
+    slist_obj empty;
+    a.swap(empty);
+    TS_ASSERT(is_container_valid(a, NULL, 0));
+    TS_ASSERT(is_container_valid(empty, rhs_values, 2));
+    a.push_back(obj(7));
+    empty.push_back(obj(6));
+    const int pushed[] = { 4, 5, 6 };
+    TS_ASSERT(is_container_valid(empty, pushed, 3));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case3: Moves leave the source empty.
+     */
+    slist_obj d(std::move(b));
+    TS_ASSERT(is_container_valid(d, lhs_values, 3));
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+    slist_obj e = { 4, 5 };
+    TS_ASSERT(is_container_valid(e, rhs_values, 2));
+#endif
+  }
+
+  void test_fixed()
+  {
+    /*
+     * Case1: A fixed_slist takes every node from its buffer, including those reused from the pool.
+     */
+    flex::allocation_guard::enable();
+    fixed_slist_obj a;
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.capacity(), 16);
+    for (int i = 0; i < 16; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(a.full());
+    for (int i = 0; i < 1000; ++i)
+    {
+      a.pop_front();
+      a.push_back(obj(i + 16));
+    }
+    TS_ASSERT_EQUALS(a.front(), 1000);
+    TS_ASSERT_EQUALS(a.back(), 1015);
+
+    /*
+     * Case2: Splicing and merging between fixed lists copies the elements, as with fixed_list.
+     */
+    const int lhs_values[] = { 1, 3, 5 };
+    const int rhs_values[] = { 2, 4, 6 };
+    fixed_slist_int b(lhs_values, lhs_values + 3);
+    fixed_slist_int c(rhs_values, rhs_values + 3);
+    b.merge(c);
+    const int merged[] = { 1, 2, 3, 4, 5, 6 };
+    TS_ASSERT(is_container_valid(b, merged, 6));
+    TS_ASSERT(is_container_valid(c, NULL, 0));
+    c.splice_after(c.before_begin(), b);
+    TS_ASSERT(is_container_valid(c, merged, 6));
+    TS_ASSERT(is_container_valid(b, NULL, 0));
+
+    /*
+     * Case3: Splicing within one fixed list relinks the nodes.
+     */
+    fixed_slist_int::iterator last = c.begin();
+    std::advance(last, 5);
+    c.splice_after(last, c, c.before_begin());
+    const int rotated[] = { 2, 3, 4, 5, 6, 1 };
+    TS_ASSERT(is_container_valid(c, rotated, 6));
+
+    /*
+     * Case4: Sorting and swapping fixed lists.
+     */
+    c.sort();
+    b.push_back(9);
+    c.swap(b);
+    const int nine[] = { 9 };
+    TS_ASSERT(is_container_valid(c, nine, 1));
+    TS_ASSERT(is_container_valid(b, merged, 6));
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Exceeding the buffer reports once and falls back to the heap.
+     */
+    fixed_slist_int a;
+    for (int i = 0; i < 20; ++i)
+    {
+      a.push_back(i);
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 20);
+    TS_ASSERT_EQUALS(a.back(), 19);
+
+    /*
+     * Case2: A plain slist spliced into a fixed one copies rather than mixing heap nodes into the buffer.
+     */
+    slist_int b(4, 7);
+    fixed_slist_int c;
+    c.splice_after(c.before_begin(), b);
+    TS_ASSERT_EQUALS(c.size(), 4);
+    TS_ASSERT(b.empty());
+  }
+
+};
@@ -0,0 +1,211 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/slot_map.h"
+#include "flex/debug/allocator.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class slot_map_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::slot_map<obj, flex::debug::allocator<obj> > map_obj;
+  typedef map_obj::handle_type handle_type;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+  }
+
+  bool is_container_valid(const map_obj& c)
+  {
+    //Every live object must be reachable through its own handle.
+    for (map_obj::const_iterator it = c.begin(); it != c.end(); ++it)
+    {
+      handle_type h = c.get_handle(it);
+      if (c.find(h) != it)
+      {
+        printf("Error: Expected (c.find(h) == it) when n=%zu\n", (size_t) (it - c.begin()));
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void test_default_constructor()
+  {
+    map_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.size(), 0);
+    TS_ASSERT_EQUALS(a.capacity(), 0);
+    TS_ASSERT(!a.fixed());
+
+    map_obj b(8);
+    TS_ASSERT_EQUALS(b.capacity(), 8);
+  }
+
+  void test_insert()
+  {
+    map_obj a;
+    handle_type h[16];
+    for (int i = 0; i < 16; ++i)
+    {
+      h[i] = a.insert(obj(i));
+    }
+    TS_ASSERT_EQUALS(a.size(), 16);
+    TS_ASSERT(is_container_valid(a));
+    for (int i = 0; i < 16; ++i)
+    {
+      TS_ASSERT(a.contains(h[i]));
+      TS_ASSERT_EQUALS(a[h[i]], i);
+      TS_ASSERT_EQUALS(a.at(h[i]), i);
+    }
+  }
+
+  void test_emplace()
+  {
+#ifdef FLEX_HAS_CXX11
+    map_obj a;
+    handle_type h = a.emplace(7);
+    TS_ASSERT_EQUALS(a[h], 7);
+    TS_ASSERT(!a[h].was_copied);
+#endif
+  }
+
+  void test_erase()
+  {
+    map_obj a;
+    handle_type h[8];
+    for (int i = 0; i < 8; ++i)
+    {
+      h[i] = a.insert(obj(i));
+    }
+
+    /*
+     * Case1: Erased handle is no longer valid.
+     */
+    TS_ASSERT(a.erase(h[2]));
+    TS_ASSERT(!a.contains(h[2]));
+    TS_ASSERT_EQUALS(a.find(h[2]), (obj* )NULL);
+    TS_ASSERT(!a.erase(h[2]));
+    TS_ASSERT_EQUALS(a.size(), 7);
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Other handles survive the move of the last object.
+     */
+    for (int i = 0; i < 8; ++i)
+    {
+      if (i != 2)
+      {
+        TS_ASSERT_EQUALS(a[h[i]], i);
+      }
+    }
+
+    /*
+     * Case3: A reused slot does not revive a stale handle.
+     */
+    handle_type g = a.insert(obj(100));
+    TS_ASSERT_EQUALS(g.mIndex, h[2].mIndex);
+    TS_ASSERT_DIFFERS(g.mGeneration, h[2].mGeneration);
+    TS_ASSERT(!a.contains(h[2]));
+    TS_ASSERT_EQUALS(a[g], 100);
+
+    /*
+     * Case4: Erase by iterator.
+     */
+    map_obj::iterator it = a.erase(a.begin());
+    TS_ASSERT_EQUALS(it, a.begin());
+    TS_ASSERT(!a.contains(h[0]));
+    TS_ASSERT_EQUALS(a.size(), 7);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_at_invalid()
+  {
+    map_obj a;
+    handle_type h = a.insert(obj(1));
+    a.erase(h);
+    TS_ASSERT_THROWS(a.at(h), std::out_of_range);
+    TS_ASSERT_THROWS(a.at(handle_type()), std::out_of_range);
+  }
+
+  void test_clear()
+  {
+    map_obj a;
+    handle_type h[4];
+    for (int i = 0; i < 4; ++i)
+    {
+      h[i] = a.insert(obj(i));
+    }
+    a.clear();
+    TS_ASSERT(a.empty());
+    for (int i = 0; i < 4; ++i)
+    {
+      TS_ASSERT(!a.contains(h[i]));
+    }
+    a.insert(obj(5));
+    TS_ASSERT_EQUALS(a.size(), 1);
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_iteration()
+  {
+    map_obj a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a.insert(obj(i));
+    }
+    int sum = 0;
+    for (map_obj::iterator it = a.begin(); it != a.end(); ++it)
+    {
+      sum += *it;
+    }
+    TS_ASSERT_EQUALS(sum, 45);
+    TS_ASSERT_EQUALS(a.end() - a.begin(), 10);
+    TS_ASSERT_EQUALS(a.data(), &(*a.begin()));
+  }
+
+  void test_copy()
+  {
+    map_obj a;
+    handle_type h[4];
+    for (int i = 0; i < 4; ++i)
+    {
+      h[i] = a.insert(obj(i));
+    }
+    a.erase(h[1]);
+
+    map_obj b(a);
+    TS_ASSERT_EQUALS(b.size(), 3);
+    TS_ASSERT(!b.contains(h[1]));
+    TS_ASSERT_EQUALS(b[h[3]], 3);
+    TS_ASSERT(is_container_valid(b));
+
+    map_obj c;
+    c.insert(obj(9));
+    c = a;
+    TS_ASSERT_EQUALS(c.size(), 3);
+    TS_ASSERT_EQUALS(c[h[0]], 0);
+  }
+
+  void test_move()
+  {
+#ifdef FLEX_HAS_CXX11
+    map_obj a;
+    handle_type h = a.insert(obj(3));
+    obj* ptr = a.find(h);
+    map_obj b(std::move(a));
+    TS_ASSERT_EQUALS(b.find(h), ptr);
+    TS_ASSERT(a.empty());
+#endif
+  }
+
+};
@@ -0,0 +1,195 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/small_vector.h"
+#include "flex/debug/allocator.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class small_vector_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::small_vector<obj, 8, flex::debug::allocator<obj> > vec;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  bool is_container_valid(const vec& c)
+  {
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+      if (c[i].init != obj::INIT_KEY)
+      {
+        printf("Error: Expected (c[i].init == obj::INIT_KEY) when i=%zu\n", i);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void test_default_constructor()
+  {
+    flex::allocation_guard::enable();
+    vec a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT(a.is_inline());
+    TS_ASSERT_EQUALS(a.capacity(), 8);
+    TS_ASSERT_LESS_THAN(8, a.max_size());
+  }
+
+  void test_fill_constructor()
+  {
+    /*
+     * Case1: Fits inline.
+     */
+    vec a(4, obj(1));
+    TS_ASSERT(a.is_inline());
+    TS_ASSERT_EQUALS(a.size(), 4);
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Spills during construction without an error.
+     */
+    vec b(20, obj(2));
+    TS_ASSERT(!b.is_inline());
+    TS_ASSERT_EQUALS(b.size(), 20);
+    TS_ASSERT_EQUALS(b[19], 2);
+    TS_ASSERT(is_container_valid(b));
+  }
+
+  void test_spill()
+  {
+    flex::allocation_guard::enable();
+    vec a;
+    for (int i = 0; i < 8; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(a.is_inline());
+
+    /*
+     * Case1: Spilling allocates but is not reported as a fixed container overflow.
+     */
+    flex::allocation_guard::disable();
+    a.push_back(obj(8));
+    TS_ASSERT(!a.is_inline());
+    TS_ASSERT(!errno);
+    for (int i = 0; i < 9; ++i)
+    {
+      TS_ASSERT_EQUALS(a[i], i);
+    }
+    TS_ASSERT(is_container_valid(a));
+  }
+
+  void test_clear()
+  {
+    vec a(20, obj(1));
+    TS_ASSERT(!a.is_inline());
+    a.clear();
+    TS_ASSERT(a.empty());
+    TS_ASSERT(a.is_inline());
+    TS_ASSERT_EQUALS(a.capacity(), 8);
+
+    /*
+     * Case1: Inline buffer is reused after clear.
+     */
+    flex::allocation_guard::enable();
+    for (int i = 0; i < 8; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(a.is_inline());
+  }
+
+  void test_shrink_to_fit()
+  {
+    /*
+     * Case1: Elements fit inline again.
+     */
+    vec a(20, obj(1));
+    a.resize(5);
+    a.shrink_to_fit();
+    TS_ASSERT(a.is_inline());
+    TS_ASSERT_EQUALS(a.size(), 5);
+    TS_ASSERT(is_container_valid(a));
+
+    /*
+     * Case2: Elements do not fit inline.
+     */
+    vec b(20, obj(1));
+    b.reserve(64);
+    b.shrink_to_fit();
+    TS_ASSERT(!b.is_inline());
+    TS_ASSERT_EQUALS(b.capacity(), 20);
+    TS_ASSERT(is_container_valid(b));
+  }
+
+  void test_copy()
+  {
+    vec a(4, obj(1));
+    vec b(a);
+    TS_ASSERT(b.is_inline());
+    TS_ASSERT_EQUALS(b.size(), 4);
+
+    vec c(20, obj(3));
+    vec d(c);
+    TS_ASSERT(!d.is_inline());
+    TS_ASSERT_EQUALS(d.size(), 20);
+
+    d = a;
+    TS_ASSERT_EQUALS(d.size(), 4);
+    TS_ASSERT_EQUALS(d[0], 1);
+  }
+
+  void test_move()
+  {
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case1: Spilled buffer is stolen.
+     */
+    vec a(20, obj(1));
+    obj* ptr = &a[0];
+    vec b(std::move(a));
+    TS_ASSERT_EQUALS(&b[0], ptr);
+    TS_ASSERT(a.is_inline());
+    TS_ASSERT(a.empty());
+
+    /*
+     * Case2: Inline elements are moved.
+     */
+    vec c(4, obj(2));
+    vec d(std::move(c));
+    TS_ASSERT(d.is_inline());
+    TS_ASSERT_EQUALS(d.size(), 4);
+    TS_ASSERT(c.empty());
+
+    /*
+     * Case3: Move assignment steals from a spilled vector.
+     */
+    vec e(4, obj(5));
+    e = std::move(b);
+    TS_ASSERT_EQUALS(&e[0], ptr);
+    TS_ASSERT(b.is_inline());
+
+    /*
+     * Case4: Move from a plain vector.
+     */
+    vector<obj, flex::debug::allocator<obj> > v(20, obj(6));
+    ptr = &v[0];
+    vec f(std::move(v));
+    TS_ASSERT_EQUALS(&f[0], ptr);
+    TS_ASSERT(v.empty());
+#endif
+  }
+
+};
@@ -0,0 +1,252 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/soa_vector.h"
+#include "flex/debug/allocator.h"
+#include "flex/debug/obj.h"
+
+using namespace flex;
+
+class soa_vector_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+#ifdef FLEX_HAS_CXX11
+    flex::allocation_guard::enable();
+    soa_vector<int, double> a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 0);
+    TS_ASSERT(!a.fixed());
+#endif
+  }
+
+  void test_fill_constructor()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a(5, std::make_tuple(3, obj(4)));
+    TS_ASSERT_EQUALS(a.size(), 5);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+      TS_ASSERT_EQUALS(a.get<0>(i), 3);
+      TS_ASSERT_EQUALS(a.get<1>(i), 4);
+    }
+
+    soa_vector<int, obj> b(3);
+    TS_ASSERT_EQUALS(b.get<0>(2), 0);
+    TS_ASSERT_EQUALS(b.get<1>(2).val, obj::DEFAULT_VAL);
+#endif
+  }
+
+  void test_columns()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<char, double, int> a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a.push_back(std::make_tuple('a' + (i % 26), i * 0.5, i));
+    }
+
+    /*
+     * Case1: Each column is a contiguous, aligned array.
+     */
+    soa_span<double> d = a.column<1>();
+    TS_ASSERT_EQUALS(d.size(), 100);
+    TS_ASSERT_EQUALS(d.data(), a.data<1>());
+    TS_ASSERT_EQUALS((size_t ) a.data<1>() % alignof(std::max_align_t), 0);
+    TS_ASSERT_EQUALS((size_t ) a.data<2>() % alignof(std::max_align_t), 0);
+    double sum = 0;
+    for (double* it = d.begin(); it != d.end(); ++it)
+    {
+      sum += *it;
+    }
+    TS_ASSERT_EQUALS(sum, 2475.0);
+
+    /*
+     * Case2: Columns of a const container are read-only.
+     */
+    const soa_vector<char, double, int>& b = a;
+    soa_span<const int> c = b.column<2>();
+    TS_ASSERT_EQUALS(c[99], 99);
+    TS_ASSERT_EQUALS(b.get<0>(27), 'b');
+#endif
+  }
+
+  void test_reference()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a;
+    a.emplace_back(1, obj(10));
+    a.emplace_back(2, 20);
+
+    /*
+     * Case1: Fields are read and written through the row.
+     */
+    soa_vector<int, obj>::reference row = a[1];
+    TS_ASSERT_EQUALS(std::get<0>(row), 2);
+    std::get<1>(row).val = 21;
+    TS_ASSERT_EQUALS(a.get<1>(1), 21);
+
+    /*
+     * Case2: A row is assigned from and copied to a value.
+     */
+    a[0] = std::make_tuple(5, obj(50));
+    soa_vector<int, obj>::value_type val = a[0];
+    TS_ASSERT_EQUALS(std::get<0>(val), 5);
+    TS_ASSERT_EQUALS(std::get<1>(val), 50);
+    TS_ASSERT_EQUALS(std::get<0>(a.back()), 2);
+    TS_ASSERT_EQUALS(std::get<0>(a.front()), 5);
+    TS_ASSERT_THROWS(a.at(2), std::out_of_range);
+#endif
+  }
+
+  void test_push_back()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a;
+    for (int i = 0; i < 50; ++i)
+    {
+      a.push_back(std::make_tuple(i, obj(i)));
+    }
+    TS_ASSERT_EQUALS(a.size(), 50);
+    TS_ASSERT_EQUALS(a.capacity(), 64);
+    for (int i = 0; i < 50; ++i)
+    {
+      TS_ASSERT_EQUALS(a.get<0>(i), i);
+      TS_ASSERT_EQUALS(a.get<1>(i), i);
+      TS_ASSERT_EQUALS(a.get<1>(i).init, obj::INIT_KEY);
+    }
+
+    /*
+     * Case1: Pushing fields of the container onto itself while it grows.
+     */
+    a.shrink_to_fit();
+    a.emplace_back(a.get<0>(3), a.get<1>(4));
+    TS_ASSERT_EQUALS(a.get<0>(50), 3);
+    TS_ASSERT_EQUALS(a.get<1>(50), 4);
+#endif
+  }
+
+  void test_erase()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a;
+    for (int i = 0; i < 10; ++i)
+    {
+      a.emplace_back(i, obj(i));
+    }
+
+    /*
+     * Case1: Single row.
+     */
+    a.erase(0);
+    TS_ASSERT_EQUALS(a.size(), 9);
+    TS_ASSERT_EQUALS(a.get<0>(0), 1);
+    TS_ASSERT_EQUALS(a.get<1>(8), 9);
+
+    /*
+     * Case2: Range of rows.
+     */
+    a.erase(2, 5);
+    TS_ASSERT_EQUALS(a.size(), 6);
+    TS_ASSERT_EQUALS(a.get<0>(1), 2);
+    TS_ASSERT_EQUALS(a.get<0>(2), 6);
+    TS_ASSERT_EQUALS(a.get<1>(5), 9);
+
+    a.pop_back();
+    TS_ASSERT_EQUALS(a.size(), 5);
+    TS_ASSERT_EQUALS(std::get<1>(a.back()), 8);
+#endif
+  }
+
+  void test_resize()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a(2, std::make_tuple(1, obj(1)));
+    a.resize(6, std::make_tuple(2, obj(2)));
+    TS_ASSERT_EQUALS(a.size(), 6);
+    TS_ASSERT_EQUALS(a.get<0>(1), 1);
+    TS_ASSERT_EQUALS(a.get<1>(5), 2);
+
+    a.resize(3);
+    TS_ASSERT_EQUALS(a.size(), 3);
+    a.shrink_to_fit();
+    TS_ASSERT_EQUALS(a.capacity(), 3);
+    TS_ASSERT_EQUALS(a.get<1>(2), 2);
+
+    a.clear();
+    TS_ASSERT(a.empty());
+    a.shrink_to_fit();
+    TS_ASSERT_EQUALS(a.capacity(), 0);
+#endif
+  }
+
+  void test_copy()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a(4, std::make_tuple(1, obj(2)));
+    soa_vector<int, obj> b(a);
+    TS_ASSERT(a == b);
+
+    soa_vector<int, obj> c;
+    c = a;
+    TS_ASSERT(a == c);
+    c.get<1>(3).val = 5;
+    TS_ASSERT(a != c);
+#endif
+  }
+
+  void test_move()
+  {
+#ifdef FLEX_HAS_CXX11
+    soa_vector<int, obj> a(4, std::make_tuple(1, obj(2)));
+    int* ptr = a.data<0>();
+    soa_vector<int, obj> b(std::move(a));
+    TS_ASSERT_EQUALS(b.data<0>(), ptr);
+    TS_ASSERT(a.empty());
+
+    soa_vector<int, obj> c(1);
+    c = std::move(b);
+    TS_ASSERT_EQUALS(c.data<0>(), ptr);
+    TS_ASSERT_EQUALS(c.size(), 4);
+    TS_ASSERT_EQUALS(c.get<1>(3), 2);
+#endif
+  }
+
+  void test_allocator_growth()
+  {
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case1: The buffer is taken from Alloc and grown by the Growth policy.
+     */
+    typedef flex::debug::allocator<char> alloc;
+    flex::debug::allocator<char>::clear();
+    {
+      basic_soa_vector<alloc, one_and_half_growth, int, obj> a;
+      for (int i = 0; i < 5; ++i)
+      {
+        a.push_back(std::make_tuple(i, obj(i)));
+      }
+      TS_ASSERT_EQUALS(a.capacity(), 6);
+      TS_ASSERT_EQUALS(alloc::mAllocatedPointers.size(), 1);
+      TS_ASSERT_EQUALS(alloc::mAllocatedPointers.begin()->second, a.bytes(6));
+      TS_ASSERT_EQUALS(a.get<1>(4), 4);
+    }
+    TS_ASSERT(alloc::mAllocatedPointers.empty());
+#endif
+  }
+
+};
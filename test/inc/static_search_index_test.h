@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/static_search_index.h"
+#include "flex/fixed_vector.h"
+
+#include <functional>
+
+using namespace flex;
+
+class static_search_index_test: public CxxTest::TestSuite
+{
+public:
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_default_constructor()
+  {
+    flex::allocation_guard::enable();
+    static_search_index<int> a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.size(), 0);
+    TS_ASSERT_EQUALS(a.lower_bound(5), 0);
+    TS_ASSERT_EQUALS(a.upper_bound(5), 0);
+    TS_ASSERT_EQUALS(a.find(5), 0);
+    TS_ASSERT_EQUALS(a.count(5), 0);
+  }
+
+  void test_find()
+  {
+    fixed_vector<int, 8> table;
+    for (int i = 1; i <= 7; ++i)
+    {
+      table.push_back(i * 10);
+    }
+    static_search_index<int> a(table.begin(), table.end());
+    TS_ASSERT_EQUALS(a.size(), 7);
+
+    /*
+     * Case1: The result is the position of the key in the source table.
+     */
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+      TS_ASSERT_EQUALS(a.find(table[i]), i);
+      TS_ASSERT_EQUALS(a.count(table[i]), 1);
+    }
+
+    /*
+     * Case2: Missing keys yield size().
+     */
+    TS_ASSERT_EQUALS(a.find(5), a.size());
+    TS_ASSERT_EQUALS(a.find(35), a.size());
+    TS_ASSERT_EQUALS(a.find(80), a.size());
+    TS_ASSERT_EQUALS(a.count(35), 0);
+  }
+
+  void test_lower_bound()
+  {
+    //Every size from 1 to 130 covers complete and incomplete bottom levels of the tree.
+    for (int n = 1; n <= 130; ++n)
+    {
+      vector<int> table;
+      for (int i = 0; i < n; ++i)
+      {
+        table.push_back(2 * (i / 3)); //Each key repeats up to three times.
+      }
+      static_search_index<int> a(table.begin(), table.end());
+      for (int key = -1; key <= 2 * (n / 3) + 2; ++key)
+      {
+        TS_ASSERT_EQUALS(a.lower_bound(key),
+            (size_t )(std::lower_bound(table.begin(), table.end(), key) - table.begin()));
+        TS_ASSERT_EQUALS(a.upper_bound(key),
+            (size_t )(std::upper_bound(table.begin(), table.end(), key) - table.begin()));
+      }
+    }
+  }
+
+  void test_compare()
+  {
+    double data[] = { 9.5, 7.25, 3.0, 1.5, -2.0 };
+    static_search_index<double, std::greater<double> > a(data, data + 5);
+    TS_ASSERT_EQUALS(a.find(3.0), 2);
+    TS_ASSERT_EQUALS(a.lower_bound(8.0), 1);
+    TS_ASSERT_EQUALS(a.upper_bound(-2.0), 5);
+    TS_ASSERT_EQUALS(a.lower_bound(100.0), 0);
+  }
+
+  void test_assign()
+  {
+    int first[] = { 1, 2, 3 };
+    int second[] = { 4, 5, 6, 7, 8 };
+    static_search_index<int> a(first, first + 3);
+    a.assign(second, second + 5);
+    TS_ASSERT_EQUALS(a.size(), 5);
+    TS_ASSERT_EQUALS(a.find(2), 5);
+    TS_ASSERT_EQUALS(a.find(8), 4);
+
+    static_search_index<int> b;
+    b.swap(a);
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(b.find(4), 0);
+
+    b.clear();
+    TS_ASSERT(b.empty());
+    TS_ASSERT_EQUALS(b.lower_bound(4), 0);
+  }
+
+};
@@ -7,6 +7,35 @@ class string_test: public CxxTest::TestSuite
 {
   typedef flex::basic_string<char, flex::debug::allocator<char> > str;
 
+  //Copies up to mCount characters of mSrc into the window, like read() would.
+  struct reader
+  {
+    const char* mSrc;
+    size_t mCount;
+
+    reader(const char* src, size_t count) :
+        mSrc(src), mCount(count)
+    {
+    }
+
+    size_t operator()(char* p, size_t n)
+    {
+      size_t count = (n < mCount) ? n : mCount;
+      memcpy(p, mSrc, count);
+      return count;
+    }
+  };
+
+  //Uses the whole window as scratch space but produces nothing.
+  struct scribbler
+  {
+    size_t operator()(char* p, size_t n)
+    {
+      memset(p, 'x', n);
+      return 0;
+    }
+  };
+
 public:
 
   void setUp()
@@ -351,6 +380,40 @@ public:
     TS_ASSERT_EQUALS(a.c_str(), "01234567");
   }
 
+  void test_append_with()
+  {
+    /*
+     * Case1: Fewer characters are produced than requested.
+     */
+    str a("0123");
+    TS_ASSERT_EQUALS(a.append_with(64, reader("4567", 4)), 4);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.size(), 8);
+    TS_ASSERT_LESS_THAN_EQUALS(68, a.capacity());
+    TS_ASSERT_EQUALS(a.c_str(), "01234567");
+
+    /*
+     * Case2: The whole window is used.
+     */
+    TS_ASSERT_EQUALS(a.append_with(2, reader("89ab", 4)), 2);
+    TS_ASSERT_EQUALS(a.c_str(), "0123456789");
+
+    /*
+     * Case3: Nothing is produced.
+     */
+    str b;
+    TS_ASSERT_EQUALS(b.append_with(16, reader("", 0)), 0);
+    TS_ASSERT(b.empty());
+    TS_ASSERT_EQUALS(b.c_str(), "");
+
+    /*
+     * Case4: The string stays terminated when the window is scribbled on but nothing is produced.
+     */
+    TS_ASSERT_EQUALS(a.append_with(8, scribbler()), 0);
+    TS_ASSERT_EQUALS(a.size(), 10);
+    TS_ASSERT_EQUALS(a.c_str(), "0123456789");
+  }
+
   void test_assign_string()
   {
     /*
@@ -1912,6 +1975,26 @@ public:
     TS_ASSERT_EQUALS(a.capacity(), 8);
   }
 
+  void test_resize_default_init()
+  {
+    /*
+     * Case1: Size is increased and the caller fills the characters.
+     */
+    str a("01");
+    a.resize_default_init(8);
+    TS_ASSERT_EQUALS(a.size(), 8);
+    TS_ASSERT_EQUALS(a[8], 0);
+    memcpy(a.begin() + 2, "234567", 6);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.c_str(), "01234567");
+
+    /*
+     * Case2: Size is decreased.
+     */
+    a.resize_uninitialized(4);
+    TS_ASSERT_EQUALS(a.c_str(), "0123");
+  }
+
   void test_rfind_string()
   {
     str a("01234567");
@@ -0,0 +1,313 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/timer_wheel.h"
+#include "flex/debug/obj.h"
+
+#include <stdlib.h>
+#include <vector>
+
+class timer_wheel_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+
+  //Records the payloads it is called with.
+  struct recorder
+  {
+    recorder() :
+        fired(NULL)
+    {
+    }
+
+    explicit recorder(std::vector<int>* f) :
+        fired(f)
+    {
+    }
+
+    template<class T>
+    void operator()(T& val)
+    {
+      fired->push_back(val);
+    }
+
+    std::vector<int>* fired;
+  };
+
+  //Counts the timers that fire on any tick but the one their payload names.
+  struct deadline
+  {
+    deadline() :
+        clock(NULL), fired(0), wrong(0)
+    {
+    }
+
+    void operator()(uint64_t& expires)
+    {
+      ++fired;
+      if (expires != *clock)
+      {
+        ++wrong;
+      }
+    }
+
+    const uint64_t* clock;
+    size_t fired;
+    size_t wrong;
+  };
+
+  typedef flex::timer_wheel<obj, 64, recorder> wheel_obj;
+  typedef flex::timer_wheel<int, 64, recorder> wheel_int;
+
+  //A handler that cancels one timer and schedules another when it first fires.
+  struct rescheduler
+  {
+    rescheduler() :
+        wheel(NULL), fired(NULL)
+    {
+    }
+
+    void operator()(int& val);
+
+    flex::timer_wheel<int, 64, rescheduler>* wheel;
+    flex::timer_wheel_handle victim;
+    std::vector<int>* fired;
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  void test_schedule_tick()
+  {
+    flex::allocation_guard::enable();
+    std::vector<int> fired;
+    fired.reserve(64);
+    wheel_obj a((recorder(&fired)));
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.capacity(), 64);
+    TS_ASSERT_EQUALS(a.now(), 0);
+
+    /*
+     * Case1: Timers fire on the tick their delay names, in the order they were scheduled.
+     */
+    a.schedule(3, obj(30));
+    a.schedule(1, obj(10));
+    a.schedule(3, obj(31));
+    a.schedule(5, obj(50));
+    TS_ASSERT_EQUALS(a.size(), 4);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(fired.size(), 1);
+    TS_ASSERT_EQUALS(fired[0], 10);
+    TS_ASSERT_EQUALS(a.tick(), 0);
+    TS_ASSERT_EQUALS(a.tick(), 2);
+    TS_ASSERT_EQUALS(fired[1], 30);
+    TS_ASSERT_EQUALS(fired[2], 31);
+    TS_ASSERT_EQUALS(a.advance(2), 1);
+    TS_ASSERT_EQUALS(fired[3], 50);
+    TS_ASSERT_EQUALS(a.now(), 5);
+    TS_ASSERT(a.empty());
+
+    /*
+     * Case2: A delay of zero fires on the next tick.
+     */
+    a.schedule(0, obj(0));
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(fired.back(), 0);
+
+    /*
+     * Case3: Delays that wrap the first level fire on time.
+     */
+    fired.clear();
+    a.schedule(255, obj(255));
+    a.schedule(256, obj(256));
+    a.schedule(257, obj(257));
+    a.schedule(1000, obj(1000));
+    TS_ASSERT_EQUALS(a.advance(254), 0);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(a.advance(742), 0);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    const int wrapped[] = { 255, 256, 257, 1000 };
+    TS_ASSERT(std::equal(wrapped, wrapped + 4, fired.begin()));
+
+    /*
+     * Case4: A cascaded timer fires ahead of one scheduled later for the same tick.
+     */
+    fired.clear();
+    a.schedule(300, obj(1));
+    a.advance(200);
+    a.schedule(100, obj(2));
+    a.schedule(400, obj(3));
+    TS_ASSERT_EQUALS(a.advance(100), 2);
+    a.advance(200);
+    a.schedule(100, obj(4));
+    TS_ASSERT_EQUALS(a.advance(100), 2);
+    const int ordered[] = { 1, 2, 3, 4 };
+    TS_ASSERT(std::equal(ordered, ordered + 4, fired.begin()));
+  }
+
+  void test_cancel()
+  {
+    flex::allocation_guard::enable();
+    std::vector<int> fired;
+    fired.reserve(64);
+    wheel_obj a((recorder(&fired)));
+
+    /*
+     * Case1: cancel() removes a pending timer, and its handle stops matching.
+     */
+    wheel_obj::handle_type h1 = a.schedule(10, obj(1));
+    wheel_obj::handle_type h2 = a.schedule(1000, obj(2));
+    TS_ASSERT(a.pending(h1));
+    TS_ASSERT_EQUALS(*a.get(h1), 1);
+    TS_ASSERT_EQUALS(a.expires(h2), 1000);
+    TS_ASSERT(a.cancel(h1));
+    TS_ASSERT(!a.cancel(h1));
+    TS_ASSERT(!a.pending(h1));
+    TS_ASSERT(!a.get(h1));
+    TS_ASSERT(!a.cancel(wheel_obj::handle_type()));
+    TS_ASSERT_EQUALS(a.size(), 1);
+
+    /*
+     * Case2: A stale handle doesn't match the timer that reuses its node.
+     */
+    wheel_obj::handle_type h3 = a.schedule(10, obj(3));
+    TS_ASSERT_EQUALS(h3.mNode, h1.mNode);
+    TS_ASSERT(h3 != h1);
+    TS_ASSERT(!a.pending(h1));
+    TS_ASSERT(a.pending(h3));
+
+    /*
+     * Case3: reschedule() moves a pending timer, keeping its handle.
+     */
+    TS_ASSERT(a.reschedule(h2, 5));
+    TS_ASSERT(!a.reschedule(h1, 5));
+    TS_ASSERT_EQUALS(a.advance(5), 1);
+    TS_ASSERT_EQUALS(fired.back(), 2);
+    TS_ASSERT(!a.pending(h2));
+    TS_ASSERT_EQUALS(a.advance(5), 1);
+    TS_ASSERT_EQUALS(fired.back(), 3);
+
+    /*
+     * Case4: clear() drops every timer without firing it.
+     */
+    for (int i = 0; i < 64; ++i)
+    {
+      a.schedule(i * 1000, obj(i));
+    }
+    fired.clear();
+    a.clear();
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.advance(100000), 0);
+    TS_ASSERT(fired.empty());
+  }
+
+  void test_handler()
+  {
+    /*
+     * Case1: A handler may cancel a timer in the same batch and schedule new ones.
+     */
+    flex::allocation_guard::enable();
+    std::vector<int> fired;
+    fired.reserve(64);
+    flex::timer_wheel<int, 64, rescheduler> a;
+    a.get_expiry_handler().wheel = &a;
+    a.get_expiry_handler().fired = &fired;
+    a.schedule(2, 1);
+    a.get_expiry_handler().victim = a.schedule(2, 2);
+    a.schedule(2, 3);
+    TS_ASSERT_EQUALS(a.advance(2), 2);
+    TS_ASSERT_EQUALS(fired.size(), 2);
+    TS_ASSERT_EQUALS(fired[0], 1);
+    TS_ASSERT_EQUALS(fired[1], 3);
+    TS_ASSERT_EQUALS(a.size(), 1);
+    TS_ASSERT_EQUALS(a.tick(), 1);
+    TS_ASSERT_EQUALS(fired.back(), 100);
+    TS_ASSERT(a.empty());
+  }
+
+  void test_random()
+  {
+    /*
+     * Case1: Random delays across the lower three levels all fire on their own tick.
+     */
+    flex::allocation_guard::enable();
+    static flex::timer_wheel<uint64_t, 4096, deadline> a;
+    uint64_t clock = 0;
+    a.get_expiry_handler().clock = &clock;
+    srand(3);
+    for (int i = 0; i < 4096; ++i)
+    {
+      const uint64_t delay = (uint64_t) (rand() % (1 << (4 * (i % 6))));
+      a.schedule(delay, a.now() + (delay ? delay : 1));
+      if (i % 16 == 0)
+      {
+        for (int j = 0; j < 5; ++j)
+        {
+          clock = a.now() + 1;
+          a.tick();
+        }
+      }
+    }
+    while (!a.empty())
+    {
+      clock = a.now() + 1;
+      a.tick();
+    }
+    TS_ASSERT_EQUALS(a.get_expiry_handler().fired, 4096);
+    TS_ASSERT_EQUALS(a.get_expiry_handler().wrong, 0);
+
+    /*
+     * Case2: A delay in the top level cascades through every level below it.
+     */
+    const uint64_t delay = (uint64_t(1) << 24) + 70000;
+    a.schedule(delay, a.now() + delay);
+    a.schedule(delay + 1, a.now() + delay + 1);
+    while (!a.empty())
+    {
+      clock = a.now() + 1;
+      a.tick();
+    }
+    TS_ASSERT_EQUALS(a.get_expiry_handler().fired, 4098);
+    TS_ASSERT_EQUALS(a.get_expiry_handler().wrong, 0);
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Scheduling more than N timers reports once and falls back to the heap.
+     */
+    std::vector<int> fired;
+    wheel_int a((recorder(&fired)));
+    for (int i = 0; i < 100; ++i)
+    {
+      a.schedule(i + 1, i);
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 100);
+    TS_ASSERT_EQUALS(a.advance(100), 100);
+    TS_ASSERT_EQUALS(fired.size(), 100);
+    TS_ASSERT_EQUALS(fired.back(), 99);
+  }
+
+};
+
+inline void timer_wheel_test::rescheduler::operator()(int& val)
+{
+  fired->push_back(val);
+  if (val == 1)
+  {
+    wheel->cancel(victim);
+    wheel->schedule(1, 100);
+  }
+}
@@ -0,0 +1,456 @@
+#include <cxxtest/TestSuite.h>
+
+#include "flex/fixed_unrolled_list.h"
+#include "flex/debug/obj.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+class unrolled_list_test: public CxxTest::TestSuite
+{
+public:
+
+  typedef flex::debug::obj obj;
+  typedef flex::unrolled_list<obj, 4> list_obj;
+  typedef flex::unrolled_list<int, 4> list_int;
+  typedef flex::fixed_unrolled_list<obj, 32, 4> fixed_list_obj;
+
+  struct is_odd
+  {
+    bool operator()(int x) const
+    {
+      return (x % 2);
+    }
+  };
+
+  void setUp()
+  {
+    errno = 0;
+  }
+
+  void tearDown()
+  {
+    TS_ASSERT(!errno);
+    flex::allocation_guard::disable();
+  }
+
+  template<class List>
+  bool is_container_valid(const List& list, const int* expected, size_t n, size_t k = 4)
+  {
+    //Walks the list in both directions and checks every chunk is non-empty and within capacity, and every chunk
+    //but the first and last is at least half full.  k is the chunk size.
+    size_t i = 0;
+    typename List::const_iterator prev = list.end();
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it, ++i)
+    {
+      typename List::const_iterator back(it);
+      if ((i >= n) || !(*it == expected[i]) || ((i > 0) && (--back != prev)))
+      {
+        return false;
+      }
+      prev = it;
+    }
+
+    size_t chunks = 0;
+    size_t count = 0;
+    typename List::const_iterator it = list.begin();
+    while (it != list.end())
+    {
+      const flex::list_node_base* const node = it.mNode;
+      const size_t chunk_size = static_cast<const typename List::chunk_type*>(node)->mCount;
+      const bool inner = (node != list.begin().mNode) && (node->mNext != list.end().mNode);
+      if ((chunk_size == 0) || (chunk_size > k) || (inner && (chunk_size < k / 2)))
+      {
+        return false;
+      }
+      count += chunk_size;
+      ++chunks;
+      it = typename List::const_iterator(node->mNext, 0);
+    }
+
+    typename List::const_iterator last(list.end());
+    return (i == n) && (count == n) && (list.size() == n) && (list.chunk_count() == chunks)
+        && (list.empty() == (n == 0)) && ((n == 0) || (--last == prev));
+  }
+
+  void test_push_pop()
+  {
+    list_obj a;
+    TS_ASSERT(a.empty());
+    TS_ASSERT_EQUALS(a.chunk_count(), 0);
+
+    /*
+     * Case1: Pushing to the back fills each chunk before starting the next.
+     */
+    for (int i = 0; i < 10; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    const int expected[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    TS_ASSERT(is_container_valid(a, expected, 10));
+    TS_ASSERT_EQUALS(a.chunk_count(), 3);
+    TS_ASSERT_EQUALS(a.front(), 0);
+    TS_ASSERT_EQUALS(a.back(), 9);
+
+    /*
+     * Case2: Pushing to the front.
+     */
+    list_obj b;
+    for (int i = 9; i >= 0; --i)
+    {
+      b.push_front(obj(i));
+    }
+    TS_ASSERT(is_container_valid(b, expected, 10));
+    TS_ASSERT(a == b);
+
+    /*
+     * Case3: Pop from either end.  Emptied chunks are released.
+     */
+    a.pop_front();
+    a.pop_back();
+    TS_ASSERT(is_container_valid(a, expected + 1, 8));
+    while (!a.empty())
+    {
+      a.pop_back();
+    }
+    TS_ASSERT_EQUALS(a.chunk_count(), 0);
+
+    /*
+     * Case4: Reverse iteration.
+     */
+    list_obj::const_reverse_iterator it = b.crbegin();
+    TS_ASSERT_EQUALS(*it, 9);
+    TS_ASSERT_EQUALS(*++it, 8);
+    TS_ASSERT_EQUALS(std::distance(b.rbegin(), b.rend()), 10);
+  }
+
+  void test_insert()
+  {
+    list_obj a;
+    for (int i = 0; i < 4; ++i)
+    {
+      a.push_back(obj(i * 10));
+    }
+    TS_ASSERT_EQUALS(a.chunk_count(), 1);
+
+    /*
+     * Case1: Inserting into a full chunk splits it in half.
+     */
+    list_obj::iterator it = a.begin();
+    std::advance(it, 3);
+    it = a.insert(it, obj(25));
+    TS_ASSERT_EQUALS(*it, 25);
+    TS_ASSERT_EQUALS(a.chunk_count(), 2);
+    const int split[] = { 0, 10, 20, 25, 30 };
+    TS_ASSERT(is_container_valid(a, split, 5));
+
+    /*
+     * Case2: Inserting at the start of a chunk appends to the previous chunk when it has room.
+     */
+    it = a.begin();
+    std::advance(it, 2);
+    list_obj::iterator next = a.insert(it, obj(15));
+    TS_ASSERT_EQUALS(*next, 15);
+    TS_ASSERT_EQUALS(a.chunk_count(), 2);
+    const int appended[] = { 0, 10, 15, 20, 25, 30 };
+    TS_ASSERT(is_container_valid(a, appended, 6));
+
+    /*
+     * Case3: Many insertions in the middle.
+     */
+    list_int b;
+    std::vector<int> expected;
+    for (int i = 0; i < 200; ++i)
+    {
+      const size_t pos = (i * 7919) % (expected.size() + 1);
+      list_int::iterator pos_it = b.begin();
+      std::advance(pos_it, pos);
+      TS_ASSERT_EQUALS(*b.insert(pos_it, i), i);
+      expected.insert(expected.begin() + pos, i);
+    }
+    TS_ASSERT(is_container_valid(b, &expected[0], 200));
+
+    /*
+     * Case4: Inserting an element of the list into its own chunk.
+     */
+    list_obj c(3, obj(1));
+    c.front() = obj(7);
+    c.insert(++c.begin(), c.front());
+    const int aliased[] = { 7, 7, 1, 1 };
+    TS_ASSERT(is_container_valid(c, aliased, 4));
+    c.insert(++c.begin(), c.back());
+    const int aliased_split[] = { 7, 1, 7, 1, 1 };
+    TS_ASSERT(is_container_valid(c, aliased_split, 5));
+
+    /*
+     * Case5: Fill and range insertion.
+     */
+    list_int d;
+    d.insert(d.end(), 3, 1);
+    const int data[] = { 2, 3, 4, 5, 6 };
+    d.insert(++d.begin(), data, data + 5);
+    const int ranged[] = { 1, 2, 3, 4, 5, 6, 1, 1 };
+    TS_ASSERT(is_container_valid(d, ranged, 8));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case6: Emplace.
+     */
+    list_obj e;
+    e.emplace_back(2);
+    e.emplace_front(0);
+    e.emplace(--e.end(), 1);
+    const int emplaced[] = { 0, 1, 2 };
+    TS_ASSERT(is_container_valid(e, emplaced, 3));
+#endif
+  }
+
+  void test_erase()
+  {
+    const int data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    list_obj a(data, data + 12);
+    TS_ASSERT_EQUALS(a.chunk_count(), 3);
+
+    /*
+     * Case1: Erase returns the element that followed the erased one.
+     */
+    list_obj::iterator it = a.begin();
+    std::advance(it, 3);
+    it = a.erase(it);
+    TS_ASSERT_EQUALS(*it, 4);
+    const int erased[] = { 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11 };
+    TS_ASSERT(is_container_valid(a, erased, 11));
+
+    /*
+     * Case2: A sparse chunk is merged with its neighbour.
+     */
+    it = a.begin();
+    it = a.erase(it);
+    it = a.erase(it);
+    TS_ASSERT_EQUALS(*it, 2);
+    TS_ASSERT_EQUALS(a.chunk_count(), 3);
+    ++it;
+    it = a.erase(it);
+    it = a.erase(it);
+    it = a.erase(it);
+    TS_ASSERT_EQUALS(*it, 7);
+    TS_ASSERT_EQUALS(a.chunk_count(), 2);
+    const int merged[] = { 2, 7, 8, 9, 10, 11 };
+    TS_ASSERT(is_container_valid(a, merged, 6));
+
+    /*
+     * Case3: Erasing a range spanning several chunks.
+     */
+    list_obj b(data, data + 12);
+    list_obj::iterator first = b.begin();
+    std::advance(first, 2);
+    list_obj::iterator last = first;
+    std::advance(last, 7);
+    it = b.erase(first, last);
+    TS_ASSERT_EQUALS(*it, 9);
+    const int range[] = { 0, 1, 9, 10, 11 };
+    TS_ASSERT(is_container_valid(b, range, 5));
+    TS_ASSERT(b.erase(b.begin(), b.end()) == b.end());
+    TS_ASSERT(is_container_valid(b, range, 0));
+
+    /*
+     * Case4: Erasing everything a single element at a time.
+     */
+    list_int c(data, data + 12);
+    list_int::iterator c_it = c.begin();
+    std::advance(c_it, 5);
+    while (c_it != c.end())
+    {
+      c_it = c.erase(c_it);
+    }
+    while (!c.empty())
+    {
+      c.erase(c.begin());
+    }
+    TS_ASSERT_EQUALS(c.chunk_count(), 0);
+  }
+
+  void test_remove_resize()
+  {
+    const int data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+    list_int a(data, data + 13);
+
+    /*
+     * Case1: remove_if compacts chunks and folds them together.
+     */
+    a.remove_if(is_odd());
+    const int evens[] = { 2, 4, 6, 8, 10, 12 };
+    TS_ASSERT(is_container_valid(a, evens, 6));
+    TS_ASSERT_EQUALS(a.chunk_count(), 2);
+
+    /*
+     * Case2: Remove by value, including with an element of the list.
+     */
+    a.remove(6);
+    a.remove(a.front());
+    const int removed[] = { 4, 8, 10, 12 };
+    TS_ASSERT(is_container_valid(a, removed, 4));
+
+    /*
+     * Case3: Resize in both directions.
+     */
+    a.resize(9, 1);
+    const int grown[] = { 4, 8, 10, 12, 1, 1, 1, 1, 1 };
+    TS_ASSERT(is_container_valid(a, grown, 9));
+    a.resize(2);
+    TS_ASSERT(is_container_valid(a, grown, 2));
+
+    /*
+     * Case4: Clear.
+     */
+    a.clear();
+    TS_ASSERT(is_container_valid(a, grown, 0));
+    TS_ASSERT_EQUALS(a.chunk_count(), 0);
+  }
+
+  void test_copy_swap()
+  {
+    const int data[] = { 4, 8, 15, 16, 23, 42 };
+    const int sevens[] = { 7, 7, 7 };
+
+    /*
+     * Case1: Copy constructor, assignment and assign.
+     */
+    list_int a(data, data + 6);
+    list_int b(a);
+    TS_ASSERT(is_container_valid(b, data, 6));
+    TS_ASSERT(a == b);
+    list_int c(3, 7);
+    b = c;
+    TS_ASSERT(is_container_valid(b, sevens, 3));
+    TS_ASSERT(a < b);
+    TS_ASSERT(a != b);
+    b.assign(data, data + 6);
+    TS_ASSERT(is_container_valid(b, data, 6));
+    b.assign(2, 7);
+    TS_ASSERT(is_container_valid(b, sevens, 2));
+
+    /*
+     * Case2: Swap.
+     */
+    a.swap(b);
+    TS_ASSERT(is_container_valid(a, sevens, 2));
+    TS_ASSERT(is_container_valid(b, data, 6));
+
+#ifdef FLEX_HAS_CXX11
+    /*
+     * Case3: Move constructor, move assignment and initializer lists.
+     */
+    list_int d(std::move(b));
+    TS_ASSERT(b.empty());
+    TS_ASSERT(is_container_valid(d, data, 6));
+    b = std::move(d);
+    TS_ASSERT(d.empty());
+    TS_ASSERT(is_container_valid(b, data, 6));
+    list_int e( { 4, 8, 15, 16, 23, 42 });
+    TS_ASSERT(e == b);
+    e = { 7, 7, 7};
+    TS_ASSERT(e == c);
+#endif
+  }
+
+  void test_fixed()
+  {
+    const int data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+    /*
+     * Case1: The fixed list does not allocate, even when every chunk is split.
+     */
+    flex::allocation_guard::enable();
+    fixed_list_obj a;
+    TS_ASSERT(a.fixed());
+    TS_ASSERT_EQUALS(a.capacity(), 32);
+    std::vector<int> expected;
+    for (int i = 0; i < 32; ++i)
+    {
+      fixed_list_obj::iterator it = a.begin();
+      std::advance(it, i / 2);
+      a.insert(it, obj(i));
+      expected.insert(expected.begin() + i / 2, i);
+    }
+    TS_ASSERT(is_container_valid(a, &expected[0], 32));
+    a.clear();
+    a.insert(a.end(), data, data + 12);
+    TS_ASSERT(is_container_valid(a, data, 12));
+    flex::allocation_guard::disable();
+
+    /*
+     * Case2: Copies and swaps between fixed and dynamic lists.
+     */
+    list_obj b(3, obj(7));
+    fixed_list_obj c(b);
+    TS_ASSERT(c == b);
+    c.swap(a);
+    TS_ASSERT(is_container_valid(c, data, 12));
+    TS_ASSERT_EQUALS(a.size(), 3);
+    b.swap(c);
+    TS_ASSERT(is_container_valid(b, data, 12));
+    TS_ASSERT_EQUALS(c.size(), 3);
+    TS_ASSERT(c.fixed());
+    TS_ASSERT(!b.fixed());
+
+    /*
+     * Case3: Erasures in the middle never leave enough sparse chunks to overflow the buffer.
+     */
+    flex::allocation_guard::enable();
+    flex::fixed_unrolled_list<int, 64, 8> d;
+    expected.clear();
+    srand(5);
+    for (int i = 0; i < 4000; ++i)
+    {
+      const size_t pos = expected.empty() ? 0 : rand() % (expected.size() + 1);
+      flex::fixed_unrolled_list<int, 64, 8>::iterator it = d.begin();
+      std::advance(it, pos);
+      if ((expected.size() < 64) && (rand() % 3))
+      {
+        d.insert(it, i);
+        expected.insert(expected.begin() + pos, i);
+      }
+      else if (rand() % 8 == 0)
+      {
+        const size_t n = std::min(expected.size() - pos, (size_t) (rand() % 24));
+        flex::fixed_unrolled_list<int, 64, 8>::iterator last = it;
+        std::advance(last, n);
+        it = d.erase(it, last);
+        expected.erase(expected.begin() + pos, expected.begin() + pos + n);
+        TS_ASSERT((pos == expected.size()) ? (it == d.end()) : (*it == expected[pos]));
+      }
+      else if (rand() % 8 == 0)
+      {
+        d.remove_if(is_odd());
+        expected.erase(std::remove_if(expected.begin(), expected.end(), is_odd()), expected.end());
+      }
+      else if (pos != expected.size())
+      {
+        it = d.erase(it);
+        expected.erase(expected.begin() + pos);
+        TS_ASSERT((pos == expected.size()) ? (it == d.end()) : (*it == expected[pos]));
+      }
+      TS_ASSERT(is_container_valid(d, expected.empty() ? NULL : &expected[0], expected.size(), 8));
+    }
+    TS_ASSERT(d.fixed());
+  }
+
+  void test_overflow()
+  {
+    /*
+     * Case1: Exceeding the buffer falls back to the heap and reports an error.
+     */
+    fixed_list_obj a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a.push_back(obj(i));
+    }
+    TS_ASSERT(errno);
+    errno = 0;
+    TS_ASSERT_EQUALS(a.size(), 100);
+    TS_ASSERT_EQUALS(a.back(), 99);
+  }
+
+};
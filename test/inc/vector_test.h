@@ -4,9 +4,64 @@
 #include "flex/debug/allocator.h"
 #include "flex/debug/obj.h"
 
+//A type with a user-defined copy constructor that is declared trivially relocatable.  The copy count
+//shows whether the vector relocated it with memcpy or copied it.
+struct vector_test_relocatable
+{
+  int val;
+  int copies;
+
+  vector_test_relocatable(int v) :
+      val(v), copies(0)
+  {
+  }
+
+  vector_test_relocatable(const vector_test_relocatable& obj) :
+      val(obj.val), copies(obj.copies + 1)
+  {
+  }
+};
+
+namespace flex
+{
+  template<> struct is_trivially_relocatable<vector_test_relocatable> : std::true_type
+  {
+  };
+}
+
 class vector_test: public CxxTest::TestSuite
 {
 
+  //Constructs up to mCount objs with consecutive values in the window.
+  struct generator
+  {
+    int mCount;
+
+    generator(int count) :
+        mCount(count)
+    {
+    }
+
+    size_t operator()(flex::debug::obj* p, size_t n)
+    {
+      size_t count = ((size_t) mCount < n) ? mCount : n;
+      for (size_t i = 0; i < count; ++i)
+      {
+        ::new ((void*) (p + i)) flex::debug::obj(i);
+      }
+      return count;
+    }
+  };
+
+  //Predicate for erase_if().
+  struct is_odd
+  {
+    bool operator()(const flex::debug::obj& o) const
+    {
+      return (o.val % 2) != 0;
+    }
+  };
+
   typedef flex::debug::obj obj;
   typedef flex::vector<obj, flex::debug::allocator<obj> > vec;
 
@@ -130,6 +185,33 @@ public:
     TS_ASSERT_EQUALS(third[2], 4);
   }
 
+  void test_append_with(void)
+  {
+    /*
+     * Case1: Fewer elements are produced than requested.
+     */
+    vec a(2, obj(7));
+    TS_ASSERT_EQUALS(a.append_with(10, generator(4)), 4);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.size(), 6);
+    TS_ASSERT_LESS_THAN_EQUALS(12, a.capacity());
+    TS_ASSERT_EQUALS(a[1], 7);
+    TS_ASSERT_EQUALS(a[2], 0);
+    TS_ASSERT_EQUALS(a[5], 3);
+
+    /*
+     * Case2: Bulk read into a vector of char.
+     */
+    flex::vector<char> b;
+    b.resize_uninitialized(5);
+    memcpy(&b[0], "hello", 5);
+    TS_ASSERT_EQUALS(b.size(), 5);
+    TS_ASSERT_EQUALS(b[4], 'o');
+    b.resize_default_init(2);
+    TS_ASSERT_EQUALS(b.size(), 2);
+    TS_ASSERT_EQUALS(b[1], 'e');
+  }
+
   void test_assign_initializer()
   {
     /*
@@ -431,6 +513,72 @@ public:
     TS_ASSERT_EQUALS(myvector[5], 10);
   }
 
+  void test_erase_if()
+  {
+    /*
+     * Case1: Nothing matches.
+     */
+    vec a;
+    TS_ASSERT_EQUALS(a.erase_if(is_odd()), 0);
+    a.push_back(2);
+    a.push_back(4);
+    TS_ASSERT_EQUALS(a.erase_if(is_odd()), 0);
+    TS_ASSERT_EQUALS(a.size(), 2);
+
+    /*
+     * Case2: Survivors keep their order and are moved rather than copied.
+     */
+    for (unsigned s = 0; s < 100; ++s)
+    {
+      a.assign(OBJ_DATA, OBJ_DATA + (s % 40));
+      vec expected;
+      for (unsigned i = 0; i < a.size(); ++i)
+      {
+        if (!is_odd()(a[i]))
+        {
+          expected.push_back(a[i]);
+        }
+      }
+      mark_move_only(a);
+      clear_copy_flags(a);
+      TS_ASSERT_EQUALS(a.erase_if(is_odd()), (s % 40) - expected.size());
+      TS_ASSERT(is_container_valid(a));
+      TS_ASSERT(a == expected);
+    }
+  }
+
+  void test_erase_unordered()
+  {
+    vec a(OBJ_DATA, OBJ_DATA + 10);
+
+    /*
+     * Case1: The last element fills the hole.
+     */
+    mark_move_only(a);
+    clear_copy_flags(a);
+    vec::iterator it = a.erase_unordered(a.begin() + 2);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT_EQUALS(a.size(), 9);
+    TS_ASSERT_EQUALS(*it, 9);
+    TS_ASSERT_EQUALS(a[1], 1);
+    TS_ASSERT_EQUALS(a[3], 3);
+
+    /*
+     * Case2: Erasing the last element.
+     */
+    it = a.erase_unordered(a.end() - 1);
+    TS_ASSERT(is_container_valid(a));
+    TS_ASSERT(it == a.end());
+    TS_ASSERT_EQUALS(a.size(), 8);
+    TS_ASSERT_EQUALS(a.back(), 7);
+
+    while (!a.empty())
+    {
+      a.erase_unordered(a.begin());
+    }
+    TS_ASSERT(is_container_valid(a));
+  }
+
   void test_front(void)
   {
     const size_t size = 3;
@@ -804,6 +952,50 @@ public:
 #endif
   }
 
+  void test_relocate(void)
+  {
+    /*
+     * Case1: Trait defaults and user specialization.
+     */
+    TS_ASSERT(flex::is_trivially_relocatable<int>::value);
+    TS_ASSERT(flex::is_trivially_relocatable<int*>::value);
+    TS_ASSERT(flex::is_trivially_relocatable<vector_test_relocatable>::value);
+
+    /*
+     * Case2: Relocatable elements are not copied when the vector grows.
+     */
+    flex::vector<vector_test_relocatable> a;
+    for (int i = 0; i < 100; ++i)
+    {
+      a.push_back(vector_test_relocatable(i));
+    }
+    a.shrink_to_fit();
+    a.insert(a.begin() + 50, vector_test_relocatable(-1));
+    a.reserve(1000);
+    TS_ASSERT_EQUALS(a.size(), 101);
+    for (int i = 0; i < 101; ++i)
+    {
+      TS_ASSERT_EQUALS(a[i].val, (i < 50) ? i : ((i == 50) ? -1 : i - 1));
+      TS_ASSERT_EQUALS(a[i].copies, 1);
+    }
+
+    /*
+     * Case3: Inserting an element of the container itself when it grows.
+     */
+    vec b(OBJ_DATA, OBJ_DATA + 4);
+    b.shrink_to_fit();
+    b.push_back(b[0]);
+    TS_ASSERT_EQUALS(b.back(), OBJ_DATA[0]);
+    b.insert(b.begin(), b[4]);
+    TS_ASSERT_EQUALS(b.front(), OBJ_DATA[0]);
+    b.shrink_to_fit();
+    b.insert(b.begin() + 1, 2, b[5]);
+    TS_ASSERT_EQUALS(b[1], OBJ_DATA[0]);
+    TS_ASSERT_EQUALS(b[2], OBJ_DATA[0]);
+    TS_ASSERT_EQUALS(b.size(), 8);
+    TS_ASSERT(is_container_valid(b));
+  }
+
   void test_rbegin_and_rend(void)
   {
     const size_t size = 3;
@@ -1,9 +1,34 @@
 #include <flex/fixed_pool.h>
+#include <flex/fixed_bitmap_pool.h>
 #include <flex/fixed_vector.h>
+#include <flex/small_vector.h>
 #include <flex/fixed_ring.h>
+#include <flex/fixed_slot_map.h>
 #include <flex/fixed_list.h>
 #include <flex/fixed_string.h>
 #include <flex/string_ref.h>
+#include <flex/arena.h>
+#include <flex/pmr.h>
+#include <flex/hugepage_allocator.h>
+#include <flex/growth_policy.h>
+#include <flex/segmented_vector.h>
+#include <flex/fixed_soa_vector.h>
+#include <flex/fixed_flat_map.h>
+#include <flex/fixed_flat_set.h>
+#include <flex/static_search_index.h>
+#include <flex/algorithm.h>
+#include <flex/intrusive_list.h>
+#include <flex/compact_fixed_list.h>
+#include <flex/unrolled_list.h>
+#include <flex/fixed_unrolled_list.h>
+#include <flex/fixed_lru_cache.h>
+#include <flex/slist.h>
+#include <flex/fixed_slist.h>
+#include <flex/skip_map.h>
+#include <flex/fixed_skip_map.h>
+#include <flex/btree_map.h>
+#include <flex/fixed_btree_map.h>
+#include <flex/timer_wheel.h>
 
 using namespace flex;
 int main(int argc, char** argv)